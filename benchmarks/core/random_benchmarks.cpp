@@ -0,0 +1,95 @@
+////////////////////////////////////////////////////////////////////////////////
+//         Distributed under the Boost Software License, Version 1.0.         //
+//            (See accompanying file LICENSE or copy at                       //
+//                 https://www.boost.org/LICENSE_1_0.txt)                     //
+////////////////////////////////////////////////////////////////////////////////
+
+#include <cstdint>
+#include <random>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include "core/random.h"
+#include "core/vector3.h"
+
+namespace
+{
+
+constexpr auto batch_size = 4096u;
+
+// what random_float used to do, a new engine seeded from a random_device on every call
+void seeded_mt19937_float(benchmark::State &state)
+{
+    thread_local std::random_device device;
+
+    for (auto _ : state)
+    {
+        std::mt19937 engine(device());
+        benchmark::DoNotOptimize(std::uniform_real_distribution<float>(0.0f, 1.0f)(engine));
+    }
+}
+
+void random_float(benchmark::State &state)
+{
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(iris::random_float(0.0f, 1.0f));
+    }
+}
+
+void random_int32(benchmark::State &state)
+{
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(iris::random_int32(-100, 100));
+    }
+}
+
+void random_floats(benchmark::State &state)
+{
+    std::vector<float> values(batch_size);
+
+    for (auto _ : state)
+    {
+        iris::random_floats(values, 0.0f, 1.0f);
+        benchmark::DoNotOptimize(values.data());
+    }
+
+    state.SetItemsProcessed(state.iterations() * batch_size);
+}
+
+void random_int32s(benchmark::State &state)
+{
+    std::vector<std::int32_t> values(batch_size);
+
+    for (auto _ : state)
+    {
+        iris::random_int32s(values, -100, 100);
+        benchmark::DoNotOptimize(values.data());
+    }
+
+    state.SetItemsProcessed(state.iterations() * batch_size);
+}
+
+void random_unit_vectors(benchmark::State &state)
+{
+    std::vector<iris::Vector3> values(batch_size);
+
+    for (auto _ : state)
+    {
+        iris::random_unit_vectors(values);
+        benchmark::DoNotOptimize(values.data());
+    }
+
+    state.SetItemsProcessed(state.iterations() * batch_size);
+}
+
+}
+
+BENCHMARK(seeded_mt19937_float);
+BENCHMARK(random_float);
+BENCHMARK(random_int32);
+BENCHMARK(random_floats);
+BENCHMARK(random_int32s);
+BENCHMARK(random_unit_vectors);
@@ -0,0 +1,232 @@
+////////////////////////////////////////////////////////////////////////////////
+//         Distributed under the Boost Software License, Version 1.0.         //
+//            (See accompanying file LICENSE or copy at                       //
+//                 https://www.boost.org/LICENSE_1_0.txt)                     //
+////////////////////////////////////////////////////////////////////////////////
+
+#include <algorithm>
+#include <chrono>
+#include <functional>
+#include <map>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include "core/string_id.h"
+#include "core/transform.h"
+#include "graphics/animation/animation.h"
+#include "graphics/bone.h"
+#include "graphics/keyframe.h"
+#include "graphics/skeleton.h"
+#include "log/log_level.h"
+#include "log/logger.h"
+
+using namespace std::chrono_literals;
+
+namespace
+{
+
+// each benchmark iteration is one frame of looking up every bone of a 64 bone skeleton
+
+constexpr auto bone_count = 64u;
+
+std::vector<std::string> bone_names()
+{
+    std::vector<std::string> names{};
+    for (auto i = 0u; i < bone_count; ++i)
+    {
+        // realistic names share long prefixes, which is the worst case for string compares
+        names.emplace_back("mixamorig:skeleton_bone_" + std::to_string(i));
+    }
+
+    return names;
+}
+
+std::vector<iris::StringId> bone_ids(const std::vector<std::string> &names)
+{
+    std::vector<iris::StringId> ids{};
+    std::transform(std::cbegin(names), std::cend(names), std::back_inserter(ids), [](const std::string &name) {
+        return iris::StringId{name};
+    });
+
+    return ids;
+}
+
+iris::Skeleton skeleton(const std::vector<std::string> &names)
+{
+    std::vector<iris::Bone> bones{};
+    bones.emplace_back("root", "", iris::Matrix4{}, iris::Matrix4{});
+    for (const auto &name : names)
+    {
+        bones.emplace_back(name, "root", iris::Matrix4{}, iris::Matrix4{});
+    }
+
+    return iris::Skeleton{bones};
+}
+
+iris::Animation animation(const std::vector<std::string> &names)
+{
+    std::map<std::string, std::vector<iris::KeyFrame>, std::less<>> frames{};
+    for (const auto &name : names)
+    {
+        frames[name] = {{iris::Transform{}, 0ms}, {iris::Transform{}, 1000ms}};
+    }
+
+    return {1000ms, "animation", frames};
+}
+
+// string keyed map, as Animation and CachedBoneQuery used to store bones
+void string_map_lookup(benchmark::State &state)
+{
+    const auto names = bone_names();
+    std::map<std::string, iris::Transform, std::less<>> transforms{};
+    for (const auto &name : names)
+    {
+        transforms[name] = {};
+    }
+
+    for (auto _ : state)
+    {
+        for (const auto &name : names)
+        {
+            benchmark::DoNotOptimize(transforms.find(name));
+        }
+    }
+
+    state.SetItemsProcessed(state.iterations() * bone_count);
+}
+
+void string_id_map_lookup(benchmark::State &state)
+{
+    const auto names = bone_names();
+    const auto ids = bone_ids(names);
+    std::unordered_map<iris::StringId, iris::Transform> transforms{};
+    for (const auto id : ids)
+    {
+        transforms[id] = {};
+    }
+
+    for (auto _ : state)
+    {
+        for (const auto id : ids)
+        {
+            benchmark::DoNotOptimize(transforms.find(id));
+        }
+    }
+
+    state.SetItemsProcessed(state.iterations() * bone_count);
+}
+
+// linear string compare, as Skeleton::bone_index used to do
+void bone_index_linear_string(benchmark::State &state)
+{
+    const auto names = bone_names();
+    const auto skeleton = ::skeleton(names);
+    const auto &bones = skeleton.bones();
+
+    for (auto _ : state)
+    {
+        for (const auto &name : names)
+        {
+            benchmark::DoNotOptimize(
+                std::find_if(std::cbegin(bones), std::cend(bones), [&name](const iris::Bone &bone) {
+                    return bone.name() == name;
+                }));
+        }
+    }
+
+    state.SetItemsProcessed(state.iterations() * bone_count);
+}
+
+void bone_index_string_id(benchmark::State &state)
+{
+    const auto names = bone_names();
+    const auto ids = bone_ids(names);
+    const auto skeleton = ::skeleton(names);
+
+    for (auto _ : state)
+    {
+        for (const auto id : ids)
+        {
+            benchmark::DoNotOptimize(skeleton.bone_index(id));
+        }
+    }
+
+    state.SetItemsProcessed(state.iterations() * bone_count);
+}
+
+void animation_transform_by_name(benchmark::State &state)
+{
+    const auto names = bone_names();
+    const auto animation = ::animation(names);
+
+    for (auto _ : state)
+    {
+        for (const auto &name : names)
+        {
+            benchmark::DoNotOptimize(animation.transform(name));
+        }
+    }
+
+    state.SetItemsProcessed(state.iterations() * bone_count);
+}
+
+void animation_transform_by_id(benchmark::State &state)
+{
+    const auto names = bone_names();
+    const auto ids = bone_ids(names);
+    const auto animation = ::animation(names);
+
+    for (auto _ : state)
+    {
+        for (const auto id : ids)
+        {
+            benchmark::DoNotOptimize(animation.transform(id));
+        }
+    }
+
+    state.SetItemsProcessed(state.iterations() * bone_count);
+}
+
+void log_tag_filter_by_name(benchmark::State &state)
+{
+    auto &logger = iris::Logger::instance();
+    logger.ignore_tag("ignored");
+
+    const std::string tag = "physics";
+
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(logger.is_enabled(iris::LogLevel::ERR, tag, false));
+    }
+
+    logger.show_tag("ignored");
+}
+
+void log_tag_filter_by_id(benchmark::State &state)
+{
+    auto &logger = iris::Logger::instance();
+    logger.ignore_tag("ignored");
+
+    const auto tag = iris::StringId{"physics"};
+
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(logger.is_enabled(iris::LogLevel::ERR, tag, false));
+    }
+
+    logger.show_tag("ignored");
+}
+
+}
+
+BENCHMARK(string_map_lookup);
+BENCHMARK(string_id_map_lookup);
+BENCHMARK(bone_index_linear_string);
+BENCHMARK(bone_index_string_id);
+BENCHMARK(animation_transform_by_name);
+BENCHMARK(animation_transform_by_id);
+BENCHMARK(log_tag_filter_by_name);
+BENCHMARK(log_tag_filter_by_id);
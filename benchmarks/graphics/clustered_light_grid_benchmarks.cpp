@@ -0,0 +1,118 @@
+////////////////////////////////////////////////////////////////////////////////
+//         Distributed under the Boost Software License, Version 1.0.         //
+//            (See accompanying file LICENSE or copy at                       //
+//                 https://www.boost.org/LICENSE_1_0.txt)                     //
+////////////////////////////////////////////////////////////////////////////////
+
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include "core/bounding_sphere.h"
+#include "core/camera.h"
+#include "core/camera_type.h"
+#include "core/random.h"
+#include "core/vector3.h"
+#include "graphics/clustered_light_grid.h"
+#include "graphics/lights/light.h"
+#include "graphics/lights/point_light.h"
+
+namespace
+{
+
+constexpr auto entity_count = 1000u;
+constexpr auto light_count = 256u;
+
+/**
+ * Helper function to get a random position in front of the default camera.
+ */
+iris::Vector3 random_position()
+{
+    return {
+        iris::random_float(-200.0f, 200.0f), iris::random_float(-200.0f, 200.0f), iris::random_float(-800.0f, 0.0f)};
+}
+
+/**
+ * Helper function to create lights scattered in front of the default camera, each with a range of ~70.
+ */
+std::vector<std::unique_ptr<iris::PointLight>> create_lights()
+{
+    std::vector<std::unique_ptr<iris::PointLight>> lights{};
+
+    for (auto i = 0u; i < light_count; ++i)
+    {
+        lights.push_back(std::make_unique<iris::PointLight>(random_position()));
+        lights.back()->set_attenuation_linear_term(0.0f);
+        lights.back()->set_attenuation_quadratic_term(0.05f);
+    }
+
+    return lights;
+}
+
+/**
+ * Helper function to create entity bounds scattered in front of the default camera.
+ */
+std::vector<iris::BoundingSphere> create_entities()
+{
+    std::vector<iris::BoundingSphere> entities{};
+
+    for (auto i = 0u; i < entity_count; ++i)
+    {
+        entities.push_back({random_position(), 5.0f});
+    }
+
+    return entities;
+}
+
+// cpu cost of assigning all lights to clusters, this is done every frame
+void clustered_light_grid_build(benchmark::State &state)
+{
+    const iris::Camera camera{iris::CameraType::PERSPECTIVE, 1920u, 1080u};
+    const auto lights = create_lights();
+    iris::ClusteredLightGrid grid{};
+
+    for (auto _ : state)
+    {
+        grid.build(camera, lights);
+        benchmark::ClobberMemory();
+    }
+
+    state.SetItemsProcessed(state.iterations() * light_count);
+}
+
+// building the grid and finding the lights for every entity, the "draws" counter is the number of point light draws
+// that would be issued compared to the "unculled_draws" of one draw per entity per light
+void clustered_light_grid_assign(benchmark::State &state)
+{
+    const iris::Camera camera{iris::CameraType::PERSPECTIVE, 1920u, 1080u};
+    const auto lights = create_lights();
+    const auto entities = create_entities();
+    iris::ClusteredLightGrid grid{};
+    std::vector<const iris::Light *> entity_lights{};
+    std::size_t draws = 0u;
+
+    for (auto _ : state)
+    {
+        grid.build(camera, lights);
+
+        draws = 0u;
+        for (const auto &entity : entities)
+        {
+            grid.lights(entity, entity_lights);
+            draws += entity_lights.size();
+        }
+
+        benchmark::DoNotOptimize(draws);
+    }
+
+    state.counters["draws"] = static_cast<double>(draws);
+    state.counters["unculled_draws"] = static_cast<double>(entity_count * light_count);
+    state.SetItemsProcessed(state.iterations() * entity_count);
+}
+
+}
+
+BENCHMARK(clustered_light_grid_build);
+BENCHMARK(clustered_light_grid_assign);
@@ -0,0 +1,102 @@
+////////////////////////////////////////////////////////////////////////////////
+//         Distributed under the Boost Software License, Version 1.0.         //
+//            (See accompanying file LICENSE or copy at                       //
+//                 https://www.boost.org/LICENSE_1_0.txt)                     //
+////////////////////////////////////////////////////////////////////////////////
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include "core/dirty_range_tracker.h"
+#include "core/matrix4.h"
+#include "core/random.h"
+#include "core/transform.h"
+#include "core/vector3.h"
+#include "graphics/instanced_entity.h"
+#include "graphics/mesh.h"
+
+namespace
+{
+
+constexpr auto instance_count = 100000u;
+
+/**
+ * Minimal mesh, instanced entities only need its bounds.
+ */
+class BenchmarkMesh : public iris::Mesh
+{
+  public:
+    BenchmarkMesh()
+        : Mesh({}, {})
+    {
+    }
+
+    void update_vertex_data(const std::vector<iris::VertexData> &) override
+    {
+    }
+
+    void update_index_data(const std::vector<std::uint32_t> &) override
+    {
+    }
+};
+
+/**
+ * Helper function to get a random transform.
+ */
+iris::Transform random_transform()
+{
+    return {{iris::random_float(-500.0f, 500.0f), 0.0f, iris::random_float(-500.0f, 500.0f)}, {}, {1.0f}};
+}
+
+// moving a percentage of 100k instances each frame and finding the ranges which need uploading, the "uploaded_bytes"
+// counter is the instance data that would be uploaded compared to the "full_bytes" of re-uploading every instance
+void instanced_entity_partial_update(benchmark::State &state)
+{
+    const auto changed = static_cast<std::size_t>(instance_count * state.range(0) / 100u);
+    const BenchmarkMesh mesh{};
+
+    std::vector<iris::Transform> transforms{};
+    for (auto i = 0u; i < instance_count; ++i)
+    {
+        transforms.push_back(random_transform());
+    }
+
+    iris::InstancedEntity entity{&mesh, transforms};
+    entity.clear_dirty_instances();
+
+    // crowds tend to move in groups, so change contiguous blocks of instances
+    std::vector<iris::DirtyRange> ranges{};
+    std::size_t uploaded = 0u;
+    std::size_t start = 0u;
+
+    for (auto _ : state)
+    {
+        for (auto i = 0u; i < changed; ++i)
+        {
+            entity.set_transform((start + i) % instance_count, random_transform());
+        }
+        start = (start + 7919u) % instance_count;
+
+        entity.dirty_instances().ranges(ranges);
+
+        uploaded = 0u;
+        for (const auto &range : ranges)
+        {
+            uploaded += (range.end - range.begin) * sizeof(iris::Matrix4) * 2u;
+        }
+
+        entity.clear_dirty_instances();
+        benchmark::DoNotOptimize(uploaded);
+    }
+
+    state.counters["uploaded_bytes"] = static_cast<double>(uploaded);
+    state.counters["full_bytes"] = static_cast<double>(entity.data().size() * sizeof(iris::Matrix4));
+    state.SetItemsProcessed(state.iterations() * changed);
+}
+
+}
+
+BENCHMARK(instanced_entity_partial_update)->Arg(1)->Arg(3)->Arg(10);
@@ -0,0 +1,117 @@
+////////////////////////////////////////////////////////////////////////////////
+//         Distributed under the Boost Software License, Version 1.0.         //
+//            (See accompanying file LICENSE or copy at                       //
+//                 https://www.boost.org/LICENSE_1_0.txt)                     //
+////////////////////////////////////////////////////////////////////////////////
+
+#include <filesystem>
+#include <string>
+
+#include <benchmark/benchmark.h>
+
+#include "core/vector3.h"
+#include "log/file_outputter.h"
+#include "log/format.h"
+#include "log/log.h"
+#include "log/log_level.h"
+#include "log/logger.h"
+#include "log/stdout_outputter.h"
+
+namespace
+{
+
+void disabled_by_level(benchmark::State &state)
+{
+    auto &logger = iris::Logger::instance();
+    logger.set_min_level(iris::LogLevel::ERR);
+
+    const iris::Vector3 position{1.0f, 2.0f, 3.0f};
+
+    for (auto _ : state)
+    {
+        logger.log(iris::LogLevel::DEBUG, "tag", __FILE__, __LINE__, false, "position: {} health: {}", position, 100.0f);
+    }
+
+    logger.set_min_level(iris::LogLevel::DEBUG);
+}
+
+void disabled_by_tag(benchmark::State &state)
+{
+    auto &logger = iris::Logger::instance();
+    logger.ignore_tag("tag");
+
+    const iris::Vector3 position{1.0f, 2.0f, 3.0f};
+
+    for (auto _ : state)
+    {
+        logger.log(iris::LogLevel::DEBUG, "tag", __FILE__, __LINE__, false, "position: {} health: {}", position, 100.0f);
+    }
+
+    logger.show_tag("tag");
+}
+
+void disabled_engine(benchmark::State &state)
+{
+    auto &logger = iris::Logger::instance();
+    logger.set_log_engine(false);
+
+    const iris::Vector3 position{1.0f, 2.0f, 3.0f};
+
+    for (auto _ : state)
+    {
+        logger.log(iris::LogLevel::DEBUG, "tag", __FILE__, __LINE__, true, "position: {} health: {}", position, 100.0f);
+    }
+}
+
+void format(benchmark::State &state)
+{
+    const iris::Vector3 position{1.0f, 2.0f, 3.0f};
+
+    for (auto _ : state)
+    {
+        auto &buffer = iris::format_buffer();
+        iris::format_to(buffer, "position: {} health: {} tag: {}", position, 100.0f, "player");
+        benchmark::DoNotOptimize(buffer.data());
+    }
+}
+
+void async_text(benchmark::State &state)
+{
+    auto &logger = iris::Logger::instance();
+    const auto path = std::filesystem::temp_directory_path() / "iris_benchmark.log";
+    logger.set_Outputter<iris::FileOutputter>(path.string());
+    logger.set_async(true, 1u << 16u, iris::LogOverflowPolicy::BLOCK);
+
+    for (auto _ : state)
+    {
+        IRIS_LOG(iris::LogLevel::INFO, false, "tag", "frame: {} time: {}", 1u, 16.6f);
+    }
+
+    logger.set_async(false);
+    logger.set_Outputter<iris::StdoutFormatter>();
+    std::filesystem::remove(path);
+}
+
+void binary(benchmark::State &state)
+{
+    auto &logger = iris::Logger::instance();
+    const auto path = std::filesystem::temp_directory_path() / "iris_benchmark.bin";
+    logger.set_binary_output(path, 1u << 26u);
+
+    for (auto _ : state)
+    {
+        IRIS_LOG(iris::LogLevel::INFO, false, "tag", "frame: {} time: {}", 1u, 16.6f);
+    }
+
+    logger.set_binary_output({});
+    std::filesystem::remove(path);
+}
+
+}
+
+BENCHMARK(disabled_by_level);
+BENCHMARK(disabled_by_tag);
+BENCHMARK(disabled_engine);
+BENCHMARK(format);
+BENCHMARK(async_text);
+BENCHMARK(binary);
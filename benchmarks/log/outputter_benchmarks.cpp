@@ -0,0 +1,79 @@
+////////////////////////////////////////////////////////////////////////////////
+//         Distributed under the Boost Software License, Version 1.0.         //
+//            (See accompanying file LICENSE or copy at                       //
+//                 https://www.boost.org/LICENSE_1_0.txt)                     //
+////////////////////////////////////////////////////////////////////////////////
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <string>
+
+#include <benchmark/benchmark.h>
+
+#include "log/file_outputter.h"
+#include "log/file_write_mode.h"
+#include "log/outputter.h"
+#include "log/rotating_file_outputter.h"
+
+namespace
+{
+
+constexpr std::size_t line_count = 1'000'000u;
+
+/**
+ * Write line_count lines to an outputter, flushing after each as the synchronous logger does.
+ */
+void write_lines(benchmark::State &state, iris::Outputter &outputter)
+{
+    const std::string line = "I 12:34:56.789 [game] main.cpp:42 | frame: 1234 time: 16.6 position: 1 2 3";
+
+    for (auto i = 0u; i < line_count; ++i)
+    {
+        outputter.output(line);
+        outputter.flush();
+    }
+
+    outputter.sync();
+
+    state.SetItemsProcessed(state.items_processed() + static_cast<std::int64_t>(line_count));
+    state.SetBytesProcessed(state.bytes_processed() + static_cast<std::int64_t>(line_count * (line.size() + 1u)));
+}
+
+void file_outputter(benchmark::State &state)
+{
+    const auto path = std::filesystem::temp_directory_path() / "iris_outputter_benchmark.log";
+
+    for (auto _ : state)
+    {
+        std::filesystem::remove(path);
+        iris::FileOutputter outputter{path.string()};
+        write_lines(state, outputter);
+    }
+
+    std::filesystem::remove(path);
+}
+
+void rotating_file_outputter(benchmark::State &state)
+{
+    const auto path = std::filesystem::temp_directory_path() / "iris_outputter_benchmark.log";
+
+    for (auto _ : state)
+    {
+        std::filesystem::remove(path);
+        iris::RotatingFileOutputter outputter{
+            path, {.buffer_size = 1u << 20u, .mode = static_cast<iris::FileWriteMode>(state.range(0))}};
+        write_lines(state, outputter);
+    }
+
+    std::filesystem::remove(path);
+}
+
+}
+
+BENCHMARK(file_outputter)->Unit(benchmark::kMillisecond);
+BENCHMARK(rotating_file_outputter)
+    ->Arg(static_cast<int>(iris::FileWriteMode::BUFFERED))
+    ->Arg(static_cast<int>(iris::FileWriteMode::DIRECT))
+    ->Arg(static_cast<int>(iris::FileWriteMode::MAPPED))
+    ->Unit(benchmark::kMillisecond);
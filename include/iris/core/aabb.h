@@ -0,0 +1,159 @@
+////////////////////////////////////////////////////////////////////////////////
+//         Distributed under the Boost Software License, Version 1.0.         //
+//            (See accompanying file LICENSE or copy at                       //
+//                 https://www.boost.org/LICENSE_1_0.txt)                     //
+////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+#include "core/matrix4.h"
+#include "core/vector3.h"
+
+namespace iris
+{
+
+/**
+ * Class representing an axis aligned bounding box.
+ *
+ * This is a header only class to allow for constexpr methods.
+ */
+class AABB
+{
+  public:
+    /**
+     * Construct an empty AABB, merging anything into it will produce a valid box.
+     */
+    constexpr AABB()
+        : AABB({std::numeric_limits<float>::max()}, {std::numeric_limits<float>::lowest()})
+    {
+    }
+
+    /**
+     * Construct an AABB from its minimum and maximum corners.
+     *
+     * @param min
+     *   Minimum corner.
+     *
+     * @param max
+     *   Maximum corner.
+     */
+    constexpr AABB(const Vector3 &min, const Vector3 &max)
+        : min(min)
+        , max(max)
+    {
+    }
+
+    /**
+     * Check if the AABB contains nothing.
+     *
+     * @returns
+     *   True if AABB is empty, false otherwise.
+     */
+    constexpr bool empty() const
+    {
+        return (min.x > max.x) || (min.y > max.y) || (min.z > max.z);
+    }
+
+    /**
+     * Grow the AABB to contain a point.
+     *
+     * @param point
+     *   Point to contain.
+     *
+     * @returns
+     *   Reference to this AABB.
+     */
+    constexpr AABB &merge(const Vector3 &point)
+    {
+        min = {std::min(min.x, point.x), std::min(min.y, point.y), std::min(min.z, point.z)};
+        max = {std::max(max.x, point.x), std::max(max.y, point.y), std::max(max.z, point.z)};
+
+        return *this;
+    }
+
+    /**
+     * Grow the AABB to contain another AABB.
+     *
+     * @param aabb
+     *   AABB to contain.
+     *
+     * @returns
+     *   Reference to this AABB.
+     */
+    constexpr AABB &merge(const AABB &aabb)
+    {
+        if (!aabb.empty())
+        {
+            merge(aabb.min);
+            merge(aabb.max);
+        }
+
+        return *this;
+    }
+
+    /**
+     * Get the centre of the AABB.
+     *
+     * @returns
+     *   Centre point.
+     */
+    constexpr Vector3 centre() const
+    {
+        return (min + max) * 0.5f;
+    }
+
+    /**
+     * Get the half size of the AABB along each axis.
+     *
+     * @returns
+     *   Half extents.
+     */
+    constexpr Vector3 extents() const
+    {
+        return (max - min) * 0.5f;
+    }
+
+    /**
+     * Get an AABB which contains this AABB after it has been transformed.
+     *
+     * @param transform
+     *   Transform to apply.
+     *
+     * @returns
+     *   Transformed AABB.
+     */
+    AABB transformed(const Matrix4 &transform) const
+    {
+        if (empty())
+        {
+            return *this;
+        }
+
+        // transform the centre and project the extents onto each world axis (Arvo's method), this is much cheaper
+        // than transforming all eight corners
+        const auto centre = transform * this->centre();
+        const auto extents = this->extents();
+
+        const Vector3 world_extents{
+            std::abs(transform[0]) * extents.x + std::abs(transform[1]) * extents.y +
+                std::abs(transform[2]) * extents.z,
+            std::abs(transform[4]) * extents.x + std::abs(transform[5]) * extents.y +
+                std::abs(transform[6]) * extents.z,
+            std::abs(transform[8]) * extents.x + std::abs(transform[9]) * extents.y +
+                std::abs(transform[10]) * extents.z};
+
+        return {centre - world_extents, centre + world_extents};
+    }
+
+    /** Minimum corner. */
+    Vector3 min;
+
+    /** Maximum corner. */
+    Vector3 max;
+};
+
+}
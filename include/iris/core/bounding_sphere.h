@@ -0,0 +1,112 @@
+////////////////////////////////////////////////////////////////////////////////
+//         Distributed under the Boost Software License, Version 1.0.         //
+//            (See accompanying file LICENSE or copy at                       //
+//                 https://www.boost.org/LICENSE_1_0.txt)                     //
+////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+
+#include "core/matrix4.h"
+#include "core/vector3.h"
+
+namespace iris
+{
+
+/**
+ * Class representing a bounding sphere.
+ *
+ * This is a header only class to allow for constexpr methods.
+ */
+class BoundingSphere
+{
+  public:
+    /**
+     * Construct a sphere of radius 0 at the origin.
+     */
+    constexpr BoundingSphere()
+        : BoundingSphere({}, 0.0f)
+    {
+    }
+
+    /**
+     * Construct a sphere.
+     *
+     * @param centre
+     *   Centre of sphere.
+     *
+     * @param radius
+     *   Radius of sphere.
+     */
+    constexpr BoundingSphere(const Vector3 &centre, float radius)
+        : centre(centre)
+        , radius(radius)
+    {
+    }
+
+    /**
+     * Get a sphere which contains this sphere after it has been transformed.
+     *
+     * @param transform
+     *   Transform to apply.
+     *
+     * @returns
+     *   Transformed sphere.
+     */
+    BoundingSphere transformed(const Matrix4 &transform) const
+    {
+        // scale the radius by the largest axis scale so the sphere always contains the transformed object
+        const auto axis_scale = [&transform](std::size_t column)
+        {
+            return Vector3{transform[column], transform[column + 4u], transform[column + 8u]}.magnitude();
+        };
+        const auto scale = std::max({axis_scale(0u), axis_scale(1u), axis_scale(2u)});
+
+        return {transform * centre, radius * scale};
+    }
+
+    /**
+     * Grow the sphere to contain another sphere.
+     *
+     * @param sphere
+     *   Sphere to contain.
+     *
+     * @returns
+     *   Reference to this sphere.
+     */
+    BoundingSphere &merge(const BoundingSphere &sphere)
+    {
+        const auto offset = sphere.centre - centre;
+        const auto distance = offset.magnitude();
+
+        if (distance + sphere.radius <= radius)
+        {
+            // already contained
+            return *this;
+        }
+
+        if (distance + radius <= sphere.radius)
+        {
+            *this = sphere;
+            return *this;
+        }
+
+        // smallest sphere touching the far side of both spheres
+        const auto new_radius = (distance + radius + sphere.radius) * 0.5f;
+        centre += offset * ((new_radius - radius) / distance);
+        radius = new_radius;
+
+        return *this;
+    }
+
+    /** Centre of sphere. */
+    Vector3 centre;
+
+    /** Radius of sphere. */
+    float radius;
+};
+
+}
@@ -9,6 +9,7 @@
 #include <cstdint>
 
 #include "core/camera_type.h"
+#include "core/frustum.h"
 #include "core/matrix4.h"
 #include "core/quaternion.h"
 #include "core/vector3.h"
@@ -103,6 +104,30 @@ class Camera
      */
     Matrix4 projection() const;
 
+    /**
+     * Get the view frustum of the camera, in world space.
+     *
+     * @returns
+     *   Camera frustum.
+     */
+    Frustum frustum() const;
+
+    /**
+     * Get the distance to the near plane along the view direction. For an orthographic camera this may be negative.
+     *
+     * @returns
+     *   Near plane distance.
+     */
+    float near_plane() const;
+
+    /**
+     * Get the distance to the far plane along the view direction.
+     *
+     * @returns
+     *   Far plane distance.
+     */
+    float far_plane() const;
+
     /**
      * Get camera yaw.
      *
@@ -183,6 +208,12 @@ class Camera
     /** Projection Matrix4 for the camera. */
     Matrix4 projection_;
 
+    /** Distance to near plane. */
+    float near_plane_;
+
+    /** Distance to far plane. */
+    float far_plane_;
+
     /** Pitch of camera. */
     float pitch_;
 
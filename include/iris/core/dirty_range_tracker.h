@@ -0,0 +1,101 @@
+////////////////////////////////////////////////////////////////////////////////
+//         Distributed under the Boost Software License, Version 1.0.         //
+//            (See accompanying file LICENSE or copy at                       //
+//                 https://www.boost.org/LICENSE_1_0.txt)                     //
+////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace iris
+{
+
+/**
+ * A half open range [begin, end) of element indices.
+ */
+struct DirtyRange
+{
+    /** First element in range. */
+    std::size_t begin;
+
+    /** One past the last element in range. */
+    std::size_t end;
+
+    bool operator==(const DirtyRange &) const = default;
+};
+
+/**
+ * Class for tracking which elements of an array have changed, so only those need to be copied (e.g. uploaded to the
+ * GPU). Changed elements are stored as a bitset so marking is cheap, and then converted into a minimal set of
+ * contiguous ranges when they are consumed.
+ */
+class DirtyRangeTracker
+{
+  public:
+    /**
+     * Create a new DirtyRangeTracker.
+     *
+     * @param merge_gap
+     *   Dirty ranges separated by this many (or fewer) clean elements are merged into a single range, which trades
+     *   copying some clean elements for fewer copies.
+     */
+    explicit DirtyRangeTracker(std::size_t merge_gap = 0u);
+
+    /**
+     * Mark an element as dirty.
+     *
+     * @param index
+     *   Index of element.
+     */
+    void mark(std::size_t index);
+
+    /**
+     * Mark a range of elements as dirty.
+     *
+     * @param begin
+     *   Index of first element.
+     *
+     * @param end
+     *   One past the index of the last element.
+     */
+    void mark(std::size_t begin, std::size_t end);
+
+    /**
+     * Check if any elements are dirty.
+     *
+     * @returns
+     *   True if no elements are dirty, otherwise false.
+     */
+    bool empty() const;
+
+    /**
+     * Get the dirty elements as contiguous ranges, in ascending order.
+     *
+     * @param ranges
+     *   Collection to write ranges to, any existing contents are replaced.
+     */
+    void ranges(std::vector<DirtyRange> &ranges) const;
+
+    /**
+     * Mark all elements as clean.
+     */
+    void clear();
+
+  private:
+    /** Bitset of dirty elements. */
+    std::vector<std::uint64_t> bits_;
+
+    /** Index of first word in bits_ which may have a bit set. */
+    std::size_t first_word_;
+
+    /** One past the index of last word in bits_ which may have a bit set. */
+    std::size_t last_word_;
+
+    /** Maximum gap between merged ranges. */
+    std::size_t merge_gap_;
+};
+
+}
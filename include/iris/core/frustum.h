@@ -0,0 +1,80 @@
+////////////////////////////////////////////////////////////////////////////////
+//         Distributed under the Boost Software License, Version 1.0.         //
+//            (See accompanying file LICENSE or copy at                       //
+//                 https://www.boost.org/LICENSE_1_0.txt)                     //
+////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <array>
+
+#include "core/aabb.h"
+#include "core/bounding_sphere.h"
+#include "core/matrix4.h"
+#include "core/vector3.h"
+
+namespace iris
+{
+
+/**
+ * Class representing a view frustum as six inward facing planes.
+ */
+class Frustum
+{
+  public:
+    /**
+     * A plane, a point p is in front of the plane if normal.dot(p) + distance >= 0.
+     */
+    struct Plane
+    {
+        /** Unit normal of plane. */
+        Vector3 normal;
+
+        /** Signed distance of plane from origin. */
+        float distance;
+    };
+
+    /**
+     * Extract the frustum planes from a combined projection and view matrix.
+     *
+     * @param view_projection
+     *   Projection matrix multiplied by view matrix.
+     */
+    explicit Frustum(const Matrix4 &view_projection);
+
+    /**
+     * Get the planes of the frustum, in the order left, right, bottom, top, near, far.
+     *
+     * @returns
+     *   Frustum planes.
+     */
+    const std::array<Plane, 6u> &planes() const;
+
+    /**
+     * Check if a sphere is at least partially inside the frustum.
+     *
+     * @param sphere
+     *   Sphere to test.
+     *
+     * @returns
+     *   True if sphere intersects frustum, false otherwise.
+     */
+    bool intersects(const BoundingSphere &sphere) const;
+
+    /**
+     * Check if an AABB is at least partially inside the frustum.
+     *
+     * @param aabb
+     *   AABB to test.
+     *
+     * @returns
+     *   True if AABB intersects frustum, false otherwise.
+     */
+    bool intersects(const AABB &aabb) const;
+
+  private:
+    /** Frustum planes. */
+    std::array<Plane, 6u> planes_;
+};
+
+}
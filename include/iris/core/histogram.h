@@ -0,0 +1,203 @@
+////////////////////////////////////////////////////////////////////////////////
+//         Distributed under the Boost Software License, Version 1.0.         //
+//            (See accompanying file LICENSE or copy at                       //
+//                 https://www.boost.org/LICENSE_1_0.txt)                     //
+////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+
+namespace iris
+{
+
+/**
+ * Lock free histogram of durations. Values are bucketed in a log-linear fashion (similar to HdrHistogram), each
+ * power of two range is split into 32 linear sub-buckets, giving a worst case relative error of ~3%.
+ *
+ * Recording is wait free and can be done from any thread.
+ */
+class Histogram
+{
+  public:
+    /**
+     * Summary statistics of a histogram, all durations are in microseconds.
+     */
+    struct Summary
+    {
+        std::uint64_t count = 0u;
+        std::uint64_t min = 0u;
+        std::uint64_t max = 0u;
+        double mean = 0.0;
+        std::uint64_t p50 = 0u;
+        std::uint64_t p95 = 0u;
+        std::uint64_t p99 = 0u;
+    };
+
+    /**
+     * Construct a new empty Histogram.
+     */
+    Histogram();
+
+    /**
+     * Record a value.
+     *
+     * @param value
+     *   Value to record.
+     */
+    void record(std::chrono::microseconds value);
+
+    /**
+     * Get the number of recorded values.
+     *
+     * @returns
+     *   Number of recorded values.
+     */
+    std::uint64_t count() const;
+
+    /**
+     * Get the value at a given percentile.
+     *
+     * @param percentile
+     *   Percentile to get, in the range [0.0, 1.0].
+     *
+     * @returns
+     *   Value at percentile, or 0 if the histogram is empty.
+     */
+    std::chrono::microseconds percentile(double percentile) const;
+
+    /**
+     * Get summary statistics of the histogram.
+     *
+     * @returns
+     *   Histogram summary.
+     */
+    Summary summary() const;
+
+    /**
+     * Reset all values. Values recorded concurrently with a reset may or may not be included.
+     */
+    void reset();
+
+    /**
+     * Get summary statistics of the histogram and reset it in a single step. Each value is exchanged out rather than
+     * read then cleared, so a value recorded concurrently is never lost (although its parts may be split between this
+     * summary and the next).
+     *
+     * @returns
+     *   Summary of values recorded since the last reset.
+     */
+    Summary take_summary();
+
+  private:
+    /** Number of linear sub-buckets per power of two, as a power of two. */
+    static constexpr std::uint32_t sub_bucket_bits = 5u;
+
+    /** Number of linear sub-buckets per power of two. */
+    static constexpr std::uint32_t sub_bucket_count = 1u << sub_bucket_bits;
+
+    /** Total number of buckets, enough to cover the full 64 bit range. */
+    static constexpr std::size_t bucket_count = (64u - sub_bucket_bits + 1u) * sub_bucket_count;
+
+    /**
+     * Get the index of the bucket a value belongs in.
+     *
+     * @param value
+     *   Value to bucket.
+     *
+     * @returns
+     *   Bucket index.
+     */
+    static std::size_t bucket_index(std::uint64_t value);
+
+    /**
+     * Get the smallest value that falls into a bucket.
+     *
+     * @param index
+     *   Bucket index.
+     *
+     * @returns
+     *   Lowest value in bucket.
+     */
+    static std::uint64_t bucket_lower_bound(std::size_t index);
+
+    /** Plain copy of the bucket hit counts. */
+    using Buckets = std::array<std::uint64_t, bucket_count>;
+
+    /**
+     * Get the value at a given percentile of a copy of the buckets.
+     *
+     * @param buckets
+     *   Bucket hit counts.
+     *
+     * @param min
+     *   Smallest recorded value.
+     *
+     * @param max
+     *   Largest recorded value.
+     *
+     * @param percentile
+     *   Percentile to get, in the range [0.0, 1.0].
+     *
+     * @returns
+     *   Value at percentile, or 0 if there are no values.
+     */
+    static std::uint64_t percentile(const Buckets &buckets, std::uint64_t min, std::uint64_t max, double percentile);
+
+    /**
+     * Get summary statistics of a copy of the histogram.
+     *
+     * @param buckets
+     *   Bucket hit counts.
+     *
+     * @param count
+     *   Number of recorded values.
+     *
+     * @param sum
+     *   Sum of recorded values.
+     *
+     * @param min
+     *   Smallest recorded value.
+     *
+     * @param max
+     *   Largest recorded value.
+     *
+     * @returns
+     *   Summary.
+     */
+    static Summary summarise(
+        const Buckets &buckets,
+        std::uint64_t count,
+        std::uint64_t sum,
+        std::uint64_t min,
+        std::uint64_t max);
+
+    /**
+     * Copy the bucket hit counts.
+     *
+     * @returns
+     *   Bucket hit counts.
+     */
+    Buckets load_buckets() const;
+
+    /** Hit count for each bucket. */
+    std::array<std::atomic<std::uint64_t>, bucket_count> buckets_;
+
+    /** Number of recorded values. */
+    std::atomic<std::uint64_t> count_;
+
+    /** Sum of recorded values. */
+    std::atomic<std::uint64_t> sum_;
+
+    /** Smallest recorded value. */
+    std::atomic<std::uint64_t> min_;
+
+    /** Largest recorded value. */
+    std::atomic<std::uint64_t> max_;
+};
+
+}
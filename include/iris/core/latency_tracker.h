@@ -0,0 +1,136 @@
+////////////////////////////////////////////////////////////////////////////////
+//         Distributed under the Boost Software License, Version 1.0.         //
+//            (See accompanying file LICENSE or copy at                       //
+//                 https://www.boost.org/LICENSE_1_0.txt)                     //
+////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <mutex>
+#include <optional>
+
+namespace iris
+{
+
+class Histogram;
+class TelemetryCounter;
+
+/**
+ * Opt-in tracker for end-to-end input latency, from the time an input event is received to the time the frame which
+ * could first react to it is presented.
+ *
+ * The Looper advances the frame id at the start of every frame, each Event pumped from a Window is stamped with the
+ * frame it was received in and reported here, and the Renderer reports when it presents. At present time the oldest
+ * unpresented input gives the latency for that frame. Results are reported through Telemetry:
+ *
+ *   latency.input_to_present - histogram of latency for each presented frame which had input
+ *   latency.presented_inputs - counter of presented frames which had input
+ *   latency.input_frame_lag  - counter of frames between input and present, divide by latency.presented_inputs for
+ *                              the average pipelining depth
+ *
+ * Note that present time is when the swap/present call returns, the driver may still queue the frame before it is
+ * displayed.
+ */
+class LatencyTracker
+{
+  public:
+    /**
+     * Get single instance.
+     *
+     * @returns
+     *   LatencyTracker single instance.
+     */
+    static LatencyTracker &instance();
+
+    LatencyTracker();
+
+    LatencyTracker(const LatencyTracker &) = delete;
+    LatencyTracker &operator=(const LatencyTracker &) = delete;
+
+    /**
+     * Enable or disable tracking, disabling discards any pending input.
+     *
+     * @param enabled
+     *   True to enable tracking.
+     */
+    void set_enabled(bool enabled);
+
+    /**
+     * Check if tracking is enabled.
+     *
+     * @returns
+     *   True if enabled.
+     */
+    bool enabled() const
+    {
+        return enabled_.load(std::memory_order_relaxed);
+    }
+
+    /**
+     * Start a new frame.
+     *
+     * @returns
+     *   Id of new frame.
+     */
+    std::uint64_t begin_frame()
+    {
+        return frame_.fetch_add(1u, std::memory_order_relaxed) + 1u;
+    }
+
+    /**
+     * Get the id of the current frame.
+     *
+     * @returns
+     *   Current frame id.
+     */
+    std::uint64_t frame() const
+    {
+        return frame_.load(std::memory_order_relaxed);
+    }
+
+    /**
+     * Record that an input was received. Does nothing if tracking is disabled.
+     *
+     * @param frame
+     *   Frame the input was received in.
+     *
+     * @param timestamp
+     *   Time the input was received.
+     */
+    void record_input(std::uint64_t frame, std::chrono::steady_clock::time_point timestamp);
+
+    /**
+     * Record that the current frame has been presented. Does nothing if tracking is disabled.
+     */
+    void record_present();
+
+  private:
+    /** Whether tracking is enabled. */
+    std::atomic<bool> enabled_;
+
+    /** Current frame id. */
+    std::atomic<std::uint64_t> frame_;
+
+    /** Oldest input not yet presented. */
+    std::optional<std::chrono::steady_clock::time_point> pending_timestamp_;
+
+    /** Frame of oldest input not yet presented. */
+    std::uint64_t pending_frame_;
+
+    /** Latency histogram. */
+    Histogram &latency_histogram_;
+
+    /** Count of presented frames with input. */
+    TelemetryCounter &presented_counter_;
+
+    /** Sum of frames between input and present. */
+    TelemetryCounter &frame_lag_counter_;
+
+    /** Lock for pending input. */
+    std::mutex mutex_;
+};
+
+}
@@ -7,6 +7,7 @@
 #pragma once
 
 #include <chrono>
+#include <cstdint>
 #include <functional>
 
 namespace iris
@@ -16,6 +17,27 @@ namespace iris
  * This class provides a game looper. It takes two functions, one that is called
  * at a fixed time step and another that is run as frequently as possible. This
  * is based on the https://gafferongames.com/post/fix_your_timestep/ article.
+ *
+ * Frame and step timings are recorded into the engine Telemetry (see
+ * telemetry.h) under the following names:
+ *   looper.frame_time          - histogram of frame durations
+ *   looper.fixed_step          - histogram of fixed step function durations
+ *   looper.variable_step       - histogram of variable step function durations
+ *   looper.frames              - counter of frames
+ *   looper.fixed_steps         - counter of fixed steps
+ *   looper.fixed_step_overruns - counter of fixed steps that took longer than
+ *                                the timestep they simulated
+ *   looper.catch_up_limited    - counter of frames where the maximum number of
+ *                                fixed steps was hit and time was dropped
+ *
+ * Each iteration also starts a new LatencyTracker frame, so input events
+ * can be tied to the frame they were received in.
+ *
+ * To prevent a "spiral of death" (where slow fixed steps cause more fixed
+ * steps to be needed to catch up) the number of fixed steps per frame can be
+ * capped, any time that couldn't be simulated is then dropped. By default
+ * there is no cap, so all elapsed time is simulated. An optional frame
+ * limiter can be set to sleep away any time left in a frame.
  */
 class Looper
 {
@@ -34,6 +56,27 @@ class Looper
      */
     using LoopFunction = std::function<bool(std::chrono::microseconds, std::chrono::microseconds)>;
 
+    /**
+     * Definition of a variable time step function which also receives an
+     * interpolation factor.
+     *
+     * @param clock
+     *   Total elapsed time since loop started.
+     *
+     * @param delta
+     *   Duration of frame.
+     *
+     * @param alpha
+     *   How far (in the range [0.0, 1.0)) between the last and next fixed
+     *   step the current time is. This can be used to interpolate between
+     *   the previous and current fixed step state when rendering.
+     *
+     * @returns
+     *   True if loop should continue, false if it should exit.
+     */
+    using InterpolatedLoopFunction =
+        std::function<bool(std::chrono::microseconds, std::chrono::microseconds, float)>;
+
     /**
      * Construct a new looper.
      *
@@ -55,6 +98,57 @@ class Looper
         LoopFunction fixed_timestep,
         LoopFunction variable_timestep);
 
+    /**
+     * Construct a new looper, with a variable time step function that is
+     * passed an interpolation factor.
+     *
+     * @param clock
+     *   Start time of looping.
+     *
+     * @param timestep
+     *   How frequently to call the fixed time step function.
+     *
+     * @param fixed_timestep
+     *   Function to call at the supplied fixed timestep.
+     *
+     * @param variable_timestep
+     *   Function to call as frequently as possible (or at the frame limit).
+     */
+    Looper(
+        std::chrono::microseconds clock,
+        std::chrono::microseconds timestep,
+        LoopFunction fixed_timestep,
+        InterpolatedLoopFunction variable_timestep);
+
+    /**
+     * Set the minimum duration of a frame, the looper will sleep at the end
+     * of a frame until this has elapsed. A value of 0 disables the limiter.
+     *
+     * @param min_frame_time
+     *   Minimum frame duration.
+     */
+    void set_frame_limit(std::chrono::microseconds min_frame_time);
+
+    /**
+     * Set how much of the end of each frame limiter wait is spent spinning
+     * rather than sleeping. Spinning gives more precise frame times but keeps
+     * a core busy, so the default of 0 (always sleep) suits headless servers
+     * whereas a client may want ~1-2ms.
+     *
+     * @param spin_time
+     *   Duration to spin for.
+     */
+    void set_frame_limit_spin(std::chrono::microseconds spin_time);
+
+    /**
+     * Set the maximum number of fixed steps to run in a single frame. A
+     * value of 0 (the default) means there is no limit.
+     *
+     * @param max_fixed_steps
+     *   Maximum number of fixed steps per frame.
+     */
+    void set_max_fixed_steps(std::uint32_t max_fixed_steps);
+
     /**
      * Run the loop. Will continue until one of the supplied functions
      * returns false. Clock time will start incrementing from this call.
@@ -72,7 +166,16 @@ class Looper
     LoopFunction fixed_timestep_;
 
     /** Function to run at variable time step. */
-    LoopFunction variable_timestep_;
+    InterpolatedLoopFunction variable_timestep_;
+
+    /** Minimum frame duration, 0 if not limited. */
+    std::chrono::microseconds min_frame_time_;
+
+    /** How long to spin at the end of a frame limiter wait. */
+    std::chrono::microseconds spin_time_;
+
+    /** Maximum fixed steps per frame, 0 if unlimited. */
+    std::uint32_t max_fixed_steps_;
 };
 
 }
@@ -0,0 +1,219 @@
+////////////////////////////////////////////////////////////////////////////////
+//         Distributed under the Boost Software License, Version 1.0.         //
+//            (See accompanying file LICENSE or copy at                       //
+//                 https://www.boost.org/LICENSE_1_0.txt)                     //
+////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <memory>
+#include <utility>
+
+#include "core/error_handling.h"
+
+namespace iris
+{
+
+/**
+ * Bounded lock-free multi-producer single-consumer FIFO queue.
+ *
+ * Each slot has a sequence number which producers and the consumer use to hand ownership of the slot back and forth,
+ * so producers only contend on claiming a position and never block each other or the consumer.
+ *
+ * Capacity is rounded up to a power of two (with a minimum of two, as a single slot can't distinguish full from
+ * empty).
+ */
+template <class T>
+class MpscQueue
+{
+  public:
+    /**
+     * Construct a new MpscQueue.
+     *
+     * @param capacity
+     *   Maximum number of elements in the queue, will be rounded up to a power of two.
+     */
+    explicit MpscQueue(std::size_t capacity)
+        : slots_(nullptr)
+        , mask_(0u)
+        , tail_(0u)
+        , head_(0u)
+    {
+        ensure(capacity > 0u, "capacity must be non-zero");
+
+        const auto size = std::bit_ceil(std::max(capacity, std::size_t{2u}));
+        slots_ = std::make_unique<Slot[]>(size);
+        mask_ = size - 1u;
+
+        for (auto i = 0u; i < size; ++i)
+        {
+            slots_[i].sequence.store(i, std::memory_order_relaxed);
+        }
+    }
+
+    MpscQueue(const MpscQueue &) = delete;
+    MpscQueue &operator=(const MpscQueue &) = delete;
+
+    /**
+     * Get the capacity of the queue.
+     *
+     * @returns
+     *   Maximum number of elements.
+     */
+    std::size_t capacity() const
+    {
+        return mask_ + 1u;
+    }
+
+    /**
+     * Try and push a value on to the queue. Safe to call from any thread.
+     *
+     * @param value
+     *   Value to push, only moved from if push succeeds.
+     *
+     * @returns
+     *   True if value was pushed, false if the queue was full.
+     */
+    bool try_push(T &&value)
+    {
+        return try_push_with([&value](T &slot_value) { slot_value = std::move(value); });
+    }
+
+    /**
+     * Try and push a value on to the queue by writing it in place, so a slot's existing storage (e.g. string capacity)
+     * can be reused. Safe to call from any thread.
+     *
+     * @param write
+     *   Callable which is passed the slot's value to overwrite, only called if there is space. If it throws the slot is
+     *   still pushed with whatever was written.
+     *
+     * @returns
+     *   True if a value was pushed, false if the queue was full.
+     */
+    template <class Write>
+    bool try_push_with(Write &&write)
+    {
+        auto position = tail_.load(std::memory_order_relaxed);
+
+        for (;;)
+        {
+            auto &slot = slots_[position & mask_];
+            const auto sequence = slot.sequence.load(std::memory_order_acquire);
+            const auto diff = static_cast<std::ptrdiff_t>(sequence) - static_cast<std::ptrdiff_t>(position);
+
+            if (diff == 0)
+            {
+                // slot is free, try and claim it
+                if (tail_.compare_exchange_weak(position, position + 1u, std::memory_order_relaxed))
+                {
+                    // the slot has to be handed to the consumer even if writing fails, otherwise the queue stalls
+                    const SequenceUpdate update{slot.sequence, position + 1u};
+                    write(slot.value);
+                    return true;
+                }
+            }
+            else if (diff < 0)
+            {
+                // slot still holds a value the consumer hasn't popped, so we're full
+                return false;
+            }
+            else
+            {
+                // another producer claimed this position
+                position = tail_.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    /**
+     * Try and pop a value from the queue. Must only be called from a single consumer thread.
+     *
+     * @param value
+     *   Out parameter to move popped value into.
+     *
+     * @returns
+     *   True if a value was popped, false if the queue was empty.
+     */
+    bool try_pop(T &value)
+    {
+        return try_pop_with([&value](T &slot_value) { value = std::move(slot_value); });
+    }
+
+    /**
+     * Try and pop a value from the queue by reading it in place, so the slot keeps its storage for the next push. Must
+     * only be called from a single consumer thread.
+     *
+     * @param read
+     *   Callable which is passed the slot's value, only called if the queue is not empty. The value is popped even if
+     *   it throws.
+     *
+     * @returns
+     *   True if a value was popped, false if the queue was empty.
+     */
+    template <class Read>
+    bool try_pop_with(Read &&read)
+    {
+        auto &slot = slots_[head_ & mask_];
+
+        // a slot is ready when the producer has bumped its sequence to one passed the position
+        if (slot.sequence.load(std::memory_order_acquire) != head_ + 1u)
+        {
+            return false;
+        }
+
+        // mark the slot as free for the producer one lap ahead once we're done with it
+        const SequenceUpdate update{slot.sequence, head_ + mask_ + 1u};
+        ++head_;
+        read(slot.value);
+
+        return true;
+    }
+
+  private:
+    /**
+     * Internal struct for a queue slot.
+     */
+    struct Slot
+    {
+        /** Sequence number used to hand the slot between producers and the consumer. */
+        std::atomic<std::size_t> sequence;
+
+        /** Stored value. */
+        T value;
+    };
+
+    /**
+     * Internal struct to publish a new slot sequence number on scope exit.
+     */
+    struct SequenceUpdate
+    {
+        ~SequenceUpdate()
+        {
+            sequence.store(value, std::memory_order_release);
+        }
+
+        /** Sequence number to update. */
+        std::atomic<std::size_t> &sequence;
+
+        /** New value. */
+        std::size_t value;
+    };
+
+    /** Queue storage. */
+    std::unique_ptr<Slot[]> slots_;
+
+    /** Mask to wrap a position to an index. */
+    std::size_t mask_;
+
+    /** Next position to push to, shared by all producers. */
+    alignas(64) std::atomic<std::size_t> tail_;
+
+    /** Next position to pop from, only touched by the consumer. */
+    alignas(64) std::size_t head_;
+};
+
+}
@@ -0,0 +1,69 @@
+////////////////////////////////////////////////////////////////////////////////
+//         Distributed under the Boost Software License, Version 1.0.         //
+//            (See accompanying file LICENSE or copy at                       //
+//                 https://www.boost.org/LICENSE_1_0.txt)                     //
+////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <cstdint>
+
+#include "core/trace_recorder.h"
+
+namespace iris
+{
+
+/**
+ * RAII class which records a named zone covering its lifetime into the TraceRecorder.
+ *
+ * This should be used via the IRIS_PROFILE_SCOPE macro, which compiles out unless IRIS_ENABLE_PROFILE_ZONES is
+ * defined.
+ */
+class ProfileScope
+{
+  public:
+    /**
+     * Construct a new ProfileScope, starting the zone.
+     *
+     * @param name
+     *   Name of zone, must have static storage duration (e.g. a string literal).
+     */
+    explicit ProfileScope(const char *name)
+        : name_(name)
+        , begin_(TraceRecorder::instance().is_recording() ? TraceRecorder::now() : 0u)
+    {
+    }
+
+    /**
+     * End the zone.
+     */
+    ~ProfileScope()
+    {
+        if (begin_ != 0u)
+        {
+            TraceRecorder::instance().record(name_, begin_, TraceRecorder::now());
+        }
+    }
+
+    ProfileScope(const ProfileScope &) = delete;
+    ProfileScope &operator=(const ProfileScope &) = delete;
+
+  private:
+    /** Name of zone. */
+    const char *name_;
+
+    /** Start time of zone, 0 if we were not recording at construction. */
+    std::uint64_t begin_;
+};
+
+}
+
+// helper macros to generate a unique variable name per line
+#define IRIS_PROFILE_CONCAT_IMPL(a, b) a##b
+#define IRIS_PROFILE_CONCAT(a, b) IRIS_PROFILE_CONCAT_IMPL(a, b)
+
+#if defined(IRIS_ENABLE_PROFILE_ZONES)
+#define IRIS_PROFILE_SCOPE(NAME) ::iris::ProfileScope IRIS_PROFILE_CONCAT(iris_profile_scope_, __LINE__)(NAME)
+#else
+#define IRIS_PROFILE_SCOPE(NAME) static_cast<void>(0)
+#endif
@@ -6,29 +6,96 @@
 
 #pragma once
 
+#include <cstdint>
+#include <filesystem>
 #include <memory>
 
+#include "core/profiler_output_format.h"
+
 namespace iris
 {
 
 /**
- * Sampling based profiler which periodically suspends and samples all running threads.
- * 
- * Currently prints the profile breakdown to stdout when program ends.
+ * Sampling based profiler which periodically samples the stacks of running threads.
+ *
+ * Profiling can be started and stopped at runtime, every time profiling is stopped the profile breakdown for that
+ * session is written out in the configured format. The destructor will stop a running profiler.
  */
 class Profiler
 {
   public:
     /**
-     * Construct a new Profiler.
+     * Construct a new Profiler which immediately starts profiling and prints a text breakdown to stdout.
      */
     Profiler();
-    
+
+    /**
+     * Construct a new Profiler.
+     *
+     * @param format
+     *   Format to write profile in.
+     *
+     * @param output_path
+     *   Path of file to write profile to, if empty then stdout is used.
+     *
+     * @param start_immediately
+     *   If true then profiling is started on construction, else start() must be called.
+     */
+    Profiler(ProfilerOutputFormat format, const std::filesystem::path &output_path, bool start_immediately = true);
+
     /**
-     * Signals profiling thread to stop
+     * Stops profiling (if running).
      */
     ~Profiler();
 
+    Profiler(const Profiler &) = delete;
+    Profiler &operator=(const Profiler &) = delete;
+
+    /**
+     * Start profiling, discarding any samples from a previous session. Does nothing if already running.
+     */
+    void start();
+
+    /**
+     * Stop profiling and write the profile breakdown. Does nothing if not running.
+     */
+    void stop();
+
+    /**
+     * Check if the profiler is currently sampling.
+     *
+     * @returns
+     *   True if profiling, otherwise false.
+     */
+    bool is_running() const;
+
+    /**
+     * Set how many samples per second to take of each thread, takes effect on the next call to start(). Where
+     * supported this is measured in thread cpu time, so idle threads are not sampled.
+     *
+     * Higher frequencies need more memory to buffer samples, at the maximum this is just under 1MB per sampled thread.
+     *
+     * @param frequency
+     *   Samples per second, must be in the range [1, 10000].
+     */
+    void set_sample_frequency(std::uint32_t frequency);
+
+    /**
+     * Set the format the profile will be written in, takes effect on the next call to stop().
+     *
+     * @param format
+     *   New output format.
+     */
+    void set_output_format(ProfilerOutputFormat format);
+
+    /**
+     * Set the path the profile will be written to, takes effect on the next call to stop().
+     *
+     * @param output_path
+     *   Path of file to write profile to, if empty then stdout is used.
+     */
+    void set_output_path(const std::filesystem::path &output_path);
+
   private:
     /** Pointer to implementation. */
     struct implementation;
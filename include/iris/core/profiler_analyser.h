@@ -7,15 +7,21 @@
 #pragma once
 
 #include <cstdint>
+#include <filesystem>
+#include <iosfwd>
+#include <map>
 #include <string>
 #include <unordered_map>
 #include <vector>
 
+#include "core/profiler_output_format.h"
+
 namespace iris
 {
 
 /**
- * Class which records stack traces as they are generated and pretty prints the final profile stats.
+ * Class which records stack traces as they are generated and writes the final profile stats in one of several
+ * formats.
  */
 class ProfilerAnalyser
 {
@@ -23,16 +29,82 @@ class ProfilerAnalyser
     /**
      * Add a stack trace to the analyser.
      *
+     * @param thread_id
+     *   Id of the thread the stack trace was sampled from.
+     *
      * @param stack_trace
-     *   The stack trace to add.
+     *   The stack trace to add, innermost frame first.
      */
-    void add_stack_trace(const std::vector<std::string> &stack_trace);
+    void add_stack_trace(std::uint64_t thread_id, const std::vector<std::string> &stack_trace);
+
+    /**
+     * Get the total number of stack traces recorded.
+     *
+     * @returns
+     *   Number of recorded samples.
+     */
+    std::uint32_t sample_count() const;
 
     /**
      * Pretty print all generated profile stats to stdout.
      */
     void print();
 
+    /**
+     * Write the profile stats to a stream in the supplied format.
+     *
+     * @param format
+     *   Format to write.
+     *
+     * @param out
+     *   Stream to write to.
+     */
+    void write(ProfilerOutputFormat format, std::ostream &out);
+
+    /**
+     * Write the profile stats to a file in the supplied format (including TEXT). If the path is empty then the stats
+     * are written to stdout.
+     *
+     * @param format
+     *   Format to write.
+     *
+     * @param path
+     *   Path of file to write to.
+     */
+    void write(ProfilerOutputFormat format, const std::filesystem::path &path);
+
+    /**
+     * Write profile stats as an indented tree of call counts and percentages, as print() does.
+     *
+     * @param out
+     *   Stream to write to.
+     */
+    void write_text(std::ostream &out);
+
+    /**
+     * Write profile stats as collapsed stacks, one line per unique stack prefixed with the thread it was sampled from.
+     *
+     * @param out
+     *   Stream to write to.
+     */
+    void write_collapsed(std::ostream &out) const;
+
+    /**
+     * Write profile stats as a speedscope JSON document, with one sampled profile per thread.
+     *
+     * @param out
+     *   Stream to write to.
+     */
+    void write_speedscope(std::ostream &out) const;
+
+    /**
+     * Write profile stats as an (uncompressed) pprof protobuf, each sample is labelled with its thread id.
+     *
+     * @param out
+     *   Stream to write to.
+     */
+    void write_pprof(std::ostream &out) const;
+
   private:
     /**
      * Struct to encapsulate recorded data.
@@ -46,6 +118,18 @@ class ProfilerAnalyser
 
     /** Start of the profiling heirarchy. */
     Level root_level_;
+
+    /** Interned function names, index is the frame id. */
+    std::vector<std::string> frames_;
+
+    /** Map of function name to frame id. */
+    std::unordered_map<std::string, std::uint32_t> frame_lookup_;
+
+    /** Map of thread id to unique stacks (outermost frame first) and their hit counts. */
+    std::map<std::uint64_t, std::map<std::vector<std::uint32_t>, std::uint32_t>> thread_stacks_;
+
+    /** Total number of samples recorded. */
+    std::uint32_t sample_count_ = 0u;
 };
 
 }
@@ -0,0 +1,32 @@
+////////////////////////////////////////////////////////////////////////////////
+//         Distributed under the Boost Software License, Version 1.0.         //
+//            (See accompanying file LICENSE or copy at                       //
+//                 https://www.boost.org/LICENSE_1_0.txt)                     //
+////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <cstdint>
+
+namespace iris
+{
+
+/**
+ * Enumeration of formats the profiler can write its results in.
+ */
+enum class ProfilerOutputFormat : std::uint8_t
+{
+    /** Indented text tree (legacy format). */
+    TEXT,
+
+    /** Brendan Gregg collapsed stacks, suitable for flamegraph.pl. */
+    COLLAPSED,
+
+    /** speedscope JSON file format (https://www.speedscope.app). */
+    SPEEDSCOPE,
+
+    /** Uncompressed pprof protobuf. */
+    PPROF
+};
+
+}
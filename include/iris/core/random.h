@@ -7,10 +7,41 @@
 #pragma once
 
 #include <cstdint>
+#include <span>
+
+#include "core/random_generator.h"
+#include "core/vector3.h"
 
 namespace iris
 {
 
+/**
+ * Get the random generator for the calling thread. This is lock free, each thread has its own generator.
+ *
+ * @returns
+ *   Generator for calling thread.
+ */
+RandomGenerator &thread_random_generator();
+
+/**
+ * Set the seed for all thread generators, each thread reseeds (with its stream) the next time it generates a value.
+ * Until this is called the seed is non-deterministic.
+ *
+ * @param seed
+ *   New seed.
+ */
+void set_random_seed(std::uint64_t seed);
+
+/**
+ * Set the stream of the calling threads generator and reseed it. By default each thread is given a unique stream in
+ * the order they first generate a value, for deterministic replays across threads each thread should set an explicit
+ * stream (e.g. its worker index).
+ *
+ * @param stream
+ *   New stream.
+ */
+void set_thread_random_stream(std::uint64_t stream);
+
 /**
  * Generate a uniform random integer in the range [min, max].
  *
@@ -49,7 +80,7 @@ std::int32_t random_int32(std::int32_t min, std::int32_t max);
  *   Maximum value.
  *
  * @returns
- *   Random integer.
+ *   Random float.
  */
 float random_float(float min, float max);
 
@@ -64,6 +95,56 @@ float random_float(float min, float max);
  */
 bool flip_coin(float bias = 0.5f);
 
+/**
+ * Fill a buffer with uniform random integers in the range [min, max].
+ *
+ * @param out
+ *   Buffer to fill.
+ *
+ * @param min
+ *   Minimum value.
+ *
+ * @param max
+ *   Maximum value.
+ */
+void random_uint32s(std::span<std::uint32_t> out, std::uint32_t min, std::uint32_t max);
+
+/**
+ * Fill a buffer with uniform random integers in the range [min, max].
+ *
+ * @param out
+ *   Buffer to fill.
+ *
+ * @param min
+ *   Minimum value.
+ *
+ * @param max
+ *   Maximum value.
+ */
+void random_int32s(std::span<std::int32_t> out, std::int32_t min, std::int32_t max);
+
+/**
+ * Fill a buffer with uniform random floats in the range [min, max).
+ *
+ * @param out
+ *   Buffer to fill.
+ *
+ * @param min
+ *   Minimum value.
+ *
+ * @param max
+ *   Maximum value.
+ */
+void random_floats(std::span<float> out, float min, float max);
+
+/**
+ * Fill a buffer with random unit vectors, uniformly distributed over the sphere.
+ *
+ * @param out
+ *   Buffer to fill.
+ */
+void random_unit_vectors(std::span<Vector3> out);
+
 /**
  * Get a random element from a collection.
  *
@@ -0,0 +1,262 @@
+////////////////////////////////////////////////////////////////////////////////
+//         Distributed under the Boost Software License, Version 1.0.         //
+//            (See accompanying file LICENSE or copy at                       //
+//                 https://www.boost.org/LICENSE_1_0.txt)                     //
+////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <limits>
+#include <span>
+
+#include "core/vector3.h"
+
+namespace iris
+{
+
+/**
+ * A small, fast, seedable random number generator (xoshiro256**). It is not thread safe, the intended use is one
+ * generator per thread (see thread_random_generator()).
+ *
+ * A generator is constructed from a seed and a stream, generators with the same seed and stream produce the same
+ * sequence, which allows for deterministic replays. Different streams of the same seed produce independent
+ * sequences, so each thread can be given its own.
+ *
+ * This satisfies UniformRandomBitGenerator so can also be used with the standard library distributions.
+ */
+class RandomGenerator
+{
+  public:
+    using result_type = std::uint64_t;
+
+    /**
+     * Construct a new RandomGenerator.
+     *
+     * @param seed
+     *   Seed for the sequence.
+     *
+     * @param stream
+     *   Stream of the seed to use.
+     */
+    explicit RandomGenerator(std::uint64_t seed = 0u, std::uint64_t stream = 0u);
+
+    /**
+     * Reset the generator to the start of a sequence.
+     *
+     * @param seed
+     *   Seed for the sequence.
+     *
+     * @param stream
+     *   Stream of the seed to use.
+     */
+    void seed(std::uint64_t seed, std::uint64_t stream = 0u);
+
+    /**
+     * Smallest value returned by operator().
+     */
+    static constexpr result_type min()
+    {
+        return std::numeric_limits<result_type>::min();
+    }
+
+    /**
+     * Largest value returned by operator().
+     */
+    static constexpr result_type max()
+    {
+        return std::numeric_limits<result_type>::max();
+    }
+
+    /**
+     * Generate the next 64 random bits.
+     *
+     * @returns
+     *   Random value.
+     */
+    result_type operator()()
+    {
+        const auto result = rotl(state_[1] * 5u, 7) * 9u;
+        const auto t = state_[1] << 17u;
+
+        state_[2] ^= state_[0];
+        state_[3] ^= state_[1];
+        state_[1] ^= state_[2];
+        state_[0] ^= state_[3];
+        state_[2] ^= t;
+        state_[3] = rotl(state_[3], 45);
+
+        return result;
+    }
+
+    /**
+     * Generate a uniform random integer in the range [min, max].
+     *
+     * @param min
+     *   Minimum value.
+     *
+     * @param max
+     *   Maximum value.
+     *
+     * @returns
+     *   Random integer.
+     */
+    std::uint32_t uniform_uint32(std::uint32_t min, std::uint32_t max)
+    {
+        // Lemire's nearly divisionless bounded integers, range of 0 means the full 32 bits
+        const auto range = static_cast<std::uint32_t>(max - min + 1u);
+        if (range == 0u)
+        {
+            return static_cast<std::uint32_t>((*this)() >> 32u);
+        }
+
+        auto product = ((*this)() >> 32u) * range;
+        auto low = static_cast<std::uint32_t>(product);
+
+        if (low < range)
+        {
+            const auto threshold = static_cast<std::uint32_t>(-range) % range;
+            while (low < threshold)
+            {
+                product = ((*this)() >> 32u) * range;
+                low = static_cast<std::uint32_t>(product);
+            }
+        }
+
+        return min + static_cast<std::uint32_t>(product >> 32u);
+    }
+
+    /**
+     * Generate a uniform random integer in the range [min, max].
+     *
+     * @param min
+     *   Minimum value.
+     *
+     * @param max
+     *   Maximum value.
+     *
+     * @returns
+     *   Random integer.
+     */
+    std::int32_t uniform_int32(std::int32_t min, std::int32_t max)
+    {
+        const auto offset = uniform_uint32(0u, static_cast<std::uint32_t>(max) - static_cast<std::uint32_t>(min));
+        return static_cast<std::int32_t>(static_cast<std::uint32_t>(min) + offset);
+    }
+
+    /**
+     * Generate a uniform random float in the range [min, max).
+     *
+     * @param min
+     *   Minimum value.
+     *
+     * @param max
+     *   Maximum value.
+     *
+     * @returns
+     *   Random float.
+     */
+    float uniform_float(float min, float max)
+    {
+        return min + (max - min) * unit_float();
+    }
+
+    /**
+     * Flip a (biased) coin.
+     *
+     * @param bias
+     *   Possibility of heads [0.0, 1.0]. A value of 0.5 is a fair coin toss.
+     *
+     * @returns
+     *   True if heads, false if tails.
+     */
+    bool flip_coin(float bias = 0.5f)
+    {
+        return unit_float() < bias;
+    }
+
+    /**
+     * Generate a random unit vector, uniformly distributed over the sphere.
+     *
+     * @returns
+     *   Random unit vector.
+     */
+    Vector3 unit_vector();
+
+    /**
+     * Fill a buffer with uniform random integers in the range [min, max].
+     *
+     * @param out
+     *   Buffer to fill.
+     *
+     * @param min
+     *   Minimum value.
+     *
+     * @param max
+     *   Maximum value.
+     */
+    void fill_uint32(std::span<std::uint32_t> out, std::uint32_t min, std::uint32_t max);
+
+    /**
+     * Fill a buffer with uniform random integers in the range [min, max].
+     *
+     * @param out
+     *   Buffer to fill.
+     *
+     * @param min
+     *   Minimum value.
+     *
+     * @param max
+     *   Maximum value.
+     */
+    void fill_int32(std::span<std::int32_t> out, std::int32_t min, std::int32_t max);
+
+    /**
+     * Fill a buffer with uniform random floats in the range [min, max).
+     *
+     * @param out
+     *   Buffer to fill.
+     *
+     * @param min
+     *   Minimum value.
+     *
+     * @param max
+     *   Maximum value.
+     */
+    void fill_float(std::span<float> out, float min, float max);
+
+    /**
+     * Fill a buffer with random unit vectors, uniformly distributed over the sphere.
+     *
+     * @param out
+     *   Buffer to fill.
+     */
+    void fill_unit_vector(std::span<Vector3> out);
+
+  private:
+    /**
+     * Generate a uniform random float in the range [0, 1).
+     *
+     * @returns
+     *   Random float.
+     */
+    float unit_float()
+    {
+        // top 24 bits fill the float mantissa exactly
+        return static_cast<float>((*this)() >> 40u) * 0x1.0p-24f;
+    }
+
+    /**
+     * Rotate bits left.
+     */
+    static constexpr std::uint64_t rotl(std::uint64_t x, int k)
+    {
+        return (x << k) | (x >> (64 - k));
+    }
+
+    /** Generator state. */
+    std::array<std::uint64_t, 4u> state_;
+};
+
+}
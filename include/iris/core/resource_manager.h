@@ -7,13 +7,12 @@
 #pragma once
 
 #include <filesystem>
-#include <string>
 #include <string_view>
 #include <unordered_map>
 #include <vector>
 
 #include "core/data_buffer.h"
-#include "core/string_hash.h"
+#include "core/string_id.h"
 
 namespace iris
 {
@@ -40,6 +39,17 @@ class ResourceManager
      */
     const DataBuffer &load(std::string_view resource);
 
+    /**
+     * Get a resource which has already been loaded (by name) without hashing its name again.
+     *
+     * @param resource
+     *   Id of name of resource.
+     *
+     * @returns
+     *   Const reference to loaded data.
+     */
+    const DataBuffer &load(StringId resource) const;
+
     /**
      * Set root resource location. Note that implementations may choose to ignore this.
      *
@@ -64,8 +74,8 @@ class ResourceManager
     std::filesystem::path root_;
 
   private:
-    /** Cache of loaded resources. */
-    std::unordered_map<std::string, DataBuffer, StringHash, std::equal_to<>> resources_;
+    /** Cache of loaded resources, keyed by name id. */
+    std::unordered_map<StringId, DataBuffer> resources_;
 };
 
 }
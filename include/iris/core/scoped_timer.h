@@ -0,0 +1,54 @@
+////////////////////////////////////////////////////////////////////////////////
+//         Distributed under the Boost Software License, Version 1.0.         //
+//            (See accompanying file LICENSE or copy at                       //
+//                 https://www.boost.org/LICENSE_1_0.txt)                     //
+////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <chrono>
+
+#include "core/histogram.h"
+
+namespace iris
+{
+
+/**
+ * RAII class which records the duration of its lifetime into a Histogram.
+ */
+class ScopedTimer
+{
+  public:
+    /**
+     * Construct a new ScopedTimer, starting the timer.
+     *
+     * @param histogram
+     *   Histogram to record into, must outlive this object.
+     */
+    explicit ScopedTimer(Histogram &histogram)
+        : histogram_(histogram)
+        , start_(std::chrono::steady_clock::now())
+    {
+    }
+
+    /**
+     * Stop the timer and record the duration.
+     */
+    ~ScopedTimer()
+    {
+        histogram_.record(
+            std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start_));
+    }
+
+    ScopedTimer(const ScopedTimer &) = delete;
+    ScopedTimer &operator=(const ScopedTimer &) = delete;
+
+  private:
+    /** Histogram to record into. */
+    Histogram &histogram_;
+
+    /** Time timer was started. */
+    std::chrono::steady_clock::time_point start_;
+};
+
+}
@@ -6,6 +6,11 @@
 
 #pragma once
 
+#include <cstddef>
+#include <functional>
+#include <string>
+#include <string_view>
+
 namespace iris
 {
 
@@ -0,0 +1,137 @@
+////////////////////////////////////////////////////////////////////////////////
+//         Distributed under the Boost Software License, Version 1.0.         //
+//            (See accompanying file LICENSE or copy at                       //
+//                 https://www.boost.org/LICENSE_1_0.txt)                     //
+////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <compare>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string_view>
+
+namespace iris
+{
+
+/**
+ * A compact identifier for a string, the 64 bit FNV-1a hash of its characters. As the hash is constexpr, ids for
+ * literals can be computed at compile time and lookups by id are a single integer compare/hash rather than a string
+ * one.
+ *
+ * Ids are not reversible. In debug builds strings passed to intern() are recorded so name() can be used to get back
+ * the original string (and to catch collisions), in release name() always returns an empty string.
+ */
+class StringId
+{
+  public:
+    /**
+     * Construct an id for the empty string.
+     */
+    constexpr StringId()
+        : StringId(std::string_view{})
+    {
+    }
+
+    /**
+     * Construct an id for a string.
+     *
+     * @param str
+     *   String to hash.
+     */
+    explicit constexpr StringId(std::string_view str)
+        : value_(hash(str))
+    {
+    }
+
+    /**
+     * Construct an id for a string and, in debug builds, record the string so it can be retrieved with name(). This
+     * should be used where strings are first introduced (e.g. when loading) rather than in hot paths.
+     *
+     * @param str
+     *   String to hash.
+     *
+     * @returns
+     *   Id for string.
+     */
+    static StringId intern(std::string_view str);
+
+    /**
+     * Get the string this id was interned from.
+     *
+     * @returns
+     *   Original string in debug builds if it was interned, otherwise an empty string.
+     */
+    std::string_view name() const;
+
+    /**
+     * Get the hash value.
+     *
+     * @returns
+     *   Hash value.
+     */
+    constexpr std::uint64_t value() const
+    {
+        return value_;
+    }
+
+    constexpr auto operator<=>(const StringId &) const = default;
+
+  private:
+    /**
+     * Compute the FNV-1a hash of a string.
+     *
+     * @param str
+     *   String to hash.
+     *
+     * @returns
+     *   Hash of string.
+     */
+    static constexpr std::uint64_t hash(std::string_view str)
+    {
+        auto hash = 14695981039346656037ull;
+
+        for (const auto c : str)
+        {
+            hash ^= static_cast<std::uint8_t>(c);
+            hash *= 1099511628211ull;
+        }
+
+        return hash;
+    }
+
+    /** Hash value. */
+    std::uint64_t value_;
+};
+
+/**
+ * Construct a StringId at compile time.
+ *
+ * @param str
+ *   String literal.
+ *
+ * @param length
+ *   Length of string literal.
+ *
+ * @returns
+ *   Id for string.
+ */
+consteval StringId operator""_sid(const char *str, std::size_t length)
+{
+    return StringId{std::string_view{str, length}};
+}
+
+}
+
+/**
+ * Specialisation of std::hash so StringId can be used as a key. The value is already a good hash.
+ */
+template <>
+struct std::hash<iris::StringId>
+{
+    std::size_t operator()(const iris::StringId &id) const
+    {
+        return static_cast<std::size_t>(id.value());
+    }
+};
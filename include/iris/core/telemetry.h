@@ -0,0 +1,170 @@
+////////////////////////////////////////////////////////////////////////////////
+//         Distributed under the Boost Software License, Version 1.0.         //
+//            (See accompanying file LICENSE or copy at                       //
+//                 https://www.boost.org/LICENSE_1_0.txt)                     //
+////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <filesystem>
+#include <functional>
+#include <iosfwd>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+
+#include "core/histogram.h"
+#include "core/telemetry_counter.h"
+
+namespace iris
+{
+
+/**
+ * Point in time copy of all telemetry values.
+ */
+struct TelemetrySnapshot
+{
+    /** Time snapshot was taken. */
+    std::chrono::system_clock::time_point timestamp;
+
+    /** Value of each counter. */
+    std::map<std::string, std::uint64_t> counters;
+
+    /** Summary of each histogram. */
+    std::map<std::string, Histogram::Summary> histograms;
+};
+
+/**
+ * Registry of named counters and histograms that subsystems can record into, with optional periodic export.
+ *
+ * Registering a metric takes a lock but the returned reference is stable for the lifetime of the Telemetry object, so
+ * hot paths should look up their metrics once and then only perform lock free updates e.g.
+ *
+ *   static auto &draws = Telemetry::instance().counter("renderer.draws");
+ *   draws.add();
+ *
+ * The Looper records frame and step timings into the "looper.*" metrics.
+ */
+class Telemetry
+{
+  public:
+    /** Callback for exported snapshots. */
+    using Exporter = std::function<void(const TelemetrySnapshot &)>;
+
+    /**
+     * Get the engine wide Telemetry instance.
+     *
+     * @returns
+     *   Telemetry single instance.
+     */
+    static Telemetry &instance();
+
+    /**
+     * Construct a new empty Telemetry. In general the engine wide instance() should be used.
+     */
+    Telemetry();
+
+    Telemetry(const Telemetry &) = delete;
+    Telemetry &operator=(const Telemetry &) = delete;
+
+    /**
+     * Get (or create) a named counter.
+     *
+     * @param name
+     *   Name of counter.
+     *
+     * @returns
+     *   Reference to counter, valid for the lifetime of this object.
+     */
+    TelemetryCounter &counter(std::string_view name);
+
+    /**
+     * Get (or create) a named histogram.
+     *
+     * @param name
+     *   Name of histogram.
+     *
+     * @returns
+     *   Reference to histogram, valid for the lifetime of this object.
+     */
+    Histogram &histogram(std::string_view name);
+
+    /**
+     * Take a snapshot of all current values.
+     *
+     * @returns
+     *   Snapshot of all counters and histograms.
+     */
+    TelemetrySnapshot snapshot() const;
+
+    /**
+     * Set a callback to periodically export snapshots to. Histograms are reset after each export, so each exported
+     * snapshot covers the preceding interval. Counters are never reset.
+     *
+     * @param exporter
+     *   Callback to export to.
+     *
+     * @param interval
+     *   How often to export.
+     */
+    void set_exporter(Exporter exporter, std::chrono::milliseconds interval);
+
+    /**
+     * Stop periodic exporting.
+     */
+    void clear_exporter();
+
+    /**
+     * Export a snapshot if the export interval has elapsed. This is called once per frame by the Looper, but can be
+     * called manually if not using a Looper.
+     */
+    void tick();
+
+    /**
+     * Create an exporter which appends each snapshot as a single line of JSON to a file.
+     *
+     * @param path
+     *   Path of file to append to.
+     *
+     * @returns
+     *   Exporter writing to file.
+     */
+    static Exporter file_exporter(const std::filesystem::path &path);
+
+    /**
+     * Write a snapshot as a single line JSON object.
+     *
+     * @param snapshot
+     *   Snapshot to write.
+     *
+     * @param out
+     *   Stream to write to.
+     */
+    static void write_json(const TelemetrySnapshot &snapshot, std::ostream &out);
+
+  private:
+    /** Registered counters. */
+    std::map<std::string, std::unique_ptr<TelemetryCounter>, std::less<>> counters_;
+
+    /** Registered histograms. */
+    std::map<std::string, std::unique_ptr<Histogram>, std::less<>> histograms_;
+
+    /** Export callback. */
+    Exporter exporter_;
+
+    /** Export interval. */
+    std::chrono::milliseconds export_interval_;
+
+    /** Time (in steady clock nanoseconds) of next export, 0 if exporting is disabled. */
+    std::atomic<std::int64_t> next_export_;
+
+    /** Lock for registration and exporting. */
+    mutable std::mutex mutex_;
+};
+
+}
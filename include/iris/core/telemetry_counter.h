@@ -0,0 +1,67 @@
+////////////////////////////////////////////////////////////////////////////////
+//         Distributed under the Boost Software License, Version 1.0.         //
+//            (See accompanying file LICENSE or copy at                       //
+//                 https://www.boost.org/LICENSE_1_0.txt)                     //
+////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+
+namespace iris
+{
+
+/**
+ * Lock free monotonic counter which can be incremented from any thread.
+ */
+class TelemetryCounter
+{
+  public:
+    /**
+     * Construct a new TelemetryCounter with a value of 0.
+     */
+    TelemetryCounter()
+        : value_(0u)
+    {
+    }
+
+    /**
+     * Increment the counter.
+     *
+     * @param amount
+     *   Amount to increment by.
+     */
+    void add(std::uint64_t amount = 1u)
+    {
+        value_.fetch_add(amount, std::memory_order_relaxed);
+    }
+
+    /**
+     * Get the current value.
+     *
+     * @returns
+     *   Counter value.
+     */
+    std::uint64_t value() const
+    {
+        return value_.load(std::memory_order_relaxed);
+    }
+
+    /**
+     * Reset the counter to 0.
+     *
+     * @returns
+     *   Value before reset.
+     */
+    std::uint64_t reset()
+    {
+        return value_.exchange(0u, std::memory_order_relaxed);
+    }
+
+  private:
+    /** Counter value. */
+    std::atomic<std::uint64_t> value_;
+};
+
+}
@@ -0,0 +1,226 @@
+////////////////////////////////////////////////////////////////////////////////
+//         Distributed under the Boost Software License, Version 1.0.         //
+//            (See accompanying file LICENSE or copy at                       //
+//                 https://www.boost.org/LICENSE_1_0.txt)                     //
+////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <iosfwd>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace iris
+{
+
+/**
+ * Singleton class which records timed, named zones into per-thread buffers and writes them out as a Chrome trace
+ * (which can also be loaded into Perfetto).
+ *
+ * Zones are usually recorded via the IRIS_PROFILE_SCOPE macro (see profile_scope.h) rather than directly. Recording
+ * is lock free, each thread only ever writes to its own buffer. If a buffer fills up then further zones from that
+ * thread are dropped.
+ *
+ * When a thread exits its buffer (and any zones in it) is handed to the next new thread, so memory is bounded by the
+ * number of concurrently recording threads. This means a thread id in a trace identifies a buffer, which may have been
+ * written to by several short lived threads one after another.
+ */
+class TraceRecorder
+{
+  public:
+    /**
+     * A single recorded zone.
+     */
+    struct Zone
+    {
+        /** Name of zone, must have static storage duration. */
+        const char *name;
+
+        /** Start time in nanoseconds. */
+        std::uint64_t begin;
+
+        /** End time in nanoseconds. */
+        std::uint64_t end;
+    };
+
+    /**
+     * Get single instance of TraceRecorder.
+     *
+     * @returns
+     *   TraceRecorder single instance.
+     */
+    static TraceRecorder &instance();
+
+    ~TraceRecorder();
+
+    TraceRecorder(const TraceRecorder &) = delete;
+    TraceRecorder &operator=(const TraceRecorder &) = delete;
+    TraceRecorder(TraceRecorder &&) = delete;
+    TraceRecorder &operator=(TraceRecorder &&) = delete;
+
+    /**
+     * Get the current time in the clock used for recording zones.
+     *
+     * @returns
+     *   Current time in nanoseconds.
+     */
+    static std::uint64_t now();
+
+    /**
+     * Start recording, discarding any previously recorded zones.
+     */
+    void start();
+
+    /**
+     * Stop recording. Recorded zones are kept until the next call to start().
+     */
+    void stop();
+
+    /**
+     * Check if zones are currently being recorded.
+     *
+     * @returns
+     *   True if recording, otherwise false.
+     */
+    bool is_recording() const
+    {
+        return recording_.load(std::memory_order_relaxed);
+    }
+
+    /**
+     * Set the number of zones each thread can record, takes effect for buffers created (or reused by a new thread)
+     * after this call.
+     *
+     * @param capacity
+     *   Number of zones per thread.
+     */
+    void set_thread_capacity(std::size_t capacity);
+
+    /**
+     * Record a completed zone for the calling thread. Does nothing if not recording.
+     *
+     * @param name
+     *   Name of zone, must have static storage duration.
+     *
+     * @param begin
+     *   Start time of zone (from now()).
+     *
+     * @param end
+     *   End time of zone (from now()).
+     */
+    void record(const char *name, std::uint64_t begin, std::uint64_t end);
+
+    /**
+     * Get the number of zones dropped in the current recording because a thread's buffer was full.
+     *
+     * @returns
+     *   Number of dropped zones.
+     */
+    std::uint64_t dropped_count() const;
+
+    /**
+     * Get all zones recorded by all threads in the current recording.
+     *
+     * @returns
+     *   Collection of (thread id, zones) pairs.
+     */
+    std::vector<std::pair<std::uint32_t, std::vector<Zone>>> zones() const;
+
+    /**
+     * Write all recorded zones as Chrome trace event JSON.
+     *
+     * @param out
+     *   Stream to write to.
+     */
+    void write_chrome_trace(std::ostream &out) const;
+
+    /**
+     * Write all recorded zones as Chrome trace event JSON to a file.
+     *
+     * @param path
+     *   Path of file to write.
+     */
+    void write_chrome_trace(const std::filesystem::path &path) const;
+
+  private:
+    /**
+     * Per-thread storage for zones.
+     */
+    struct ThreadBuffer
+    {
+        /** Sequential id of thread, used in trace output. */
+        std::uint32_t thread_id;
+
+        /** Recording epoch the zones belong to, a buffer from an old epoch is reset by its thread on next record. */
+        std::atomic<std::uint32_t> epoch;
+
+        /** Number of valid zones, published with release semantics after a zone is written. */
+        std::atomic<std::size_t> size;
+
+        /** Number of zones dropped because the buffer was full. */
+        std::atomic<std::uint64_t> dropped;
+
+        /** Zone storage, only resized when not owned by a thread. */
+        std::vector<Zone> zones;
+    };
+
+    /**
+     * Thread local owner of a ThreadBuffer, which returns it to the recorder when the thread exits.
+     */
+    struct ThreadBufferOwner
+    {
+        ~ThreadBufferOwner();
+
+        /** Recorder buffer belongs to. */
+        TraceRecorder *recorder = nullptr;
+
+        /** Owned buffer. */
+        ThreadBuffer *buffer = nullptr;
+    };
+
+    /**
+     * Construct a new TraceRecorder.
+     */
+    TraceRecorder();
+
+    /**
+     * Get (or create) the buffer for the calling thread.
+     *
+     * @returns
+     *   Buffer for calling thread.
+     */
+    ThreadBuffer *thread_buffer();
+
+    /**
+     * Make a buffer available for reuse by another thread.
+     *
+     * @param buffer
+     *   Buffer to release.
+     */
+    void release_thread_buffer(ThreadBuffer *buffer);
+
+    /** Flag indicating if we are recording. */
+    std::atomic<bool> recording_;
+
+    /** Current recording epoch. */
+    std::atomic<std::uint32_t> epoch_;
+
+    /** Number of zones to allocate for each new thread buffer. */
+    std::size_t thread_capacity_;
+
+    /** All thread buffers, buffers are never removed so outlive their threads. */
+    std::vector<std::unique_ptr<ThreadBuffer>> buffers_;
+
+    /** Buffers whose thread has exited, most recently released last. */
+    std::vector<ThreadBuffer *> free_buffers_;
+
+    /** Lock for buffers_ and free_buffers_, only taken when a thread first records, exits or when reading. */
+    mutable std::mutex mutex_;
+};
+
+}
@@ -6,6 +6,7 @@
 
 #pragma once
 
+#include <chrono>
 #include <cstdint>
 #include <variant>
 
@@ -223,12 +224,44 @@ class Event
      */
     ScrollWheelEvent scroll_wheel() const;
 
+    /**
+     * Get the time the event was received by the engine, this uses a monotonic clock so can be compared with other
+     * steady_clock times (e.g. to measure input latency).
+     *
+     * @returns
+     *   Time event was received.
+     */
+    std::chrono::steady_clock::time_point timestamp() const;
+
+    /**
+     * Get the id of the frame (see LatencyTracker) the event was received in. This is only set for events pumped from
+     * a Window, events created by the engine or user are 0.
+     *
+     * @returns
+     *   Frame id.
+     */
+    std::uint64_t frame() const;
+
+    /**
+     * Set the id of the frame (see LatencyTracker) the event was received in.
+     *
+     * @param frame
+     *   Frame id.
+     */
+    void set_frame(std::uint64_t frame);
+
   private:
     /** Type of event. */
     EventType type_;
 
     /** Variant of possible Event types. */
     std::variant<QuitEvent, KeyboardEvent, MouseEvent, MouseButtonEvent, TouchEvent, ScrollWheelEvent> event_;
+
+    /** Time event was received. */
+    std::chrono::steady_clock::time_point timestamp_;
+
+    /** Frame event was received in. */
+    std::uint64_t frame_;
 };
 
 }
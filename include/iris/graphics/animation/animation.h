@@ -12,10 +12,12 @@
 #include <string>
 #include <string_view>
 #include <tuple>
+#include <unordered_map>
 #include <vector>
 
 #include "core/matrix4.h"
 #include "core/quaternion.h"
+#include "core/string_id.h"
 #include "core/transform.h"
 #include "core/vector3.h"
 #include "graphics/keyframe.h"
@@ -80,6 +82,19 @@ class Animation
      */
     Transform transform(std::string_view bone) const;
 
+    /**
+     * Get the Transformation for a bone at the current animation time. If the
+     * time falls between two keyframes then this method will interpolate
+     * between them.
+     *
+     * @param bone
+     *   Bone name id.
+     *
+     * @returns
+     *   Transformation of supplied bone at current animation time.
+     */
+    Transform transform(StringId bone) const;
+
     /**
      * Check if a bone exists in the animation.
      *
@@ -91,6 +106,17 @@ class Animation
      */
     bool bone_exists(std::string_view bone) const;
 
+    /**
+     * Check if a bone exists in the animation.
+     *
+     * @param bone
+     *   Bone name id.
+     *
+     * @returns
+     *   True if bone exists, false otherwise.
+     */
+    bool bone_exists(StringId bone) const;
+
     /**
      * Advances the animation by the amount of time since the last call.
      */
@@ -154,8 +180,8 @@ class Animation
     /** Name of animation. */
     std::string name_;
 
-    /** Collection of bones and their keyframes. */
-    std::map<std::string, std::vector<KeyFrame>, std::less<>> frames_;
+    /** Collection of bone name ids and their keyframes. */
+    std::unordered_map<StringId, std::vector<KeyFrame>> frames_;
 
     /** Type of playback. */
     PlaybackType playback_type_;
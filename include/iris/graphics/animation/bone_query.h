@@ -9,6 +9,7 @@
 #include <optional>
 #include <string_view>
 
+#include "core/string_id.h"
 #include "core/transform.h"
 
 namespace iris
@@ -31,7 +32,21 @@ class BoneQuery
      * @returns
      *   Bone transform, if bone exists.
      */
-    virtual std::optional<Transform> transform(std::string_view bone_name) = 0;
+    std::optional<Transform> transform(std::string_view bone_name)
+    {
+        return transform(StringId{bone_name});
+    }
+
+    /**
+     * Get the transformation for a bone.
+     *
+     * @param bone_id
+     *   Id of the name of the bone to query.
+     *
+     * @returns
+     *   Bone transform, if bone exists.
+     */
+    virtual std::optional<Transform> transform(StringId bone_id) = 0;
 };
 
 }
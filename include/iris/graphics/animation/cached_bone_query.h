@@ -8,13 +8,14 @@
 
 #include <chrono>
 #include <functional>
-#include <map>
 #include <optional>
 #include <set>
 #include <string>
 #include <string_view>
+#include <unordered_map>
 #include <vector>
 
+#include "core/string_id.h"
 #include "core/transform.h"
 #include "graphics/animation/bone_query.h"
 
@@ -41,16 +42,18 @@ class CachedBoneQuery : public BoneQuery
      */
     CachedBoneQuery(const Skeleton *skeleton, const std::vector<std::set<std::string>> &bone_masks);
 
+    using BoneQuery::transform;
+
     /**
      * Get the transformation for a bone.
      *
-     * @param bone_name
-     *   Name of the bone to query.
+     * @param bone_id
+     *   Id of the name of the bone to query.
      *
      * @returns
      *   Bone transform, if bone exists.
      */
-    std::optional<Transform> transform(std::string_view bone_name) override;
+    std::optional<Transform> transform(StringId bone_id) override;
 
     /**
      * Update the bone transformations for the supplied layer.
@@ -88,8 +91,8 @@ class CachedBoneQuery : public BoneQuery
         std::chrono::system_clock::time_point ease_end;
     };
 
-    /** Collection mapping bone name to bone data. */
-    std::map<std::string, CachedBone, std::less<>> transforms_;
+    /** Collection mapping bone name id to bone data. */
+    std::unordered_map<StringId, CachedBone> transforms_;
 };
 
 }
\ No newline at end of file
@@ -11,6 +11,7 @@
 #include <vector>
 
 #include "core/matrix4.h"
+#include "core/string_id.h"
 #include "core/transform.h"
 #include "graphics/weight.h"
 
@@ -62,6 +63,14 @@ class Bone
      */
     std::string name() const;
 
+    /**
+     * Get id of bone name.
+     *
+     * @returns
+     *   Bone name id.
+     */
+    StringId id() const;
+
     /** Get name of parent pone.
      *
      * @returns
@@ -113,6 +122,9 @@ class Bone
     /** Bone name. */
     std::string name_;
 
+    /** Bone name id. */
+    StringId id_;
+
     /** Parent bone name. */
     std::string parent_;
 
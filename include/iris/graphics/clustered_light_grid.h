@@ -0,0 +1,182 @@
+////////////////////////////////////////////////////////////////////////////////
+//         Distributed under the Boost Software License, Version 1.0.         //
+//            (See accompanying file LICENSE or copy at                       //
+//                 https://www.boost.org/LICENSE_1_0.txt)                     //
+////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <span>
+#include <vector>
+
+#include "core/bounding_sphere.h"
+#include "core/camera.h"
+#include "core/camera_type.h"
+#include "core/matrix4.h"
+#include "graphics/lights/light.h"
+#include "graphics/lights/point_light.h"
+
+namespace iris
+{
+
+/**
+ * Class for assigning point lights to clusters of a camera's view frustum. The frustum is split into screen space
+ * tiles and depth slices (froxels), and each light is added to every cluster its range overlaps. This allows the
+ * lights which can reach an object to be found without testing every light.
+ *
+ * Depth slices are exponentially distributed for perspective cameras (so near clusters are thinner) and linear for
+ * orthographic cameras.
+ */
+class ClusteredLightGrid
+{
+  public:
+    /** Number of tiles across the screen. */
+    static constexpr std::uint32_t tiles_x = 16u;
+
+    /** Number of tiles down the screen. */
+    static constexpr std::uint32_t tiles_y = 9u;
+
+    /** Number of depth slices. */
+    static constexpr std::uint32_t slices = 24u;
+
+    /**
+     * Create a new, empty, ClusteredLightGrid.
+     */
+    ClusteredLightGrid();
+
+    /**
+     * Assign lights to clusters, replacing any previous assignment.
+     *
+     * @param camera
+     *   Camera to build clusters for.
+     *
+     * @param point_lights
+     *   Lights to assign, their range is used as their bounds.
+     */
+    void build(const Camera &camera, std::span<const std::unique_ptr<PointLight>> point_lights);
+
+    /**
+     * Get all lights whose range intersects a sphere.
+     *
+     * @param sphere
+     *   World space sphere to test.
+     *
+     * @param lights
+     *   Collection to write lights to, sorted by address. Any existing contents are replaced.
+     */
+    void lights(const BoundingSphere &sphere, std::vector<const Light *> &lights) const;
+
+    /**
+     * Get the number of lights assigned to a cluster.
+     *
+     * @param x
+     *   Tile x index.
+     *
+     * @param y
+     *   Tile y index.
+     *
+     * @param z
+     *   Depth slice index.
+     *
+     * @returns
+     *   Number of lights in cluster.
+     */
+    std::size_t light_count(std::uint32_t x, std::uint32_t y, std::uint32_t z) const;
+
+  private:
+    /**
+     * Inclusive range of clusters.
+     */
+    struct ClusterRange
+    {
+        /** Whether the range contains no clusters. */
+        bool empty;
+
+        /** First tile along x. */
+        std::uint32_t min_x;
+
+        /** Last tile along x. */
+        std::uint32_t max_x;
+
+        /** First tile along y. */
+        std::uint32_t min_y;
+
+        /** Last tile along y. */
+        std::uint32_t max_y;
+
+        /** First depth slice. */
+        std::uint32_t min_z;
+
+        /** Last depth slice. */
+        std::uint32_t max_z;
+    };
+
+    /**
+     * Get the clusters overlapped by a sphere. This is conservative, it may include clusters the sphere does not
+     * touch.
+     *
+     * @param sphere
+     *   World space sphere.
+     *
+     * @returns
+     *   Clusters overlapped by sphere.
+     */
+    ClusterRange cluster_range(const BoundingSphere &sphere) const;
+
+    /**
+     * Get the depth slice for a view space distance.
+     *
+     * @param depth
+     *   Distance along view direction, must be within the near and far planes.
+     *
+     * @returns
+     *   Slice index.
+     */
+    std::uint32_t slice(float depth) const;
+
+    /**
+     * Get the index of a cluster in the flat storage arrays.
+     *
+     * @returns
+     *   Cluster index.
+     */
+    std::size_t cluster_index(std::uint32_t x, std::uint32_t y, std::uint32_t z) const;
+
+    /** View matrix of camera. */
+    Matrix4 view_;
+
+    /** Projection matrix of camera. */
+    Matrix4 projection_;
+
+    /** Type of camera. */
+    CameraType camera_type_;
+
+    /** Camera near plane distance. */
+    float near_plane_;
+
+    /** Camera far plane distance. */
+    float far_plane_;
+
+    /** Lights in grid. */
+    std::vector<const PointLight *> lights_;
+
+    /** World space bounds of each light, indices match lights_. */
+    std::vector<BoundingSphere> light_bounds_;
+
+    /** Clusters overlapped by each light, indices match lights_. */
+    std::vector<ClusterRange> light_ranges_;
+
+    /** Offset of each cluster into light_indices_, with a final entry for the end of the last cluster. */
+    std::vector<std::uint32_t> cluster_offsets_;
+
+    /** Indices into lights_ for all clusters, packed together. */
+    std::vector<std::uint32_t> light_indices_;
+
+    /** Scratch buffer of candidate light indices, reused across calls to lights(). */
+    mutable std::vector<std::uint32_t> candidates_;
+};
+
+}
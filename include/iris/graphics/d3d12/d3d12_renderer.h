@@ -7,6 +7,7 @@
 #pragma once
 
 #include <chrono>
+#include <cstddef>
 #include <cstdint>
 #include <deque>
 #include <limits>
@@ -26,6 +27,7 @@
 #include "directx/d3dx12.h"
 
 #include "core/auto_release.h"
+#include "core/dirty_range_tracker.h"
 #include "graphics/d3d12/d3d12_constant_buffer.h"
 #include "graphics/d3d12/d3d12_constant_buffer_pool.h"
 #include "graphics/d3d12/d3d12_cube_map.h"
@@ -33,6 +35,7 @@
 #include "graphics/d3d12/d3d12_root_signature.h"
 #include "graphics/d3d12/d3d12_structured_buffer.h"
 #include "graphics/d3d12/d3d12_texture.h"
+#include "graphics/instanced_entity.h"
 #include "graphics/material_cache.h"
 #include "graphics/material_manager.h"
 #include "graphics/render_pipeline.h"
@@ -113,6 +116,34 @@ class D3D12Renderer : public Renderer
     void execute_present(RenderCommand &command) override;
 
   private:
+    /**
+     * Bring the current frame's copy of the instance data of an instanced entity up to date, creating a buffer for it
+     * if needed.
+     *
+     * @param instanced_entity
+     *   Entity to upload.
+     */
+    void upload_instance_data(InstancedEntity &instanced_entity);
+
+    /**
+     * Buffer for the instance data of an instanced entity in a scene. Each frame has its own copy, as the GPU may still
+     * be reading the others.
+     */
+    struct InstanceData
+    {
+        /** Instance data buffer. */
+        std::unique_ptr<D3D12StructuredBuffer> buffer;
+
+        /** Number of instances buffer can hold. */
+        std::size_t capacity;
+
+        /** Instances which have changed since buffer was last written. */
+        DirtyRangeTracker dirty_instances;
+
+        /** Last frame the entity was seen in a scene. */
+        std::uint64_t frame;
+    };
+
     /**
      * Internal struct encapsulating data needed for a frame.
      */
@@ -135,6 +166,7 @@ class D3D12Renderer : public Renderer
             , light_data_buffers()
             , camera_data_buffers()
             , property_buffers()
+            , instance_data()
         {
         }
 
@@ -170,6 +202,9 @@ class D3D12Renderer : public Renderer
 
         /** Cache of data buffers for material properties. */
         std::unordered_map<const Material *, std::unique_ptr<D3D12ConstantBuffer>> property_buffers;
+
+        /** Instance data buffers for instanced entities in a scene. */
+        std::unordered_map<const RenderEntity *, InstanceData> instance_data;
     };
 
     /** Window manager object. */
@@ -215,8 +250,11 @@ class D3D12Renderer : public Renderer
     /** Collection of CubeMaps that have been uploaded. */
     std::set<const D3D12CubeMap *> uploaded_cube_maps_;
 
-    /** Cache of instance model data buffers for instanced entities in the current scene. */
-    std::unordered_map<const RenderEntity *, std::unique_ptr<D3D12StructuredBuffer>> instance_data_buffers_;
+    /** Number of frames started, used to find instance data of entities no longer in a scene. */
+    std::uint64_t frame_number_;
+
+    /** Scratch collection of changed instance ranges. */
+    std::vector<DirtyRange> dirty_ranges_;
 
     /** Descriptor handle to a global texture table (for bindless). */
     D3D12DescriptorHandle texture_table_;
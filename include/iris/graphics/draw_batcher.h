@@ -0,0 +1,77 @@
+////////////////////////////////////////////////////////////////////////////////
+//         Distributed under the Boost Software License, Version 1.0.         //
+//            (See accompanying file LICENSE or copy at                       //
+//                 https://www.boost.org/LICENSE_1_0.txt)                     //
+////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+#include "core/telemetry_counter.h"
+#include "graphics/instanced_entity.h"
+#include "graphics/mesh.h"
+#include "graphics/primitive_type.h"
+#include "graphics/render_command.h"
+
+namespace iris
+{
+
+/**
+ * Class for merging draw commands of identical SingleEntity objects into a single instanced draw. Draws can be batched
+ * if they are in the same pass and share a material, mesh, light, shadow map and entity draw state (wireframe,
+ * primitive type and receive shadow). Transparent entities, skinned entities and entities which have opted out with
+ * RenderEntity::set_batchable() are never batched.
+ *
+ * This should be run after sorting, as it only looks for batches in runs of adjacent draws with the same material and
+ * mesh. Each batch is drawn with an InstancedEntity owned by this class, whose instances are rebuilt every call.
+ *
+ * The counter "renderer.batch.draws_saved" records the number of draws removed by batching.
+ */
+class DrawBatcher
+{
+  public:
+    /**
+     * Create a new DrawBatcher.
+     */
+    DrawBatcher();
+
+    /**
+     * Merge identical draws into instanced draws.
+     *
+     * @param render_queue
+     *   Queue to batch, this is modified in place.
+     */
+    void batch(std::vector<RenderCommand> &render_queue);
+
+  private:
+    /**
+     * Get an unused batch entity for the current call.
+     *
+     * @param mesh
+     *   Mesh batch will draw.
+     *
+     * @param primitive_type
+     *   Primitive type of mesh.
+     *
+     * @returns
+     *   Batch entity with no instances.
+     */
+    InstancedEntity *acquire_batch(const Mesh *mesh, PrimitiveType primitive_type);
+
+    /** Batch entities, reused between calls. */
+    std::vector<std::unique_ptr<InstancedEntity>> batches_;
+
+    /** Number of batch entities used in the current call. */
+    std::size_t batches_used_;
+
+    /** Scratch copy of the draws being batched. */
+    std::vector<RenderCommand> run_;
+
+    /** Counter for saved draws. */
+    TelemetryCounter &draws_saved_counter_;
+};
+
+}
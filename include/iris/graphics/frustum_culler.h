@@ -0,0 +1,89 @@
+////////////////////////////////////////////////////////////////////////////////
+//         Distributed under the Boost Software License, Version 1.0.         //
+//            (See accompanying file LICENSE or copy at                       //
+//                 https://www.boost.org/LICENSE_1_0.txt)                     //
+////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <cstdint>
+#include <span>
+#include <vector>
+
+#include "core/camera.h"
+#include "core/telemetry_counter.h"
+#include "graphics/render_command.h"
+
+namespace iris
+{
+
+/**
+ * Class for removing draw commands whose entities are outside the view frustum of their pass camera. This applies to
+ * all passes, including shadow passes (whose camera is the shadow camera of the light).
+ *
+ * Entity bounding spheres are copied into flat arrays and tested against each frustum plane in turn, so the inner
+ * loops are simple enough for the compiler to vectorise.
+ *
+ * The counters "renderer.cull.tested" and "renderer.cull.visible" record the number of draws (one per entity per
+ * light) tested and kept.
+ */
+class FrustumCuller
+{
+  public:
+    /**
+     * Create a new FrustumCuller.
+     */
+    FrustumCuller();
+
+    /**
+     * Copy a render queue, skipping any draws which can't be seen.
+     *
+     * @param render_queue
+     *   Queue to cull.
+     *
+     * @param visible_queue
+     *   Queue to write visible commands to, any existing contents are replaced.
+     */
+    void cull(std::span<const RenderCommand> render_queue, std::vector<RenderCommand> &visible_queue);
+
+  private:
+    /**
+     * Cull the draw commands of a single pass.
+     *
+     * @param camera
+     *   Camera of the pass, if nullptr no culling is performed.
+     *
+     * @param draws
+     *   Draw commands of the pass.
+     *
+     * @param visible_queue
+     *   Queue to append visible commands to.
+     */
+    void cull_pass(
+        const Camera *camera,
+        std::span<const RenderCommand> draws,
+        std::vector<RenderCommand> &visible_queue);
+
+    /** Bounding sphere centre x components. */
+    std::vector<float> x_;
+
+    /** Bounding sphere centre y components. */
+    std::vector<float> y_;
+
+    /** Bounding sphere centre z components. */
+    std::vector<float> z_;
+
+    /** Bounding sphere radii. */
+    std::vector<float> radius_;
+
+    /** Visibility of each draw. */
+    std::vector<std::uint8_t> visible_;
+
+    /** Counter for tested draws. */
+    TelemetryCounter &tested_counter_;
+
+    /** Counter for visible draws. */
+    TelemetryCounter &visible_counter_;
+};
+
+}
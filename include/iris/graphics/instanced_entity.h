@@ -9,9 +9,11 @@
 #include <cstddef>
 #include <vector>
 
+#include "core/dirty_range_tracker.h"
 #include "core/matrix4.h"
 #include "core/transform.h"
 #include "graphics/mesh.h"
+#include "graphics/primitive_type.h"
 #include "graphics/render_entity.h"
 #include "graphics/render_entity_type.h"
 
@@ -22,7 +24,12 @@ namespace iris
  * Implementation of RenderEntity for an instanced mesh i.e. rendering multiple copies of a single mesh with a single
  * draw call.
  *
- * Note that instances are static and cannot be modified after creation.
+ * Instances can be added, removed and moved after creation. Changed instances are tracked so that renderers only need
+ * to upload the data for those instances, rather than every instance. Adding instances grows the bounds of the entity,
+ * moving or removing them means the bounds are recalculated from every instance the next time they are read.
+ *
+ * The renderer also uses this class for batching identical entities, in which case the instances are rebuilt every
+ * frame.
  */
 class InstancedEntity : public RenderEntity
 {
@@ -34,9 +41,22 @@ class InstancedEntity : public RenderEntity
      *   Mesh to render.
      *
      * @param instances
-     *   Collection of transforms describing each instance, must be greater that one.
+     *   Collection of transforms describing each instance.
      */
     InstancedEntity(const Mesh *mesh, const std::vector<Transform> &instances);
+
+    /**
+     * Construct a new InstancedEntity object with no instances, these should be added with add_instance() before it is
+     * drawn.
+     *
+     * @param mesh
+     *   Mesh to render.
+     *
+     * @param primitive_type
+     *   Primitive type of underlying mesh.
+     */
+    InstancedEntity(const Mesh *mesh, PrimitiveType primitive_type);
+
     ~InstancedEntity() override = default;
 
     /**
@@ -72,12 +92,88 @@ class InstancedEntity : public RenderEntity
      */
     const std::vector<Matrix4> &data() const;
 
+    /**
+     * Add an instance.
+     *
+     * @param transform
+     *   Transform of instance.
+     *
+     * @returns
+     *   Index of new instance.
+     */
+    std::size_t add_instance(const Transform &transform);
+
+    /**
+     * Set the transform of an instance.
+     *
+     * @param index
+     *   Index of instance.
+     *
+     * @param transform
+     *   New transform.
+     */
+    void set_transform(std::size_t index, const Transform &transform);
+
+    /**
+     * Remove an instance. To avoid moving every subsequent instance the last instance is moved into the removed index.
+     *
+     * @param index
+     *   Index of instance to remove.
+     */
+    void remove_instance(std::size_t index);
+
+    /**
+     * Remove all instances.
+     */
+    void clear_instances();
+
+    /**
+     * Add an instance where the transforms have already been calculated.
+     *
+     * @param transform
+     *   Transform of instance.
+     *
+     * @param normal_transform
+     *   Normal transform of instance.
+     */
+    void add_instance(const Matrix4 &transform, const Matrix4 &normal_transform);
+
+    /**
+     * Get the instances which have changed since clear_dirty_instances() was last called (or since construction).
+     *
+     * @returns
+     *   Changed instances.
+     */
+    const DirtyRangeTracker &dirty_instances() const;
+
+    /**
+     * Mark all instances as unchanged, this should be called once the changed instances have been uploaded.
+     */
+    void clear_dirty_instances();
+
+  protected:
+    /**
+     * Recalculate the bounds from every instance.
+     */
+    void update_bounds() const override;
+
   private:
+    /**
+     * Grow the bounds to contain an instance.
+     *
+     * @param transform
+     *   Transform of instance.
+     */
+    void merge_bounds(const Matrix4 &transform) const;
+
     /** Number of instances to render. */
     std::size_t instance_count_;
 
     /** Render data for instances. */
     std::vector<Matrix4> data_;
+
+    /** Instances which have changed. */
+    DirtyRangeTracker dirty_instances_;
 };
 
 }
\ No newline at end of file
@@ -0,0 +1,57 @@
+////////////////////////////////////////////////////////////////////////////////
+//         Distributed under the Boost Software License, Version 1.0.         //
+//            (See accompanying file LICENSE or copy at                       //
+//                 https://www.boost.org/LICENSE_1_0.txt)                     //
+////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <vector>
+
+#include "core/telemetry_counter.h"
+#include "graphics/clustered_light_grid.h"
+#include "graphics/lights/light.h"
+#include "graphics/render_command.h"
+
+namespace iris
+{
+
+/**
+ * Class for removing point light draw commands where the light can't reach the entity being drawn. For each pass with
+ * a camera and point lights a ClusteredLightGrid is built, which is then used to find the lights that affect each
+ * entity.
+ *
+ * The counters "renderer.light_cull.tested" and "renderer.light_cull.visible" record the number of point light draws
+ * tested and kept.
+ */
+class LightCuller
+{
+  public:
+    /**
+     * Create a new LightCuller.
+     */
+    LightCuller();
+
+    /**
+     * Remove point light draws which have no effect.
+     *
+     * @param render_queue
+     *   Queue to cull, this is modified in place.
+     */
+    void cull(std::vector<RenderCommand> &render_queue);
+
+  private:
+    /** Light grid for current pass. */
+    ClusteredLightGrid grid_;
+
+    /** Lights which affect the current entity, sorted by address. */
+    std::vector<const Light *> entity_lights_;
+
+    /** Counter for tested draws. */
+    TelemetryCounter &tested_counter_;
+
+    /** Counter for visible draws. */
+    TelemetryCounter &visible_counter_;
+};
+
+}
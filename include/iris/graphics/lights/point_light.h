@@ -161,6 +161,15 @@ class PointLight : public Light
      */
     void set_attenuation_quadratic_term(float quadratic);
 
+    /**
+     * Get the distance at which the contribution of the light drops below what can be represented in an 8-bit colour
+     * channel. Beyond this the light can be ignored.
+     *
+     * @returns
+     *   Range of light, this may be infinite if the light does not attenuate.
+     */
+    float range() const;
+
   private:
     /**
      * Struct storing all attenuation terms. This makes it convenient to memcpy
@@ -6,9 +6,11 @@
 
 #pragma once
 
+#include <cstddef>
 #include <cstdint>
 #include <optional>
 #include <queue>
+#include <vector>
 
 #include <GL/glx.h>
 #include <X11/Xlib.h>
@@ -74,6 +76,18 @@ class LinuxWindow : public Window
      */
     std::optional<Event> pump_event() override;
 
+    /**
+     * Pump all pending user input events, with a single check of the X
+     * server.
+     *
+     * @param events
+     *   Collection to append events to.
+     *
+     * @returns
+     *   Number of events appended.
+     */
+    std::size_t pump_events(std::vector<Event> &events) override;
+
     /**
      * Get display handle.
      *
@@ -91,6 +105,11 @@ class LinuxWindow : public Window
     ::Window window() const;
 
   private:
+    /**
+     * Read all events from the X server and convert them to engine events.
+     */
+    void read_events();
+
     /** X11 display handle. */
     AutoRelease<Display *, nullptr> display_;
 
@@ -100,6 +119,9 @@ class LinuxWindow : public Window
     /** OpenGL context object. */
     AutoRelease<GLXContext, nullptr> context_;
 
+    /** Atom for window close messages. */
+    Atom wm_delete_window_;
+
     /** Queue of input events. */
     std::queue<Event> events_;
 };
@@ -12,6 +12,7 @@
 #include <vector>
 
 #include "graphics/lights/light_type.h"
+#include "graphics/shading_mode.h"
 
 namespace iris
 {
@@ -49,6 +50,9 @@ class MaterialManager
      * @param light_type
      *   The type of light that material should use.
      *
+     * @param shading_mode
+     *   How lights are applied, for ShadingMode::SINGLE_PASS the material handles all light types.
+     *
      * @param render_to_colour_target
      *   Whether the material is rendering to a colour target or the back buffer.
      *
@@ -68,6 +72,7 @@ class MaterialManager
         RenderGraph *render_graph,
         RenderEntity *render_entity,
         LightType light_type,
+        ShadingMode shading_mode,
         bool render_to_colour_target,
         bool render_to_normal_target,
         bool render_to_position_target,
@@ -10,6 +10,8 @@
 #include <functional>
 #include <vector>
 
+#include "core/aabb.h"
+#include "core/bounding_sphere.h"
 #include "graphics/vertex_data.h"
 
 namespace iris
@@ -66,12 +68,34 @@ class Mesh
      */
     const std::vector<std::uint32_t> &indices() const;
 
+    /**
+     * Get the local space axis aligned bounding box, calculated from the vertices the mesh was created with.
+     *
+     * @returns
+     *   Mesh AABB.
+     */
+    const AABB &aabb() const;
+
+    /**
+     * Get the local space bounding sphere, calculated from the vertices the mesh was created with.
+     *
+     * @returns
+     *   Mesh bounding sphere.
+     */
+    const BoundingSphere &bounding_sphere() const;
+
   protected:
     /** Vertex data. */
     std::vector<VertexData> vertices_;
 
     /** Index data. */
     std::vector<std::uint32_t> indices_;
+
+    /** Local space AABB. */
+    AABB aabb_;
+
+    /** Local space bounding sphere. */
+    BoundingSphere bounding_sphere_;
 };
 
 }
@@ -6,6 +6,7 @@
 
 #pragma once
 
+#include <cstddef>
 #include <cstdint>
 #include <memory>
 #include <mutex>
@@ -16,6 +17,8 @@
 #import <MetalKit/MetalKit.h>
 #import <QuartzCore/QuartzCore.h>
 
+#include "core/dirty_range_tracker.h"
+#include "graphics/instanced_entity.h"
 #include "graphics/material_manager.h"
 #include "graphics/metal/metal_constant_buffer.h"
 #include "graphics/metal/metal_material.h"
@@ -88,6 +91,34 @@ class MetalRenderer : public Renderer
     void post_render() override;
 
   private:
+    /**
+     * Bring the current frame's copy of the instance data of an instanced entity up to date, creating a buffer for it
+     * if needed.
+     *
+     * @param instanced_entity
+     *   Entity to upload.
+     */
+    void upload_instance_data(InstancedEntity &instanced_entity);
+
+    /**
+     * Buffer for the instance data of an instanced entity in a scene. Each frame has its own copy, as the GPU may still
+     * be reading the others.
+     */
+    struct InstanceData
+    {
+        /** Instance data buffer. */
+        std::unique_ptr<MetalConstantBuffer> buffer;
+
+        /** Number of instances buffer can hold. */
+        std::size_t capacity;
+
+        /** Instances which have changed since buffer was last written. */
+        DirtyRangeTracker dirty_instances;
+
+        /** Last frame the entity was seen in a scene. */
+        std::size_t frame;
+    };
+
     /**
      * Internal struct encapsulating data needed for a frame.
      */
@@ -111,6 +142,9 @@ class MetalRenderer : public Renderer
         std::unordered_map<const Camera *, std::unique_ptr<MetalConstantBuffer>> camera_data;
 
         std::unordered_map<const Material *, std::unique_ptr<MetalConstantBuffer>> property_data;
+
+        /** Map of instance data buffers to instanced entities in a scene. */
+        std::unordered_map<const RenderEntity *, InstanceData> instance_data;
     };
 
     /** Texture manager object. */
@@ -148,8 +182,8 @@ class MetalRenderer : public Renderer
     /** The depth buffer for the default frame. */
     std::unique_ptr<MetalTexture> default_depth_buffer_;
 
-    /** Map of instance data buffers to render entities.  */
-    std::unordered_map<const RenderEntity *, std::unique_ptr<MetalConstantBuffer>> instance_data_;
+    /** Scratch collection of changed instance ranges. */
+    std::vector<DirtyRange> dirty_ranges_;
 
     /** Buffer for bindless texture table. */
     std::unique_ptr<MetalConstantBuffer> texture_table_;
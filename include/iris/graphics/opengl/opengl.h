@@ -37,12 +37,30 @@
 #define EXTERN extern
 #endif
 #include "graphics/opengl/opengl_defines.h"
+#include "graphics/opengl/opengl_error_mode.h"
 
 namespace iris
 {
 
 /**
- * Throws an exception if an OpenGl error has occurred.
+ * Get the current OpenGL error mode. The initial mode is set at build time with IRIS_OPENGL_ERROR_MODE.
+ *
+ * @returns
+ *   Current error mode.
+ */
+OpenGLErrorMode opengl_error_mode();
+
+/**
+ * Set the OpenGL error mode. This must be called with a current OpenGL context, as it installs (or removes) the debug
+ * callback.
+ *
+ * @param error_mode
+ *   New error mode.
+ */
+void set_opengl_error_mode(OpenGLErrorMode error_mode);
+
+/**
+ * Throws an exception if an OpenGl error has occurred. This is a no-op unless the error mode is CHECK_EACH_CALL.
  *
  * @param error_message
  *   The message to include in the exception.
@@ -65,6 +65,25 @@
 #if defined(IRIS_PLATFORM_WIN32)
 #define GL_COLOR_ATTACHMENT1 0x8CE1
 #define GL_COLOR_ATTACHMENT2 0x8CE2
+#define GL_MAP_WRITE_BIT 0x0002
+#define GL_MAP_PERSISTENT_BIT 0x0040
+#define GL_MAP_COHERENT_BIT 0x0080
+#define GL_SYNC_GPU_COMMANDS_COMPLETE 0x9117
+#define GL_SYNC_FLUSH_COMMANDS_BIT 0x00000001
+#define GL_ALREADY_SIGNALED 0x911A
+#define GL_TIMEOUT_EXPIRED 0x911B
+#define GL_CONDITION_SATISFIED 0x911C
+#define GL_WAIT_FAILED 0x911D
+#define GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT 0x8A34
+#define GL_SHADER_STORAGE_BUFFER_OFFSET_ALIGNMENT 0x90DF
+#define GL_DEBUG_OUTPUT 0x92E0
+#define GL_DEBUG_TYPE_ERROR 0x824C
+#define GL_DEBUG_SEVERITY_HIGH 0x9146
+#define GL_DEBUG_SEVERITY_MEDIUM 0x9147
+#define GL_DEBUG_SEVERITY_LOW 0x9148
+#define GL_DEBUG_SEVERITY_NOTIFICATION 0x826B
+
+using GLsync = struct __GLsync *;
 #endif
 
 using GLsizeiptr = std::ptrdiff_t;
@@ -72,6 +91,10 @@ using GLintptr = std::ptrdiff_t;
 using GLchar = char;
 using GLuint64 = std::uint64_t;
 
+#if defined(IRIS_PLATFORM_WIN32)
+using GLDEBUGPROC = void(APIENTRY *)(GLenum, GLenum, GLuint, GLenum, GLsizei, const GLchar *, const void *);
+#endif
+
 // x-macro definition for all opengl functions we want to laod
 // by default when we include opengl.h we want all these to be marked extern we will then define them all once in a
 // single translation unit where they can be resolved
@@ -131,6 +154,13 @@ using GLuint64 = std::uint64_t;
     DO(void, glSamplerParameteri, GLuint, GLenum, GLint)                                                               \
     DO(void, glSamplerParameterfv, GLuint, GLenum, const GLfloat *)                                                    \
     DO(void, glDrawBuffers, GLsizei, const GLenum *)                                                                   \
+    DO(void, glBufferStorage, GLenum, GLsizeiptr, const void *, GLbitfield)                                            \
+    DO(void *, glMapBufferRange, GLenum, GLintptr, GLsizeiptr, GLbitfield)                                             \
+    DO(GLboolean, glUnmapBuffer, GLenum)                                                                               \
+    DO(GLsync, glFenceSync, GLenum, GLbitfield)                                                                        \
+    DO(GLenum, glClientWaitSync, GLsync, GLbitfield, GLuint64)                                                         \
+    DO(void, glDeleteSync, GLsync)                                                                                     \
+    DO(void, glDebugMessageCallback, GLDEBUGPROC, const void *)                                                        \
     DO(void, glActiveTexture, GLenum)
 #elif defined(IRIS_PLATFORM_LINUX)
 #define FOR_OPENGL_FUNCTIONS(DO)                                                                                       \
@@ -184,7 +214,14 @@ using GLuint64 = std::uint64_t;
     DO(void, glDeleteSamplers, GLsizei, const GLuint *)                                                                \
     DO(void, glSamplerParameteri, GLuint, GLenum, GLint)                                                               \
     DO(void, glSamplerParameterfv, GLuint, GLenum, const GLfloat *)                                                    \
-    DO(void, glDrawBuffers, GLsizei, const GLenum *)
+    DO(void, glDrawBuffers, GLsizei, const GLenum *)                                                                   \
+    DO(void, glBufferStorage, GLenum, GLsizeiptr, const void *, GLbitfield)                                            \
+    DO(void *, glMapBufferRange, GLenum, GLintptr, GLsizeiptr, GLbitfield)                                             \
+    DO(GLboolean, glUnmapBuffer, GLenum)                                                                               \
+    DO(GLsync, glFenceSync, GLenum, GLbitfield)                                                                        \
+    DO(GLenum, glClientWaitSync, GLsync, GLbitfield, GLuint64)                                                         \
+    DO(void, glDeleteSync, GLsync)                                                                                     \
+    DO(void, glDebugMessageCallback, GLDEBUGPROC, const void *)
 #endif
 
 // declare all functions
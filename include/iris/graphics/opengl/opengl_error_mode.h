@@ -0,0 +1,30 @@
+////////////////////////////////////////////////////////////////////////////////
+//         Distributed under the Boost Software License, Version 1.0.         //
+//            (See accompanying file LICENSE or copy at                       //
+//                 https://www.boost.org/LICENSE_1_0.txt)                     //
+////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <cstdint>
+
+namespace iris
+{
+
+/**
+ * Enumeration of the ways OpenGL errors can be detected.
+ *
+ * CHECK_EACH_CALL - glGetError is called after every OpenGL call, this pinpoints the failing call but each check can
+ *                   stall the driver.
+ * DEBUG_CALLBACK - the driver reports errors (and other issues) via a KHR_debug callback, which are logged. There are
+ *                  no per call checks.
+ * NONE - no error checking.
+ */
+enum class OpenGLErrorMode : std::uint8_t
+{
+    CHECK_EACH_CALL,
+    DEBUG_CALLBACK,
+    NONE
+};
+
+}
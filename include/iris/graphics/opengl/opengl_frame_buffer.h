@@ -61,6 +61,14 @@ class OpenGLFrameBuffer
      */
     void unbind() const;
 
+    /**
+     * Get the OpenGL handle to the FBO.
+     *
+     * @return
+     *   OpenGL handle.
+     */
+    GLuint handle() const;
+
     /**
      * Get the colour target.
      *
@@ -11,7 +11,9 @@
 #include "graphics/lights/light_type.h"
 #include "graphics/material.h"
 #include "graphics/opengl/opengl.h"
+#include "graphics/opengl/opengl_uniform.h"
 #include "graphics/render_graph/render_graph.h"
+#include "graphics/shading_mode.h"
 
 namespace iris
 {
@@ -31,6 +33,9 @@ class OpenGLMaterial : public Material
      * @param light_type
      *   Type of light for this material.
      *
+     * @param shading_mode
+     *   How lights are applied, for ShadingMode::SINGLE_PASS light_type is ignored.
+     *
      * @param render_to_normal_target
      *   Flag indicating whether the material should also write out screen space normals to a render texture.
      *
@@ -40,6 +45,7 @@ class OpenGLMaterial : public Material
     OpenGLMaterial(
         const RenderGraph *render_graph,
         LightType light_type,
+        ShadingMode shading_mode,
         bool render_to_normal_target,
         bool render_to_position_target);
 
@@ -61,9 +67,32 @@ class OpenGLMaterial : public Material
      */
     GLuint handle() const;
 
+    /**
+     * Get the uniform for the index of the shadow map (into the texture table). Resolved at link time so it can be set
+     * per draw without a name lookup.
+     *
+     * @returns
+     *   Shadow map index uniform, setting it is a no-op if the program does not use it.
+     */
+    const OpenGLUniform &shadow_map_index_uniform() const;
+
+    /**
+     * Get the uniform for whether the entity being drawn receives shadows (single pass shading only).
+     *
+     * @returns
+     *   Receive shadow uniform, setting it is a no-op if the program does not use it.
+     */
+    const OpenGLUniform &receive_shadow_uniform() const;
+
   private:
     /** OpenGL handle to material. */
     GLuint handle_;
+
+    /** Uniform for shadow map index. */
+    OpenGLUniform shadow_map_index_uniform_;
+
+    /** Uniform for receive shadow flag. */
+    OpenGLUniform receive_shadow_uniform_;
 };
 
 }
@@ -10,6 +10,7 @@
 #include "graphics/material_cache.h"
 #include "graphics/material_manager.h"
 #include "graphics/opengl/opengl_material.h"
+#include "graphics/shading_mode.h"
 
 namespace iris
 {
@@ -38,6 +39,9 @@ class OpenGLMaterialManager : public MaterialManager
      * @param light_type
      *   The type of light that material should use.
      *
+     * @param shading_mode
+     *   How lights are applied, for ShadingMode::SINGLE_PASS the material handles all light types.
+     *
      * @param render_to_colour_target
      *   Whether the material is rendering to a colour target or the back buffer.
      *
@@ -57,6 +61,7 @@ class OpenGLMaterialManager : public MaterialManager
         RenderGraph *render_graph,
         RenderEntity *render_entity,
         LightType light_type,
+        ShadingMode shading_mode,
         bool render_to_colour_target,
         bool render_to_normal_target,
         bool render_to_position_target,
@@ -69,7 +74,7 @@ class OpenGLMaterialManager : public MaterialManager
 
   private:
     /** Cache of created materials. */
-    MaterialCache<OpenGLMaterial, RenderGraph *, LightType, bool, bool> materials_;
+    MaterialCache<OpenGLMaterial, RenderGraph *, LightType, ShadingMode, bool, bool> materials_;
 };
 
 }
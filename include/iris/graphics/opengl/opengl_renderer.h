@@ -9,15 +9,20 @@
 #include <cstdint>
 #include <deque>
 #include <memory>
+#include <optional>
 #include <unordered_map>
 #include <vector>
 
+#include "core/dirty_range_tracker.h"
+#include "graphics/instanced_entity.h"
 #include "graphics/material_cache.h"
 #include "graphics/material_manager.h"
 #include "graphics/opengl/opengl_buffer.h"
 #include "graphics/opengl/opengl_frame_buffer.h"
 #include "graphics/opengl/opengl_material.h"
 #include "graphics/opengl/opengl_render_target.h"
+#include "graphics/opengl/opengl_ring_buffer.h"
+#include "graphics/opengl/opengl_state_cache.h"
 #include "graphics/opengl/opengl_uniform.h"
 #include "graphics/render_pipeline.h"
 #include "graphics/renderer.h"
@@ -70,6 +75,10 @@ class OpenGLRenderer : public Renderer
 
     // handlers for the supported RenderCommandTypes
 
+    void pre_render() override;
+
+    void post_render() override;
+
     void execute_pass_start(RenderCommand &command) override;
 
     void execute_draw(RenderCommand &command) override;
@@ -77,6 +86,38 @@ class OpenGLRenderer : public Renderer
     void execute_present(RenderCommand &command) override;
 
   private:
+    /**
+     * Upload the changed instances of an instanced entity, creating a buffer for it if needed.
+     *
+     * @param instanced_entity
+     *   Entity to upload.
+     */
+    void upload_instance_data(InstancedEntity &instanced_entity);
+
+    /**
+     * Get the instance data buffer of an instanced entity which is in a scene this frame.
+     *
+     * @param render_entity
+     *   Entity to get buffer for.
+     *
+     * @returns
+     *   Instance data buffer, or nullptr if the entity is not a scene instanced entity (e.g. it is a single entity or a
+     *   batch).
+     */
+    const SSBO *scene_instance_data(const RenderEntity *render_entity) const;
+
+    /**
+     * Buffer for the instance data of an instanced entity in a scene.
+     */
+    struct InstanceData
+    {
+        /** Instance data buffer. */
+        std::unique_ptr<SSBO> buffer;
+
+        /** Last frame the entity was seen in a scene. */
+        std::uint64_t frame;
+    };
+
     /** Window manager object. */
     WindowManager &window_manager_;
 
@@ -92,17 +133,32 @@ class OpenGLRenderer : public Renderer
     /** Height of window being rendered to. */
     std::uint32_t height_;
 
-    /** Buffer for per pass camera data. */
-    std::unique_ptr<UBO> camera_data_;
+    /** Cache of OpenGL state, to filter out redundant state changes. */
+    OpenGLStateCache state_cache_;
+
+    /** Streaming buffer for all per frame constant data. */
+    std::unique_ptr<OpenGLRingBuffer> frame_data_;
 
-    /** Buffers for per pass entity bone data. */
-    std::unordered_map<const RenderEntity *, std::unique_ptr<UBO>> bone_data_;
+    /** Bone data for entities without a skeleton, shared by all of them for the frame. */
+    OpenGLBufferAllocation default_bone_data_;
 
-    /** Buffers for per pass entity model data. */
-    std::unordered_map<const RenderEntity *, std::unique_ptr<SSBO>> model_data_;
+    /** Per pass camera data. */
+    OpenGLBufferAllocation camera_data_;
+
+    /** Per pass entity bone data. */
+    std::unordered_map<const RenderEntity *, OpenGLBufferAllocation> bone_data_;
+
+    /** Per pass entity model data. */
+    std::unordered_map<const RenderEntity *, OpenGLBufferAllocation> model_data_;
+
+    /** Number of frames started, used to find instance data of entities no longer in a scene. */
+    std::uint64_t frame_;
 
     /** Buffers for per scene entity instance data. */
-    std::unordered_map<const RenderEntity *, std::unique_ptr<SSBO>> instance_data_;
+    std::unordered_map<const RenderEntity *, InstanceData> instance_data_;
+
+    /** Scratch collection of changed instance ranges. */
+    std::vector<DirtyRange> dirty_ranges_;
 
     /** Buffers for per scene texture data. */
     std::unique_ptr<SSBO> texture_table_;
@@ -110,11 +166,14 @@ class OpenGLRenderer : public Renderer
     /** Buffers for per scene cube map data. */
     std::unique_ptr<SSBO> cube_map_table_;
 
-    /** Buffer for render specific values. */
-    std::unique_ptr<UBO> render_values_;
+    /** Per pass render specific values. */
+    OpenGLBufferAllocation render_values_;
+
+    /** Per pass light data. */
+    std::unordered_map<const Light *, OpenGLBufferAllocation> light_data_;
 
-    /** Buffers for per pass light data. */
-    std::unordered_map<const Light *, std::unique_ptr<UBO>> light_data_;
+    /** All lights in the current pass, only written for single pass shading. */
+    std::optional<OpenGLBufferAllocation> light_array_;
 
     /** Collection of frame buffers per render pass. */
     std::unordered_map<const RenderPass *, OpenGLFrameBuffer> pass_frame_buffers_;
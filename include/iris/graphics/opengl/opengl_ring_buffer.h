@@ -0,0 +1,226 @@
+////////////////////////////////////////////////////////////////////////////////
+//         Distributed under the Boost Software License, Version 1.0.         //
+//            (See accompanying file LICENSE or copy at                       //
+//                 https://www.boost.org/LICENSE_1_0.txt)                     //
+////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstring>
+#include <memory>
+#include <vector>
+
+#include "core/error_handling.h"
+#include "graphics/opengl/opengl.h"
+#include "graphics/opengl/opengl_state_cache.h"
+
+namespace iris
+{
+
+/**
+ * A region of an OpenGLRingBuffer, valid for the frame it was allocated in. It can be written to with a
+ * ConstantBufferWriter.
+ */
+class OpenGLBufferAllocation
+{
+  public:
+    /**
+     * Construct an empty allocation.
+     */
+    OpenGLBufferAllocation()
+        : OpenGLBufferAllocation(0u, 0u, 0u, nullptr)
+    {
+    }
+
+    /**
+     * Construct a new OpenGLBufferAllocation.
+     *
+     * @param handle
+     *   OpenGL handle of buffer allocation is in.
+     *
+     * @param offset
+     *   Offset of allocation in buffer.
+     *
+     * @param size
+     *   Size of allocation.
+     *
+     * @param data
+     *   Mapped pointer to start of allocation.
+     */
+    OpenGLBufferAllocation(GLuint handle, std::size_t offset, std::size_t size, std::byte *data)
+        : handle_(handle)
+        , offset_(offset)
+        , size_(size)
+        , data_(data)
+    {
+    }
+
+    /**
+     * Bind the allocation to an indexed binding point.
+     *
+     * @param state_cache
+     *   State cache to bind through, so rebinding the same allocation is skipped.
+     *
+     * @param target
+     *   Target to bind to, e.g. GL_UNIFORM_BUFFER.
+     *
+     * @param index
+     *   Index of binding point in target.
+     */
+    void bind(OpenGLStateCache &state_cache, GLenum target, GLuint index) const
+    {
+        state_cache.bind_buffer_range(
+            target, index, handle_, static_cast<GLintptr>(offset_), static_cast<GLsizeiptr>(size_));
+    }
+
+    /**
+     * Write an object into the allocation at an offset.
+     *
+     * @param object
+     *   Object to write.
+     *
+     * @param offset
+     *   Offset into allocation to write object.
+     */
+    template <class T>
+    void write(const T &object, std::size_t offset)
+    {
+        write(std::addressof(object), sizeof(T), offset);
+    }
+
+    /**
+     * Write an object into the allocation at an offset.
+     *
+     * @param object
+     *   Object to write.
+     *
+     * @param size
+     *   Size (in bytes) of object to write.
+     *
+     * @param offset
+     *   Offset into allocation to write object.
+     */
+    template <class T>
+    void write(const T *object, std::size_t size, std::size_t offset)
+    {
+        expect(offset + size <= size_, "write would overflow");
+        std::memcpy(data_ + offset, object, size);
+    }
+
+  private:
+    /** OpenGL handle of buffer. */
+    GLuint handle_;
+
+    /** Offset of allocation in buffer. */
+    std::size_t offset_;
+
+    /** Size of allocation. */
+    std::size_t size_;
+
+    /** Mapped pointer to start of allocation. */
+    std::byte *data_;
+};
+
+/**
+ * Per frame streaming allocator for constant data (uniform and shader storage buffers).
+ *
+ * This is backed by a single persistently mapped buffer, split into a region for each frame in flight. Each frame the
+ * next region is reused, but only once a fence shows the GPU has finished the frame which last used it. Allocations
+ * are then just bumping an offset and writing directly to mapped memory, so no buffers are created per frame.
+ *
+ * If a frame allocates more than a region the buffer is replaced with one twice the size. The old buffer is deleted at
+ * the start of the next frame, so allocations already made this frame remain valid.
+ */
+class OpenGLRingBuffer
+{
+  public:
+    /** Number of frames which can be in flight. */
+    static constexpr std::size_t frames_in_flight = 3u;
+
+    /**
+     * Construct a new OpenGLRingBuffer.
+     *
+     * @param frame_capacity
+     *   Initial number of bytes which can be allocated per frame.
+     */
+    OpenGLRingBuffer(std::size_t frame_capacity);
+
+    ~OpenGLRingBuffer();
+
+    OpenGLRingBuffer(const OpenGLRingBuffer &) = delete;
+    OpenGLRingBuffer &operator=(const OpenGLRingBuffer &) = delete;
+
+    /**
+     * Start a new frame, this may block until the GPU has finished with the region being reused.
+     */
+    void begin_frame();
+
+    /**
+     * End the current frame, this must be called after all commands using the frames allocations have been issued.
+     */
+    void end_frame();
+
+    /**
+     * Allocate a region of the buffer for the current frame. The region is suitably aligned for use as either a
+     * uniform or shader storage buffer.
+     *
+     * @param size
+     *   Number of bytes to allocate.
+     *
+     * @returns
+     *   Allocation.
+     */
+    OpenGLBufferAllocation allocate(std::size_t size);
+
+    /**
+     * Get the number of bytes which can be allocated per frame.
+     *
+     * @returns
+     *   Frame capacity.
+     */
+    std::size_t frame_capacity() const;
+
+  private:
+    /**
+     * Create and map the buffer.
+     */
+    void create_buffer();
+
+    /**
+     * Unmap the buffer and queue it for deletion.
+     */
+    void retire_buffer();
+
+    /**
+     * Delete all retired buffers.
+     */
+    void delete_retired_buffers();
+
+    /** OpenGL handle of buffer. */
+    GLuint handle_;
+
+    /** Mapped pointer to start of buffer. */
+    std::byte *data_;
+
+    /** Number of bytes which can be allocated per frame. */
+    std::size_t frame_capacity_;
+
+    /** Alignment of allocations. */
+    std::size_t alignment_;
+
+    /** Index of current frame region. */
+    std::size_t frame_index_;
+
+    /** Offset of next allocation in current frame region. */
+    std::size_t frame_offset_;
+
+    /** Fence for each region, signalled when the GPU has finished the frame which last used it. */
+    std::array<GLsync, frames_in_flight> fences_;
+
+    /** Handles of replaced buffers, which may still be bound this frame. */
+    std::vector<GLuint> retired_handles_;
+};
+
+}
@@ -0,0 +1,211 @@
+////////////////////////////////////////////////////////////////////////////////
+//         Distributed under the Boost Software License, Version 1.0.         //
+//            (See accompanying file LICENSE or copy at                       //
+//                 https://www.boost.org/LICENSE_1_0.txt)                     //
+////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <optional>
+
+#include "core/telemetry_counter.h"
+#include "graphics/opengl/opengl.h"
+
+namespace iris
+{
+
+/**
+ * Shadow copy of the OpenGL state set per draw, so redundant state changes can be filtered out before they reach the
+ * driver.
+ *
+ * The cache assumes it is the only thing changing the state it tracks. Anything which changes that state directly (e.g.
+ * creating a buffer bound to an index) must be followed by a call to invalidate().
+ */
+class OpenGLStateCache
+{
+  public:
+    /** Number of indexed binding points tracked for each buffer target. */
+    static constexpr std::size_t max_buffer_bindings = 8u;
+
+    /**
+     * Construct a new OpenGLStateCache, with all state unknown.
+     */
+    OpenGLStateCache();
+
+    /**
+     * Forget all cached state, so the next call for each piece of state is always issued.
+     */
+    void invalidate();
+
+    /**
+     * Set the current program.
+     *
+     * @param program
+     *   OpenGL handle of program.
+     */
+    void use_program(GLuint program);
+
+    /**
+     * Bind a framebuffer to GL_FRAMEBUFFER.
+     *
+     * @param framebuffer
+     *   OpenGL handle of framebuffer, 0 for the default framebuffer.
+     */
+    void bind_framebuffer(GLuint framebuffer);
+
+    /**
+     * Enable or disable blending.
+     *
+     * @param enabled
+     *   True to enable blending, false to disable.
+     */
+    void set_blend(bool enabled);
+
+    /**
+     * Set the blend function.
+     *
+     * @param source
+     *   Source factor.
+     *
+     * @param destination
+     *   Destination factor.
+     */
+    void set_blend_func(GLenum source, GLenum destination);
+
+    /**
+     * Enable or disable depth testing.
+     *
+     * @param enabled
+     *   True to enable depth testing, false to disable.
+     */
+    void set_depth_test(bool enabled);
+
+    /**
+     * Set the depth test function.
+     *
+     * @param func
+     *   Depth function.
+     */
+    void set_depth_func(GLenum func);
+
+    /**
+     * Set the polygon mode for front and back faces.
+     *
+     * @param mode
+     *   Polygon mode e.g. GL_FILL.
+     */
+    void set_polygon_mode(GLenum mode);
+
+    /**
+     * Bind a whole buffer to an indexed binding point.
+     *
+     * @param target
+     *   Either GL_UNIFORM_BUFFER or GL_SHADER_STORAGE_BUFFER.
+     *
+     * @param index
+     *   Index of binding point.
+     *
+     * @param buffer
+     *   OpenGL handle of buffer.
+     */
+    void bind_buffer_base(GLenum target, GLuint index, GLuint buffer);
+
+    /**
+     * Bind a range of a buffer to an indexed binding point.
+     *
+     * @param target
+     *   Either GL_UNIFORM_BUFFER or GL_SHADER_STORAGE_BUFFER.
+     *
+     * @param index
+     *   Index of binding point.
+     *
+     * @param buffer
+     *   OpenGL handle of buffer.
+     *
+     * @param offset
+     *   Offset of range in buffer.
+     *
+     * @param size
+     *   Size of range.
+     */
+    void bind_buffer_range(GLenum target, GLuint index, GLuint buffer, GLintptr offset, GLsizeiptr size);
+
+  private:
+    /**
+     * A buffer (or range of a buffer) bound to an indexed binding point. A size of -1 means the whole buffer.
+     */
+    struct BufferBinding
+    {
+        GLuint buffer;
+        GLintptr offset;
+        GLsizeiptr size;
+
+        bool operator==(const BufferBinding &) const = default;
+    };
+
+    /**
+     * Helper method to update a piece of cached state, recording whether the call was issued or skipped.
+     *
+     * @param cached
+     *   Cached state.
+     *
+     * @param value
+     *   New value of state.
+     *
+     * @returns
+     *   True if the state changed (and the call should be issued), otherwise false.
+     */
+    template <class T>
+    bool update(std::optional<T> &cached, const T &value);
+
+    /**
+     * Helper method to get the cached binding for an indexed binding point.
+     *
+     * @param target
+     *   Buffer target.
+     *
+     * @param index
+     *   Index of binding point.
+     *
+     * @returns
+     *   Cached binding.
+     */
+    std::optional<BufferBinding> &buffer_binding(GLenum target, GLuint index);
+
+    /** Current program. */
+    std::optional<GLuint> program_;
+
+    /** Current framebuffer. */
+    std::optional<GLuint> framebuffer_;
+
+    /** Whether blending is enabled. */
+    std::optional<bool> blend_;
+
+    /** Current blend function. */
+    std::optional<std::array<GLenum, 2u>> blend_func_;
+
+    /** Whether depth testing is enabled. */
+    std::optional<bool> depth_test_;
+
+    /** Current depth function. */
+    std::optional<GLenum> depth_func_;
+
+    /** Current polygon mode. */
+    std::optional<GLenum> polygon_mode_;
+
+    /** Uniform buffer bindings. */
+    std::array<std::optional<BufferBinding>, max_buffer_bindings> uniform_buffers_;
+
+    /** Shader storage buffer bindings. */
+    std::array<std::optional<BufferBinding>, max_buffer_bindings> storage_buffers_;
+
+    /** Counter for state changes passed to OpenGL. */
+    TelemetryCounter &issued_counter_;
+
+    /** Counter for redundant state changes filtered out. */
+    TelemetryCounter &skipped_counter_;
+};
+
+}
@@ -0,0 +1,92 @@
+////////////////////////////////////////////////////////////////////////////////
+//         Distributed under the Boost Software License, Version 1.0.         //
+//            (See accompanying file LICENSE or copy at                       //
+//                 https://www.boost.org/LICENSE_1_0.txt)                     //
+////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <cstdint>
+#include <span>
+#include <vector>
+
+#include "graphics/render_command.h"
+
+namespace iris
+{
+
+/**
+ * Class for ordering the draw commands of a render queue to minimise state changes.
+ *
+ * Each draw command is given a packed 64 bit key, from most to least significant:
+ *   - pass index (8 bits)
+ *   - light type (2 bits)
+ *   - blend state (1 bit, opaque before transparent)
+ *   - opaque:      material (16 bits), mesh (16 bits), depth front-to-back (21 bits)
+ *   - transparent: depth back-to-front (21 bits), material (16 bits), mesh (16 bits)
+ *
+ * The draw commands of each pass are then radix sorted by their key. Light type is above everything else so the
+ * ambient draws still happen before the additive light draws. Depth is the distance from the pass camera, so the
+ * queue should be re-sorted each frame.
+ */
+class RenderCommandSorter
+{
+  public:
+    /**
+     * Create the sort key for a draw command.
+     *
+     * @param pass_index
+     *   Index of the pass the command is in.
+     *
+     * @param command
+     *   Draw command to create key for.
+     *
+     * @returns
+     *   Sort key for command.
+     */
+    static std::uint64_t sort_key(std::uint32_t pass_index, const RenderCommand &command);
+
+    /**
+     * Sort the draw commands within each pass of a render queue. The PASS_START, PASS_END and PRESENT commands are
+     * left where they are. The sort is stable, so draws with the same key keep their relative order.
+     *
+     * @param render_queue
+     *   Queue to sort.
+     */
+    void sort(std::span<RenderCommand> render_queue);
+
+  private:
+    /**
+     * A sort key and the index of the command it was created from.
+     */
+    struct Entry
+    {
+        /** Sort key. */
+        std::uint64_t key;
+
+        /** Index of command in the range being sorted. */
+        std::uint32_t index;
+    };
+
+    /**
+     * Radix sort a range of draw commands.
+     *
+     * @param pass_index
+     *   Index of the pass the commands are in.
+     *
+     * @param commands
+     *   Commands to sort.
+     */
+    void sort_pass(std::uint32_t pass_index, std::span<RenderCommand> commands);
+
+    /** Entries being sorted. */
+    std::vector<Entry> entries_;
+
+    /** Scratch space for radix sort. */
+    std::vector<Entry> scratch_entries_;
+
+    /** Scratch space for re-ordering commands. */
+    std::vector<RenderCommand> scratch_commands_;
+};
+
+}
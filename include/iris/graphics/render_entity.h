@@ -10,6 +10,8 @@
 #include <string>
 #include <string_view>
 
+#include "core/aabb.h"
+#include "core/bounding_sphere.h"
 #include "graphics/mesh.h"
 #include "graphics/primitive_type.h"
 #include "graphics/render_entity_type.h"
@@ -121,7 +123,64 @@ class RenderEntity
      */
     void set_receive_shadow(bool receive_shadow);
 
+    /**
+     * Get the world space axis aligned bounding box of the entity.
+     *
+     * @returns
+     *   World space AABB.
+     */
+    const AABB &aabb() const;
+
+    /**
+     * Get the world space bounding sphere of the entity.
+     *
+     * @returns
+     *   World space bounding sphere.
+     */
+    const BoundingSphere &bounding_sphere() const;
+
+    /**
+     * Can this entity be skipped when it is outside the view frustum.
+     *
+     * @returns
+     *   True if entity can be culled, false otherwise.
+     */
+    bool cullable() const;
+
+    /**
+     * Set whether this entity can be skipped when it is outside the view frustum. This should be disabled for
+     * entities whose bounds don't reflect what is drawn, e.g. those deformed by a vertex shader.
+     *
+     * @param cullable
+     *   New cullable option.
+     */
+    void set_cullable(bool cullable);
+
+    /**
+     * Can this entity be drawn in a single instanced draw with other identical entities (same mesh and material).
+     *
+     * @returns
+     *   True if entity can be batched, false otherwise.
+     */
+    bool batchable() const;
+
+    /**
+     * Set whether this entity can be drawn in a single instanced draw with other identical entities. This should be
+     * disabled for entities whose draw relies on per entity state (e.g. draw order).
+     *
+     * @param batchable
+     *   New batchable option.
+     */
+    void set_batchable(bool batchable);
+
   protected:
+    /**
+     * Recalculate aabb_ and bounding_sphere_, this is called by aabb() and bounding_sphere() when bounds_dirty_ is set.
+     * Implementations whose bounds are expensive to keep up to date can set bounds_dirty_ and override this, so the
+     * work is only done when the bounds are needed. The default does nothing.
+     */
+    virtual void update_bounds() const;
+
     /** Mesh to render. */
     const Mesh *mesh_;
 
@@ -136,6 +195,21 @@ class RenderEntity
 
     /** Should object render shadows. */
     bool receive_shadow_;
+
+    /** World space AABB, implementations must keep this up to date (or set bounds_dirty_). */
+    mutable AABB aabb_;
+
+    /** World space bounding sphere, implementations must keep this up to date (or set bounds_dirty_). */
+    mutable BoundingSphere bounding_sphere_;
+
+    /** Whether aabb_ and bounding_sphere_ need recalculating with update_bounds() before they are next read. */
+    mutable bool bounds_dirty_;
+
+    /** Can object be culled. */
+    bool cullable_;
+
+    /** Can object be batched. */
+    bool batchable_;
 };
 
 }
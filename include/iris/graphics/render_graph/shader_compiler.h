@@ -18,6 +18,7 @@
 #include "graphics/default_shader_languages.h"
 #include "graphics/lights/light_type.h"
 #include "graphics/render_graph/render_graph.h"
+#include "graphics/shading_mode.h"
 
 namespace inja
 {
@@ -63,6 +64,7 @@ class ShaderCompiler
         ShaderLanguage language,
         const RenderGraph *render_graph,
         LightType light_type,
+        ShadingMode shading_mode,
         bool render_to_normal_target,
         bool render_to_position_target);
 
@@ -150,6 +152,9 @@ class ShaderCompiler
     /** Type of light to render with. */
     LightType light_type_;
 
+    /** How lights are applied, for ShadingMode::SINGLE_PASS the shader loops over all lights. */
+    ShadingMode shading_mode_;
+
     /** Flag indicating whether the shader should also write out screen space normals to a render texture. */
     bool render_to_normal_target_;
 
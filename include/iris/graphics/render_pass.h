@@ -11,6 +11,7 @@
 #include "graphics/post_processing_description.h"
 #include "graphics/render_target.h"
 #include "graphics/scene.h"
+#include "graphics/shading_mode.h"
 
 namespace iris
 {
@@ -58,6 +59,12 @@ struct RenderPass
     /** Should the depth buffer be cleared before rendering. */
     bool clear_depth = true;
 
+    /**
+     * How lights are applied to entities. Passes which are depth only or use ambient occlusion always fall back to
+     * ShadingMode::PER_LIGHT.
+     */
+    ShadingMode shading_mode = ShadingMode::PER_LIGHT;
+
     PostProcessingDescription post_processing_description = PostProcessingDescription{};
 
   private:
@@ -19,7 +19,9 @@
 #include "graphics/render_pass.h"
 #include "graphics/render_target_manager.h"
 #include "graphics/scene.h"
+#include "graphics/shading_mode.h"
 #include "graphics/single_entity.h"
+#include "jobs/job_system_manager.h"
 
 namespace iris
 {
@@ -52,13 +54,17 @@ class RenderPipeline
      *
      * @param height
      *   Height of final render output.
+     *
+     * @param jobs_manager
+     *   Optional job system manager, if supplied draw commands are encoded in parallel jobs.
      */
     RenderPipeline(
         MaterialManager &material_manager,
         MeshManager &mesh_manager,
         RenderTargetManager &render_target_manager,
         std::uint32_t width,
-        std::uint32_t height);
+        std::uint32_t height,
+        JobSystemManager *jobs_manager = nullptr);
     ~RenderPipeline();
 
     RenderPipeline(const RenderPipeline &) = delete;
@@ -117,6 +123,22 @@ class RenderPipeline
      */
     std::vector<RenderCommand> rebuild();
 
+    /**
+     * Apply any entity changes (add, remove, render graph change) made to scenes since the last build, rebuild or
+     * update. Only the commands for the affected entities are encoded, the rest of the queue is reused as is.
+     *
+     * Structural changes (e.g. adding lights) still require a full rebuild(), which is indicated by is_dirty().
+     *
+     * Note this should only be called internally by the engine, calling it manually may produce unexpected results.
+     *
+     * @param render_queue
+     *   Queue to update, this is refilled in place so its storage is reused.
+     *
+     * @returns
+     *   True if render_queue was updated, false if there were no changes.
+     */
+    bool update(std::vector<RenderCommand> &render_queue);
+
     /**
      * Get collection of all RenderPass objects in this pipeline.
      *
@@ -126,10 +148,11 @@ class RenderPipeline
     std::vector<RenderPass *> render_passes() const;
 
     /**
-     * Check if a created object has been mutated.
+     * Check if a created object has been structurally mutated, meaning a rebuild() is required. Adding, removing or
+     * changing the RenderGraph of an entity is not a structural change, see update().
      *
      * @returns
-     *   True if a created object has been mutated, false otherwise.
+     *   True if a created object has been structurally mutated, false otherwise.
      */
     bool is_dirty() const;
 
@@ -148,9 +171,129 @@ class RenderPipeline
      */
     Scene *scene(std::size_t index) const;
 
+    /**
+     * Get the shadow map created for a directional light.
+     *
+     * @param light
+     *   Light to get shadow map for.
+     *
+     * @returns
+     *   Shadow map if light casts shadows, otherwise nullptr.
+     */
+    const RenderTarget *shadow_map(const DirectionalLight *light) const;
+
+    /**
+     * Get the shading mode a pass is actually drawn with.
+     *
+     * @param render_pass
+     *   Pass to get shading mode for.
+     *
+     * @returns
+     *   Shading mode of pass, depth only passes and passes using ssao (where the ambient light is handled separately)
+     *   always use ShadingMode::PER_LIGHT.
+     */
+    static ShadingMode shading_mode(const RenderPass *render_pass);
+
   private:
+    /**
+     * The draw commands for a single pass, split by light type. Keeping these separate (rather than one flat queue)
+     * means an entity can be patched in or out of a pass without re-encoding the rest of it.
+     */
+    struct PassCommands
+    {
+        /** Draw commands for the ambient light. */
+        std::vector<RenderCommand> ambient;
+
+        /** Draw commands for each point light. */
+        std::vector<RenderCommand> point;
+
+        /** Draw commands for each directional light. */
+        std::vector<RenderCommand> directional;
+    };
+
+    /**
+     * An entity to be encoded along with the materials it is drawn with for each light type. A nullptr material means
+     * the entity is not drawn with that light type.
+     */
+    struct EntityMaterials
+    {
+        /** Entity to encode. */
+        RenderEntity *render_entity;
+
+        /** Material for ambient light. */
+        const Material *ambient;
+
+        /** Material for point lights. */
+        const Material *point;
+
+        /** Material for directional lights. */
+        const Material *directional;
+    };
+
     RenderPass *create_engine_render_pass(Scene *scene);
 
+    /**
+     * Create all the materials an entity needs in a pass. This must be called on the thread which owns the graphics
+     * context, as creating a material may compile shaders.
+     *
+     * @param pass
+     *   Pass entity is drawn in.
+     *
+     * @param render_graph
+     *   RenderGraph for entity.
+     *
+     * @param render_entity
+     *   Entity to create materials for.
+     *
+     * @returns
+     *   Materials for entity.
+     */
+    EntityMaterials create_materials(const RenderPass *pass, RenderGraph *render_graph, RenderEntity *render_entity);
+
+    /**
+     * Encode all the draw commands for an entity in a pass. This does not modify the pipeline so can be called
+     * concurrently.
+     *
+     * @param pass
+     *   Pass to encode for.
+     *
+     * @param entity_materials
+     *   Entity to encode and its materials.
+     *
+     * @param commands
+     *   Commands for pass to add to.
+     */
+    void encode_entity(const RenderPass *pass, const EntityMaterials &entity_materials, PassCommands &commands) const;
+
+    /**
+     * Encode the draw commands for all passes using the job system. Entities are split into chunks, each encoded by
+     * a separate job into its own command lists, which are then merged in order. The output is identical to encoding
+     * serially.
+     *
+     * @param pass_entities
+     *   Entities (and their materials) for each pass, indices match render_passes_.
+     */
+    void encode_parallel(const std::vector<std::vector<EntityMaterials>> &pass_entities);
+
+    /**
+     * Apply pending entity changes for the scene of a pass.
+     *
+     * @param pass
+     *   Pass to patch.
+     *
+     * @param commands
+     *   Commands for pass to patch.
+     */
+    void patch_pass(const RenderPass *pass, PassCommands &commands);
+
+    /**
+     * Write all pass commands into a render queue.
+     *
+     * @param render_queue
+     *   Queue to write to, any existing contents are replaced.
+     */
+    void flatten(std::vector<RenderCommand> &render_queue) const;
+
     /**
      * Add a new pass to collection of passes. This creates a new scene, camera and render target as well as using a
      * callback to allow the caller to set the render graph for the scene.
@@ -190,6 +333,9 @@ class RenderPipeline
     /** Render target manager object. */
     RenderTargetManager &render_target_manager_;
 
+    /** Optional job system manager for parallel encoding. */
+    JobSystemManager *jobs_manager_;
+
     /** Collection of created scenes. */
     std::vector<std::unique_ptr<Scene>> scenes_;
 
@@ -205,6 +351,9 @@ class RenderPipeline
     /** Collection of pointers to all render passes in the pipeline. */
     std::vector<RenderPass *> render_passes_;
 
+    /** Draw commands for each pass, indices match render_passes_. */
+    std::vector<PassCommands> pass_commands_;
+
     /** Collection of created sky box entities. */
     std::unordered_map<const RenderPass *, SingleEntity *> sky_box_entities_;
 
@@ -12,8 +12,13 @@
 
 #include "core/camera.h"
 #include "graphics/lights/light_type.h"
+#include "graphics/draw_batcher.h"
+#include "graphics/frustum_culler.h"
+#include "graphics/instanced_entity.h"
+#include "graphics/light_culler.h"
 #include "graphics/material_manager.h"
 #include "graphics/render_command.h"
+#include "graphics/render_command_sorter.h"
 #include "graphics/render_pass.h"
 #include "graphics/render_pipeline.h"
 #include "graphics/render_target.h"
@@ -34,8 +39,12 @@ class Renderer
      *
      * @param material_manager
      *   Material manager object.
+     *
+     * @param batch_draws
+     *   If identical draws should be batched into instanced draws, implementations which enable this must support
+     *   InstancedEntity objects whose instances change every frame.
      */
-    Renderer(MaterialManager &material_manager);
+    Renderer(MaterialManager &material_manager, bool batch_draws = false);
     virtual ~Renderer() = default;
 
     /**
@@ -85,6 +94,13 @@ class Renderer
     /** The queue of RenderCommand objects created from the current RenderPass objects. */
     std::vector<RenderCommand> render_queue_;
 
+    /**
+     * Instanced entities in the scenes of the current RenderPass objects, each appears once no matter how many passes
+     * render its scene. Instances can change every frame so implementations should use this to upload them once per
+     * frame, it is only rebuilt when the render queue changes.
+     */
+    std::vector<InstancedEntity *> instanced_entities_;
+
     /** Pipeline to execute with render(). */
     std::unique_ptr<RenderPipeline> render_pipeline_;
 
@@ -95,6 +111,29 @@ class Renderer
     std::chrono::steady_clock::duration time_;
 
   private:
+    /**
+     * Collect the instanced entities from the scenes of the current RenderPass objects into instanced_entities_.
+     */
+    void update_instanced_entities();
+
+    /** The commands from render_queue_ which are visible this frame, in the order they are executed. */
+    std::vector<RenderCommand> visible_queue_;
+
+    /** Culler for removing draw commands outside the view frustum. */
+    FrustumCuller frustum_culler_;
+
+    /** Culler for removing point light draws which can't affect their entity. */
+    LightCuller light_culler_;
+
+    /** Sorter for ordering draw commands to minimise state changes. */
+    RenderCommandSorter render_command_sorter_;
+
+    /** Batcher for merging identical draws into instanced draws. */
+    DrawBatcher draw_batcher_;
+
+    /** Should draws be batched. */
+    bool batch_draws_;
+
     /** Material manager object. */
     MaterialManager &material_manager_;
 };
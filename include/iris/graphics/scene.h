@@ -68,6 +68,17 @@ class Scene
      */
     void remove(RenderEntity *entity);
 
+    /**
+     * Change the RenderGraph (and therefore the material) used to render an entity.
+     *
+     * @param entity
+     *   RenderEntity to update, must be in the scene.
+     *
+     * @param render_graph
+     *   New RenderGraph for RenderEntity, if nullptr then the default RenderGraph is used.
+     */
+    void set_render_graph(RenderEntity *entity, RenderGraph *render_graph);
+
     /**
      * Create a Light and add it to the scene. Uses perfect forwarding to pass
      * along all arguments.
@@ -169,7 +180,7 @@ class Scene
      *   Render graph to use when a user does to supply one.
      *
      * @param dirty_pipeline
-     *   Flag to set when the scene is modified.
+     *   Flag to set when the scene is structurally modified (i.e. the pipeline needs a full rebuild).
      */
     Scene(RenderGraph *default_render_graph, bool *dirty_pipeline);
 
@@ -217,6 +228,19 @@ class Scene
      */
     RenderEntity *add_at_front(RenderGraph *render_graph, std::unique_ptr<RenderEntity> entity);
 
+    /**
+     * Check if any entities have been added, removed or updated since the last call to clear_changes().
+     *
+     * @returns
+     *   True if there are pending entity changes, false otherwise.
+     */
+    bool has_changes() const;
+
+    /**
+     * Discard all pending entity changes, called by the RenderPipeline once they have been applied.
+     */
+    void clear_changes();
+
     /** Collection of <RenderGraph, RenderEntity> tuples. */
     std::vector<std::tuple<RenderGraph *, std::unique_ptr<RenderEntity>>> entities_;
 
@@ -229,8 +253,17 @@ class Scene
     /** Handle to the default render graph. */
     RenderGraph *default_render_graph_;
 
-    /** Flag to indicate user has changed the scene. */
+    /** Flag to indicate user has structurally changed the scene. */
     bool *dirty_pipeline_;
+
+    /** Entities added since the pipeline last encoded this scene, with the RenderGraph they should be drawn with. */
+    std::vector<std::tuple<RenderGraph *, RenderEntity *>> added_entities_;
+
+    /** Entities removed since the pipeline last encoded this scene, these must not be dereferenced. */
+    std::vector<const RenderEntity *> removed_entities_;
+
+    /** Entities whose RenderGraph has changed since the pipeline last encoded this scene. */
+    std::vector<std::tuple<RenderGraph *, RenderEntity *>> updated_entities_;
 };
 
 }
@@ -0,0 +1,28 @@
+////////////////////////////////////////////////////////////////////////////////
+//         Distributed under the Boost Software License, Version 1.0.         //
+//            (See accompanying file LICENSE or copy at                       //
+//                 https://www.boost.org/LICENSE_1_0.txt)                     //
+////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <cstdint>
+
+namespace iris
+{
+
+/**
+ * Enumeration of the ways lights can be applied to an entity.
+ *
+ * PER_LIGHT - the entity is drawn once for the ambient light and then once more (with additive blending) for every
+ *             other light.
+ * SINGLE_PASS - the entity is drawn once, with the shader looping over all the lights in the scene. Currently only
+ *               supported by the OpenGL backend.
+ */
+enum class ShadingMode : std::uint8_t
+{
+    PER_LIGHT,
+    SINGLE_PASS
+};
+
+}
@@ -228,6 +228,11 @@ class SingleEntity : public RenderEntity
     bool has_transparency() const override;
 
   private:
+    /**
+     * Update the world space bounds from the mesh bounds and transform.
+     */
+    void update_bounds();
+
     /** World space transform. */
     Transform transform_;
 
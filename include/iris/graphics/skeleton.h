@@ -13,6 +13,7 @@
 #include <vector>
 
 #include "core/matrix4.h"
+#include "core/string_id.h"
 #include "core/transform.h"
 #include "core/utils.h"
 #include "graphics/bone.h"
@@ -122,6 +123,17 @@ class Skeleton
      */
     bool has_bone(std::string_view name) const;
 
+    /**
+     * Check if a bone exists.
+     *
+     * @param id
+     *   Id of bone name to check.
+     *
+     * @returns
+     *   True if bone exists, otherwise false.
+     */
+    bool has_bone(StringId id) const;
+
     /**
      * Get the index of the given bone name.
      *
@@ -133,6 +145,17 @@ class Skeleton
      */
     std::size_t bone_index(std::string_view name) const;
 
+    /**
+     * Get the index of the given bone name id.
+     *
+     * @param id
+     *   Id of bone name.
+     *
+     * @returns
+     *   Index of bone.
+     */
+    std::size_t bone_index(StringId id) const;
+
     /**
      * Get reference to bone at index.
      *
@@ -173,6 +196,9 @@ class Skeleton
     /** Index of parents for bones. */
     std::vector<std::size_t> parents_;
 
+    /** Map of bone name id to index. */
+    std::unordered_map<StringId, std::size_t> bone_lookup_;
+
     /** Collection of transform matrices for bones. */
     std::vector<Matrix4> transforms_;
 };
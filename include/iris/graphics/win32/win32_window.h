@@ -6,8 +6,10 @@
 
 #pragma once
 
+#include <cstddef>
 #include <cstdint>
 #include <optional>
+#include <vector>
 
 #define WIN32_LEAN_AND_MEAN
 #include <Windows.h>
@@ -61,6 +63,18 @@ class Win32Window : public Window
      */
     std::optional<Event> pump_event() override;
 
+    /**
+     * Pump all pending user input events, draining the windows message queue
+     * once.
+     *
+     * @param events
+     *   Collection to append events to.
+     *
+     * @returns
+     *   Number of events appended.
+     */
+    std::size_t pump_events(std::vector<Event> &events) override;
+
     /**
      * Get device context handle.
      *
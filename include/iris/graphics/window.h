@@ -7,10 +7,12 @@
 #pragma once
 
 #include <chrono>
+#include <cstddef>
 #include <cstdint>
 #include <deque>
 #include <memory>
 #include <optional>
+#include <vector>
 
 #include "events/event.h"
 #include "graphics/render_pass.h"
@@ -53,6 +55,21 @@ class Window
      */
     virtual std::optional<Event> pump_event() = 0;
 
+    /**
+     * Pump all pending user input events in one go. Events are appended, so the same vector can be cleared and reused
+     * each frame without allocating.
+     *
+     * The default implementation calls pump_event() until it is empty, platforms which can drain their native queue
+     * more cheaply override this.
+     *
+     * @param events
+     *   Collection to append events to.
+     *
+     * @returns
+     *   Number of events appended.
+     */
+    virtual std::size_t pump_events(std::vector<Event> &events);
+
     /**
      * Render the current scene.
      */
@@ -101,6 +118,15 @@ class Window
     std::chrono::milliseconds time() const;
 
   protected:
+    /**
+     * Stamp an event translated from the native queue with the current frame and report it to the LatencyTracker.
+     * Platforms call this for every event they pump, so only real user input is counted.
+     *
+     * @param event
+     *   Event to record.
+     */
+    static void record_input(Event &event);
+
     /** Window width. */
     std::uint32_t width_;
 
@@ -0,0 +1,26 @@
+////////////////////////////////////////////////////////////////////////////////
+//         Distributed under the Boost Software License, Version 1.0.         //
+//            (See accompanying file LICENSE or copy at                       //
+//                 https://www.boost.org/LICENSE_1_0.txt)                     //
+////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <iosfwd>
+
+namespace iris
+{
+
+/**
+ * Decode a binary log (as written by BinaryLogWriter) to text. Messages from all threads are written in timestamp
+ * order, one per line, in the same layout as BasicFormatter.
+ *
+ * @param in
+ *   Stream to read binary log from.
+ *
+ * @param out
+ *   Stream to write text log to.
+ */
+void decode_binary_log(std::istream &in, std::ostream &out);
+
+}
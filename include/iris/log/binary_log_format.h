@@ -0,0 +1,45 @@
+////////////////////////////////////////////////////////////////////////////////
+//         Distributed under the Boost Software License, Version 1.0.         //
+//            (See accompanying file LICENSE or copy at                       //
+//                 https://www.boost.org/LICENSE_1_0.txt)                     //
+////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <cstdint>
+
+namespace iris
+{
+
+/*
+ * Binary log file layout (all values are in host byte order):
+ *
+ *   header: magic (8 bytes), version (u32), steady clock start (u64 ns), system clock start (u64 ns)
+ *
+ *   followed by any number of blocks, each starting with a BinaryLogBlockType:
+ *
+ *     SITE:  id (u32), level (u32), engine (u8), line (i32), filename, tag, format (each u32 length then bytes),
+ *            flags (u8, bit 0 = dynamic tag, bit 1 = dynamic format)
+ *
+ *     CHUNK: thread id (u32), size (u32), then size bytes of records
+ *
+ *   a record is: site id (u32), steady clock timestamp (u64 ns), payload size (u32), then the payload which is the tag
+ *   (if dynamic) followed by each argument, each prefixed with a BinaryLogType.
+ */
+
+/** Magic bytes at the start of a binary log. */
+inline constexpr char binary_log_magic[8] = {'I', 'R', 'I', 'S', 'B', 'L', 'O', 'G'};
+
+/** Binary log format version. */
+inline constexpr std::uint32_t binary_log_version = 1u;
+
+/**
+ * Enumeration of blocks in a binary log.
+ */
+enum class BinaryLogBlockType : std::uint8_t
+{
+    SITE,
+    CHUNK
+};
+
+}
@@ -0,0 +1,36 @@
+////////////////////////////////////////////////////////////////////////////////
+//         Distributed under the Boost Software License, Version 1.0.         //
+//            (See accompanying file LICENSE or copy at                       //
+//                 https://www.boost.org/LICENSE_1_0.txt)                     //
+////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <cstdint>
+
+namespace iris
+{
+
+/**
+ * Enumeration of argument types that can be stored in a binary log. Each argument is prefixed with one of these.
+ */
+enum class BinaryLogType : std::uint8_t
+{
+    BOOL,
+    CHAR,
+    INT8,
+    UINT8,
+    INT16,
+    UINT16,
+    INT32,
+    UINT32,
+    INT64,
+    UINT64,
+    FLOAT,
+    DOUBLE,
+
+    /** Length (std::uint32_t) prefixed bytes. */
+    STRING
+};
+
+}
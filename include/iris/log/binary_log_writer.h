@@ -0,0 +1,444 @@
+////////////////////////////////////////////////////////////////////////////////
+//         Distributed under the Boost Software License, Version 1.0.         //
+//            (See accompanying file LICENSE or copy at                       //
+//                 https://www.boost.org/LICENSE_1_0.txt)                     //
+////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+#include "log/binary_log_type.h"
+#include "log/format.h"
+#include "log/log_site.h"
+
+namespace iris
+{
+
+namespace detail
+{
+
+/**
+ * Convert a log argument to something that can be written to a binary log. Arithmetic types and strings are written
+ * as is, anything else is formatted to a string (so still pays for formatting).
+ *
+ * @param value
+ *   Value to convert.
+ *
+ * @returns
+ *   Value to write.
+ */
+template <class T>
+auto to_binary_log_arg(const T &value)
+{
+    if constexpr (std::is_same_v<T, long double>)
+    {
+        return static_cast<double>(value);
+    }
+    else if constexpr (std::is_arithmetic_v<T>)
+    {
+        return value;
+    }
+    else if constexpr (std::is_pointer_v<T> && std::is_convertible_v<T, std::string_view>)
+    {
+        // match the text formatter, rather than taking the length of a null string
+        return value == nullptr ? std::string_view{"(null)"} : std::string_view{value};
+    }
+    else if constexpr (std::is_convertible_v<const T &, std::string_view>)
+    {
+        return std::string_view{value};
+    }
+    else
+    {
+        std::string str{};
+        format_arg(str, value);
+        return str;
+    }
+}
+
+/**
+ * Get the BinaryLogType for an arithmetic type.
+ *
+ * @returns
+ *   BinaryLogType for T.
+ */
+template <class T>
+constexpr BinaryLogType binary_log_type()
+{
+    if constexpr (std::is_same_v<T, bool>)
+    {
+        return BinaryLogType::BOOL;
+    }
+    else if constexpr (std::is_same_v<T, char>)
+    {
+        return BinaryLogType::CHAR;
+    }
+    else if constexpr (std::is_floating_point_v<T>)
+    {
+        return sizeof(T) == sizeof(float) ? BinaryLogType::FLOAT : BinaryLogType::DOUBLE;
+    }
+    else if constexpr (std::is_signed_v<T>)
+    {
+        constexpr BinaryLogType types[] = {
+            BinaryLogType::INT8, BinaryLogType::INT16, BinaryLogType::INT32, BinaryLogType::INT64};
+        return types[std::countr_zero(sizeof(T))];
+    }
+    else
+    {
+        constexpr BinaryLogType types[] = {
+            BinaryLogType::UINT8, BinaryLogType::UINT16, BinaryLogType::UINT32, BinaryLogType::UINT64};
+        return types[std::countr_zero(sizeof(T))];
+    }
+}
+
+}
+
+/**
+ * Class for writing log messages in a compact binary format, deferring all formatting to an offline decoder (see
+ * binary_log_decoder.h).
+ *
+ * Each message is recorded as its LogSite id, a timestamp and the raw bytes of its arguments into a lock-free buffer
+ * owned by the logging thread. A background thread periodically copies the buffers to file, along with the details of
+ * any newly seen LogSite. If a buffer is full the message is dropped.
+ *
+ * When a thread exits its buffer is handed to the next new logging thread, so memory is bounded by the number of
+ * concurrently logging threads. This means a thread id in the file identifies a buffer, which may have been written to
+ * by several short lived threads one after another.
+ */
+class BinaryLogWriter
+{
+  public:
+    /**
+     * Construct a new BinaryLogWriter.
+     *
+     * @param path
+     *   Path of file to write.
+     *
+     * @param thread_capacity
+     *   Size in bytes of each per-thread buffer, will be rounded up to a power of two.
+     */
+    explicit BinaryLogWriter(const std::filesystem::path &path, std::size_t thread_capacity = 1u << 20u);
+
+    /**
+     * Stop the background thread and write any buffered messages.
+     */
+    ~BinaryLogWriter();
+
+    BinaryLogWriter(const BinaryLogWriter &) = delete;
+    BinaryLogWriter &operator=(const BinaryLogWriter &) = delete;
+
+    /**
+     * Record a log message.
+     *
+     * @param site
+     *   Site of the log call. If the site has no format then the message is expected to have already been formatted
+     *   and be supplied as the only argument.
+     *
+     * @param tag
+     *   Tag of the message, only recorded if the site has no tag.
+     *
+     * @param args
+     *   Arguments for the site format.
+     */
+    template <class... Args>
+    void record(const LogSite &site, std::string_view tag, const Args &...args)
+    {
+        record_encoded(site, tag, detail::to_binary_log_arg(args)...);
+    }
+
+    /**
+     * Write all buffered messages to file.
+     */
+    void flush();
+
+    /**
+     * Write all buffered messages to file, unless another thread is already doing so.
+     *
+     * @returns
+     *   True if messages were written, false otherwise.
+     */
+    bool try_flush();
+
+    /**
+     * Get the number of messages dropped because a buffer was full.
+     *
+     * @returns
+     *   Number of dropped messages.
+     */
+    std::uint64_t dropped_count() const;
+
+  private:
+    /**
+     * Single-producer single-consumer byte ring buffer owned by a logging thread.
+     */
+    struct ThreadBuffer
+    {
+        /** Ring buffer storage. */
+        std::unique_ptr<std::byte[]> data;
+
+        /** Mask to wrap a position to an index. */
+        std::size_t mask;
+
+        /** Position the consumer will read from next. */
+        std::atomic<std::uint64_t> head;
+
+        /** Position after the last committed record. */
+        std::atomic<std::uint64_t> tail;
+
+        /** Position of the next byte to write, only used by the producer. */
+        std::uint64_t position;
+
+        /** Number of dropped messages. */
+        std::atomic<std::uint64_t> dropped;
+
+        /** Id of the owning thread. */
+        std::uint32_t thread_id;
+
+        /**
+         * Start writing a record.
+         *
+         * @param size
+         *   Size in bytes of the record.
+         *
+         * @returns
+         *   True if there is space for the record, false otherwise.
+         */
+        bool begin(std::size_t size)
+        {
+            position = tail.load(std::memory_order_relaxed);
+            return (mask + 1u) - (position - head.load(std::memory_order_acquire)) >= size;
+        }
+
+        /**
+         * Write bytes to the buffer.
+         *
+         * @param bytes
+         *   Bytes to write.
+         *
+         * @param size
+         *   Number of bytes to write.
+         */
+        void put(const void *bytes, std::size_t size)
+        {
+            const auto index = position & mask;
+            const auto first = std::min<std::size_t>(size, (mask + 1u) - index);
+
+            std::memcpy(data.get() + index, bytes, first);
+            std::memcpy(data.get(), static_cast<const std::byte *>(bytes) + first, size - first);
+
+            position += size;
+        }
+
+        /**
+         * Make the current record visible to the consumer.
+         */
+        void commit()
+        {
+            tail.store(position, std::memory_order_release);
+        }
+    };
+
+    /**
+     * Buffers whose thread has exited, most recently released last. This is shared with the thread local owners, as
+     * a thread may exit after the writer has been destroyed.
+     */
+    struct FreeBuffers
+    {
+        /** Released buffers. */
+        std::vector<ThreadBuffer *> buffers;
+
+        /** Lock for buffers. */
+        std::mutex mutex;
+    };
+
+    /**
+     * Thread local owner of a ThreadBuffer, which returns it to the writer when the thread exits.
+     */
+    struct ThreadBufferOwner
+    {
+        ~ThreadBufferOwner();
+
+        /**
+         * Return the owned buffer (if any) to its writer, if the writer still exists.
+         */
+        void release();
+
+        /** Id of the writer buffer belongs to. */
+        std::uint64_t writer_id = 0u;
+
+        /** Free list of the writer buffer belongs to. */
+        std::weak_ptr<FreeBuffers> free_buffers;
+
+        /** Owned buffer. */
+        ThreadBuffer *buffer = nullptr;
+    };
+
+    /**
+     * Get the size of an encoded argument.
+     *
+     * @param value
+     *   Argument.
+     *
+     * @returns
+     *   Encoded size in bytes.
+     */
+    template <class T>
+    static std::size_t encoded_size(const T &value)
+    {
+        if constexpr (std::is_arithmetic_v<T>)
+        {
+            return sizeof(BinaryLogType) + sizeof(T);
+        }
+        else
+        {
+            return sizeof(BinaryLogType) + sizeof(std::uint32_t) + std::string_view{value}.size();
+        }
+    }
+
+    /**
+     * Write an encoded argument.
+     *
+     * @param buffer
+     *   Buffer to write to.
+     *
+     * @param value
+     *   Argument.
+     */
+    template <class T>
+    static void encode(ThreadBuffer *buffer, const T &value)
+    {
+        if constexpr (std::is_arithmetic_v<T>)
+        {
+            const auto type = detail::binary_log_type<T>();
+            buffer->put(&type, sizeof(type));
+            buffer->put(&value, sizeof(value));
+        }
+        else
+        {
+            const std::string_view str{value};
+            const auto type = BinaryLogType::STRING;
+            const auto size = static_cast<std::uint32_t>(str.size());
+
+            buffer->put(&type, sizeof(type));
+            buffer->put(&size, sizeof(size));
+            buffer->put(str.data(), str.size());
+        }
+    }
+
+    /**
+     * Record a log message with arguments that have been converted with to_binary_log_arg.
+     *
+     * @param site
+     *   Site of the log call.
+     *
+     * @param tag
+     *   Tag of the message, only recorded if the site has no tag.
+     *
+     * @param args
+     *   Arguments for the site format.
+     */
+    template <class... Args>
+    void record_encoded(const LogSite &site, std::string_view tag, const Args &...args)
+    {
+        const auto dynamic_tag = site.tag == nullptr;
+        const auto payload_size =
+            static_cast<std::uint32_t>((dynamic_tag ? encoded_size(tag) : 0u) + (0u + ... + encoded_size(args)));
+
+        const auto timestamp = static_cast<std::uint64_t>(
+            std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch())
+                .count());
+
+        auto *buffer = thread_buffer();
+
+        if (!buffer->begin(sizeof(site.id) + sizeof(timestamp) + sizeof(payload_size) + payload_size))
+        {
+            buffer->dropped.fetch_add(1u, std::memory_order_relaxed);
+            return;
+        }
+
+        buffer->put(&site.id, sizeof(site.id));
+        buffer->put(&timestamp, sizeof(timestamp));
+        buffer->put(&payload_size, sizeof(payload_size));
+
+        if (dynamic_tag)
+        {
+            encode(buffer, tag);
+        }
+
+        (encode(buffer, args), ...);
+
+        buffer->commit();
+    }
+
+    /**
+     * Get the buffer for the calling thread, reusing the buffer of an exited thread or creating one if needed.
+     *
+     * @returns
+     *   Buffer for calling thread.
+     */
+    ThreadBuffer *thread_buffer();
+
+    /**
+     * Write any new sites and buffered messages to file. Caller must hold drain_mutex_.
+     */
+    void drain();
+
+    /**
+     * Background thread function.
+     */
+    void run();
+
+    /** Unique id of this writer, used to invalidate thread local buffer pointers. */
+    std::uint64_t id_;
+
+    /** Size of each thread buffer. */
+    std::size_t thread_capacity_;
+
+    /** File to write to. */
+    std::ofstream file_;
+
+    /** All thread buffers, buffers are never removed so outlive their threads. */
+    std::vector<std::unique_ptr<ThreadBuffer>> buffers_;
+
+    /** Buffers available for reuse. */
+    std::shared_ptr<FreeBuffers> free_buffers_;
+
+    /** Lock for buffers_. */
+    mutable std::mutex buffers_mutex_;
+
+    /** Lock for draining buffers to file. */
+    std::mutex drain_mutex_;
+
+    /** Number of sites written to file. */
+    std::size_t sites_written_;
+
+    /** Flag indicating whether the background thread should keep running. */
+    bool running_;
+
+    /** Lock for running_. */
+    std::mutex running_mutex_;
+
+    /** Used to wake the background thread when stopping. */
+    std::condition_variable running_cv_;
+
+    /** Background thread. */
+    std::thread thread_;
+};
+
+}
@@ -7,6 +7,7 @@
 #pragma once
 
 #include <string>
+#include <string_view>
 
 #include "log/basic_formatter.h"
 #include "log/formatter.h"
@@ -25,7 +26,10 @@ class ColourFormatter : public Formatter
     ~ColourFormatter() override = default;
 
     /**
-     * Format the supplied log details into a string.
+     * Format the supplied log details, appending them to a string.
+     *
+     * @param out
+     *   String to append to.
      *
      * @param level
      *   Log level.
@@ -42,11 +46,12 @@ class ColourFormatter : public Formatter
      * @param line
      *   Line of the log call in the file.
      */
-    std::string format(
+    void format(
+        std::string &out,
         const LogLevel level,
-        const std::string &tag,
-        const std::string &message,
-        const std::string &filename,
+        std::string_view tag,
+        std::string_view message,
+        std::string_view filename,
         const int line) override;
 
   private:
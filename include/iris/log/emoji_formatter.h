@@ -7,6 +7,7 @@
 #pragma once
 
 #include <string>
+#include <string_view>
 
 #include "log/basic_formatter.h"
 #include "log/formatter.h"
@@ -26,7 +27,10 @@ class EmojiFormatter : public Formatter
     ~EmojiFormatter() override = default;
 
     /**
-     * Format the supplied log details into a string.
+     * Format the supplied log details, appending them to a string.
+     *
+     * @param out
+     *   String to append to.
      *
      * @param level
      *   Log level.
@@ -43,11 +47,12 @@ class EmojiFormatter : public Formatter
      * @param line
      *   Line of the log call in the file.
      */
-    std::string format(
+    void format(
+        std::string &out,
         const LogLevel level,
-        const std::string &tag,
-        const std::string &message,
-        const std::string &filename,
+        std::string_view tag,
+        std::string_view message,
+        std::string_view filename,
         const int line) override;
 
   private:
@@ -39,6 +39,11 @@ class FileOutputter : public Outputter
      */
     void output(const std::string &log) override;
 
+    /**
+     * Flush buffered output.
+     */
+    void flush() override;
+
   private:
     /** File stream to write to. */
     std::ofstream file_;
@@ -0,0 +1,29 @@
+////////////////////////////////////////////////////////////////////////////////
+//         Distributed under the Boost Software License, Version 1.0.         //
+//            (See accompanying file LICENSE or copy at                       //
+//                 https://www.boost.org/LICENSE_1_0.txt)                     //
+////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <cstdint>
+
+namespace iris
+{
+
+/**
+ * Enumeration of ways RotatingFileOutputter can write to disk.
+ */
+enum class FileWriteMode : std::uint8_t
+{
+    /** Buffer in user space then write() full buffers. */
+    BUFFERED,
+
+    /** As BUFFERED but bypassing the OS page cache (O_DIRECT on linux, F_NOCACHE on macOS). Not supported on win32. */
+    DIRECT,
+
+    /** Copy directly into a memory mapped window of the file. Not supported on win32. */
+    MAPPED
+};
+
+}
@@ -0,0 +1,292 @@
+////////////////////////////////////////////////////////////////////////////////
+//         Distributed under the Boost Software License, Version 1.0.         //
+//            (See accompanying file LICENSE or copy at                       //
+//                 https://www.boost.org/LICENSE_1_0.txt)                     //
+////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <charconv>
+#include <concepts>
+#include <cstddef>
+#include <cstdio>
+#include <ostream>
+#include <streambuf>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <version>
+
+namespace iris
+{
+
+/**
+ * Wrapper for a format string that is only known at runtime, and so can't be checked at compile time. Create with
+ * runtime_format().
+ */
+struct RuntimeFormat
+{
+    /** Format string. */
+    std::string_view str;
+};
+
+/**
+ * Mark a format string as only known at runtime. Placeholders without an argument are written as is and arguments
+ * without a placeholder are ignored.
+ *
+ * @param str
+ *   Format string.
+ *
+ * @returns
+ *   RuntimeFormat for string.
+ */
+inline RuntimeFormat runtime_format(std::string_view str)
+{
+    return {str};
+}
+
+namespace detail
+{
+
+/** Pattern replaced with an argument when formatting. */
+inline constexpr std::string_view format_pattern{"{}"};
+
+/**
+ * Count the number of placeholders in a format string.
+ *
+ * @param str
+ *   Format string.
+ *
+ * @returns
+ *   Number of '{}' in str.
+ */
+constexpr std::size_t count_placeholders(std::string_view str)
+{
+    std::size_t count = 0u;
+
+    for (auto pos = str.find(format_pattern); pos != std::string_view::npos;
+         pos = str.find(format_pattern, pos + format_pattern.size()))
+    {
+        ++count;
+    }
+
+    return count;
+}
+
+/**
+ * Stream buffer which appends to a std::string, used to format types which only provide operator<< without an
+ * intermediate std::stringstream.
+ */
+class StringAppendBuffer : public std::streambuf
+{
+  public:
+    /**
+     * Set the string to append to.
+     *
+     * @param out
+     *   String to append to.
+     */
+    void set_output(std::string *out)
+    {
+        out_ = out;
+    }
+
+  protected:
+    int_type overflow(int_type c) override
+    {
+        if (!traits_type::eq_int_type(c, traits_type::eof()))
+        {
+            out_->push_back(traits_type::to_char_type(c));
+        }
+
+        return c;
+    }
+
+    std::streamsize xsputn(const char *s, std::streamsize count) override
+    {
+        out_->append(s, static_cast<std::size_t>(count));
+        return count;
+    }
+
+  private:
+    /** String to append to. */
+    std::string *out_ = nullptr;
+};
+
+/**
+ * Append a single value to a string, with the same output as writing it to a std::ostream.
+ *
+ * @param out
+ *   String to append to.
+ *
+ * @param value
+ *   Value to append.
+ */
+template <class T>
+void format_arg(std::string &out, const T &value)
+{
+    if constexpr (std::is_same_v<T, bool>)
+    {
+        out.push_back(value ? '1' : '0');
+    }
+    else if constexpr (
+        std::is_same_v<T, char> || std::is_same_v<T, signed char> || std::is_same_v<T, unsigned char>)
+    {
+        out.push_back(static_cast<char>(value));
+    }
+    else if constexpr (std::is_integral_v<T>)
+    {
+        char buffer[24];
+        const auto result = std::to_chars(std::begin(buffer), std::end(buffer), value);
+        out.append(buffer, result.ptr);
+    }
+    else if constexpr (std::is_floating_point_v<T>)
+    {
+        // general format with a precision of 6 matches the default std::ostream formatting, fallback to snprintf
+        // where floating point to_chars is not available
+        char buffer[64];
+#if defined(__cpp_lib_to_chars)
+        const auto result = std::to_chars(std::begin(buffer), std::end(buffer), value, std::chars_format::general, 6);
+        out.append(buffer, result.ptr);
+#else
+        const auto length = std::snprintf(buffer, sizeof(buffer), "%Lg", static_cast<long double>(value));
+        out.append(buffer, static_cast<std::size_t>(length));
+#endif
+    }
+    else if constexpr (std::is_pointer_v<T> && std::is_convertible_v<T, std::string_view>)
+    {
+        out.append(value == nullptr ? std::string_view{"(null)"} : std::string_view{value});
+    }
+    else if constexpr (std::is_convertible_v<const T &, std::string_view>)
+    {
+        out.append(std::string_view{value});
+    }
+    else
+    {
+        thread_local StringAppendBuffer buffer{};
+        thread_local std::ostream strm{&buffer};
+
+        buffer.set_output(&out);
+        strm << value;
+    }
+}
+
+/**
+ * Append the format string up to the next placeholder, then the supplied value. If there are no more placeholders
+ * then nothing is written.
+ *
+ * @param out
+ *   String to append to.
+ *
+ * @param format
+ *   Format string.
+ *
+ * @param pos
+ *   [in/out] Position in format to search from, updated to be after the placeholder.
+ *
+ * @param value
+ *   Value to append.
+ */
+template <class T>
+void format_next(std::string &out, std::string_view format, std::size_t &pos, const T &value)
+{
+    if (const auto next = format.find(format_pattern, pos); next != std::string_view::npos)
+    {
+        out.append(format.substr(pos, next - pos));
+        format_arg(out, value);
+        pos = next + format_pattern.size();
+    }
+}
+
+}
+
+/**
+ * A format string which is checked at compile time to have one placeholder ('{}') for each argument. Implicitly
+ * constructed from a string literal (or from RuntimeFormat to skip the check).
+ */
+template <class... Args>
+class FormatString
+{
+  public:
+    /**
+     * Construct a new FormatString, failing to compile if the number of placeholders doesn't match the number of
+     * arguments.
+     *
+     * @param str
+     *   Format string.
+     */
+    template <class T>
+        requires std::convertible_to<const T &, std::string_view>
+    consteval FormatString(const T &str)
+        : str_(str)
+    {
+        if (detail::count_placeholders(str_) != sizeof...(Args))
+        {
+            // not a constant expression, so is reported as a compile error
+            throw "number of {} in format string does not match number of arguments";
+        }
+    }
+
+    /**
+     * Construct a new FormatString from a string only known at runtime.
+     *
+     * @param str
+     *   Format string.
+     */
+    FormatString(RuntimeFormat str)
+        : str_(str.str)
+    {
+    }
+
+    /**
+     * Get format string.
+     *
+     * @returns
+     *   Format string.
+     */
+    constexpr std::string_view get() const
+    {
+        return str_;
+    }
+
+  private:
+    /** Format string. */
+    std::string_view str_;
+};
+
+/**
+ * Append a formatted string, each '{}' is replaced with the next argument.
+ *
+ * @param out
+ *   String to append to.
+ *
+ * @param format
+ *   Format string.
+ *
+ * @param args
+ *   Arguments to format.
+ */
+template <class... Args>
+void format_to(std::string &out, FormatString<std::type_identity_t<Args>...> format, const Args &...args)
+{
+    std::size_t pos = 0u;
+    (detail::format_next(out, format.get(), pos, args), ...);
+
+    out.append(format.get().substr(pos));
+}
+
+/**
+ * Get a reusable per-thread buffer for formatting log messages, avoiding an allocation per message.
+ *
+ * @returns
+ *   Cleared thread local buffer.
+ */
+inline std::string &format_buffer()
+{
+    thread_local std::string buffer{};
+
+    buffer.clear();
+    return buffer;
+}
+
+}
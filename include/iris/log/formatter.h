@@ -7,6 +7,7 @@
 #pragma once
 
 #include <string>
+#include <string_view>
 
 #include "log/log_level.h"
 
@@ -24,7 +25,10 @@ class Formatter
     virtual ~Formatter() = default;
 
     /**
-     * Format the supplied log details into a string.
+     * Format the supplied log details, appending them to a string.
+     *
+     * @param out
+     *   String to append to.
      *
      * @param level
      *   Log level.
@@ -41,11 +45,12 @@ class Formatter
      * @param line
      *   Line of the log call in the file.
      */
-    virtual std::string format(
+    virtual void format(
+        std::string &out,
         const LogLevel level,
-        const std::string &tag,
-        const std::string &message,
-        const std::string &filename,
+        std::string_view tag,
+        std::string_view message,
+        std::string_view filename,
         const int line) = 0;
 };
 
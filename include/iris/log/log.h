@@ -7,38 +7,48 @@
 #pragma once
 
 #include "log/log_level.h"
+#include "log/log_site.h"
 #include "log/logger.h"
 
-#if !defined(NDEBUG)
-
-// convenient macros for logging
-#define LOG_DEBUG(T, ...) iris::Logger::instance().log(iris::LogLevel::DEBUG, T, __FILE__, __LINE__, false, __VA_ARGS__)
-#define LOG_INFO(T, ...) iris::Logger::instance().log(iris::LogLevel::INFO, T, __FILE__, __LINE__, false, __VA_ARGS__)
-#define LOG_WARN(T, ...) iris::Logger::instance().log(iris::LogLevel::WARN, T, __FILE__, __LINE__, false, __VA_ARGS__)
-#define LOG_ERROR(T, ...) iris::Logger::instance().log(iris::LogLevel::ERR, T, __FILE__, __LINE__, false, __VA_ARGS__)
+// IRIS_LOG_MIN_LEVEL sets the minimum level of log macro compiled in, anything below it expands to nothing so has no
+// runtime cost. Values match LogLevel: 0 = DEBUG, 1 = INFO, 2 = WARN, 3 = ERR, 4 = none.
+#if !defined(IRIS_LOG_MIN_LEVEL)
+#define IRIS_LOG_MIN_LEVEL 0
+#endif
 
-// convenient macros for engine logging
-#define LOG_ENGINE_DEBUG(T, ...)                                                                                       \
-    iris::Logger::instance().log(iris::LogLevel::DEBUG, T, __FILE__, __LINE__, true, __VA_ARGS__)
-#define LOG_ENGINE_INFO(T, ...)                                                                                        \
-    iris::Logger::instance().log(iris::LogLevel::INFO, T, __FILE__, __LINE__, true, __VA_ARGS__)
-#define LOG_ENGINE_WARN(T, ...)                                                                                        \
-    iris::Logger::instance().log(iris::LogLevel::WARN, T, __FILE__, __LINE__, true, __VA_ARGS__)
-#define LOG_ENGINE_ERROR(T, ...)                                                                                       \
-    iris::Logger::instance().log(iris::LogLevel::ERR, T, __FILE__, __LINE__, true, __VA_ARGS__)
+// each log macro creates a static LogSite, which registers the tag and format with the logger the first time it runs
+#define IRIS_LOG_FIRST(F, ...) F
+#define IRIS_LOG(LEVEL, ENGINE, T, ...)                                                                                \
+    iris::Logger::instance().log(IRIS_LOG_SITE(LEVEL, ENGINE, T, IRIS_LOG_FIRST(__VA_ARGS__)), T, __VA_ARGS__)
 
+#if !defined(NDEBUG) && (IRIS_LOG_MIN_LEVEL <= 0)
+#define LOG_DEBUG(T, ...) IRIS_LOG(iris::LogLevel::DEBUG, false, T, __VA_ARGS__)
+#define LOG_ENGINE_DEBUG(T, ...) IRIS_LOG(iris::LogLevel::DEBUG, true, T, __VA_ARGS__)
 #else
-
-// convenient macros for logging
 #define LOG_DEBUG(T, ...)
-#define LOG_INFO(T, ...)
-#define LOG_WARN(T, ...)
-#define LOG_ERROR(T, ...)
-
-// convenient macros for engine logging
 #define LOG_ENGINE_DEBUG(T, ...)
+#endif
+
+#if !defined(NDEBUG) && (IRIS_LOG_MIN_LEVEL <= 1)
+#define LOG_INFO(T, ...) IRIS_LOG(iris::LogLevel::INFO, false, T, __VA_ARGS__)
+#define LOG_ENGINE_INFO(T, ...) IRIS_LOG(iris::LogLevel::INFO, true, T, __VA_ARGS__)
+#else
+#define LOG_INFO(T, ...)
 #define LOG_ENGINE_INFO(T, ...)
+#endif
+
+#if !defined(NDEBUG) && (IRIS_LOG_MIN_LEVEL <= 2)
+#define LOG_WARN(T, ...) IRIS_LOG(iris::LogLevel::WARN, false, T, __VA_ARGS__)
+#define LOG_ENGINE_WARN(T, ...) IRIS_LOG(iris::LogLevel::WARN, true, T, __VA_ARGS__)
+#else
+#define LOG_WARN(T, ...)
 #define LOG_ENGINE_WARN(T, ...)
-#define LOG_ENGINE_ERROR(T, ...)
+#endif
 
+#if !defined(NDEBUG) && (IRIS_LOG_MIN_LEVEL <= 3)
+#define LOG_ERROR(T, ...) IRIS_LOG(iris::LogLevel::ERR, false, T, __VA_ARGS__)
+#define LOG_ENGINE_ERROR(T, ...) IRIS_LOG(iris::LogLevel::ERR, true, T, __VA_ARGS__)
+#else
+#define LOG_ERROR(T, ...)
+#define LOG_ENGINE_ERROR(T, ...)
 #endif
@@ -0,0 +1,26 @@
+////////////////////////////////////////////////////////////////////////////////
+//         Distributed under the Boost Software License, Version 1.0.         //
+//            (See accompanying file LICENSE or copy at                       //
+//                 https://www.boost.org/LICENSE_1_0.txt)                     //
+////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <cstdint>
+
+namespace iris
+{
+
+/**
+ * Enumeration of what an asynchronous logger should do when its queue is full.
+ */
+enum class LogOverflowPolicy : std::uint8_t
+{
+    /** Discard the log message, the number of dropped messages is reported once there is space. */
+    DROP,
+
+    /** Block the logging thread until there is space in the queue. */
+    BLOCK
+};
+
+}
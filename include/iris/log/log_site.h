@@ -0,0 +1,181 @@
+////////////////////////////////////////////////////////////////////////////////
+//         Distributed under the Boost Software License, Version 1.0.         //
+//            (See accompanying file LICENSE or copy at                       //
+//                 https://www.boost.org/LICENSE_1_0.txt)                     //
+////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <vector>
+
+#include "core/string_id.h"
+#include "log/log_level.h"
+
+namespace iris
+{
+
+/**
+ * Static description of a single log call site. One of these is created (as a function local static) by each of the
+ * LOG_* macros the first time it runs, which allows the binary logger to record a small id rather than the strings.
+ *
+ * The tag and format are only stored if they are string literals, otherwise they are null and the binary logger
+ * records them with each message instead.
+ */
+struct LogSite
+{
+    /**
+     * Construct and register a new LogSite.
+     *
+     * @param level
+     *   Log level.
+     *
+     * @param engine
+     *   True if this is an internal engine log call.
+     *
+     * @param filename
+     *   Name of the file containing the call.
+     *
+     * @param line
+     *   Line of the call.
+     *
+     * @param tag
+     *   Tag string literal, or null if the tag is not a literal.
+     *
+     * @param format
+     *   Format string literal, or null if the format is not a literal.
+     */
+    LogSite(LogLevel level, bool engine, const char *filename, int line, const char *tag, const char *format);
+
+    LogSite(const LogSite &) = delete;
+    LogSite &operator=(const LogSite &) = delete;
+
+    /** Log level. */
+    LogLevel level;
+
+    /** Whether this is an internal engine log call. */
+    bool engine;
+
+    /** Name of the file containing the call. */
+    const char *filename;
+
+    /** Line of the call. */
+    int line;
+
+    /** Tag string literal, null if dynamic. */
+    const char *tag;
+
+    /** Id of tag, only valid if tag is not null. */
+    StringId tag_id;
+
+    /** Format string literal, null if dynamic. */
+    const char *format;
+
+    /** Unique id of this site. */
+    std::uint32_t id;
+};
+
+/**
+ * Singleton registry of all LogSite objects, indexed by their id.
+ */
+class LogSiteRegistry
+{
+  public:
+    /**
+     * Get single instance of LogSiteRegistry.
+     *
+     * @returns
+     *   LogSiteRegistry single instance.
+     */
+    static LogSiteRegistry &instance();
+
+    /**
+     * Register a site.
+     *
+     * @param site
+     *   Site to register, must outlive the registry.
+     *
+     * @returns
+     *   Id of the site.
+     */
+    std::uint32_t add(const LogSite *site);
+
+    /**
+     * Get registered sites.
+     *
+     * @param first
+     *   Id of first site to get.
+     *
+     * @returns
+     *   All sites with an id equal to or greater than first.
+     */
+    std::vector<const LogSite *> sites(std::size_t first) const;
+
+  private:
+    /** Registered sites, index is id. */
+    std::vector<const LogSite *> sites_;
+
+    /** Lock for sites. */
+    mutable std::mutex mutex_;
+};
+
+namespace detail
+{
+
+/**
+ * Get a string literal for storing in a LogSite. This is consteval so only strings with static storage can be stored,
+ * passing a local const array fails to compile.
+ *
+ * @param str
+ *   String literal.
+ *
+ * @returns
+ *   Supplied literal.
+ */
+template <std::size_t N>
+consteval const char *log_site_literal(const char (&str)[N])
+{
+    return str;
+}
+
+/**
+ * Overload for mutable arrays, which can't be stored in a LogSite as their contents may change between calls.
+ *
+ * @returns
+ *   nullptr.
+ */
+template <std::size_t N>
+constexpr const char *log_site_literal(char (&)[N])
+{
+    return nullptr;
+}
+
+/**
+ * Overload for anything that isn't a string literal, which can't be stored in a LogSite as it may change (or be
+ * destroyed) between calls.
+ *
+ * @returns
+ *   nullptr.
+ */
+template <class T>
+constexpr const char *log_site_literal(const T &)
+{
+    return nullptr;
+}
+
+}
+
+}
+
+/**
+ * Expands to a reference to a LogSite for the current call site. The tag and message are checked for being literals
+ * at the call site (as inside the lambda they are just references), but only used to initialise the site the first time
+ * the call runs.
+ */
+#define IRIS_LOG_SITE(LEVEL, ENGINE, T, MESSAGE)                                                                       \
+    [](const char *tag, const char *format) -> const iris::LogSite & {                                                 \
+        static const iris::LogSite site{LEVEL, ENGINE, __FILE__, __LINE__, tag, format};                               \
+        return site;                                                                                                   \
+    }(iris::detail::log_site_literal(T), iris::detail::log_site_literal(MESSAGE))
@@ -6,123 +6,30 @@
 
 #pragma once
 
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
 #include <iostream>
 #include <iterator>
 #include <memory>
 #include <mutex>
-#include <set>
-#include <sstream>
 #include <string>
+#include <string_view>
 #include <type_traits>
+#include <unordered_set>
 
+#include "core/string_id.h"
+#include "log/binary_log_writer.h"
 #include "log/colour_formatter.h"
+#include "log/format.h"
 #include "log/log_level.h"
+#include "log/log_overflow_policy.h"
+#include "log/log_site.h"
 #include "log/stdout_outputter.h"
 
 namespace iris
 {
 
-namespace detail
-{
-
-/**
- * Helper function to write a string to a stream. Writes from the supplied
- * position to the first occurrence of '{}' (which is replaced by supplied
- * object). If '{}' is not found then nothing is written.
- *
- * @param format_str
- *   The format string to write.
- *
- * @param obj
- *   The object to write.
- *
- * @param pos
- *   [in/out] On function enter this is the position to start searching in
- *   format_str for '{}'. On exit in the position in format_str after the '{}'.
- *   If no '{}' is found in the string then it is std::string::npos.
- *
- * @param strm
- *   The stream to write to.
- */
-template <class T>
-void format(const std::string &format_str, T &&obj, std::size_t &pos, std::stringstream &strm)
-{
-    static const std::string format_pattern{"{}"};
-
-    const auto current_pos = pos;
-
-    // find the pattern
-    pos = format_str.find(format_pattern, pos);
-    if (pos != std::string::npos)
-    {
-        // write the string up to the pattern then the supplied object
-        strm << format_str.substr(current_pos, pos - current_pos) << obj;
-
-        // move position passed the format
-        pos += format_pattern.length();
-    }
-}
-
-/**
- * Base case for variadic template unpacking.
- *
- * @param message
- *   Format string message.
- *
- * @param pos
- *   [in/out] On function enter this is the position to start searching in
- *   format_str for '{}'. On exit in the position in format_str after the '{}'.
- *   If no '{}' is found in the string then it is std::string::npos.
- *
- * @param strm
- *   The stream to write to.
- *
- * @param head
- *   The object to write.
- */
-template <class Head>
-void unpack(const std::string &message, std::size_t &pos, std::stringstream &strm, Head &&head)
-{
-    // write object to stream (if '{}' is in message)
-    format(message, head, pos, strm);
-
-    // we have no more args to write to stream, so write the remainder of the
-    // message to the string (if there is any left)
-    if (pos != std::string::npos)
-    {
-        strm << message.substr(pos);
-    }
-}
-
-/**
- * Variadic template argument unpacker.
- *
- * @param message
- *   Format string message.
- *
- * @param pos
- *   [in/out] On function enter this is the position to start searching in
- *   format_str for '{}'. On exit in the position in format_str after the '{}'.
- *   If no '{}' is found in the string then it is std::string::npos.
- *
- * @param strm
- *   The stream to write to.
- *
- * @param head
- *   Current object to write.
- *
- * @param args
- *   Remaining arguments
- */
-template <class Head, class... Tail>
-void unpack(const std::string &message, std::size_t &pos, std::stringstream &strm, Head &&head, Tail &&...tail)
-{
-    format(message, std::forward<Head>(head), pos, strm);
-    unpack(message, pos, strm, std::forward<Tail>(tail)...);
-}
-
-}
-
 /**
  * Singleton class for logging. Formatting and outputting are controlled via
  * settable classes, by default uses colour formatting and outputs to stdout.
@@ -138,6 +45,17 @@ void unpack(const std::string &message, std::size_t &pos, std::stringstream &str
  * respectively (feel free to decide what constitutes as a warning and error).
  * Debug should be used for the log messages you use to diagnose a bug and will
  * probably later delete.
+ *
+ * By default messages are formatted and output on the calling thread. In
+ * asynchronous mode messages are instead pushed on to a bounded lock-free
+ * queue and a background thread formats and outputs them in batches, so
+ * logging threads never wait on I/O. Queue slots keep their storage between
+ * messages, and the background thread sleeps until there is work or an
+ * outputter's deferred flush is due.
+ *
+ * In binary mode messages from the LOG_* macros aren't formatted at all, the
+ * id of the call site and the raw arguments are recorded and formatting is
+ * done offline by a decoder (see binary_log_decoder.h).
  */
 class Logger
 {
@@ -154,6 +72,12 @@ class Logger
         return logger;
     }
 
+    /**
+     * Stops the asynchronous writer (if running), writing any queued
+     * messages.
+     */
+    ~Logger();
+
     Logger(const Logger &) = delete;
     Logger &operator=(const Logger &) = delete;
     Logger(Logger &&) = delete;
@@ -170,7 +94,7 @@ class Logger
      */
     void ignore_tag(const std::string &tag)
     {
-        ignore_.emplace(tag);
+        ignore_.emplace(StringId::intern(tag));
     }
 
     /**
@@ -185,10 +109,7 @@ class Logger
      */
     void show_tag(const std::string &tag)
     {
-        if (const auto find = ignore_.find(tag); find != std::cend(ignore_))
-        {
-            ignore_.erase(find);
-        }
+        ignore_.erase(StringId{tag});
     }
 
     /**
@@ -215,6 +136,51 @@ class Logger
         log_engine_ = log_engine;
     }
 
+    /**
+     * Check if a log message would be processed. This is cheap and is done
+     * before any message formatting.
+     *
+     * @param level
+     *   Log level.
+     *
+     * @param tag
+     *   Tag for log message.
+     *
+     * @param engine
+     *   True if this log message is from the internal engine, false
+     *   otherwise.
+     *
+     * @returns
+     *   True if a message with the supplied properties would be processed.
+     */
+    bool is_enabled(const LogLevel level, std::string_view tag, const bool engine) const
+    {
+        return (!engine || log_engine_) && (level >= min_level_) &&
+               (ignore_.empty() || !ignore_.contains(StringId{tag}));
+    }
+
+    /**
+     * Check if a log message would be processed. This is cheap and is done
+     * before any message formatting.
+     *
+     * @param level
+     *   Log level.
+     *
+     * @param tag
+     *   Id of tag for log message.
+     *
+     * @param engine
+     *   True if this log message is from the internal engine, false
+     *   otherwise.
+     *
+     * @returns
+     *   True if a message with the supplied properties would be processed.
+     */
+    bool is_enabled(const LogLevel level, StringId tag, const bool engine) const
+    {
+        return (!engine || log_engine_) && (level >= min_level_) && (ignore_.empty() || !ignore_.contains(tag));
+    }
+
     /**
      * Set the Formatter class.
      *
@@ -226,7 +192,10 @@ class Logger
     template <class T, class... Args, typename = std::enable_if_t<std::is_base_of<Formatter, T>::value>>
     void set_Formatter(Args &&...args)
     {
-        formatter_ = std::make_unique<T>(std::forward<Args>(args)...);
+        auto formatter = std::make_unique<T>(std::forward<Args>(args)...);
+
+        std::unique_lock lock(mutex_);
+        formatter_ = std::move(formatter);
     }
 
     /**
@@ -240,9 +209,81 @@ class Logger
     template <class T, class... Args, typename = std::enable_if_t<std::is_base_of<Outputter, T>::value>>
     void set_Outputter(Args &&...args)
     {
-        outputter_ = std::make_unique<T>(std::forward<Args>(args)...);
+        auto outputter = std::make_unique<T>(std::forward<Args>(args)...);
+
+        std::unique_lock lock(mutex_);
+        outputter_ = std::move(outputter);
     }
 
+    /**
+     * Enable or disable asynchronous logging. Enabling starts a background
+     * writer thread, disabling writes any queued messages and stops it.
+     *
+     * This should be called before logging from multiple threads.
+     *
+     * @param async
+     *   True to log asynchronously, false to log on the calling thread.
+     *
+     * @param queue_capacity
+     *   Maximum number of queued messages (rounded up to a power of two).
+     *
+     * @param policy
+     *   What to do when the queue is full.
+     */
+    void set_async(
+        bool async,
+        std::size_t queue_capacity = 8192u,
+        LogOverflowPolicy policy = LogOverflowPolicy::DROP);
+
+    /**
+     * Enable or disable binary logging. When enabled messages logged via the
+     * LOG_* macros are written to the supplied file in binary form, rather
+     * than formatted and passed to the Outputter.
+     *
+     * This should be called before logging from multiple threads.
+     *
+     * @param path
+     *   Path of file to write, empty to disable binary logging.
+     *
+     * @param thread_capacity
+     *   Size in bytes of the per-thread buffers.
+     */
+    void set_binary_output(const std::filesystem::path &path, std::size_t thread_capacity = 1u << 20u);
+
+    /**
+     * Block until all messages logged by the calling thread have been
+     * written and flushed.
+     */
+    void flush();
+
+    /**
+     * Get the number of messages dropped because the asynchronous queue (or
+     * a binary log buffer) was full.
+     *
+     * @returns
+     *   Number of dropped messages.
+     */
+    std::uint64_t dropped_count() const;
+
+    /**
+     * Install handlers for fatal signals and std::terminate which flush any
+     * queued messages before the process dies. This is best effort, flushing
+     * is not async-signal-safe so output may be lost if the process crashed
+     * inside the logger.
+     */
+    static void install_crash_handler();
+
+    /**
+     * Flush as much as possible without blocking indefinitely, for use when
+     * the process is about to die. Called by the crash handlers.
+     *
+     * The writer is given a bounded amount of time to drain the queue, unless
+     * it is the calling thread. Nothing is flushed if the calling thread holds
+     * the logger lock, otherwise buffered output is only written if the lock
+     * can be taken without blocking.
+     */
+    void flush_on_crash();
+
     /**
      * Log a message. This function handles the case where no arguments
      * are supplied i.e. just a log message.
@@ -268,22 +309,16 @@ class Logger
      */
     void log(
         const LogLevel level,
-        const std::string &tag,
-        const std::string &filename,
+        std::string_view tag,
+        std::string_view filename,
         const int line,
         const bool engine,
-        const std::string &message)
+        std::string_view message)
     {
         // check if we want to process this log message
-        if ((!engine || log_engine_) && (level >= min_level_) && (ignore_.find(tag) == std::cend(ignore_)))
+        if (is_enabled(level, tag, engine))
         {
-            std::stringstream strm{};
-            strm << message;
-
-            const auto log = formatter_->format(level, tag, strm.str(), filename, line);
-
-            std::unique_lock lock(mutex_);
-            outputter_->output(log);
+            write(level, tag, filename, line, message);
         }
     }
 
@@ -308,7 +343,8 @@ class Logger
      *   otherwise.
      *
      * @param message
-     *   Log message.
+     *   Log message, must have one '{}' per argument (checked at compile
+     *   time unless wrapped with runtime_format()).
      *
      * @param args
      *   Variadic list of arguments for log formatting.
@@ -316,33 +352,132 @@ class Logger
     template <class... Args>
     void log(
         const LogLevel level,
-        const std::string &tag,
-        const std::string &filename,
+        std::string_view tag,
+        std::string_view filename,
         const int line,
         const bool engine,
-        const std::string &message,
-        Args &&...args)
+        FormatString<std::type_identity_t<Args>...> message,
+        const Args &...args)
     {
-        std::stringstream strm{};
+        // filter before formatting, so disabled messages don't pay for it
+        if (!is_enabled(level, tag, engine))
+        {
+            return;
+        }
 
-        // apply string formatting
-        std::size_t pos = 0u;
-        detail::unpack(message, pos, strm, std::forward<Args>(args)...);
+        auto &buffer = format_buffer();
+        format_to(buffer, message, args...);
 
-        log(level, tag, filename, line, engine, strm.str());
+        write(level, tag, filename, line, buffer);
+    }
+
+    /**
+     * Log a message from a known call site, this is what the LOG_* macros
+     * use.
+     *
+     * @param site
+     *   Site of the log call.
+     *
+     * @param tag
+     *   Tag for log message.
+     *
+     * @param message
+     *   Log message, must have one '{}' per argument (checked at compile
+     *   time unless wrapped with runtime_format()).
+     *
+     * @param args
+     *   Variadic list of arguments for log formatting.
+     */
+    template <class... Args>
+    void log(
+        const LogSite &site,
+        std::string_view tag,
+        FormatString<std::type_identity_t<Args>...> message,
+        const Args &...args)
+    {
+        // filter before formatting, so disabled messages don't pay for it, literal tags are hashed once per site
+        if (!is_enabled(site.level, site.tag != nullptr ? site.tag_id : StringId{tag}, site.engine))
+        {
+            return;
+        }
+
+        // if the format isn't a literal then the decoder won't know it, so we have to format now
+        if (binary_ && (site.format != nullptr))
+        {
+            binary_->record(site, tag, args...);
+            return;
+        }
+
+        auto &buffer = format_buffer();
+        format_to(buffer, message, args...);
+
+        if (binary_)
+        {
+            binary_->record(site, tag, std::string_view{buffer});
+        }
+        else
+        {
+            write(site.level, tag, site.filename, site.line, buffer);
+        }
     }
 
   private:
     /**
      * Construct a new logger.
      */
-    Logger()
-        : formatter_(std::make_unique<ColourFormatter>())
-        , outputter_(std::make_unique<StdoutFormatter>())
-        , ignore_()
-        , min_level_(LogLevel::DEBUG)
-        , log_engine_(false)
-        , mutex_(){};
+    Logger();
+
+    /**
+     * Internal struct for asynchronous logging state.
+     */
+    struct AsyncState;
+
+    /**
+     * Write a formatted message, either directly or via the asynchronous
+     * queue.
+     *
+     * @param level
+     *   Log level.
+     *
+     * @param tag
+     *   Tag for log message.
+     *
+     * @param filename
+     *   Name of the file logging the message.
+     *
+     * @param line
+     *   Line of the log call in the file.
+     *
+     * @param message
+     *   Log message.
+     */
+    void write(LogLevel level, std::string_view tag, std::string_view filename, int line, std::string_view message);
+
+    /**
+     * Push a message on to the asynchronous queue, applying the overflow
+     * policy if it is full.
+     *
+     * @param level
+     *   Log level.
+     *
+     * @param tag
+     *   Tag for log message.
+     *
+     * @param filename
+     *   Name of the file logging the message.
+     *
+     * @param line
+     *   Line of the log call in the file.
+     *
+     * @param message
+     *   Log message.
+     */
+    void enqueue(LogLevel level, std::string_view tag, std::string_view filename, int line, std::string_view message);
+
+    /**
+     * Background writer thread function.
+     */
+    void write_async();
 
     /** Formatter object. */
     std::unique_ptr<Formatter> formatter_;
@@ -351,7 +486,7 @@ class Logger
     std::unique_ptr<Outputter> outputter_;
 
     /** Collection of tags to ignore. */
-    std::set<std::string> ignore_;
+    std::unordered_set<StringId> ignore_;
 
     /** Minimum log level. */
     LogLevel min_level_;
@@ -359,8 +494,14 @@ class Logger
     /** Whether to log internal engine messages. */
     bool log_engine_;
 
-    /** Lock for logging. */
+    /** Lock for formatting and outputting. */
     std::mutex mutex_;
+
+    /** Asynchronous logging state, null if logging synchronously. */
+    std::unique_ptr<AsyncState> async_;
+
+    /** Binary log writer, null if not logging in binary. */
+    std::unique_ptr<BinaryLogWriter> binary_;
 };
 
 }
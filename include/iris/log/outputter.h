@@ -6,6 +6,7 @@
 
 #pragma once
 
+#include <chrono>
 #include <string>
 
 namespace iris
@@ -28,6 +29,37 @@ class Outputter
      *   Log message to output.
      */
     virtual void output(const std::string &log) = 0;
+
+    /**
+     * Flush any buffered output to the underlying medium. Called after each
+     * synchronous log and after each batch of asynchronous logs, outputters
+     * that do their own buffering may choose to defer this.
+     */
+    virtual void flush()
+    {
+    }
+
+    /**
+     * Get the time by which flush() must be called again to write output it
+     * deferred. When logging asynchronously the writer calls flush() at this
+     * time if no messages have arrived.
+     *
+     * @returns
+     *   Flush deadline, or time_point::max() if nothing is deferred.
+     */
+    virtual std::chrono::steady_clock::time_point flush_deadline() const
+    {
+        return std::chrono::steady_clock::time_point::max();
+    }
+
+    /**
+     * Force all buffered output to be written. Unlike flush() this must not be
+     * deferred, it is called by Logger::flush() and when crashing.
+     */
+    virtual void sync()
+    {
+        flush();
+    }
 };
 
 }
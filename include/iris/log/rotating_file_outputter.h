@@ -0,0 +1,139 @@
+////////////////////////////////////////////////////////////////////////////////
+//         Distributed under the Boost Software License, Version 1.0.         //
+//            (See accompanying file LICENSE or copy at                       //
+//                 https://www.boost.org/LICENSE_1_0.txt)                     //
+////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+#include <string>
+
+#include "log/file_write_mode.h"
+#include "log/outputter.h"
+
+namespace iris
+{
+
+/**
+ * Options for a RotatingFileOutputter.
+ */
+struct RotatingFileOptions
+{
+    /** Size of the write buffer (or mapped window) in bytes. */
+    std::size_t buffer_size = 64u * 1024u;
+
+    /**
+     * Buffered output is written at least this often, 0 to write on every flush. When logging synchronously this is
+     * only checked when a message is logged.
+     */
+    std::chrono::milliseconds flush_interval = std::chrono::milliseconds(1000);
+
+    /** Rotate when the file would exceed this many bytes, 0 to disable. */
+    std::uint64_t max_file_size = 0u;
+
+    /** Rotate when the file has been open this long, 0 to disable. */
+    std::chrono::seconds rotation_interval = std::chrono::seconds(0);
+
+    /** Number of rotated files to keep. */
+    std::uint32_t retention = 5u;
+
+    /** How to write to disk. */
+    FileWriteMode mode = FileWriteMode::BUFFERED;
+};
+
+/**
+ * Implementation of Outputter which writes log messages to a file through a large buffer, rather than making a system
+ * call for each line.
+ *
+ * The file can be rotated by size and/or age. When rotated "name.ext" is renamed to "name.1.ext" (with existing
+ * rotated files being shifted up by one) and a new "name.ext" is started. Only the configured number of rotated files
+ * are kept.
+ */
+class RotatingFileOutputter : public Outputter
+{
+  public:
+    /**
+     * Construct a new RotatingFileOutputter, appending to the file if it already exists.
+     *
+     * @param path
+     *   Path of log file to write to.
+     *
+     * @param options
+     *   Buffering and rotation options.
+     */
+    explicit RotatingFileOutputter(const std::filesystem::path &path, const RotatingFileOptions &options = {});
+
+    /**
+     * Writes any buffered output.
+     */
+    ~RotatingFileOutputter() override;
+
+    RotatingFileOutputter(const RotatingFileOutputter &) = delete;
+    RotatingFileOutputter &operator=(const RotatingFileOutputter &) = delete;
+
+    /**
+     * Output log.
+     *
+     * @param log
+     *   Log message to output.
+     */
+    void output(const std::string &log) override;
+
+    /**
+     * Write buffered output if the flush interval has elapsed.
+     */
+    void flush() override;
+
+    /**
+     * Get the time the flush interval will elapse, if there is buffered output.
+     *
+     * @returns
+     *   Flush deadline, or time_point::max() if nothing is buffered.
+     */
+    std::chrono::steady_clock::time_point flush_deadline() const override;
+
+    /**
+     * Write all buffered output.
+     */
+    void sync() override;
+
+    /**
+     * Force a rotation.
+     */
+    void rotate();
+
+  private:
+    /**
+     * Open the log file.
+     */
+    void open();
+
+    /** Path of log file. */
+    std::filesystem::path path_;
+
+    /** Options. */
+    RotatingFileOptions options_;
+
+    /** Size of current file, including buffered output. */
+    std::uint64_t file_size_;
+
+    /** Time current file was opened. */
+    std::chrono::steady_clock::time_point opened_;
+
+    /** Time of last write to disk. */
+    std::chrono::steady_clock::time_point last_flush_;
+
+    /** Whether there is output which has not been written to disk. */
+    bool pending_;
+
+    /** Pointer to implementation. */
+    struct implementation;
+    std::unique_ptr<implementation> impl_;
+};
+
+}
@@ -29,6 +29,11 @@ class StdoutFormatter : public Outputter
      *   Log message to output.
      */
     void output(const std::string &log) override;
+
+    /**
+     * Flush buffered output.
+     */
+    void flush() override;
 };
 
 }
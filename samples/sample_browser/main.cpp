@@ -9,6 +9,7 @@
 #include <memory>
 #include <string>
 #include <tuple>
+#include <vector>
 
 #include <core/context.h>
 #include <core/exception.h>
@@ -70,7 +71,8 @@ RenderState create_render_state(iris::Context &context, iris::Window *window, ir
         context.mesh_manager(),
         context.render_target_manager(),
         window->width(),
-        window->height());
+        window->height(),
+        std::addressof(context.jobs_manager()));
     auto sample = create_sample(context, window, *render_pipeline, index % sample_count);
 
     const auto *sample_target = sample->target();
@@ -110,6 +112,9 @@ void go(iris::Context context)
     std::size_t frame_counter = 0u;
     std::size_t next_update = 1u;
 
+    // reused each frame so pumping events doesn't allocate
+    std::vector<iris::Event> events{};
+
     iris::Looper looper{
         0ms,
         16ms,
@@ -121,14 +126,17 @@ void go(iris::Context context)
         [&, &sample = sample](std::chrono::microseconds elapsed, auto)
         {
             auto running = true;
-            auto event = window->pump_event();
-            while (event)
+
+            events.clear();
+            window->pump_events(events);
+
+            for (const auto &event : events)
             {
-                if (event->is_quit() || event->is_key(iris::Key::ESCAPE))
+                if (event.is_quit() || event.is_key(iris::Key::ESCAPE))
                 {
                     running = false;
                 }
-                else if (event->is_key(iris::Key::TAB, iris::KeyState::UP))
+                else if (event.is_key(iris::Key::TAB, iris::KeyState::UP))
                 {
                     ++sample_number;
 
@@ -139,9 +147,8 @@ void go(iris::Context context)
                 }
                 else
                 {
-                    sample->handle_input(*event);
+                    sample->handle_input(event);
                 }
-                event = window->pump_event();
             }
 
             sample->variable_update();
@@ -9,6 +9,9 @@ in vec4 norm;
 in vec4 vertex_pos;
 in vec4 view_norm;
 in vec4 view_position;
+{% if single_pass %}
+in mat3 world_tbn;
+{% endif %}
 
 layout (location = 0) out vec4 out_colour;
 
@@ -54,6 +57,26 @@ layout (std140, binding = 6) uniform RenderValues
 
 uniform int shadow_map_index;
 
+{% if single_pass %}
+struct Light
+{
+    mat4 projection;
+    mat4 view;
+    vec4 colour;
+    vec4 position;
+    vec4 attenuation;
+    ivec4 info;
+};
+
+layout (std430, binding = 7) buffer LightArray
+{
+    uvec4 light_count;
+    Light lights[];
+};
+
+uniform int receive_shadow;
+{% endif %}
+
 {{properties}}
 
 void main()
@@ -75,7 +98,54 @@ void main()
         vec3 normal = normalize(norm.xyz);
     {% endif %}
 
-    {% if light_type == 0 %}
+    {% if single_pass %}
+        {% if exists("ambient_input") %}
+            vec4 lit = {{ambient_input}};
+        {% else %}
+            vec4 lit = light_colour * fragment_colour;
+        {% endif %}
+
+        {% if exists("normal") %}
+            // lights are in world space, so move the tangent space normal there too
+            normal = normalize(world_tbn * normal);
+        {% endif %}
+
+        // info.x is the light type, info.y the index of the shadow map in the texture table (or -1 for none)
+        for (uint i = 0u; i < light_count.x; ++i)
+        {
+            if (lights[i].info.x == 1)
+            {
+                vec3 light_dir = normalize(-lights[i].position.xyz);
+
+                float shadow = 0.0;
+                if ((lights[i].info.y >= 0) && (receive_shadow != 0))
+                {
+                    vec4 light_space = transpose(lights[i].projection) * transpose(lights[i].view) * frag_pos;
+                    shadow = calculate_shadow(
+                        normal,
+                        light_space,
+                        lights[i].position.xyz,
+                        sampler2D(texture_table[lights[i].info.y]));
+                }
+
+                float diff = (1.0 - shadow) * max(dot(normal, light_dir), 0.0);
+                lit.xyz += diff * fragment_colour.xyz;
+            }
+            else
+            {
+                vec3 light_dir = normalize(lights[i].position.xyz - frag_pos.xyz);
+
+                float distance = length(lights[i].position.xyz - frag_pos.xyz);
+                float attenuation = 1.0 / (lights[i].attenuation.x + lights[i].attenuation.y * distance +
+                    lights[i].attenuation.z * (distance * distance));
+
+                float diff = max(dot(normal, light_dir), 0.0);
+                lit.xyz += diff * lights[i].colour.xyz * fragment_colour.xyz * attenuation;
+            }
+        }
+
+        out_colour = lit;
+    {% else if light_type == 0 %}
         {% if exists("ambient_input") %}
             out_colour = {{ambient_input}};
         {% else %}
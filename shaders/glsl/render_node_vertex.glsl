@@ -18,6 +18,9 @@ out vec4 norm;
 out vec4 vertex_pos;
 out vec4 view_norm;
 out vec4 view_position;
+{% if single_pass %}
+out mat3 world_tbn;
+{% endif %}
 
 layout (std140, binding = 0) uniform CameraData
 {
@@ -95,6 +98,10 @@ void main()
     tangent_view_pos = tbn * camera.xyz;
     tangent_frag_pos = tbn * frag_pos.xyz;
 
+    {% if single_pass %}
+        world_tbn = mat3(T, B, N);
+    {% endif %}
+
     view_norm = transpose(normal_view) * norm;
     
 }
@@ -9,6 +9,7 @@
 #include <cmath>
 
 #include "core/camera_type.h"
+#include "core/frustum.h"
 #include "core/matrix4.h"
 #include "core/quaternion.h"
 #include "core/vector3.h"
@@ -53,6 +54,8 @@ Camera::Camera(CameraType type, std::uint32_t width, std::uint32_t height, std::
     , up_(0.0f, 1.0f, 0.0f)
     , view_()
     , projection_()
+    , near_plane_(0.0f)
+    , far_plane_(static_cast<float>(depth))
     , pitch_(0.0f)
     , yaw_(-3.141592654f / 2.0f)
     , type_(type)
@@ -64,9 +67,11 @@ Camera::Camera(CameraType type, std::uint32_t width, std::uint32_t height, std::
     switch (type_)
     {
         case CameraType::PERSPECTIVE:
-            projection_ = Matrix4::make_perspective_projection(0.785398f, width_f, height_f, 0.1f, depth_f);
+            near_plane_ = 0.1f;
+            projection_ = Matrix4::make_perspective_projection(0.785398f, width_f, height_f, near_plane_, depth_f);
             break;
         case CameraType::ORTHOGRAPHIC:
+            near_plane_ = -depth_f;
             projection_ = Matrix4::make_orthographic_projection(width_f, height_f, depth_f);
             break;
     }
@@ -118,6 +123,11 @@ Matrix4 Camera::projection() const
     return projection_;
 }
 
+Frustum Camera::frustum() const
+{
+    return Frustum{projection_ * view_};
+}
+
 float Camera::yaw() const
 {
     return yaw_;
@@ -160,6 +170,16 @@ void Camera::adjust_pitch(float adjust)
     set_pitch(pitch_ + adjust);
 }
 
+float Camera::near_plane() const
+{
+    return near_plane_;
+}
+
+float Camera::far_plane() const
+{
+    return far_plane_;
+}
+
 CameraType Camera::type() const
 {
     return type_;
@@ -0,0 +1,135 @@
+////////////////////////////////////////////////////////////////////////////////
+//         Distributed under the Boost Software License, Version 1.0.         //
+//            (See accompanying file LICENSE or copy at                       //
+//                 https://www.boost.org/LICENSE_1_0.txt)                     //
+////////////////////////////////////////////////////////////////////////////////
+
+#include "core/dirty_range_tracker.h"
+
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+namespace
+{
+
+constexpr auto word_bits = 64u;
+
+/**
+ * Helper function to create a mask of set bits.
+ *
+ * @param begin
+ *   Index of first bit to set.
+ *
+ * @param end
+ *   One past the index of the last bit to set, must be greater than begin.
+ *
+ * @returns
+ *   Mask with bits [begin, end) set.
+ */
+std::uint64_t bit_mask(std::size_t begin, std::size_t end)
+{
+    const auto upper = (end == word_bits) ? std::numeric_limits<std::uint64_t>::max() : ((1ull << end) - 1u);
+    return upper & ~((1ull << begin) - 1u);
+}
+
+}
+
+namespace iris
+{
+
+DirtyRangeTracker::DirtyRangeTracker(std::size_t merge_gap)
+    : bits_()
+    , first_word_(0u)
+    , last_word_(0u)
+    , merge_gap_(merge_gap)
+{
+}
+
+void DirtyRangeTracker::mark(std::size_t index)
+{
+    mark(index, index + 1u);
+}
+
+void DirtyRangeTracker::mark(std::size_t begin, std::size_t end)
+{
+    if (begin >= end)
+    {
+        return;
+    }
+
+    const auto begin_word = begin / word_bits;
+    const auto end_word = ((end - 1u) / word_bits) + 1u;
+
+    if (end_word > bits_.size())
+    {
+        bits_.resize(end_word);
+    }
+
+    if (empty())
+    {
+        first_word_ = begin_word;
+        last_word_ = end_word;
+    }
+    else
+    {
+        first_word_ = std::min(first_word_, begin_word);
+        last_word_ = std::max(last_word_, end_word);
+    }
+
+    for (auto word = begin_word; word < end_word; ++word)
+    {
+        const auto word_begin = word * word_bits;
+        const auto first = std::max(begin, word_begin) - word_begin;
+        const auto last = std::min(end, word_begin + word_bits) - word_begin;
+
+        bits_[word] |= bit_mask(first, last);
+    }
+}
+
+bool DirtyRangeTracker::empty() const
+{
+    return first_word_ == last_word_;
+}
+
+void DirtyRangeTracker::ranges(std::vector<DirtyRange> &ranges) const
+{
+    ranges.clear();
+
+    for (auto word = first_word_; word < last_word_; ++word)
+    {
+        auto bits = bits_[word];
+
+        // walk each run of set bits in the word
+        while (bits != 0u)
+        {
+            const auto start = static_cast<std::size_t>(std::countr_zero(bits));
+            const auto length = static_cast<std::size_t>(std::countr_one(bits >> start));
+            const auto begin = (word * word_bits) + start;
+
+            // runs which span words (or are close enough) are joined onto the previous range
+            if (!ranges.empty() && (begin <= ranges.back().end + merge_gap_))
+            {
+                ranges.back().end = begin + length;
+            }
+            else
+            {
+                ranges.push_back({.begin = begin, .end = begin + length});
+            }
+
+            bits &= ~bit_mask(start, start + length);
+        }
+    }
+}
+
+void DirtyRangeTracker::clear()
+{
+    std::fill(std::begin(bits_) + first_word_, std::begin(bits_) + last_word_, 0u);
+    first_word_ = 0u;
+    last_word_ = 0u;
+}
+
+}
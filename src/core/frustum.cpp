@@ -0,0 +1,82 @@
+////////////////////////////////////////////////////////////////////////////////
+//         Distributed under the Boost Software License, Version 1.0.         //
+//            (See accompanying file LICENSE or copy at                       //
+//                 https://www.boost.org/LICENSE_1_0.txt)                     //
+////////////////////////////////////////////////////////////////////////////////
+
+#include "core/frustum.h"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+
+#include "core/aabb.h"
+#include "core/bounding_sphere.h"
+#include "core/matrix4.h"
+#include "core/vector3.h"
+
+namespace iris
+{
+
+Frustum::Frustum(const Matrix4 &view_projection)
+    : planes_()
+{
+    // Gribb-Hartmann extraction, each plane is the fourth row of the matrix plus or minus one of the others
+    // this assumes a clip space z range of [-w, w], for a [0, w] range the near plane is looser than it needs to be,
+    // which is still conservative
+    const auto row = [&view_projection](std::size_t index) -> std::array<float, 4u>
+    {
+        return {
+            view_projection[index * 4u],
+            view_projection[index * 4u + 1u],
+            view_projection[index * 4u + 2u],
+            view_projection[index * 4u + 3u]};
+    };
+
+    const auto w = row(3u);
+
+    for (auto i = 0u; i < planes_.size(); ++i)
+    {
+        const auto other = row(i / 2u);
+        const auto sign = (i % 2u == 0u) ? 1.0f : -1.0f;
+
+        const Vector3 normal{w[0] + sign * other[0], w[1] + sign * other[1], w[2] + sign * other[2]};
+        const auto length = normal.magnitude();
+
+        planes_[i] = {.normal = normal * (1.0f / length), .distance = (w[3] + sign * other[3]) / length};
+    }
+}
+
+const std::array<Frustum::Plane, 6u> &Frustum::planes() const
+{
+    return planes_;
+}
+
+bool Frustum::intersects(const BoundingSphere &sphere) const
+{
+    return std::all_of(
+        std::cbegin(planes_),
+        std::cend(planes_),
+        [&sphere](const Plane &plane) { return plane.normal.dot(sphere.centre) + plane.distance >= -sphere.radius; });
+}
+
+bool Frustum::intersects(const AABB &aabb) const
+{
+    const auto centre = aabb.centre();
+    const auto extents = aabb.extents();
+
+    return std::all_of(
+        std::cbegin(planes_),
+        std::cend(planes_),
+        [&centre, &extents](const Plane &plane)
+        {
+            // projected radius of the box onto the plane normal
+            const auto radius = extents.x * std::abs(plane.normal.x) + extents.y * std::abs(plane.normal.y) +
+                                extents.z * std::abs(plane.normal.z);
+
+            return plane.normal.dot(centre) + plane.distance >= -radius;
+        });
+}
+
+}
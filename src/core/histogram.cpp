@@ -0,0 +1,205 @@
+////////////////////////////////////////////////////////////////////////////////
+//         Distributed under the Boost Software License, Version 1.0.         //
+//            (See accompanying file LICENSE or copy at                       //
+//                 https://www.boost.org/LICENSE_1_0.txt)                     //
+////////////////////////////////////////////////////////////////////////////////
+
+#include "core/histogram.h"
+
+#include <algorithm>
+#include <bit>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+
+#include "core/error_handling.h"
+
+namespace iris
+{
+
+Histogram::Histogram()
+    : buckets_()
+    , count_(0u)
+    , sum_(0u)
+    , min_(std::numeric_limits<std::uint64_t>::max())
+    , max_(0u)
+{
+}
+
+void Histogram::record(std::chrono::microseconds value)
+{
+    const auto us = static_cast<std::uint64_t>(std::max(value.count(), std::chrono::microseconds::rep{0}));
+
+    buckets_[bucket_index(us)].fetch_add(1u, std::memory_order_relaxed);
+    count_.fetch_add(1u, std::memory_order_relaxed);
+    sum_.fetch_add(us, std::memory_order_relaxed);
+
+    // cas loops to update min/max, these almost always succeed first time (or are skipped entirely)
+    auto current_min = min_.load(std::memory_order_relaxed);
+    while ((us < current_min) && !min_.compare_exchange_weak(current_min, us, std::memory_order_relaxed))
+    {
+    }
+
+    auto current_max = max_.load(std::memory_order_relaxed);
+    while ((us > current_max) && !max_.compare_exchange_weak(current_max, us, std::memory_order_relaxed))
+    {
+    }
+}
+
+std::uint64_t Histogram::count() const
+{
+    return count_.load(std::memory_order_relaxed);
+}
+
+std::chrono::microseconds Histogram::percentile(double percentile) const
+{
+    ensure((percentile >= 0.0) && (percentile <= 1.0), "percentile out of range");
+
+    const auto value = Histogram::percentile(
+        load_buckets(), min_.load(std::memory_order_relaxed), max_.load(std::memory_order_relaxed), percentile);
+
+    return std::chrono::microseconds{static_cast<std::chrono::microseconds::rep>(value)};
+}
+
+Histogram::Summary Histogram::summary() const
+{
+    return summarise(
+        load_buckets(),
+        count_.load(std::memory_order_relaxed),
+        sum_.load(std::memory_order_relaxed),
+        min_.load(std::memory_order_relaxed),
+        max_.load(std::memory_order_relaxed));
+}
+
+void Histogram::reset()
+{
+    for (auto &bucket : buckets_)
+    {
+        bucket.store(0u, std::memory_order_relaxed);
+    }
+
+    count_ = 0u;
+    sum_ = 0u;
+    min_ = std::numeric_limits<std::uint64_t>::max();
+    max_ = 0u;
+}
+
+Histogram::Summary Histogram::take_summary()
+{
+    Buckets buckets{};
+    for (auto i = 0u; i < bucket_count; ++i)
+    {
+        buckets[i] = buckets_[i].exchange(0u, std::memory_order_relaxed);
+    }
+
+    const auto count = count_.exchange(0u, std::memory_order_relaxed);
+    const auto sum = sum_.exchange(0u, std::memory_order_relaxed);
+    const auto min = min_.exchange(std::numeric_limits<std::uint64_t>::max(), std::memory_order_relaxed);
+    const auto max = max_.exchange(0u, std::memory_order_relaxed);
+
+    return summarise(buckets, count, sum, min, max);
+}
+
+std::size_t Histogram::bucket_index(std::uint64_t value)
+{
+    // values small enough to fit in the first set of sub-buckets are stored exactly
+    if (value < sub_bucket_count)
+    {
+        return static_cast<std::size_t>(value);
+    }
+
+    // otherwise use the top sub_bucket_bits bits (after the leading one) to pick a linear sub-bucket within the power
+    // of two range
+    const auto exponent = static_cast<std::uint32_t>(std::bit_width(value)) - sub_bucket_bits;
+    const auto sub_bucket = static_cast<std::uint32_t>(value >> (exponent - 1u)) - sub_bucket_count;
+
+    return static_cast<std::size_t>(exponent) * sub_bucket_count + sub_bucket;
+}
+
+std::uint64_t Histogram::bucket_lower_bound(std::size_t index)
+{
+    if (index < sub_bucket_count)
+    {
+        return static_cast<std::uint64_t>(index);
+    }
+
+    const auto exponent = static_cast<std::uint32_t>(index / sub_bucket_count);
+    const auto sub_bucket = static_cast<std::uint64_t>(index % sub_bucket_count);
+
+    return (sub_bucket_count + sub_bucket) << (exponent - 1u);
+}
+
+std::uint64_t Histogram::percentile(
+    const Buckets &buckets,
+    std::uint64_t min,
+    std::uint64_t max,
+    double percentile)
+{
+    // sum the buckets rather than using count_ so we get a consistent view if values are being recorded
+    std::uint64_t total = 0u;
+    for (const auto bucket : buckets)
+    {
+        total += bucket;
+    }
+
+    if (total == 0u)
+    {
+        return 0u;
+    }
+
+    const auto target = std::max<std::uint64_t>(
+        static_cast<std::uint64_t>(std::ceil(percentile * static_cast<double>(total))), std::uint64_t{1u});
+
+    std::uint64_t cumulative = 0u;
+    for (auto i = 0u; i < bucket_count; ++i)
+    {
+        cumulative += buckets[i];
+        if (cumulative >= target)
+        {
+            // clamp to the recorded range so exact values (e.g. a single sample) are reported exactly, the range may
+            // be empty if a value was split across summaries
+            return std::clamp(bucket_lower_bound(i), std::min(min, max), max);
+        }
+    }
+
+    return max;
+}
+
+Histogram::Summary Histogram::summarise(
+    const Buckets &buckets,
+    std::uint64_t count,
+    std::uint64_t sum,
+    std::uint64_t min,
+    std::uint64_t max)
+{
+    Summary summary{};
+
+    summary.count = count;
+    if (summary.count == 0u)
+    {
+        return summary;
+    }
+
+    summary.min = min;
+    summary.max = max;
+    summary.mean = static_cast<double>(sum) / static_cast<double>(summary.count);
+    summary.p50 = percentile(buckets, min, max, 0.50);
+    summary.p95 = percentile(buckets, min, max, 0.95);
+    summary.p99 = percentile(buckets, min, max, 0.99);
+
+    return summary;
+}
+
+Histogram::Buckets Histogram::load_buckets() const
+{
+    Buckets buckets{};
+    for (auto i = 0u; i < bucket_count; ++i)
+    {
+        buckets[i] = buckets_[i].load(std::memory_order_relaxed);
+    }
+
+    return buckets;
+}
+
+}
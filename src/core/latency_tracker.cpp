@@ -0,0 +1,86 @@
+////////////////////////////////////////////////////////////////////////////////
+//         Distributed under the Boost Software License, Version 1.0.         //
+//            (See accompanying file LICENSE or copy at                       //
+//                 https://www.boost.org/LICENSE_1_0.txt)                     //
+////////////////////////////////////////////////////////////////////////////////
+
+#include "core/latency_tracker.h"
+
+#include <chrono>
+#include <cstdint>
+#include <mutex>
+
+#include "core/histogram.h"
+#include "core/telemetry.h"
+#include "core/telemetry_counter.h"
+
+namespace iris
+{
+
+LatencyTracker &LatencyTracker::instance()
+{
+    static LatencyTracker tracker{};
+    return tracker;
+}
+
+LatencyTracker::LatencyTracker()
+    : enabled_(false)
+    , frame_(0u)
+    , pending_timestamp_()
+    , pending_frame_(0u)
+    , latency_histogram_(Telemetry::instance().histogram("latency.input_to_present"))
+    , presented_counter_(Telemetry::instance().counter("latency.presented_inputs"))
+    , frame_lag_counter_(Telemetry::instance().counter("latency.input_frame_lag"))
+    , mutex_()
+{
+}
+
+void LatencyTracker::set_enabled(bool enabled)
+{
+    std::unique_lock lock(mutex_);
+
+    enabled_ = enabled;
+    pending_timestamp_.reset();
+}
+
+void LatencyTracker::record_input(std::uint64_t frame, std::chrono::steady_clock::time_point timestamp)
+{
+    if (!enabled())
+    {
+        return;
+    }
+
+    std::unique_lock lock(mutex_);
+
+    // we only care about the oldest input, as that is the one that has waited longest to be seen
+    if (!pending_timestamp_ || (timestamp < *pending_timestamp_))
+    {
+        pending_timestamp_ = timestamp;
+        pending_frame_ = frame;
+    }
+}
+
+void LatencyTracker::record_present()
+{
+    if (!enabled())
+    {
+        return;
+    }
+
+    const auto now = std::chrono::steady_clock::now();
+
+    std::unique_lock lock(mutex_);
+
+    if (!pending_timestamp_)
+    {
+        return;
+    }
+
+    latency_histogram_.record(std::chrono::duration_cast<std::chrono::microseconds>(now - *pending_timestamp_));
+    presented_counter_.add();
+    frame_lag_counter_.add(frame() - pending_frame_);
+
+    pending_timestamp_.reset();
+}
+
+}
@@ -6,59 +6,166 @@
 
 #include "core/profiler.h"
 
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <bit>
+#include <cerrno>
+#include <chrono>
+#include <cstdint>
 #include <filesystem>
-#include <iostream>
-#include <latch>
 #include <memory>
 #include <regex>
 #include <string>
 #include <thread>
 #include <unordered_map>
+#include <unordered_set>
 #include <vector>
 
 #include <cxxabi.h>
 #include <execinfo.h>
 #include <signal.h>
+#include <time.h>
 #include <unistd.h>
 
 #include "core/auto_release.h"
 #include "core/error_handling.h"
 #include "core/profiler_analyser.h"
 #include "core/thread.h"
+#include "log/log.h"
+
+// older glibc versions don't expose the thread id member of sigevent
+#if !defined(sigev_notify_thread_id)
+#define sigev_notify_thread_id _sigev_un._tid
+#endif
 
 namespace
 {
 
-// global state, needed as a signal handler is a global function
 static constexpr auto stack_frame_size = 100u;
-static std::vector<std::byte> proc_info_buffer(1024u * 1024u * 100u);
+
+/** Minimum number of samples each thread can buffer before the worker drains them. */
+static constexpr auto min_ring_capacity = 64u;
+
+/** Number of frames at the top of a sampled stack which belong to the signal handler and trampoline. */
+static constexpr auto handler_frame_count = 2;
+
+/** How often the worker drains samples and looks for new threads. */
+static constexpr auto drain_interval = std::chrono::milliseconds(50);
+
 static const auto max_thread_count = std::thread::hardware_concurrency() * 10u;
-static std::vector<void *> stack_traces;
-static std::unordered_map<pid_t, std::size_t> index_lookup;
-static std::unique_ptr<std::latch> threads_done;
 
 /**
- * Custom signal handler that effectively allows us to suspend a thread.
+ * A single stack trace captured in the signal handler.
+ */
+struct Sample
+{
+    int depth;
+    std::array<void *, stack_frame_size> frames;
+};
+
+/**
+ * Lock free single producer single consumer ring buffer of samples for a thread. The producer is the signal handler
+ * (which always runs on the sampled thread) and the consumer is the profiler worker thread.
+ */
+struct alignas(64) ThreadSamples
+{
+    /** Id of thread being sampled, 0 if slot is free. */
+    pid_t tid = 0;
+
+    /** Cpu time timer which fires the sampling signal. */
+    timer_t timer = {};
+
+    /** Index of the next sample to write, only modified by the signal handler. */
+    std::atomic<std::uint32_t> head = 0u;
+
+    /** Index of the next sample to read, only modified by the worker. */
+    std::atomic<std::uint32_t> tail = 0u;
+
+    /** Number of samples dropped because the ring was full. */
+    std::atomic<std::uint32_t> dropped = 0u;
+
+    /** Number of samples ring can hold, always a power of two. */
+    std::uint32_t capacity = 0u;
+
+    /** Sample storage, allocated by the worker before the timer is armed. */
+    std::unique_ptr<Sample[]> ring;
+};
+
+/**
+ * Get the number of samples a thread needs to be able to buffer between drains.
+ *
+ * @param sample_frequency
+ *   Samples per second.
+ *
+ * @returns
+ *   Ring capacity, with 2x headroom for a late drain and rounded up to a power of two.
  */
-void signal_handler(int)
+std::uint32_t ring_capacity(std::uint32_t sample_frequency)
 {
-    // get the index into the global stack trace buffer we can write into, also sanity checks we are expecting to
-    // profile this thread
-    if (const auto iter = index_lookup.find(::gettid()); iter != std::cend(index_lookup))
+    const auto samples_per_drain = static_cast<std::uint32_t>(
+        (static_cast<std::uint64_t>(sample_frequency) * drain_interval.count()) / 1000u);
+
+    return std::bit_ceil(std::max(min_ring_capacity, samples_per_drain * 2u));
+}
+
+/**
+ * Signal handler that captures the stack of the thread it is run on. This is only delivered to a thread when its cpu
+ * time timer fires, so only threads which are actually running get sampled.
+ *
+ * @param info
+ *   Signal info, the value contains the ThreadSamples to write into.
+ */
+void signal_handler(int, siginfo_t *info, void *)
+{
+    // ignore any SIGPROF we didn't arm
+    if ((info == nullptr) || (info->si_code != SI_TIMER) || (info->si_value.sival_ptr == nullptr))
     {
-        // get stack trace
-        const auto index = 100u * iter->second;
-        const auto stack_size = ::backtrace(&stack_traces[index], 100u);
+        return;
+    }
 
-        // terminate the stack trace so we can find the end
-        if (stack_size != 100u)
-        {
-            stack_traces[index + stack_size] = nullptr;
-        }
+    // DANGER ZONE START
+    // we could have interrupted this thread anywhere, so we cannot allocate memory, take locks or do anything that
+    // isn't async signal safe
+
+    const auto saved_errno = errno;
+    auto *samples = static_cast<ThreadSamples *>(info->si_value.sival_ptr);
+
+    const auto head = samples->head.load(std::memory_order_relaxed);
+    const auto tail = samples->tail.load(std::memory_order_acquire);
+
+    if (head - tail < samples->capacity)
+    {
+        auto &sample = samples->ring[head & (samples->capacity - 1u)];
+        sample.depth = ::backtrace(sample.frames.data(), static_cast<int>(sample.frames.size()));
+        samples->head.store(head + 1u, std::memory_order_release);
+    }
+    else
+    {
+        samples->dropped.fetch_add(1u, std::memory_order_relaxed);
     }
 
-    // signal that this thread is done sampling
-    threads_done->count_down();
+    errno = saved_errno;
+
+    // DANGER ZONE END
+}
+
+/**
+ * Get the cpu time clock for a thread in this process. This is the same encoding the kernel uses for
+ * pthread_getcpuclockid, but works with any thread id rather than just pthread handles.
+ *
+ * @param tid
+ *   Thread id.
+ *
+ * @returns
+ *   Clock id measuring the cpu time of the thread.
+ */
+clockid_t thread_cpu_clock(pid_t tid)
+{
+    static constexpr clockid_t cpuclock_perthread = 4;
+    static constexpr clockid_t cpuclock_sched = 2;
+
+    return static_cast<clockid_t>((~static_cast<unsigned>(tid)) << 3u) | cpuclock_perthread | cpuclock_sched;
 }
 
 }
@@ -70,136 +177,333 @@ struct Profiler::implementation
 {
     Thread worker;
     std::atomic<bool> running;
+    std::uint32_t sample_frequency;
+    ProfilerOutputFormat format;
+    std::filesystem::path output_path;
+    ProfilerAnalyser analyser;
+    std::unique_ptr<ThreadSamples[]> thread_samples;
+    std::unordered_map<void *, std::string> symbol_cache;
+    std::uint32_t dropped_samples;
+
+    /**
+     * Create timers for any new threads and release slots of threads which have exited.
+     *
+     * @param frequency
+     *   Samples per second to take of new threads.
+     */
+    void sync_threads(std::uint32_t frequency);
+
+    /**
+     * Symbolise and record all buffered samples.
+     */
+    void drain();
+
+    /**
+     * Symbolise and record all buffered samples for a single thread.
+     *
+     * @param slot
+     *   Thread samples to drain.
+     */
+    void drain(ThreadSamples &slot);
+
+    /**
+     * Stop the timer for a thread, record any remaining samples and free up its slot.
+     *
+     * @param slot
+     *   Thread samples to release.
+     */
+    void release(ThreadSamples &slot);
+
+    /**
+     * Release all threads.
+     */
+    void release_threads();
+
+    /**
+     * Resolve an address to a demangled function name.
+     *
+     * @param address
+     *   Address to resolve.
+     *
+     * @returns
+     *   Function name, or "unknown" if it could not be resolved.
+     */
+    const std::string &resolve(void *address);
 };
 
-Profiler::Profiler()
-    : impl_(std::make_unique<implementation>())
+void Profiler::implementation::sync_threads(std::uint32_t frequency)
 {
-    // register custom signal handler
-    expect(::signal(SIGUSR1, &signal_handler) != SIG_ERR, "could not set signal handler");
+    std::unordered_set<pid_t> tids{};
 
-    // reserve space for a stack frame for each thread
-    stack_traces = std::vector<void *>(max_thread_count * stack_frame_size, nullptr);
-    impl_->running = true;
+    // get all threads for the current process, excluding the worker
+    for (const auto &dir_entry : std::filesystem::directory_iterator{"/proc/self/task"})
+    {
+        if (const auto tid = std::stoi(dir_entry.path().filename().string()); tid != ::gettid())
+        {
+            tids.emplace(tid);
+        }
+    }
 
-    // ensure libgcc is initialised, if we don't do this here then the first call to backtrace might try to do the
-    // initilisation which involves calls to malloc
-    // if this happens from a suspended thread then it could cause a deadlock
-    void *buffer = nullptr;
-    expect(::backtrace(&buffer, 1u) == 1u, "failed to initialise libgcc");
+    // release slots for threads which have gone away, they can no longer receive signals so it's safe to reuse them
+    for (auto i = 0u; i < max_thread_count; ++i)
+    {
+        auto &slot = thread_samples[i];
 
-    // create a new thread for handling the sampling, this thread will be excluded from the sampling
-    impl_->worker = Thread([&]() {
-        ProfilerAnalyser pa{};
+        if (slot.tid == 0)
+        {
+            continue;
+        }
 
-        while (impl_->running)
+        if (!tids.contains(slot.tid))
+        {
+            release(slot);
+        }
+        else
         {
-            std::vector<pid_t> tids{};
+            tids.erase(slot.tid);
+        }
+    }
 
-            // get all threads for the current process
-            for (const auto &dir_entry : std::filesystem::directory_iterator{"/proc/self/task"})
-            {
-                const auto tid_str = dir_entry.path().filename().string();
-                const auto tid = std::stoi(tid_str);
-                tids.push_back(tid);
-            }
+    const auto interval_ns = 1'000'000'000l / static_cast<long>(frequency);
+    const ::itimerspec spec = {
+        .it_interval = {.tv_sec = interval_ns / 1'000'000'000l, .tv_nsec = interval_ns % 1'000'000'000l},
+        .it_value = {.tv_sec = interval_ns / 1'000'000'000l, .tv_nsec = interval_ns % 1'000'000'000l}};
 
-            expect(tids.size() > 1, "found no threads");
+    // anything left is a new thread, so find it a free slot and arm a cpu time timer for it
+    auto slot_index = 0u;
+    for (const auto tid : tids)
+    {
+        while ((slot_index < max_thread_count) && (thread_samples[slot_index].tid != 0))
+        {
+            ++slot_index;
+        }
 
-            index_lookup.clear();
+        if (slot_index == max_thread_count)
+        {
+            break;
+        }
 
-            // calculate indices for all the threads to write into
-            auto index = 0u;
-            for (const auto tid : tids)
-            {
-                index_lookup[tid] = index;
-                ++index;
-            }
+        auto &slot = thread_samples[slot_index];
 
-            // we use a latch to know when all paused threads have resumed
-            threads_done = std::make_unique<std::latch>(tids.size() - 1u);
+        // size the ring so a busy thread can't fill it between drains, slots keep their ring so this only allocates
+        // when the slot is first used or the frequency changes
+        if (const auto capacity = ring_capacity(frequency); slot.capacity != capacity)
+        {
+            slot.ring = std::make_unique<Sample[]>(capacity);
+            slot.capacity = capacity;
+            slot.head = 0u;
+            slot.tail = 0u;
+        }
 
-            // DANGER ZONE START
-            // as we don't know what a thread was doing when we suspended it we have to be careful what we do
-            // we cannot allocate memory, most platform/system calls or anything which might involve trying to
-            // take a lock that a suspended thread might be holding
+        ::sigevent event{};
+        event.sigev_notify = SIGEV_THREAD_ID;
+        event.sigev_signo = SIGPROF;
+        event.sigev_value.sival_ptr = std::addressof(slot);
+        event.sigev_notify_thread_id = tid;
 
-            for (const auto tid : tids)
-            {
-                // skip the thread if it is the current thread, otherwise we will end up suspending ourselves
-                if (tid == ::gettid())
-                {
-                    continue;
-                }
-
-                // send custom signal to the thread which will cause it to suspend
-                ::syscall(SYS_tkill, tid, SIGUSR1);
-            }
+        // thread may have exited since we scanned
+        if (::timer_create(thread_cpu_clock(tid), &event, &slot.timer) != 0)
+        {
+            continue;
+        }
 
-            threads_done->wait();
+        slot.tid = tid;
 
-            // DANGER ZONE END
+        if (::timer_settime(slot.timer, 0, &spec, nullptr) != 0)
+        {
+            ::timer_delete(slot.timer);
+            slot.tid = 0;
+        }
+    }
+}
 
-            std::regex symbol_regex{".*\\(([_a-zA-Z0-9]*).*"};
+void Profiler::implementation::drain()
+{
+    for (auto i = 0u; i < max_thread_count; ++i)
+    {
+        if (auto &slot = thread_samples[i]; slot.tid != 0)
+        {
+            drain(slot);
+        }
+    }
+}
+
+void Profiler::implementation::drain(ThreadSamples &slot)
+{
+    const auto head = slot.head.load(std::memory_order_acquire);
+    auto tail = slot.tail.load(std::memory_order_relaxed);
+
+    for (; tail != head; ++tail)
+    {
+        const auto &sample = slot.ring[tail & (slot.capacity - 1u)];
+
+        std::vector<std::string> stack_trace{};
+        for (auto i = handler_frame_count; i < sample.depth; ++i)
+        {
+            stack_trace.push_back(resolve(sample.frames[i]));
+        }
+
+        analyser.add_stack_trace(static_cast<std::uint64_t>(slot.tid), stack_trace);
+    }
+
+    slot.tail.store(tail, std::memory_order_release);
+}
+
+void Profiler::implementation::release(ThreadSamples &slot)
+{
+    // once the timer is deleted no more samples can be written, so we can safely do a final drain
+    ::timer_delete(slot.timer);
+    drain(slot);
+    dropped_samples += slot.dropped.exchange(0u);
+    slot.tid = 0;
+}
+
+void Profiler::implementation::release_threads()
+{
+    for (auto i = 0u; i < max_thread_count; ++i)
+    {
+        if (auto &slot = thread_samples[i]; slot.tid != 0)
+        {
+            release(slot);
+        }
+    }
+}
 
-            // now that all threads have resumed we can resolve the symbols for all the stack traces
-            for (auto i = 0u; i < stack_traces.size() / 100u; ++i)
+const std::string &Profiler::implementation::resolve(void *address)
+{
+    if (const auto cached = symbol_cache.find(address); cached != std::cend(symbol_cache))
+    {
+        return cached->second;
+    }
+
+    static const std::regex symbol_regex{".*\\(([_a-zA-Z0-9]*).*"};
+    std::string symbol_str = "unknown";
+
+    // resolve address to symbol and try to demangle it
+    AutoRelease<char **, nullptr> symbols(::backtrace_symbols(&address, 1), ::free);
+    if (symbols && (symbols[0] != nullptr))
+    {
+        std::cmatch cmatch{};
+
+        if (std::regex_match(symbols[0], cmatch, symbol_regex))
+        {
+            if ((cmatch.size() == 2u) && (cmatch[1].length() > 0u))
             {
-                std::vector<std::string> stack_trace{};
-                auto index = i * 100u;
-
-                const auto *begin = &stack_traces[index];
-                const auto *end = &stack_traces[index + 100u];
-                const auto size = std::find(begin, end, nullptr) - begin;
-
-                // resolve stack trace to symbols
-                AutoRelease<char **, nullptr> symbols(::backtrace_symbols(begin, size), ::free);
-
-                // try and demangle each symbol
-                for (auto i = 0u; i < size; ++i)
-                {
-                    if (const auto *symbol = symbols[i]; symbol != nullptr)
-                    {
-                        std::cmatch cmatch{};
-                        std::string symbol_str = "unknown";
-
-                        if (std::regex_match(symbol, cmatch, symbol_regex))
-                        {
-                            if ((cmatch.size() == 2u) && (cmatch[1].length() > 0u))
-                            {
-                                AutoRelease<char *, nullptr> auto_demangle(
-                                    ::abi::__cxa_demangle(cmatch[1].str().c_str(), nullptr, nullptr, nullptr), ::free);
-                                ;
-                                if (auto_demangle)
-                                {
-                                    symbol_str = auto_demangle;
-                                }
-                            }
-                        }
-
-                        stack_trace.push_back(symbol_str);
-                    }
-                    else
-                    {
-                        break;
-                    }
-                }
-
-                // record the resolved stack trace
-                pa.add_stack_trace(stack_trace);
+                AutoRelease<char *, nullptr> auto_demangle(
+                    ::abi::__cxa_demangle(cmatch[1].str().c_str(), nullptr, nullptr, nullptr), ::free);
+
+                symbol_str = auto_demangle ? std::string{auto_demangle} : cmatch[1].str();
             }
+        }
+    }
+
+    return symbol_cache.emplace(address, std::move(symbol_str)).first->second;
+}
+
+Profiler::Profiler()
+    : Profiler(ProfilerOutputFormat::TEXT, {}, true)
+{
+}
+
+Profiler::Profiler(ProfilerOutputFormat format, const std::filesystem::path &output_path, bool start_immediately)
+    : impl_(std::make_unique<implementation>())
+{
+    // register custom signal handler, SA_RESTART to minimise the impact on interrupted system calls
+    struct ::sigaction action = {};
+    action.sa_sigaction = &signal_handler;
+    action.sa_flags = SA_SIGINFO | SA_RESTART;
+    ::sigemptyset(&action.sa_mask);
+    expect(::sigaction(SIGPROF, &action, nullptr) == 0, "could not set signal handler");
+
+    // reserve a slot for each thread, rings are allocated when a slot is first used
+    impl_->thread_samples = std::make_unique<ThreadSamples[]>(max_thread_count);
+    impl_->running = false;
+    impl_->sample_frequency = 100u;
+    impl_->format = format;
+    impl_->output_path = output_path;
 
-            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    // ensure libgcc is initialised, if we don't do this here then the first call to backtrace might try to do the
+    // initilisation which involves calls to malloc
+    // if this happens from a signal handler then it could cause a deadlock
+    void *buffer = nullptr;
+    expect(::backtrace(&buffer, 1u) == 1u, "failed to initialise libgcc");
+
+    if (start_immediately)
+    {
+        start();
+    }
+}
+
+Profiler::~Profiler()
+{
+    stop();
+}
+
+void Profiler::start()
+{
+    if (impl_->running)
+    {
+        return;
+    }
+
+    impl_->analyser = ProfilerAnalyser{};
+    impl_->dropped_samples = 0u;
+    impl_->running = true;
+
+    // create a new thread for managing timers and draining samples, this thread will be excluded from the sampling
+    // the frequency is passed by value, so all threads (including ones found mid run) are sampled at the same rate and
+    // it can safely be changed while running
+    impl_->worker = Thread([this, frequency = impl_->sample_frequency]() {
+        while (impl_->running)
+        {
+            impl_->sync_threads(frequency);
+            impl_->drain();
+
+            std::this_thread::sleep_for(drain_interval);
         }
 
-        pa.print();
+        impl_->release_threads();
     });
 }
 
-Profiler::~Profiler()
+void Profiler::stop()
 {
+    if (!impl_->running)
+    {
+        return;
+    }
+
     impl_->running = false;
     impl_->worker.join();
+
+    if (impl_->dropped_samples != 0u)
+    {
+        LOG_ENGINE_WARN(
+            "profiler", "dropped {} samples, consider lowering the sample frequency", impl_->dropped_samples);
+    }
+
+    impl_->analyser.write(impl_->format, impl_->output_path);
+}
+
+bool Profiler::is_running() const
+{
+    return impl_->running;
+}
+
+void Profiler::set_sample_frequency(std::uint32_t frequency)
+{
+    ensure((frequency > 0u) && (frequency <= 10'000u), "sample frequency out of range");
+    impl_->sample_frequency = frequency;
+}
+
+void Profiler::set_output_format(ProfilerOutputFormat format)
+{
+    impl_->format = format;
+}
+
+void Profiler::set_output_path(const std::filesystem::path &output_path)
+{
+    impl_->output_path = output_path;
 }
 
 }
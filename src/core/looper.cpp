@@ -7,6 +7,40 @@
 #include "core/looper.h"
 
 #include <chrono>
+#include <cstdint>
+#include <thread>
+
+#include "core/latency_tracker.h"
+#include "core/scoped_timer.h"
+#include "core/telemetry.h"
+
+namespace
+{
+
+/**
+ * Sleep until a given time. OS sleep granularity is typically around a millisecond (and can be much worse) so for
+ * better precision the last part of the wait can be spent spinning instead, at the cost of burning cpu.
+ *
+ * @param deadline
+ *   Time to sleep until.
+ *
+ * @param spin_time
+ *   How much of the end of the wait to spin for rather than sleep.
+ */
+void precise_sleep_until(std::chrono::steady_clock::time_point deadline, std::chrono::microseconds spin_time)
+{
+    if (const auto now = std::chrono::steady_clock::now(); deadline - now > spin_time)
+    {
+        std::this_thread::sleep_until(deadline - spin_time);
+    }
+
+    while (std::chrono::steady_clock::now() < deadline)
+    {
+        std::this_thread::yield();
+    }
+}
+
+}
 
 namespace iris
 {
@@ -16,15 +50,57 @@ Looper::Looper(
     std::chrono::microseconds timestep,
     LoopFunction fixed_timestep,
     LoopFunction variable_timestep)
+    : Looper(
+          clock,
+          timestep,
+          fixed_timestep,
+          [variable_timestep](std::chrono::microseconds clock, std::chrono::microseconds delta, float)
+          { return variable_timestep(clock, delta); })
+{
+}
+
+Looper::Looper(
+    std::chrono::microseconds clock,
+    std::chrono::microseconds timestep,
+    LoopFunction fixed_timestep,
+    InterpolatedLoopFunction variable_timestep)
     : clock_(clock)
     , timestep_(timestep)
     , fixed_timestep_(fixed_timestep)
     , variable_timestep_(variable_timestep)
+    , min_frame_time_(0)
+    , spin_time_(0)
+    , max_fixed_steps_(0u)
 {
 }
 
+void Looper::set_frame_limit(std::chrono::microseconds min_frame_time)
+{
+    min_frame_time_ = min_frame_time;
+}
+
+void Looper::set_frame_limit_spin(std::chrono::microseconds spin_time)
+{
+    spin_time_ = spin_time;
+}
+
+void Looper::set_max_fixed_steps(std::uint32_t max_fixed_steps)
+{
+    max_fixed_steps_ = max_fixed_steps;
+}
+
 void Looper::run()
 {
+    auto &telemetry = Telemetry::instance();
+    auto &frame_time_histogram = telemetry.histogram("looper.frame_time");
+    auto &fixed_step_histogram = telemetry.histogram("looper.fixed_step");
+    auto &variable_step_histogram = telemetry.histogram("looper.variable_step");
+    auto &frame_counter = telemetry.counter("looper.frames");
+    auto &fixed_step_counter = telemetry.counter("looper.fixed_steps");
+    auto &fixed_step_overrun_counter = telemetry.counter("looper.fixed_step_overruns");
+    auto &catch_up_limited_counter = telemetry.counter("looper.catch_up_limited");
+    auto &latency_tracker = LatencyTracker::instance();
+
     auto run = true;
     auto start = std::chrono::steady_clock::now();
     std::chrono::steady_clock::duration accumulator(0);
@@ -36,19 +112,62 @@ void Looper::run()
         const auto frame_time = end - start;
         start = end;
 
+        // input received from here on is stamped with the new frame
+        latency_tracker.begin_frame();
+
+        frame_time_histogram.record(std::chrono::duration_cast<std::chrono::microseconds>(frame_time));
+        frame_counter.add();
+
         // variable time step function produces time
         accumulator += frame_time;
 
         // fixed time step function consumed time
+        auto fixed_steps = 0u;
         while (run && (accumulator >= timestep_))
         {
+            // if we've hit the step limit then drop the time we can't simulate, rather than letting it carry over and
+            // cause even more steps next frame
+            if ((max_fixed_steps_ != 0u) && (fixed_steps == max_fixed_steps_))
+            {
+                accumulator %= timestep_;
+                catch_up_limited_counter.add();
+                break;
+            }
+
+            const auto step_start = std::chrono::steady_clock::now();
             run &= fixed_timestep_(clock_, timestep_);
+            const auto step_time = std::chrono::duration_cast<std::chrono::microseconds>(
+                std::chrono::steady_clock::now() - step_start);
+
+            // a fixed step taking longer than the time it simulates means we can never catch up
+            fixed_step_histogram.record(step_time);
+            fixed_step_counter.add();
+            if (step_time > timestep_)
+            {
+                fixed_step_overrun_counter.add();
+            }
 
             accumulator -= timestep_;
             clock_ += timestep_;
+            ++fixed_steps;
         }
 
-        run &= variable_timestep_(clock_, std::chrono::duration_cast<std::chrono::microseconds>(frame_time));
+        // how far we are between the last fixed step and the next one
+        const auto alpha = std::chrono::duration<float>(accumulator) / std::chrono::duration<float>(timestep_);
+
+        {
+            ScopedTimer timer{variable_step_histogram};
+            run &= variable_timestep_(
+                clock_, std::chrono::duration_cast<std::chrono::microseconds>(frame_time), alpha);
+        }
+
+        telemetry.tick();
+
+        // frame limiter, sleep away whatever time is left in this frame
+        if (run && (min_frame_time_.count() > 0))
+        {
+            precise_sleep_until(start + min_frame_time_, spin_time_);
+        }
     } while (run);
 }
 
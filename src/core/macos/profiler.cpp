@@ -8,6 +8,8 @@
 
 #include <atomic>
 #include <cstddef>
+#include <cstdint>
+#include <filesystem>
 #include <memory>
 #include <numeric>
 #include <regex>
@@ -100,19 +102,53 @@ struct Profiler::implementation
 {
     Thread worker;
     std::atomic<bool> running;
+    std::uint32_t sample_frequency;
     std::vector<void *> stack_traces;
+    ProfilerOutputFormat format;
+    std::filesystem::path output_path;
+    ProfilerAnalyser analyser;
 };
 
 Profiler::Profiler()
+    : Profiler(ProfilerOutputFormat::TEXT, {}, true)
+{
+}
+
+Profiler::Profiler(ProfilerOutputFormat format, const std::filesystem::path &output_path, bool start_immediately)
     : impl_(std::make_unique<implementation>())
 {
     // reserve space for a stack frame for each thread
     impl_->stack_traces.resize(max_thread_count * stack_frame_size);
+    impl_->running = false;
+    impl_->sample_frequency = 100u;
+    impl_->format = format;
+    impl_->output_path = output_path;
+
+    if (start_immediately)
+    {
+        start();
+    }
+}
+
+Profiler::~Profiler()
+{
+    stop();
+}
+
+void Profiler::start()
+{
+    if (impl_->running)
+    {
+        return;
+    }
+
+    impl_->analyser = ProfilerAnalyser{};
     impl_->running = true;
 
     // create a new thread for handling the sampling, this thread will be excluded from the sampling
-    impl_->worker = Thread([&]() {
-        ProfilerAnalyser pa{};
+    // the frequency is passed by value, so it can safely be changed while running and only affects the next session
+    impl_->worker = Thread([this, frequency = impl_->sample_frequency]() {
+        auto &pa = impl_->analyser;
 
         while (impl_->running)
         {
@@ -188,7 +224,7 @@ Profiler::Profiler()
 
                 if (stack_size < stack_frame_size)
                 {
-                    impl_->stack_traces[stack_size] = nullptr;
+                    impl_->stack_traces[index + stack_size] = nullptr;
                 }
 
                 // DANGER ZONE END
@@ -240,19 +276,45 @@ Profiler::Profiler()
                 }
 
                 // record the resolved stack trace
-                pa.add_stack_trace(stack_trace);
+                pa.add_stack_trace(static_cast<std::uint64_t>(thread_list[i]), stack_trace);
             }
 
-            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+            std::this_thread::sleep_for(std::chrono::microseconds(1'000'000u / frequency));
         }
-
-        pa.print();
     });
 }
 
-Profiler::~Profiler()
+void Profiler::stop()
 {
+    if (!impl_->running)
+    {
+        return;
+    }
+
     impl_->running = false;
     impl_->worker.join();
+
+    impl_->analyser.write(impl_->format, impl_->output_path);
+}
+
+bool Profiler::is_running() const
+{
+    return impl_->running;
+}
+
+void Profiler::set_sample_frequency(std::uint32_t frequency)
+{
+    ensure((frequency > 0u) && (frequency <= 10'000u), "sample frequency out of range");
+    impl_->sample_frequency = frequency;
+}
+
+void Profiler::set_output_format(ProfilerOutputFormat format)
+{
+    impl_->format = format;
+}
+
+void Profiler::set_output_path(const std::filesystem::path &output_path)
+{
+    impl_->output_path = output_path;
 }
 }
@@ -7,16 +7,166 @@
 #include "core/profiler_analyser.h"
 
 #include <algorithm>
+#include <cstdint>
+#include <fstream>
 #include <iostream>
 #include <numeric>
+#include <ostream>
 #include <stack>
+#include <string>
+#include <string_view>
 #include <vector>
 
+#include "core/error_handling.h"
+
+namespace
+{
+
+/**
+ * Helper function to write a string as a JSON string literal, escaping as required.
+ *
+ * @param out
+ *   Stream to write to.
+ *
+ * @param str
+ *   String to write.
+ */
+void write_json_string(std::ostream &out, std::string_view str)
+{
+    static constexpr char hex[] = "0123456789abcdef";
+
+    out << '"';
+
+    for (const auto c : str)
+    {
+        switch (c)
+        {
+            case '"': out << "\\\""; break;
+            case '\\': out << "\\\\"; break;
+            case '\n': out << "\\n"; break;
+            case '\t': out << "\\t"; break;
+            default:
+                if (static_cast<unsigned char>(c) < 0x20u)
+                {
+                    out << "\\u00" << hex[(c >> 4) & 0xf] << hex[c & 0xf];
+                }
+                else
+                {
+                    out << c;
+                }
+        }
+    }
+
+    out << '"';
+}
+
+/**
+ * Minimal protobuf encoder, sufficient for writing the pprof schema.
+ *
+ * See https://developers.google.com/protocol-buffers/docs/encoding
+ */
+class ProtobufWriter
+{
+  public:
+    /**
+     * Write a varint field.
+     *
+     * @param field
+     *   Field number.
+     *
+     * @param value
+     *   Value to write.
+     */
+    void write_varint_field(std::uint32_t field, std::uint64_t value)
+    {
+        write_varint((static_cast<std::uint64_t>(field) << 3u) | 0u);
+        write_varint(value);
+    }
+
+    /**
+     * Write a length delimited field.
+     *
+     * @param field
+     *   Field number.
+     *
+     * @param bytes
+     *   Bytes to write.
+     */
+    void write_bytes_field(std::uint32_t field, std::string_view bytes)
+    {
+        write_varint((static_cast<std::uint64_t>(field) << 3u) | 2u);
+        write_varint(bytes.size());
+        buffer_.append(bytes);
+    }
+
+    /**
+     * Write a packed repeated varint field.
+     *
+     * @param field
+     *   Field number.
+     *
+     * @param values
+     *   Values to write.
+     */
+    void write_packed_field(std::uint32_t field, const std::vector<std::uint64_t> &values)
+    {
+        ProtobufWriter packed{};
+        for (const auto value : values)
+        {
+            packed.write_varint(value);
+        }
+
+        write_bytes_field(field, packed.buffer());
+    }
+
+    /**
+     * Get the encoded bytes.
+     *
+     * @returns
+     *   Encoded bytes.
+     */
+    const std::string &buffer() const
+    {
+        return buffer_;
+    }
+
+  private:
+    /**
+     * Write a base 128 varint.
+     *
+     * @param value
+     *   Value to write.
+     */
+    void write_varint(std::uint64_t value)
+    {
+        while (value >= 0x80u)
+        {
+            buffer_.push_back(static_cast<char>((value & 0x7fu) | 0x80u));
+            value >>= 7u;
+        }
+
+        buffer_.push_back(static_cast<char>(value));
+    }
+
+    /** Encoded bytes. */
+    std::string buffer_;
+};
+
+}
+
 namespace iris
 {
 
-void ProfilerAnalyser::add_stack_trace(const std::vector<std::string> &stack_trace)
+void ProfilerAnalyser::add_stack_trace(std::uint64_t thread_id, const std::vector<std::string> &stack_trace)
 {
+    if (stack_trace.empty())
+    {
+        return;
+    }
+
+    std::vector<std::uint32_t> frame_ids{};
+    frame_ids.reserve(stack_trace.size());
+
     Level *cursor = &root_level_;
 
     // walk back through the stack trace
@@ -43,10 +193,33 @@ void ProfilerAnalyser::add_stack_trace(const std::vector<std::string> &stack_tra
             ++cursor->hit_count;
             cursor = std::addressof(*child);
         }
+
+        // intern the function name so the exporters can refer to it by id
+        auto [frame, inserted] =
+            frame_lookup_.try_emplace(function, static_cast<std::uint32_t>(frames_.size()));
+        if (inserted)
+        {
+            frames_.push_back(function);
+        }
+
+        frame_ids.push_back(frame->second);
     }
+
+    ++thread_stacks_[thread_id][frame_ids];
+    ++sample_count_;
+}
+
+std::uint32_t ProfilerAnalyser::sample_count() const
+{
+    return sample_count_;
 }
 
 void ProfilerAnalyser::print()
+{
+    write_text(std::cout);
+}
+
+void ProfilerAnalyser::write_text(std::ostream &out)
 {
     const auto total_hits = root_level_.hit_count;
     std::stack<std::tuple<Level *, std::uint32_t>> stack;
@@ -66,8 +239,8 @@ void ProfilerAnalyser::print()
         const auto percentage = static_cast<float>(level->hit_count) / static_cast<float>(total_hits);
 
         // print out line
-        std::cout << "|-" << std::string(indent, '-') << level->name << " (" << level->hit_count << " | "
-                  << percentage * 100.0f << ")" << std::endl;
+        out << "|-" << std::string(indent, '-') << level->name << " (" << level->hit_count << " | "
+            << percentage * 100.0f << ")\n";
 
         for (auto &child : level->children)
         {
@@ -76,4 +249,183 @@ void ProfilerAnalyser::print()
     }
 }
 
+void ProfilerAnalyser::write(ProfilerOutputFormat format, std::ostream &out)
+{
+    switch (format)
+    {
+        case ProfilerOutputFormat::TEXT: write_text(out); break;
+        case ProfilerOutputFormat::COLLAPSED: write_collapsed(out); break;
+        case ProfilerOutputFormat::SPEEDSCOPE: write_speedscope(out); break;
+        case ProfilerOutputFormat::PPROF: write_pprof(out); break;
+        default: throw Exception("unknown profiler output format");
+    }
+}
+
+void ProfilerAnalyser::write(ProfilerOutputFormat format, const std::filesystem::path &path)
+{
+    if (path.empty())
+    {
+        write(format, std::cout);
+    }
+    else
+    {
+        std::ofstream file{path, std::ios::out | std::ios::binary | std::ios::trunc};
+        ensure(file.is_open(), "could not open profiler output file");
+
+        write(format, file);
+    }
+}
+
+void ProfilerAnalyser::write_collapsed(std::ostream &out) const
+{
+    for (const auto &[thread_id, stacks] : thread_stacks_)
+    {
+        for (const auto &[stack, count] : stacks)
+        {
+            out << "thread-" << thread_id;
+
+            for (const auto frame_id : stack)
+            {
+                // semicolons are the frame separator, so make sure they don't appear in names
+                auto name = frames_[frame_id];
+                std::replace(std::begin(name), std::end(name), ';', ':');
+
+                out << ';' << name;
+            }
+
+            out << ' ' << count << '\n';
+        }
+    }
+}
+
+void ProfilerAnalyser::write_speedscope(std::ostream &out) const
+{
+    out << R"({"$schema":"https://www.speedscope.app/file-format-schema.json","exporter":"iris","name":"iris",)";
+    out << R"("activeProfileIndex":0,"shared":{"frames":[)";
+
+    for (auto i = 0u; i < frames_.size(); ++i)
+    {
+        out << (i == 0u ? "" : ",") << R"({"name":)";
+        write_json_string(out, frames_[i]);
+        out << '}';
+    }
+
+    out << R"(]},"profiles":[)";
+
+    auto first_profile = true;
+    for (const auto &[thread_id, stacks] : thread_stacks_)
+    {
+        const auto total = std::accumulate(
+            std::cbegin(stacks), std::cend(stacks), std::uint64_t{0u}, [](auto acc, const auto &element) {
+                return acc + element.second;
+            });
+
+        out << (first_profile ? "" : ",");
+        out << R"({"type":"sampled","name":"thread-)" << thread_id << R"(","unit":"none","startValue":0,)";
+        out << R"("endValue":)" << total << R"(,"samples":[)";
+
+        auto first_stack = true;
+        for (const auto &[stack, count] : stacks)
+        {
+            out << (first_stack ? "[" : ",[");
+
+            for (auto i = 0u; i < stack.size(); ++i)
+            {
+                out << (i == 0u ? "" : ",") << stack[i];
+            }
+
+            out << ']';
+            first_stack = false;
+        }
+
+        out << R"(],"weights":[)";
+
+        first_stack = true;
+        for (const auto &[stack, count] : stacks)
+        {
+            out << (first_stack ? "" : ",") << count;
+            first_stack = false;
+        }
+
+        out << "]}";
+        first_profile = false;
+    }
+
+    out << "]}";
+}
+
+void ProfilerAnalyser::write_pprof(std::ostream &out) const
+{
+    // fixed entries at the start of the string table, frame names follow
+    static constexpr std::uint64_t samples_string = 1u;
+    static constexpr std::uint64_t count_string = 2u;
+    static constexpr std::uint64_t thread_string = 3u;
+    static constexpr std::uint64_t first_frame_string = 4u;
+
+    ProtobufWriter profile{};
+
+    // sample_type and period_type are both ValueType {type, unit}
+    ProtobufWriter value_type{};
+    value_type.write_varint_field(1u, samples_string);
+    value_type.write_varint_field(2u, count_string);
+    profile.write_bytes_field(1u, value_type.buffer());
+
+    for (const auto &[thread_id, stacks] : thread_stacks_)
+    {
+        for (const auto &[stack, count] : stacks)
+        {
+            // pprof expects the innermost location first, ids are 1 based
+            std::vector<std::uint64_t> location_ids(stack.size());
+            std::transform(std::crbegin(stack), std::crend(stack), std::begin(location_ids), [](const auto frame_id) {
+                return static_cast<std::uint64_t>(frame_id) + 1u;
+            });
+
+            ProtobufWriter label{};
+            label.write_varint_field(1u, thread_string);
+            label.write_varint_field(3u, thread_id);
+
+            ProtobufWriter sample{};
+            sample.write_packed_field(1u, location_ids);
+            sample.write_packed_field(2u, {count});
+            sample.write_bytes_field(3u, label.buffer());
+
+            profile.write_bytes_field(2u, sample.buffer());
+        }
+    }
+
+    // we don't have address information, so each frame gets a location with a single line referencing its function
+    for (auto i = 0u; i < frames_.size(); ++i)
+    {
+        const std::uint64_t id = i + 1u;
+
+        ProtobufWriter line{};
+        line.write_varint_field(1u, id);
+
+        ProtobufWriter location{};
+        location.write_varint_field(1u, id);
+        location.write_bytes_field(4u, line.buffer());
+        profile.write_bytes_field(4u, location.buffer());
+
+        ProtobufWriter function{};
+        function.write_varint_field(1u, id);
+        function.write_varint_field(2u, first_frame_string + i);
+        function.write_varint_field(3u, first_frame_string + i);
+        profile.write_bytes_field(5u, function.buffer());
+    }
+
+    profile.write_bytes_field(6u, "");
+    profile.write_bytes_field(6u, "samples");
+    profile.write_bytes_field(6u, "count");
+    profile.write_bytes_field(6u, "thread");
+    for (const auto &frame : frames_)
+    {
+        profile.write_bytes_field(6u, frame);
+    }
+
+    profile.write_bytes_field(11u, value_type.buffer());
+    profile.write_varint_field(12u, 1u);
+
+    out.write(profile.buffer().data(), static_cast<std::streamsize>(profile.buffer().size()));
+}
+
 }
@@ -6,53 +6,193 @@
 
 #include "core/random.h"
 
+#include <atomic>
+#include <cmath>
+#include <cstdint>
+#include <numbers>
 #include <random>
+#include <span>
+
+#include "core/random_generator.h"
+#include "core/vector3.h"
 
 namespace
 {
 
-// ensure each thread gets its own random_device
-thread_local std::random_device device;
+/**
+ * Helper function to get a non-deterministic seed.
+ *
+ * @returns
+ *   Random seed.
+ */
+std::uint64_t device_seed()
+{
+    std::random_device device{};
+    return (static_cast<std::uint64_t>(device()) << 32u) | device();
+}
 
 /**
- * Helper function to generate a random value with a given distribution.
+ * splitmix64, used to expand a seed into generator state.
  *
- * @param distribution
- *   Distribution of random value.
+ * @param x
+ *   State to advance.
  *
  * @returns
- *   Random value with given distribution.
+ *   Next value.
  */
-template <class T>
-typename T::result_type generate(T distribution)
+std::uint64_t splitmix64(std::uint64_t &x)
 {
-    std::mt19937 engine(device());
-    return distribution(engine);
+    auto z = (x += 0x9e3779b97f4a7c15ull);
+    z = (z ^ (z >> 30u)) * 0xbf58476d1ce4e5b9ull;
+    z = (z ^ (z >> 27u)) * 0x94d049bb133111ebull;
+    return z ^ (z >> 31u);
 }
 
+// seed shared by all thread generators, the epoch is bumped whenever it changes so each thread knows to reseed
+std::atomic<std::uint64_t> global_seed{device_seed()};
+std::atomic<std::uint32_t> seed_epoch{0u};
+std::atomic<std::uint64_t> next_stream{0u};
+
+/**
+ * Per thread generator state.
+ */
+struct ThreadGenerator
+{
+    iris::RandomGenerator generator{};
+    std::uint64_t stream = next_stream.fetch_add(1u, std::memory_order_relaxed);
+    std::uint32_t epoch = ~0u;
+};
+
+thread_local ThreadGenerator thread_generator{};
+
 }
 
 namespace iris
 {
 
+RandomGenerator::RandomGenerator(std::uint64_t seed, std::uint64_t stream)
+    : state_()
+{
+    this->seed(seed, stream);
+}
+
+void RandomGenerator::seed(std::uint64_t seed, std::uint64_t stream)
+{
+    // mix the stream in before expanding, so neighbouring streams don't produce related state
+    auto x = seed;
+    x ^= splitmix64(stream);
+
+    for (auto &word : state_)
+    {
+        word = splitmix64(x);
+    }
+}
+
+Vector3 RandomGenerator::unit_vector()
+{
+    // uniform z and angle gives a uniform distribution over the sphere (Archimedes' hat-box theorem)
+    const auto z = uniform_float(-1.0f, 1.0f);
+    const auto angle = uniform_float(0.0f, 2.0f * std::numbers::pi_v<float>);
+    const auto r = std::sqrt(1.0f - z * z);
+
+    return {r * std::cos(angle), r * std::sin(angle), z};
+}
+
+void RandomGenerator::fill_uint32(std::span<std::uint32_t> out, std::uint32_t min, std::uint32_t max)
+{
+    for (auto &value : out)
+    {
+        value = uniform_uint32(min, max);
+    }
+}
+
+void RandomGenerator::fill_int32(std::span<std::int32_t> out, std::int32_t min, std::int32_t max)
+{
+    for (auto &value : out)
+    {
+        value = uniform_int32(min, max);
+    }
+}
+
+void RandomGenerator::fill_float(std::span<float> out, float min, float max)
+{
+    for (auto &value : out)
+    {
+        value = uniform_float(min, max);
+    }
+}
+
+void RandomGenerator::fill_unit_vector(std::span<Vector3> out)
+{
+    for (auto &value : out)
+    {
+        value = unit_vector();
+    }
+}
+
+RandomGenerator &thread_random_generator()
+{
+    auto &thread = thread_generator;
+
+    if (const auto epoch = seed_epoch.load(std::memory_order_acquire); thread.epoch != epoch)
+    {
+        thread.generator.seed(global_seed.load(std::memory_order_relaxed), thread.stream);
+        thread.epoch = epoch;
+    }
+
+    return thread.generator;
+}
+
+void set_random_seed(std::uint64_t seed)
+{
+    global_seed.store(seed, std::memory_order_relaxed);
+    seed_epoch.fetch_add(1u, std::memory_order_release);
+}
+
+void set_thread_random_stream(std::uint64_t stream)
+{
+    thread_generator.stream = stream;
+    thread_generator.epoch = ~0u;
+}
+
 std::uint32_t random_uint32(std::uint32_t min, std::uint32_t max)
 {
-    return generate(std::uniform_int_distribution<>(min, max));
+    return thread_random_generator().uniform_uint32(min, max);
 }
 
 std::int32_t random_int32(std::int32_t min, std::int32_t max)
 {
-    return generate(std::uniform_int_distribution<>(min, max));
+    return thread_random_generator().uniform_int32(min, max);
 }
 
 float random_float(float min, float max)
 {
-    return generate(std::uniform_real_distribution<float>(min, max));
+    return thread_random_generator().uniform_float(min, max);
 }
 
 bool flip_coin(float bias)
 {
-    return generate(std::bernoulli_distribution(bias));
+    return thread_random_generator().flip_coin(bias);
+}
+
+void random_uint32s(std::span<std::uint32_t> out, std::uint32_t min, std::uint32_t max)
+{
+    thread_random_generator().fill_uint32(out, min, max);
+}
+
+void random_int32s(std::span<std::int32_t> out, std::int32_t min, std::int32_t max)
+{
+    thread_random_generator().fill_int32(out, min, max);
+}
+
+void random_floats(std::span<float> out, float min, float max)
+{
+    thread_random_generator().fill_float(out, min, max);
+}
+
+void random_unit_vectors(std::span<Vector3> out)
+{
+    thread_random_generator().fill_unit_vector(out);
 }
 
 }
@@ -11,6 +11,7 @@
 #include <sstream>
 
 #include "core/error_handling.h"
+#include "core/string_id.h"
 
 namespace iris
 {
@@ -23,19 +24,27 @@ ResourceManager::ResourceManager()
 const DataBuffer &ResourceManager::load(std::string_view resource)
 {
     // lookup resource
-    auto loaded_resource = resources_.find(resource);
+    auto loaded_resource = resources_.find(StringId{resource});
 
     // if not found load from disk, treat resource as a path relative to
     // root
     if (loaded_resource == std::cend(resources_))
     {
-        const auto [iter, _] = resources_.insert({std::string{resource}, do_load(resource)});
+        const auto [iter, _] = resources_.insert({StringId::intern(resource), do_load(resource)});
         loaded_resource = iter;
     }
 
     return loaded_resource->second;
 }
 
+const DataBuffer &ResourceManager::load(StringId resource) const
+{
+    const auto loaded_resource = resources_.find(resource);
+    expect(loaded_resource != std::cend(resources_), "resource has not been loaded");
+
+    return loaded_resource->second;
+}
+
 void ResourceManager::set_root_directory(const std::filesystem::path &root)
 {
     root_ = root;
@@ -0,0 +1,84 @@
+////////////////////////////////////////////////////////////////////////////////
+//         Distributed under the Boost Software License, Version 1.0.         //
+//            (See accompanying file LICENSE or copy at                       //
+//                 https://www.boost.org/LICENSE_1_0.txt)                     //
+////////////////////////////////////////////////////////////////////////////////
+
+#include "core/string_id.h"
+
+#include <string_view>
+
+#if !defined(NDEBUG) || defined(IRIS_FORCE_EXPECT)
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+#include "core/error_handling.h"
+#endif
+
+namespace
+{
+
+#if !defined(NDEBUG) || defined(IRIS_FORCE_EXPECT)
+
+/**
+ * Debug table of interned strings.
+ */
+struct NameTable
+{
+    std::unordered_map<std::uint64_t, std::string> names;
+    std::mutex mutex;
+};
+
+/**
+ * Get the name table, constructed on first use so ids can be interned during static initialisation.
+ *
+ * @returns
+ *   Name table.
+ */
+NameTable &name_table()
+{
+    static NameTable table{};
+    return table;
+}
+
+#endif
+
+}
+
+namespace iris
+{
+
+StringId StringId::intern(std::string_view str)
+{
+    const StringId id{str};
+
+#if !defined(NDEBUG) || defined(IRIS_FORCE_EXPECT)
+    auto &table = name_table();
+    std::unique_lock lock(table.mutex);
+
+    const auto [iter, inserted] = table.names.try_emplace(id.value(), str);
+    expect(inserted || (iter->second == str), "string id collision");
+#endif
+
+    return id;
+}
+
+std::string_view StringId::name() const
+{
+#if !defined(NDEBUG) || defined(IRIS_FORCE_EXPECT)
+    auto &table = name_table();
+    std::unique_lock lock(table.mutex);
+
+    // entries are never removed so the string outlives the lock
+    if (const auto find = table.names.find(value_); find != std::cend(table.names))
+    {
+        return find->second;
+    }
+#endif
+
+    return {};
+}
+
+}
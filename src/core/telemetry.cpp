@@ -0,0 +1,206 @@
+////////////////////////////////////////////////////////////////////////////////
+//         Distributed under the Boost Software License, Version 1.0.         //
+//            (See accompanying file LICENSE or copy at                       //
+//                 https://www.boost.org/LICENSE_1_0.txt)                     //
+////////////////////////////////////////////////////////////////////////////////
+
+#include "core/telemetry.h"
+
+#include <chrono>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <string_view>
+
+#include "core/error_handling.h"
+
+namespace
+{
+
+/**
+ * Helper function to get the current steady clock time in nanoseconds.
+ *
+ * @returns
+ *   Current time.
+ */
+std::int64_t now_ns()
+{
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch())
+        .count();
+}
+
+}
+
+namespace iris
+{
+
+Telemetry &Telemetry::instance()
+{
+    static Telemetry telemetry{};
+    return telemetry;
+}
+
+Telemetry::Telemetry()
+    : counters_()
+    , histograms_()
+    , exporter_()
+    , export_interval_(0)
+    , next_export_(0)
+    , mutex_()
+{
+}
+
+TelemetryCounter &Telemetry::counter(std::string_view name)
+{
+    std::unique_lock lock(mutex_);
+
+    auto iter = counters_.find(name);
+    if (iter == std::cend(counters_))
+    {
+        iter = counters_.emplace(std::string{name}, std::make_unique<TelemetryCounter>()).first;
+    }
+
+    return *iter->second;
+}
+
+Histogram &Telemetry::histogram(std::string_view name)
+{
+    std::unique_lock lock(mutex_);
+
+    auto iter = histograms_.find(name);
+    if (iter == std::cend(histograms_))
+    {
+        iter = histograms_.emplace(std::string{name}, std::make_unique<Histogram>()).first;
+    }
+
+    return *iter->second;
+}
+
+TelemetrySnapshot Telemetry::snapshot() const
+{
+    std::unique_lock lock(mutex_);
+
+    TelemetrySnapshot snapshot{.timestamp = std::chrono::system_clock::now()};
+
+    for (const auto &[name, counter] : counters_)
+    {
+        snapshot.counters.emplace(name, counter->value());
+    }
+
+    for (const auto &[name, histogram] : histograms_)
+    {
+        snapshot.histograms.emplace(name, histogram->summary());
+    }
+
+    return snapshot;
+}
+
+void Telemetry::set_exporter(Exporter exporter, std::chrono::milliseconds interval)
+{
+    ensure(interval.count() > 0, "export interval must be positive");
+    ensure(!!exporter, "exporter must be callable");
+
+    std::unique_lock lock(mutex_);
+
+    exporter_ = std::move(exporter);
+    export_interval_ = interval;
+    next_export_ = now_ns() + std::chrono::duration_cast<std::chrono::nanoseconds>(interval).count();
+}
+
+void Telemetry::clear_exporter()
+{
+    std::unique_lock lock(mutex_);
+
+    exporter_ = nullptr;
+    next_export_ = 0;
+}
+
+void Telemetry::tick()
+{
+    // fast path, this is called every frame so avoid taking the lock unless we need to export
+    const auto next_export = next_export_.load(std::memory_order_relaxed);
+    const auto now = now_ns();
+
+    if ((next_export == 0) || (now < next_export))
+    {
+        return;
+    }
+
+    TelemetrySnapshot snapshot{.timestamp = std::chrono::system_clock::now()};
+    Exporter exporter{};
+
+    {
+        std::unique_lock lock(mutex_);
+
+        if (!exporter_)
+        {
+            return;
+        }
+
+        for (const auto &[name, counter] : counters_)
+        {
+            snapshot.counters.emplace(name, counter->value());
+        }
+
+        // summarise and reset each histogram in one step, so values recorded in between aren't dropped from every
+        // export
+        for (const auto &[name, histogram] : histograms_)
+        {
+            snapshot.histograms.emplace(name, histogram->take_summary());
+        }
+
+        next_export_ = now + std::chrono::duration_cast<std::chrono::nanoseconds>(export_interval_).count();
+        exporter = exporter_;
+    }
+
+    // call outside of the lock so the exporter is free to use the Telemetry object
+    exporter(snapshot);
+}
+
+Telemetry::Exporter Telemetry::file_exporter(const std::filesystem::path &path)
+{
+    auto file = std::make_shared<std::ofstream>(path, std::ios::out | std::ios::app);
+    ensure(file->is_open(), "could not open telemetry file");
+
+    return [file](const TelemetrySnapshot &snapshot)
+    {
+        write_json(snapshot, *file);
+        *file << '\n';
+        file->flush();
+    };
+}
+
+void Telemetry::write_json(const TelemetrySnapshot &snapshot, std::ostream &out)
+{
+    const auto timestamp =
+        std::chrono::duration_cast<std::chrono::milliseconds>(snapshot.timestamp.time_since_epoch()).count();
+
+    // metric names are chosen by the engine/user and are expected to be simple identifiers, so are not escaped
+    out << R"({"timestamp_ms":)" << timestamp << R"(,"counters":{)";
+
+    auto first = true;
+    for (const auto &[name, value] : snapshot.counters)
+    {
+        out << (first ? "" : ",") << '"' << name << R"(":)" << value;
+        first = false;
+    }
+
+    out << R"(},"histograms":{)";
+
+    first = true;
+    for (const auto &[name, summary] : snapshot.histograms)
+    {
+        out << (first ? "" : ",") << '"' << name << R"(":{"count":)" << summary.count << R"(,"min_us":)"
+            << summary.min << R"(,"max_us":)" << summary.max << R"(,"mean_us":)" << summary.mean << R"(,"p50_us":)"
+            << summary.p50 << R"(,"p95_us":)" << summary.p95 << R"(,"p99_us":)" << summary.p99 << '}';
+        first = false;
+    }
+
+    out << "}}";
+}
+
+}
@@ -0,0 +1,252 @@
+////////////////////////////////////////////////////////////////////////////////
+//         Distributed under the Boost Software License, Version 1.0.         //
+//            (See accompanying file LICENSE or copy at                       //
+//                 https://www.boost.org/LICENSE_1_0.txt)                     //
+////////////////////////////////////////////////////////////////////////////////
+
+#include "core/trace_recorder.h"
+
+#include <chrono>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <utility>
+#include <vector>
+
+#include "core/error_handling.h"
+
+namespace
+{
+
+/**
+ * Helper function to write a nanosecond value as (fractional) microseconds, which is what the Chrome trace format
+ * expects.
+ *
+ * @param out
+ *   Stream to write to.
+ *
+ * @param ns
+ *   Nanoseconds to write.
+ */
+void write_microseconds(std::ostream &out, std::uint64_t ns)
+{
+    out << ns / 1000u << '.' << std::setw(3) << std::setfill('0') << ns % 1000u;
+}
+
+}
+
+namespace iris
+{
+
+TraceRecorder &TraceRecorder::instance()
+{
+    static TraceRecorder recorder{};
+    return recorder;
+}
+
+TraceRecorder::TraceRecorder()
+    : recording_(false)
+    , epoch_(0u)
+    , thread_capacity_(1u << 16u)
+    , buffers_()
+    , free_buffers_()
+    , mutex_()
+{
+}
+
+TraceRecorder::~TraceRecorder() = default;
+
+std::uint64_t TraceRecorder::now()
+{
+    return static_cast<std::uint64_t>(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch())
+            .count());
+}
+
+void TraceRecorder::start()
+{
+    // bumping the epoch causes each thread to reset its own buffer the next time it records, so we never have to
+    // touch a buffer another thread may be writing to
+    ++epoch_;
+    recording_ = true;
+}
+
+void TraceRecorder::stop()
+{
+    recording_ = false;
+}
+
+void TraceRecorder::set_thread_capacity(std::size_t capacity)
+{
+    ensure(capacity > 0u, "capacity must be non-zero");
+
+    std::unique_lock lock(mutex_);
+    thread_capacity_ = capacity;
+}
+
+void TraceRecorder::record(const char *name, std::uint64_t begin, std::uint64_t end)
+{
+    if (!is_recording())
+    {
+        return;
+    }
+
+    auto *buffer = thread_buffer();
+
+    // reset the buffer if it contains zones from a previous recording
+    const auto epoch = epoch_.load(std::memory_order_relaxed);
+    if (buffer->epoch.load(std::memory_order_relaxed) != epoch)
+    {
+        buffer->size.store(0u, std::memory_order_relaxed);
+        buffer->dropped.store(0u, std::memory_order_relaxed);
+        buffer->epoch.store(epoch, std::memory_order_release);
+    }
+
+    const auto size = buffer->size.load(std::memory_order_relaxed);
+    if (size < buffer->zones.size())
+    {
+        buffer->zones[size] = {.name = name, .begin = begin, .end = end};
+        buffer->size.store(size + 1u, std::memory_order_release);
+    }
+    else
+    {
+        buffer->dropped.fetch_add(1u, std::memory_order_relaxed);
+    }
+}
+
+std::uint64_t TraceRecorder::dropped_count() const
+{
+    std::unique_lock lock(mutex_);
+
+    const auto epoch = epoch_.load();
+    std::uint64_t dropped = 0u;
+
+    for (const auto &buffer : buffers_)
+    {
+        if (buffer->epoch.load(std::memory_order_acquire) == epoch)
+        {
+            dropped += buffer->dropped.load(std::memory_order_relaxed);
+        }
+    }
+
+    return dropped;
+}
+
+std::vector<std::pair<std::uint32_t, std::vector<TraceRecorder::Zone>>> TraceRecorder::zones() const
+{
+    std::unique_lock lock(mutex_);
+
+    const auto epoch = epoch_.load();
+    std::vector<std::pair<std::uint32_t, std::vector<Zone>>> zones{};
+
+    for (const auto &buffer : buffers_)
+    {
+        // skip any threads which haven't recorded since the last start
+        if (buffer->epoch.load(std::memory_order_acquire) != epoch)
+        {
+            continue;
+        }
+
+        const auto size = buffer->size.load(std::memory_order_acquire);
+        zones.emplace_back(
+            buffer->thread_id,
+            std::vector<Zone>(std::cbegin(buffer->zones), std::cbegin(buffer->zones) + size));
+    }
+
+    return zones;
+}
+
+void TraceRecorder::write_chrome_trace(std::ostream &out) const
+{
+    out << R"({"displayTimeUnit":"ns","traceEvents":[)";
+
+    auto first = true;
+    for (const auto &[thread_id, zones] : this->zones())
+    {
+        // name each thread so it's easy to identify in the trace viewer
+        out << (first ? "" : ",") << R"({"name":"thread_name","ph":"M","pid":1,"tid":)" << thread_id
+            << R"(,"args":{"name":"thread-)" << thread_id << R"("}})";
+        first = false;
+
+        for (const auto &zone : zones)
+        {
+            // zone names are string literals, so we don't bother escaping them
+            out << R"(,{"name":")" << zone.name << R"(","ph":"X","pid":1,"tid":)" << thread_id << R"(,"ts":)";
+            write_microseconds(out, zone.begin);
+            out << R"(,"dur":)";
+            write_microseconds(out, zone.end - zone.begin);
+            out << '}';
+        }
+    }
+
+    out << "]}";
+}
+
+void TraceRecorder::write_chrome_trace(const std::filesystem::path &path) const
+{
+    std::ofstream file{path, std::ios::out | std::ios::trunc};
+    ensure(file.is_open(), "could not open trace file");
+
+    write_chrome_trace(file);
+}
+
+TraceRecorder::ThreadBufferOwner::~ThreadBufferOwner()
+{
+    if (buffer != nullptr)
+    {
+        recorder->release_thread_buffer(buffer);
+    }
+}
+
+TraceRecorder::ThreadBuffer *TraceRecorder::thread_buffer()
+{
+    thread_local ThreadBufferOwner owner{};
+
+    if (owner.buffer == nullptr)
+    {
+        std::unique_lock lock(mutex_);
+
+        if (!free_buffers_.empty())
+        {
+            // reuse the buffer of an exited thread, its zones are kept (the epoch check in record resets it if they
+            // are stale) unless the capacity has changed
+            owner.buffer = free_buffers_.back();
+            free_buffers_.pop_back();
+
+            if (owner.buffer->zones.size() != thread_capacity_)
+            {
+                owner.buffer->zones.resize(thread_capacity_);
+                owner.buffer->size = 0u;
+                owner.buffer->dropped = 0u;
+            }
+        }
+        else
+        {
+            auto new_buffer = std::make_unique<ThreadBuffer>();
+            new_buffer->thread_id = static_cast<std::uint32_t>(buffers_.size() + 1u);
+            new_buffer->epoch = epoch_.load();
+            new_buffer->size = 0u;
+            new_buffer->dropped = 0u;
+            new_buffer->zones.resize(thread_capacity_);
+
+            owner.buffer = new_buffer.get();
+            buffers_.emplace_back(std::move(new_buffer));
+        }
+
+        owner.recorder = this;
+    }
+
+    return owner.buffer;
+}
+
+void TraceRecorder::release_thread_buffer(ThreadBuffer *buffer)
+{
+    std::unique_lock lock(mutex_);
+    free_buffers_.push_back(buffer);
+}
+
+}
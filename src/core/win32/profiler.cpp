@@ -6,8 +6,11 @@
 
 #include "core/profiler.h"
 
+#include <algorithm>
 #include <atomic>
 #include <cstddef>
+#include <cstdint>
+#include <filesystem>
 #include <memory>
 #include <thread>
 #include <vector>
@@ -158,10 +161,20 @@ struct Profiler::implementation
 {
     Thread worker;
     std::atomic<bool> running;
+    std::uint32_t sample_frequency;
     std::vector<DWORD64> stack_traces;
+    std::vector<std::uint64_t> thread_ids;
+    ProfilerOutputFormat format;
+    std::filesystem::path output_path;
+    ProfilerAnalyser analyser;
 };
 
 Profiler::Profiler()
+    : Profiler(ProfilerOutputFormat::TEXT, {}, true)
+{
+}
+
+Profiler::Profiler(ProfilerOutputFormat format, const std::filesystem::path &output_path, bool start_immediately)
     : impl_(std::make_unique<implementation>())
 {
     proc_info_buffer.resize(1024u * 1024u * 100u);
@@ -171,13 +184,39 @@ Profiler::Profiler()
 
     // reserve space for a stack frame for each thread
     impl_->stack_traces.resize(max_thread_count * stack_frame_size);
+    impl_->thread_ids.resize(max_thread_count);
+    impl_->running = false;
+    impl_->sample_frequency = 100u;
+    impl_->format = format;
+    impl_->output_path = output_path;
+
+    if (start_immediately)
+    {
+        start();
+    }
+}
+
+Profiler::~Profiler()
+{
+    stop();
+}
+
+void Profiler::start()
+{
+    if (impl_->running)
+    {
+        return;
+    }
+
+    impl_->analyser = ProfilerAnalyser{};
     impl_->running = true;
 
     // create a new thread for handling the sampling, this thread will be excluded from the sampling
+    // the frequency is passed by value, so it can safely be changed while running and only affects the next session
     impl_->worker = Thread(
-        [&]()
+        [this, frequency = impl_->sample_frequency]()
         {
-            ProfilerAnalyser pa{};
+            auto &pa = impl_->analyser;
 
             while (impl_->running)
             {
@@ -219,6 +258,7 @@ Profiler::Profiler()
                             .AddrStack = {.Offset = context.Rsp, .Mode = AddrModeFlat}};
 
                         // get the stack trace for the thread
+                        impl_->thread_ids[i] = ::GetThreadId(handle);
                         auto index = i++ * 100u;
                         while (::StackWalk64(
                                    IMAGE_FILE_MACHINE_AMD64,
@@ -278,19 +318,45 @@ Profiler::Profiler()
                     }
 
                     // record the resolved stack trace
-                    pa.add_stack_trace(stack_trace);
+                    pa.add_stack_trace(impl_->thread_ids[i], stack_trace);
                 }
 
-                ::Sleep(10);
+                ::Sleep(std::max(1000u / frequency, 1u));
             }
-
-            pa.print();
         });
 }
 
-Profiler::~Profiler()
+void Profiler::stop()
 {
+    if (!impl_->running)
+    {
+        return;
+    }
+
     impl_->running = false;
     impl_->worker.join();
+
+    impl_->analyser.write(impl_->format, impl_->output_path);
+}
+
+bool Profiler::is_running() const
+{
+    return impl_->running;
+}
+
+void Profiler::set_sample_frequency(std::uint32_t frequency)
+{
+    ensure((frequency > 0u) && (frequency <= 10'000u), "sample frequency out of range");
+    impl_->sample_frequency = frequency;
+}
+
+void Profiler::set_output_format(ProfilerOutputFormat format)
+{
+    impl_->format = format;
+}
+
+void Profiler::set_output_path(const std::filesystem::path &output_path)
+{
+    impl_->output_path = output_path;
 }
 }
@@ -6,6 +6,9 @@
 
 #include "events/event.h"
 
+#include <chrono>
+#include <cstdint>
+
 #include "core/error_handling.h"
 #include "events/event_type.h"
 #include "events/keyboard_event.h"
@@ -21,36 +24,48 @@ namespace iris
 Event::Event(QuitEvent event)
     : type_(EventType::QUIT)
     , event_(event)
+    , timestamp_(std::chrono::steady_clock::now())
+    , frame_(0u)
 {
 }
 
 Event::Event(const KeyboardEvent event)
     : type_(EventType::KEYBOARD)
     , event_(event)
+    , timestamp_(std::chrono::steady_clock::now())
+    , frame_(0u)
 {
 }
 
 Event::Event(const MouseEvent event)
     : type_(EventType::MOUSE)
     , event_(event)
+    , timestamp_(std::chrono::steady_clock::now())
+    , frame_(0u)
 {
 }
 
 Event::Event(MouseButtonEvent event)
     : type_(EventType::MOUSE_BUTTON)
     , event_(event)
+    , timestamp_(std::chrono::steady_clock::now())
+    , frame_(0u)
 {
 }
 
 Event::Event(TouchEvent event)
     : type_(EventType::TOUCH)
     , event_(event)
+    , timestamp_(std::chrono::steady_clock::now())
+    , frame_(0u)
 {
 }
 
 Event::Event(ScrollWheelEvent event)
     : type_(EventType::SCROLL_WHEEL)
     , event_(event)
+    , timestamp_(std::chrono::steady_clock::now())
+    , frame_(0u)
 {
 }
 
@@ -170,4 +185,19 @@ ScrollWheelEvent Event::scroll_wheel() const
     return std::get<ScrollWheelEvent>(event_);
 }
 
+std::chrono::steady_clock::time_point Event::timestamp() const
+{
+    return timestamp_;
+}
+
+std::uint64_t Event::frame() const
+{
+    return frame_;
+}
+
+void Event::set_frame(std::uint64_t frame)
+{
+    frame_ = frame;
+}
+
 }
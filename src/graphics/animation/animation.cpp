@@ -10,10 +10,12 @@
 #include <string>
 #include <string_view>
 #include <tuple>
+#include <unordered_map>
 
 #include "core/error_handling.h"
 #include "core/matrix4.h"
 #include "core/quaternion.h"
+#include "core/string_id.h"
 #include "core/vector3.h"
 #include "log/log.h"
 
@@ -31,9 +33,13 @@ Animation::Animation(
     , last_advance_(std::chrono::steady_clock::now())
     , duration_(duration)
     , name_(name)
-    , frames_(frames)
+    , frames_()
     , playback_type_(PlaybackType::LOOPING)
 {
+    for (const auto &[bone, keyframes] : frames)
+    {
+        frames_.emplace(StringId::intern(bone), keyframes);
+    }
 }
 
 std::string Animation::name() const
@@ -43,9 +49,15 @@ std::string Animation::name() const
 
 Transform Animation::transform(std::string_view bone) const
 {
-    expect(bone_exists(bone), "no animation for bone");
+    return transform(StringId{bone});
+}
+
+Transform Animation::transform(StringId bone) const
+{
+    const auto find = frames_.find(bone);
+    expect(find != std::cend(frames_), "no animation for bone");
 
-    const auto &keyframes = frames_.find(bone)->second;
+    const auto &keyframes = find->second;
 
     // find the first keyframe *after* current time
     auto second_keyframe = std::find_if(std::cbegin(keyframes) + 1u, std::cend(keyframes), [this](const KeyFrame &kf) {
@@ -74,7 +86,12 @@ Transform Animation::transform(std::string_view bone) const
 
 bool Animation::bone_exists(std::string_view bone) const
 {
-    return frames_.count(bone) != 0u;
+    return bone_exists(StringId{bone});
+}
+
+bool Animation::bone_exists(StringId bone) const
+{
+    return frames_.contains(bone);
 }
 
 void Animation::advance()
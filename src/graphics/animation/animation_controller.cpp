@@ -15,6 +15,9 @@
 #include <vector>
 
 #include "core/error_handling.h"
+#include "core/profile_scope.h"
+#include "core/scoped_timer.h"
+#include "core/telemetry.h"
 #include "core/transform.h"
 #include "graphics/animation/animation.h"
 #include "graphics/animation/animation_layer.h"
@@ -99,6 +102,11 @@ AnimationController::~AnimationController() = default;
 
 void AnimationController::update()
 {
+    IRIS_PROFILE_SCOPE("AnimationController::update");
+
+    static auto &update_histogram = Telemetry::instance().histogram("animation.update");
+    ScopedTimer timer{update_histogram};
+
     for (auto i = 0u; i < layers_.size(); ++i)
     {
         auto *next_state = current_state_[i]->update();
@@ -13,6 +13,7 @@
 #include <string_view>
 #include <vector>
 
+#include "core/string_id.h"
 #include "core/transform.h"
 #include "graphics/animation/animation.h"
 #include "graphics/animation/bone_query.h"
@@ -29,7 +30,7 @@ CachedBoneQuery::CachedBoneQuery(const Skeleton *skeleton, const std::vector<std
     // create an empty transform for all bones on layer 0 (the base layer)
     for (const auto &bone : skeleton->bones())
     {
-        transforms_[bone.name()] = {0u, {}, {}};
+        transforms_[bone.id()] = {0u, {}, {}};
     }
 
     // set the layer for any bones in the supplied mask
@@ -38,14 +39,14 @@ CachedBoneQuery::CachedBoneQuery(const Skeleton *skeleton, const std::vector<std
     {
         for (const auto &bone : bone_masks[i])
         {
-            transforms_[bone].layer = i + 1u;
+            transforms_[StringId::intern(bone)].layer = i + 1u;
         }
     }
 }
 
-std::optional<Transform> CachedBoneQuery::transform(std::string_view bone_name)
+std::optional<Transform> CachedBoneQuery::transform(StringId bone_id)
 {
-    auto find = transforms_.find(bone_name);
+    auto find = transforms_.find(bone_id);
     return find != std::end(transforms_) ? std::optional<Transform>{find->second.transform} : std::nullopt;
 }
 
@@ -12,6 +12,7 @@
 #include <vector>
 
 #include "core/matrix4.h"
+#include "core/string_id.h"
 #include "core/transform.h"
 #include "graphics/weight.h"
 
@@ -20,6 +21,7 @@ namespace iris
 
 Bone::Bone(const std::string &name, const std::string &parent, const Matrix4 &offset, const Matrix4 &transform)
     : name_(name)
+    , id_(StringId::intern(name))
     , parent_(parent)
     , offset_(offset)
     , transform_(transform)
@@ -32,6 +34,11 @@ std::string Bone::name() const
     return name_;
 }
 
+StringId Bone::id() const
+{
+    return id_;
+}
+
 const Matrix4 &Bone::offset() const
 {
     return offset_;
@@ -0,0 +1,293 @@
+////////////////////////////////////////////////////////////////////////////////
+//         Distributed under the Boost Software License, Version 1.0.         //
+//            (See accompanying file LICENSE or copy at                       //
+//                 https://www.boost.org/LICENSE_1_0.txt)                     //
+////////////////////////////////////////////////////////////////////////////////
+
+#include "graphics/clustered_light_grid.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <span>
+#include <vector>
+
+#include "core/bounding_sphere.h"
+#include "core/camera.h"
+#include "core/camera_type.h"
+#include "core/profile_scope.h"
+#include "core/vector3.h"
+#include "graphics/lights/light.h"
+#include "graphics/lights/point_light.h"
+
+namespace
+{
+
+/**
+ * Helper function to convert a normalised device coordinate to a tile index.
+ *
+ * @param ndc
+ *   Coordinate in the range [-1, 1], values outside are clamped.
+ *
+ * @param tiles
+ *   Number of tiles along axis.
+ *
+ * @returns
+ *   Tile index.
+ */
+std::uint32_t tile(float ndc, std::uint32_t tiles)
+{
+    const auto scaled = (ndc * 0.5f + 0.5f) * static_cast<float>(tiles);
+    return static_cast<std::uint32_t>(std::clamp(scaled, 0.0f, static_cast<float>(tiles - 1u)));
+}
+
+}
+
+namespace iris
+{
+
+ClusteredLightGrid::ClusteredLightGrid()
+    : view_()
+    , projection_()
+    , camera_type_(CameraType::PERSPECTIVE)
+    , near_plane_(0.0f)
+    , far_plane_(0.0f)
+    , lights_()
+    , light_bounds_()
+    , light_ranges_()
+    , cluster_offsets_(tiles_x * tiles_y * slices + 1u, 0u)
+    , light_indices_()
+    , candidates_()
+{
+}
+
+void ClusteredLightGrid::build(const Camera &camera, std::span<const std::unique_ptr<PointLight>> point_lights)
+{
+    IRIS_PROFILE_SCOPE("ClusteredLightGrid::build");
+
+    view_ = camera.view();
+    projection_ = camera.projection();
+    camera_type_ = camera.type();
+    near_plane_ = camera.near_plane();
+    far_plane_ = camera.far_plane();
+
+    lights_.clear();
+    light_bounds_.clear();
+    light_ranges_.clear();
+
+    for (const auto &light : point_lights)
+    {
+        lights_.push_back(light.get());
+        light_bounds_.push_back({light->position(), light->range()});
+        light_ranges_.push_back(cluster_range(light_bounds_.back()));
+    }
+
+    // count lights in each cluster, this is offset by one so the prefix sum below produces the start offsets
+    std::fill(std::begin(cluster_offsets_), std::end(cluster_offsets_), 0u);
+
+    for (const auto &range : light_ranges_)
+    {
+        if (range.empty)
+        {
+            continue;
+        }
+
+        for (auto z = range.min_z; z <= range.max_z; ++z)
+        {
+            for (auto y = range.min_y; y <= range.max_y; ++y)
+            {
+                for (auto x = range.min_x; x <= range.max_x; ++x)
+                {
+                    ++cluster_offsets_[cluster_index(x, y, z) + 1u];
+                }
+            }
+        }
+    }
+
+    for (auto i = 1u; i < cluster_offsets_.size(); ++i)
+    {
+        cluster_offsets_[i] += cluster_offsets_[i - 1u];
+    }
+
+    // fill each cluster, lights are visited in order so each cluster is sorted by light index
+    light_indices_.resize(cluster_offsets_.back());
+    std::vector<std::uint32_t> cursors{std::cbegin(cluster_offsets_), std::cend(cluster_offsets_) - 1};
+
+    for (auto i = 0u; i < light_ranges_.size(); ++i)
+    {
+        const auto &range = light_ranges_[i];
+
+        if (range.empty)
+        {
+            continue;
+        }
+
+        for (auto z = range.min_z; z <= range.max_z; ++z)
+        {
+            for (auto y = range.min_y; y <= range.max_y; ++y)
+            {
+                for (auto x = range.min_x; x <= range.max_x; ++x)
+                {
+                    light_indices_[cursors[cluster_index(x, y, z)]++] = i;
+                }
+            }
+        }
+    }
+}
+
+void ClusteredLightGrid::lights(const BoundingSphere &sphere, std::vector<const Light *> &lights) const
+{
+    lights.clear();
+
+    const auto range = cluster_range(sphere);
+    if (range.empty)
+    {
+        return;
+    }
+
+    candidates_.clear();
+
+    for (auto z = range.min_z; z <= range.max_z; ++z)
+    {
+        for (auto y = range.min_y; y <= range.max_y; ++y)
+        {
+            for (auto x = range.min_x; x <= range.max_x; ++x)
+            {
+                const auto index = cluster_index(x, y, z);
+                candidates_.insert(
+                    std::cend(candidates_),
+                    std::cbegin(light_indices_) + cluster_offsets_[index],
+                    std::cbegin(light_indices_) + cluster_offsets_[index + 1u]);
+            }
+        }
+    }
+
+    std::sort(std::begin(candidates_), std::end(candidates_));
+    candidates_.erase(std::unique(std::begin(candidates_), std::end(candidates_)), std::end(candidates_));
+
+    // clusters are coarse, so do an exact test on the survivors
+    for (const auto index : candidates_)
+    {
+        const auto &bounds = light_bounds_[index];
+        const auto reach = bounds.radius + sphere.radius;
+
+        if ((bounds.centre - sphere.centre).magnitude() <= reach)
+        {
+            lights.push_back(lights_[index]);
+        }
+    }
+
+    std::sort(std::begin(lights), std::end(lights));
+}
+
+std::size_t ClusteredLightGrid::light_count(std::uint32_t x, std::uint32_t y, std::uint32_t z) const
+{
+    const auto index = cluster_index(x, y, z);
+    return cluster_offsets_[index + 1u] - cluster_offsets_[index];
+}
+
+ClusteredLightGrid::ClusterRange ClusteredLightGrid::cluster_range(const BoundingSphere &sphere) const
+{
+    static constexpr ClusterRange empty_range{
+        .empty = true, .min_x = 0u, .max_x = 0u, .min_y = 0u, .max_y = 0u, .min_z = 0u, .max_z = 0u};
+    static constexpr ClusterRange full_range{
+        .empty = false,
+        .min_x = 0u,
+        .max_x = tiles_x - 1u,
+        .min_y = 0u,
+        .max_y = tiles_y - 1u,
+        .min_z = 0u,
+        .max_z = slices - 1u};
+
+    // a light which never attenuates reaches everything
+    if (!std::isfinite(sphere.radius))
+    {
+        return full_range;
+    }
+
+    const auto centre = view_ * sphere.centre;
+    const auto radius = sphere.radius;
+
+    // camera looks down -z in view space
+    const auto depth = -centre.z;
+    if ((depth + radius < near_plane_) || (depth - radius > far_plane_))
+    {
+        return empty_range;
+    }
+
+    const auto min_depth = std::max(depth - radius, near_plane_);
+    const auto max_depth = std::min(depth + radius, far_plane_);
+
+    auto range = full_range;
+    range.min_z = slice(min_depth);
+    range.max_z = slice(max_depth);
+
+    // a perspective projection can't bound a sphere which crosses the near plane, so it covers every tile
+    if ((camera_type_ == CameraType::PERSPECTIVE) && (depth - radius <= near_plane_))
+    {
+        return range;
+    }
+
+    // project the corners of the view space box around the sphere, clipped to the depth range, and take their bounds
+    auto min_x = 1.0f;
+    auto max_x = -1.0f;
+    auto min_y = 1.0f;
+    auto max_y = -1.0f;
+
+    for (const auto corner_depth : {min_depth, max_depth})
+    {
+        for (const auto corner_x : {centre.x - radius, centre.x + radius})
+        {
+            for (const auto corner_y : {centre.y - radius, centre.y + radius})
+            {
+                const Vector3 corner{corner_x, corner_y, -corner_depth};
+                const auto w = projection_[12] * corner.x + projection_[13] * corner.y + projection_[14] * corner.z +
+                               projection_[15];
+                const auto ndc = (projection_ * corner) * (1.0f / w);
+
+                min_x = std::min(min_x, ndc.x);
+                max_x = std::max(max_x, ndc.x);
+                min_y = std::min(min_y, ndc.y);
+                max_y = std::max(max_y, ndc.y);
+            }
+        }
+    }
+
+    if ((max_x < -1.0f) || (min_x > 1.0f) || (max_y < -1.0f) || (min_y > 1.0f))
+    {
+        return empty_range;
+    }
+
+    range.min_x = tile(min_x, tiles_x);
+    range.max_x = tile(max_x, tiles_x);
+    range.min_y = tile(min_y, tiles_y);
+    range.max_y = tile(max_y, tiles_y);
+
+    return range;
+}
+
+std::uint32_t ClusteredLightGrid::slice(float depth) const
+{
+    auto scaled = 0.0f;
+
+    if (camera_type_ == CameraType::PERSPECTIVE)
+    {
+        scaled = std::log(depth / near_plane_) / std::log(far_plane_ / near_plane_);
+    }
+    else
+    {
+        scaled = (depth - near_plane_) / (far_plane_ - near_plane_);
+    }
+
+    return static_cast<std::uint32_t>(
+        std::clamp(scaled * static_cast<float>(slices), 0.0f, static_cast<float>(slices - 1u)));
+}
+
+std::size_t ClusteredLightGrid::cluster_index(std::uint32_t x, std::uint32_t y, std::uint32_t z) const
+{
+    return (static_cast<std::size_t>(z) * tiles_y + y) * tiles_x + x;
+}
+
+}
@@ -25,6 +25,7 @@
 #include "graphics/lights/lighting_rig.h"
 #include "graphics/render_graph/shader_compiler.h"
 #include "graphics/shader_type.h"
+#include "graphics/shading_mode.h"
 #include "log/log.h"
 
 #pragma comment(lib, "d3dcompiler.lib")
@@ -103,7 +104,12 @@ D3D12Material::D3D12Material(
     , pso_()
 {
     ShaderCompiler compiler{
-        ShaderLanguage::HLSL, render_graph, light_type, render_to_normal_target, render_to_position_target};
+        ShaderLanguage::HLSL,
+        render_graph,
+        light_type,
+        ShadingMode::PER_LIGHT,
+        render_to_normal_target,
+        render_to_position_target};
     const auto vertex_source = compiler.vertex_shader();
     const auto fragment_source = compiler.fragment_shader();
 
@@ -6,12 +6,14 @@
 
 #include "graphics/d3d12/d3d12_material_manager.h"
 
+#include "core/error_handling.h"
 #include "graphics/d3d12/d3d12_context.h"
 #include "graphics/d3d12/d3d12_mesh.h"
 #include "graphics/d3d12/d3d12_render_target.h"
 #include "graphics/material_cache.h"
 #include "graphics/render_entity.h"
 #include "graphics/render_graph/render_graph.h"
+#include "graphics/shading_mode.h"
 
 namespace iris
 {
@@ -20,11 +22,14 @@ Material *D3D12MaterialManager::create(
     RenderGraph *render_graph,
     RenderEntity *render_entity,
     LightType light_type,
+    ShadingMode shading_mode,
     bool render_to_colour_target,
     bool render_to_normal_target,
     bool render_to_position_target,
     bool has_transparency)
 {
+    ensure(shading_mode == ShadingMode::PER_LIGHT, "d3d12 only supports per light shading");
+
     return materials_.try_emplace(
         render_graph,
         light_type,
@@ -9,6 +9,7 @@
 #include <algorithm>
 #include <array>
 #include <cassert>
+#include <cstddef>
 #include <cstdint>
 #include <deque>
 #include <iostream>
@@ -27,6 +28,7 @@
 #include "directx/d3d12.h"
 #include "directx/d3dx12.h"
 
+#include "core/dirty_range_tracker.h"
 #include "core/error_handling.h"
 #include "graphics/constant_buffer_writer.h"
 #include "graphics/d3d12/d3d12_constant_buffer.h"
@@ -38,8 +40,8 @@
 #include "graphics/d3d12/d3d12_render_target.h"
 #include "graphics/d3d12/d3d12_sampler.h"
 #include "graphics/d3d12/d3d12_texture.h"
+#include "graphics/instanced_entity.h"
 #include "graphics/mesh_manager.h"
-#include "graphics/render_command_type.h"
 #include "graphics/render_entity.h"
 #include "graphics/render_graph/sky_box_node.h"
 #include "graphics/render_graph/texture_node.h"
@@ -438,7 +440,8 @@ D3D12Renderer::D3D12Renderer(
     , scissor_rect_()
     , uploaded_textures_()
     , uploaded_cube_maps_()
-    , instance_data_buffers_()
+    , frame_number_(0u)
+    , dirty_ranges_()
     , texture_table_()
     , cube_map_table_()
     , sampler_table_()
@@ -575,31 +578,10 @@ void D3D12Renderer::do_set_render_pipeline(std::function<void()> build_queue)
 
     build_queue();
 
-    instance_data_buffers_.clear();
-
     for (auto &frame : frames_)
     {
         frame.model_data_buffers.clear();
-    }
-
-    // create structured buffers for any instanced entities in the scene
-    for (const auto &command : render_queue_)
-    {
-        if (command.type() == RenderCommandType::DRAW)
-        {
-            const auto *render_entity = command.render_entity();
-
-            if (render_entity->type() == RenderEntityType::INSTANCED)
-            {
-                const auto *instanced_entity = static_cast<const InstancedEntity *>(render_entity);
-                instance_data_buffers_[render_entity] =
-                    std::make_unique<D3D12StructuredBuffer>(instanced_entity->data().size(), sizeof(Matrix4) * 2u);
-
-                ConstantBufferWriter writer{*instance_data_buffers_[render_entity]};
-
-                writer.write(instanced_entity->data());
-            }
-        }
+        frame.instance_data.clear();
     }
 
     texture_table_ = create_texture_table(texture_manager_);
@@ -627,6 +609,19 @@ void D3D12Renderer::pre_render()
     frame.light_data_buffers.clear();
     frame.camera_data_buffers.clear();
     frame.property_buffers.clear();
+
+    ++frame_number_;
+
+    // instances can be changed at any time, so bring the instance data of every instanced entity up to date before
+    // drawing
+    for (auto *instanced_entity : instanced_entities_)
+    {
+        upload_instance_data(*instanced_entity);
+    }
+
+    // entities can be removed from a scene at any time, so free the buffers of any not seen this frame (the GPU has
+    // finished with this frame so this is safe)
+    std::erase_if(frame.instance_data, [this](const auto &entry) { return entry.second.frame != frame_number_; });
 }
 
 void D3D12Renderer::execute_pass_start(RenderCommand &command)
@@ -822,7 +817,7 @@ void D3D12Renderer::execute_draw(RenderCommand &command)
     auto *bone_buffer = frame.bone_data_buffers[entity].get();
     auto *light_buffer = frame.light_data_buffers[light].get();
     auto *model_buffer = (entity->type() != RenderEntityType::INSTANCED) ? frame.model_data_buffers[entity].get()
-                                                                         : instance_data_buffers_[entity].get();
+                                                                         : frame.instance_data.at(entity).buffer.get();
     auto *property_buffer = frame.property_buffers[material].get();
     auto *camera_buffer = frame.camera_data_buffers[camera].get();
     const auto shadow_map_index =
@@ -868,6 +863,68 @@ void D3D12Renderer::execute_draw(RenderCommand &command)
     command_list_->DrawIndexedInstanced(num_indices, static_cast<UINT>(instance_count), 0u, 0u, 0u);
 }
 
+void D3D12Renderer::upload_instance_data(InstancedEntity &instanced_entity)
+{
+    const auto *key = std::addressof(instanced_entity);
+
+    // every frame has its own copy of the instance data, so changes need recording against all of them before they are
+    // cleared from the entity
+    if (!instanced_entity.dirty_instances().empty())
+    {
+        instanced_entity.dirty_instances().ranges(dirty_ranges_);
+
+        for (auto &frame : frames_)
+        {
+            auto &dirty_instances = frame.instance_data[key].dirty_instances;
+
+            for (const auto &range : dirty_ranges_)
+            {
+                dirty_instances.mark(range.begin, range.end);
+            }
+        }
+
+        instanced_entity.clear_dirty_instances();
+    }
+
+    const auto &data = instanced_entity.data();
+    const auto instance_count = instanced_entity.instance_count();
+    auto &instance_data = frames_[frame_index_].instance_data[key];
+    auto &buffer = instance_data.buffer;
+    instance_data.frame = frame_number_;
+
+    if ((buffer == nullptr) || (instance_data.capacity < instance_count))
+    {
+        // grow geometrically so adding instances one at a time doesn't reallocate every frame
+        instance_data.capacity = std::max({instance_count, std::size_t{1u}, instance_data.capacity * 2u});
+        buffer = std::make_unique<D3D12StructuredBuffer>(instance_data.capacity, sizeof(Matrix4) * 2u);
+
+        if (!data.empty())
+        {
+            buffer->write(data.data(), data.size() * sizeof(Matrix4), 0u);
+        }
+    }
+    else if (!instance_data.dirty_instances.empty())
+    {
+        // only upload changed instances, each instance is a transform and a normal transform
+        instance_data.dirty_instances.ranges(dirty_ranges_);
+
+        for (const auto &range : dirty_ranges_)
+        {
+            // instances may have been removed after being changed
+            const auto end = std::min(range.end, instance_count);
+            if (range.begin < end)
+            {
+                buffer->write(
+                    data.data() + (range.begin * 2u),
+                    (end - range.begin) * sizeof(Matrix4) * 2u,
+                    range.begin * sizeof(Matrix4) * 2u);
+            }
+        }
+    }
+
+    instance_data.dirty_instances.clear();
+}
+
 void D3D12Renderer::execute_present(RenderCommand &)
 {
     auto &frame = frames_[frame_index_];
@@ -0,0 +1,194 @@
+////////////////////////////////////////////////////////////////////////////////
+//         Distributed under the Boost Software License, Version 1.0.         //
+//            (See accompanying file LICENSE or copy at                       //
+//                 https://www.boost.org/LICENSE_1_0.txt)                     //
+////////////////////////////////////////////////////////////////////////////////
+
+#include "graphics/draw_batcher.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <memory>
+#include <tuple>
+#include <vector>
+
+#include "core/profile_scope.h"
+#include "core/telemetry.h"
+#include "core/telemetry_counter.h"
+#include "graphics/instanced_entity.h"
+#include "graphics/mesh.h"
+#include "graphics/primitive_type.h"
+#include "graphics/render_command.h"
+#include "graphics/render_command_type.h"
+#include "graphics/render_entity.h"
+#include "graphics/render_entity_type.h"
+#include "graphics/single_entity.h"
+
+namespace
+{
+
+/**
+ * Helper function to check if a command can be batched.
+ *
+ * @param command
+ *   Command to check.
+ *
+ * @returns
+ *   True if command is a draw of a batchable SingleEntity, otherwise false.
+ */
+bool can_batch(const iris::RenderCommand &command)
+{
+    if (command.type() != iris::RenderCommandType::DRAW)
+    {
+        return false;
+    }
+
+    const auto *render_entity = command.render_entity();
+
+    // transparent draws must stay in depth order and skinned entities need their own bones
+    return (render_entity->type() == iris::RenderEntityType::SINGLE) && render_entity->batchable() &&
+           !render_entity->has_transparency() &&
+           (static_cast<const iris::SingleEntity *>(render_entity)->skeleton() == nullptr);
+}
+
+/**
+ * Helper function to check if two batchable draws are in the same run i.e. could only differ by their light and entity
+ * state.
+ *
+ * @param a
+ *   First command.
+ *
+ * @param b
+ *   Second command.
+ *
+ * @returns
+ *   True if commands are in the same run, otherwise false.
+ */
+bool same_run(const iris::RenderCommand &a, const iris::RenderCommand &b)
+{
+    return (a.render_pass() == b.render_pass()) && (a.material() == b.material()) &&
+           (a.render_entity()->mesh() == b.render_entity()->mesh()) && (a.light()->type() == b.light()->type());
+}
+
+/**
+ * Helper function to get the state which must match for two draws in a run to be batched.
+ *
+ * @param command
+ *   Command to get state for.
+ *
+ * @returns
+ *   Tuple of batch state.
+ */
+auto batch_state(const iris::RenderCommand &command)
+{
+    const auto *render_entity = command.render_entity();
+
+    return std::make_tuple(
+        command.light(),
+        command.shadow_map(),
+        render_entity->should_render_wireframe(),
+        render_entity->primitive_type(),
+        render_entity->receive_shadow());
+}
+
+}
+
+namespace iris
+{
+
+DrawBatcher::DrawBatcher()
+    : batches_()
+    , batches_used_(0u)
+    , run_()
+    , draws_saved_counter_(Telemetry::instance().counter("renderer.batch.draws_saved"))
+{
+}
+
+void DrawBatcher::batch(std::vector<RenderCommand> &render_queue)
+{
+    IRIS_PROFILE_SCOPE("DrawBatcher::batch");
+
+    batches_used_ = 0u;
+    std::size_t draws_saved = 0u;
+    std::size_t write = 0u;
+    std::size_t read = 0u;
+
+    while (read < render_queue.size())
+    {
+        if (!can_batch(render_queue[read]))
+        {
+            render_queue[write++] = render_queue[read++];
+            continue;
+        }
+
+        // sorting puts draws with the same material and mesh next to each other, so find the end of this run
+        auto end = read + 1u;
+        while ((end < render_queue.size()) && can_batch(render_queue[end]) &&
+               same_run(render_queue[read], render_queue[end]))
+        {
+            ++end;
+        }
+
+        // opaque draws in a run can be freely reordered, so group them by the rest of their state
+        run_.assign(std::cbegin(render_queue) + read, std::cbegin(render_queue) + end);
+        std::stable_sort(
+            std::begin(run_),
+            std::end(run_),
+            [](const RenderCommand &a, const RenderCommand &b) { return batch_state(a) < batch_state(b); });
+
+        for (auto start = std::cbegin(run_); start != std::cend(run_);)
+        {
+            const auto state = batch_state(*start);
+            const auto group_end = std::find_if(
+                start, std::cend(run_), [&state](const RenderCommand &cmd) { return batch_state(cmd) != state; });
+
+            auto cmd = *start;
+
+            if (std::distance(start, group_end) > 1)
+            {
+                const auto *render_entity = start->render_entity();
+                auto *batch = acquire_batch(render_entity->mesh(), render_entity->primitive_type());
+                batch->set_wireframe(render_entity->should_render_wireframe());
+                batch->set_receive_shadow(render_entity->receive_shadow());
+
+                for (auto iter = start; iter != group_end; ++iter)
+                {
+                    const auto *entity = static_cast<const SingleEntity *>(iter->render_entity());
+                    batch->add_instance(entity->transform(), entity->normal_transform());
+                }
+
+                cmd.set_render_entity(batch);
+                draws_saved += static_cast<std::size_t>(std::distance(start, group_end)) - 1u;
+            }
+
+            render_queue[write++] = cmd;
+            start = group_end;
+        }
+
+        read = end;
+    }
+
+    render_queue.resize(write);
+
+    draws_saved_counter_.add(draws_saved);
+}
+
+InstancedEntity *DrawBatcher::acquire_batch(const Mesh *mesh, PrimitiveType primitive_type)
+{
+    if (batches_used_ == batches_.size())
+    {
+        batches_.push_back(std::make_unique<InstancedEntity>(mesh, primitive_type));
+    }
+    else if (
+        (batches_[batches_used_]->mesh() != mesh) || (batches_[batches_used_]->primitive_type() != primitive_type))
+    {
+        batches_[batches_used_] = std::make_unique<InstancedEntity>(mesh, primitive_type);
+    }
+
+    auto *batch = batches_[batches_used_++].get();
+    batch->clear_instances();
+
+    return batch;
+}
+
+}
@@ -0,0 +1,127 @@
+////////////////////////////////////////////////////////////////////////////////
+//         Distributed under the Boost Software License, Version 1.0.         //
+//            (See accompanying file LICENSE or copy at                       //
+//                 https://www.boost.org/LICENSE_1_0.txt)                     //
+////////////////////////////////////////////////////////////////////////////////
+
+#include "graphics/frustum_culler.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <span>
+#include <vector>
+
+#include "core/camera.h"
+#include "core/frustum.h"
+#include "core/profile_scope.h"
+#include "core/telemetry.h"
+#include "core/telemetry_counter.h"
+#include "graphics/render_command.h"
+#include "graphics/render_command_type.h"
+#include "graphics/render_entity.h"
+#include "graphics/render_pass.h"
+
+namespace iris
+{
+
+FrustumCuller::FrustumCuller()
+    : x_()
+    , y_()
+    , z_()
+    , radius_()
+    , visible_()
+    , tested_counter_(Telemetry::instance().counter("renderer.cull.tested"))
+    , visible_counter_(Telemetry::instance().counter("renderer.cull.visible"))
+{
+}
+
+void FrustumCuller::cull(std::span<const RenderCommand> render_queue, std::vector<RenderCommand> &visible_queue)
+{
+    IRIS_PROFILE_SCOPE("FrustumCuller::cull");
+
+    visible_queue.clear();
+    std::size_t start = 0u;
+
+    for (auto i = 0u; i < render_queue.size(); ++i)
+    {
+        const auto &command = render_queue[i];
+
+        switch (command.type())
+        {
+            case RenderCommandType::PASS_START:
+                visible_queue.push_back(command);
+                start = i + 1u;
+                break;
+            case RenderCommandType::PASS_END:
+                cull_pass(command.render_pass()->camera, render_queue.subspan(start, i - start), visible_queue);
+                visible_queue.push_back(command);
+                break;
+            case RenderCommandType::DRAW: break;
+            default: visible_queue.push_back(command); break;
+        }
+    }
+}
+
+void FrustumCuller::cull_pass(
+    const Camera *camera,
+    std::span<const RenderCommand> draws,
+    std::vector<RenderCommand> &visible_queue)
+{
+    if (camera == nullptr)
+    {
+        visible_queue.insert(std::cend(visible_queue), std::cbegin(draws), std::cend(draws));
+        return;
+    }
+
+    const auto count = draws.size();
+
+    x_.resize(count);
+    y_.resize(count);
+    z_.resize(count);
+    radius_.resize(count);
+    visible_.assign(count, 1u);
+
+    // gather the bounds into flat arrays
+    for (auto i = 0u; i < count; ++i)
+    {
+        const auto *render_entity = draws[i].render_entity();
+        const auto &sphere = render_entity->bounding_sphere();
+
+        x_[i] = sphere.centre.x;
+        y_[i] = sphere.centre.y;
+        z_[i] = sphere.centre.z;
+
+        // an infinite radius is in front of every plane
+        radius_[i] = render_entity->cullable() ? sphere.radius : std::numeric_limits<float>::infinity();
+    }
+
+    // test every sphere against one plane at a time, this loop has no branches so is easily vectorised
+    for (const auto &plane : camera->frustum().planes())
+    {
+        const auto nx = plane.normal.x;
+        const auto ny = plane.normal.y;
+        const auto nz = plane.normal.z;
+        const auto d = plane.distance;
+
+        for (auto i = 0u; i < count; ++i)
+        {
+            visible_[i] &= static_cast<std::uint8_t>((nx * x_[i]) + (ny * y_[i]) + (nz * z_[i]) + d >= -radius_[i]);
+        }
+    }
+
+    std::size_t visible_count = 0u;
+    for (auto i = 0u; i < count; ++i)
+    {
+        if (visible_[i] != 0u)
+        {
+            visible_queue.push_back(draws[i]);
+            ++visible_count;
+        }
+    }
+
+    tested_counter_.add(count);
+    visible_counter_.add(visible_count);
+}
+
+}
@@ -6,17 +6,24 @@
 
 #include "graphics/instanced_entity.h"
 
+#include <cstddef>
 #include <vector>
 
+#include "core/dirty_range_tracker.h"
 #include "core/error_handling.h"
 #include "core/matrix4.h"
 #include "core/transform.h"
 #include "graphics/mesh.h"
+#include "graphics/primitive_type.h"
 #include "graphics/render_entity_type.h"
 
 namespace
 {
 
+// instances separated by this many unchanged instances are uploaded together, a few wasted bytes is cheaper than an
+// extra upload call
+constexpr auto dirty_merge_gap = 8u;
+
 /**
  * Helper function to create a normal transformation matrix from a model
  * matrix.
@@ -45,18 +52,24 @@ namespace iris
 {
 
 InstancedEntity::InstancedEntity(const Mesh *mesh, const std::vector<Transform> &instances)
-    : RenderEntity(mesh, PrimitiveType::TRIANGLES)
-    , instance_count_(instances.size())
+    : InstancedEntity(mesh, PrimitiveType::TRIANGLES)
 {
-    ensure(instances.size() > 1, "must have at least two instances");
+    data_.reserve(instances.size() * 2u);
 
     for (const auto &instance : instances)
     {
-        data_.emplace_back(instance.matrix());
-        data_.emplace_back(create_normal_transform(instance.matrix()));
+        add_instance(instance);
     }
 }
 
+InstancedEntity::InstancedEntity(const Mesh *mesh, PrimitiveType primitive_type)
+    : RenderEntity(mesh, primitive_type)
+    , instance_count_(0u)
+    , data_()
+    , dirty_instances_(dirty_merge_gap)
+{
+}
+
 RenderEntityType InstancedEntity::type() const
 {
     return RenderEntityType::INSTANCED;
@@ -77,4 +90,110 @@ std::size_t InstancedEntity::instance_count() const
     return instance_count_;
 }
 
+std::size_t InstancedEntity::add_instance(const Transform &transform)
+{
+    const auto matrix = transform.matrix();
+    add_instance(matrix, create_normal_transform(matrix));
+
+    return instance_count_ - 1u;
+}
+
+void InstancedEntity::set_transform(std::size_t index, const Transform &transform)
+{
+    ensure(index < instance_count_, "index out of range");
+
+    const auto matrix = transform.matrix();
+    data_[index * 2u] = matrix;
+    data_[(index * 2u) + 1u] = create_normal_transform(matrix);
+
+    // the instance may have moved away from the edge of the bounds, so they could shrink
+    bounds_dirty_ = true;
+    dirty_instances_.mark(index);
+}
+
+void InstancedEntity::remove_instance(std::size_t index)
+{
+    ensure(index < instance_count_, "index out of range");
+
+    const auto last = instance_count_ - 1u;
+    if (index != last)
+    {
+        data_[index * 2u] = data_[last * 2u];
+        data_[(index * 2u) + 1u] = data_[(last * 2u) + 1u];
+        dirty_instances_.mark(index);
+    }
+
+    data_.resize(last * 2u);
+    --instance_count_;
+    bounds_dirty_ = true;
+}
+
+void InstancedEntity::clear_instances()
+{
+    instance_count_ = 0u;
+    data_.clear();
+    aabb_ = {};
+    bounding_sphere_ = {};
+    bounds_dirty_ = false;
+    dirty_instances_.clear();
+}
+
+void InstancedEntity::add_instance(const Matrix4 &transform, const Matrix4 &normal_transform)
+{
+    data_.emplace_back(transform);
+    data_.emplace_back(normal_transform);
+
+    // the first instance replaces any bounds left over from removed instances, otherwise the bounds only need to grow
+    // (unless they are going to be recalculated anyway)
+    if (instance_count_ == 0u)
+    {
+        aabb_ = mesh_->aabb().transformed(transform);
+        bounding_sphere_ = mesh_->bounding_sphere().transformed(transform);
+        bounds_dirty_ = false;
+    }
+    else if (!bounds_dirty_)
+    {
+        merge_bounds(transform);
+    }
+
+    dirty_instances_.mark(instance_count_);
+    ++instance_count_;
+}
+
+const DirtyRangeTracker &InstancedEntity::dirty_instances() const
+{
+    return dirty_instances_;
+}
+
+void InstancedEntity::clear_dirty_instances()
+{
+    dirty_instances_.clear();
+}
+
+void InstancedEntity::update_bounds() const
+{
+    aabb_ = {};
+    bounding_sphere_ = {};
+
+    if (instance_count_ == 0u)
+    {
+        return;
+    }
+
+    aabb_ = mesh_->aabb().transformed(data_[0]);
+    bounding_sphere_ = mesh_->bounding_sphere().transformed(data_[0]);
+
+    for (auto i = 1u; i < instance_count_; ++i)
+    {
+        merge_bounds(data_[i * 2u]);
+    }
+}
+
+void InstancedEntity::merge_bounds(const Matrix4 &transform) const
+{
+    // bounds cover every instance, so the entity is culled only when all instances are out of view
+    aabb_.merge(mesh_->aabb().transformed(transform));
+    bounding_sphere_.merge(mesh_->bounding_sphere().transformed(transform));
+}
+
 }
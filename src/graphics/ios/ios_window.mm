@@ -50,6 +50,7 @@ std::optional<Event> IOSWindow::pump_event()
     {
         event = root_view_controller->events_.front();
         root_view_controller->events_.pop();
+        record_input(*event);
     }
 
     return event;
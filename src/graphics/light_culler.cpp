@@ -0,0 +1,107 @@
+////////////////////////////////////////////////////////////////////////////////
+//         Distributed under the Boost Software License, Version 1.0.         //
+//            (See accompanying file LICENSE or copy at                       //
+//                 https://www.boost.org/LICENSE_1_0.txt)                     //
+////////////////////////////////////////////////////////////////////////////////
+
+#include "graphics/light_culler.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <vector>
+
+#include "core/profile_scope.h"
+#include "core/telemetry.h"
+#include "core/telemetry_counter.h"
+#include "graphics/lights/light.h"
+#include "graphics/lights/light_type.h"
+#include "graphics/lights/lighting_rig.h"
+#include "graphics/render_command.h"
+#include "graphics/render_command_type.h"
+#include "graphics/render_entity.h"
+#include "graphics/render_pass.h"
+#include "graphics/scene.h"
+
+namespace iris
+{
+
+LightCuller::LightCuller()
+    : grid_()
+    , entity_lights_()
+    , tested_counter_(Telemetry::instance().counter("renderer.light_cull.tested"))
+    , visible_counter_(Telemetry::instance().counter("renderer.light_cull.visible"))
+{
+}
+
+void LightCuller::cull(std::vector<RenderCommand> &render_queue)
+{
+    IRIS_PROFILE_SCOPE("LightCuller::cull");
+
+    auto grid_valid = false;
+    const RenderEntity *current_entity = nullptr;
+    std::size_t tested = 0u;
+    std::size_t visible = 0u;
+    std::size_t write = 0u;
+
+    for (auto read = 0u; read < render_queue.size(); ++read)
+    {
+        const auto &command = render_queue[read];
+        auto keep = true;
+
+        switch (command.type())
+        {
+            case RenderCommandType::PASS_START:
+            {
+                const auto *pass = command.render_pass();
+                const auto &point_lights = pass->scene->lighting_rig()->point_lights;
+
+                grid_valid = (pass->camera != nullptr) && !point_lights.empty();
+                current_entity = nullptr;
+
+                if (grid_valid)
+                {
+                    grid_.build(*pass->camera, point_lights);
+                }
+                break;
+            }
+            case RenderCommandType::DRAW:
+            {
+                const auto *render_entity = command.render_entity();
+
+                if (!grid_valid || (command.light()->type() != LightType::POINT) || !render_entity->cullable())
+                {
+                    break;
+                }
+
+                // point light draws for an entity are adjacent, so only look up its lights once
+                if (render_entity != current_entity)
+                {
+                    grid_.lights(render_entity->bounding_sphere(), entity_lights_);
+                    current_entity = render_entity;
+                }
+
+                keep = std::binary_search(std::cbegin(entity_lights_), std::cend(entity_lights_), command.light());
+
+                ++tested;
+                if (keep)
+                {
+                    ++visible;
+                }
+                break;
+            }
+            default: break;
+        }
+
+        if (keep)
+        {
+            render_queue[write++] = command;
+        }
+    }
+
+    render_queue.resize(write);
+
+    tested_counter_.add(tested);
+    visible_counter_.add(visible);
+}
+
+}
@@ -6,8 +6,11 @@
 
 #include "graphics/lights/point_light.h"
 
+#include <algorithm>
 #include <array>
+#include <cmath>
 #include <cstring>
+#include <limits>
 
 #include "core/vector3.h"
 #include "graphics/lights/light_type.h"
@@ -127,4 +130,32 @@ void PointLight::set_attenuation_quadratic_term(float quadratic)
     attenuation_terms_.quadratic = quadratic;
 }
 
+float PointLight::range() const
+{
+    // solve for the distance where the brightest channel is attenuated to 1/256, i.e.
+    // constant + linear * d + quadratic * d^2 = brightest * 256
+    const auto brightest = std::max({colour_.r, colour_.g, colour_.b});
+    const auto constant = attenuation_terms_.constant - (brightest * 256.0f);
+    const auto linear = attenuation_terms_.linear;
+    const auto quadratic = attenuation_terms_.quadratic;
+
+    auto range = std::numeric_limits<float>::infinity();
+
+    if (constant >= 0.0f)
+    {
+        // light is too dim to ever be visible
+        range = 0.0f;
+    }
+    else if (quadratic > 0.0f)
+    {
+        range = (-linear + std::sqrt((linear * linear) - (4.0f * quadratic * constant))) / (2.0f * quadratic);
+    }
+    else if (linear > 0.0f)
+    {
+        range = -constant / linear;
+    }
+
+    return std::max(range, 0.0f);
+}
+
 }
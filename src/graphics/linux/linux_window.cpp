@@ -7,9 +7,11 @@
 #include "graphics/linux/linux_window.h"
 
 #include <cmath>
+#include <cstddef>
 #include <iostream>
 #include <optional>
 #include <queue>
+#include <vector>
 
 #include <X11/Xlib.h>
 #include <X11/Xutil.h>
@@ -289,8 +291,8 @@ LinuxWindow::LinuxWindow(
         KeyPressMask | KeyReleaseMask | ButtonPressMask | ButtonReleaseMask | PointerMotionMask | ExposureMask | EnterWindowMask | LeaveWindowMask);
 
     // register for close window events
-    Atom wmDeleteMessage = XInternAtom(display_, "WM_DELETE_WINDOW", False);
-    XSetWMProtocols(display_, window_, &wmDeleteMessage, 1);
+    wm_delete_window_ = ::XInternAtom(display_, "WM_DELETE_WINDOW", False);
+    ::XSetWMProtocols(display_, window_, &wm_delete_window_, 1);
 
     ::XMapWindow(display_, window_);
 
@@ -345,11 +347,46 @@ std::uint32_t LinuxWindow::screen_scale() const
 
 std::optional<Event> LinuxWindow::pump_event()
 {
-    XEvent event{0};
+    // only go to the X server when we've handed out everything from the last read
+    if (events_.empty())
+    {
+        read_events();
+    }
+
+    std::optional<Event> next_event{};
+
+    if (!events_.empty())
+    {
+        next_event = events_.front();
+        events_.pop();
+        record_input(*next_event);
+    }
+
+    return next_event;
+}
+
+std::size_t LinuxWindow::pump_events(std::vector<Event> &events)
+{
+    read_events();
+
+    const auto count = events_.size();
+
+    while (!events_.empty())
+    {
+        record_input(events.emplace_back(events_.front()));
+        events_.pop();
+    }
 
-    ::XPending(display_);
+    return count;
+}
 
-    while (::XQLength(display_))
+void LinuxWindow::read_events()
+{
+    XEvent event{0};
+
+    // a single XPending flushes our requests and reads everything the server has sent, after that the events are
+    // all in the local queue so draining them doesn't need any more round trips
+    for (auto pending = ::XPending(display_); pending > 0; --pending)
     {
         ::XNextEvent(display_, &event);
 
@@ -406,7 +443,7 @@ std::optional<Event> LinuxWindow::pump_event()
         {
             const auto protocol = event.xclient.data.l[0];
 
-            if (static_cast<Atom>(protocol) == ::XInternAtom(display_, "WM_DELETE_WINDOW", False))
+            if (static_cast<Atom>(protocol) == wm_delete_window_)
             {
                 events_.emplace(QuitEvent{});
             }
@@ -420,18 +457,8 @@ std::optional<Event> LinuxWindow::pump_event()
         {
             ::XFixesShowCursor(display_, window_);
             ::XFlush(display_);
-        } 
-    }
-
-    std::optional<Event> next_event{};
-
-    if (!events_.empty())
-    {
-        next_event = events_.front();
-        events_.pop();
+        }
     }
-
-    return next_event;
 }
 
 Display *LinuxWindow::display() const
@@ -282,6 +282,11 @@ std::optional<Event> MacosWindow::pump_event()
         [NSApp sendEvent:event];
     }
 
+    if (evt)
+    {
+        record_input(*evt);
+    }
+
     return evt;
 }
 
@@ -6,10 +6,13 @@
 
 #include "graphics/mesh.h"
 
+#include <algorithm>
 #include <cstdint>
 #include <functional>
 #include <vector>
 
+#include "core/aabb.h"
+#include "core/bounding_sphere.h"
 #include "graphics/vertex_data.h"
 
 namespace iris
@@ -18,7 +21,25 @@ namespace iris
 Mesh::Mesh(const std::vector<VertexData> &vertices, const std::vector<std::uint32_t> &indices)
     : vertices_(vertices)
     , indices_(indices)
+    , aabb_()
+    , bounding_sphere_()
 {
+    for (const auto &vertex : vertices_)
+    {
+        aabb_.merge(vertex.position);
+    }
+
+    // centre the sphere on the box but use the furthest vertex for the radius, which is tighter than the box corner
+    if (!aabb_.empty())
+    {
+        bounding_sphere_.centre = aabb_.centre();
+
+        for (const auto &vertex : vertices_)
+        {
+            bounding_sphere_.radius =
+                std::max(bounding_sphere_.radius, (vertex.position - bounding_sphere_.centre).magnitude());
+        }
+    }
 }
 
 const std::vector<VertexData> &Mesh::vertices() const
@@ -31,4 +52,14 @@ const std::vector<std::uint32_t> &Mesh::indices() const
     return indices_;
 }
 
+const AABB &Mesh::aabb() const
+{
+    return aabb_;
+}
+
+const BoundingSphere &Mesh::bounding_sphere() const
+{
+    return bounding_sphere_;
+}
+
 }
@@ -19,6 +19,7 @@
 #include "graphics/mesh.h"
 #include "graphics/render_graph/render_graph.h"
 #include "graphics/render_graph/shader_compiler.h"
+#include "graphics/shading_mode.h"
 #include "log/log.h"
 
 namespace
@@ -84,7 +85,12 @@ MetalMaterial::MetalMaterial(
     , pipeline_state_()
 {
     ShaderCompiler compiler{
-        ShaderLanguage::MSL, render_graph, light_type, render_to_normal_target, render_to_position_target};
+        ShaderLanguage::MSL,
+        render_graph,
+        light_type,
+        ShadingMode::PER_LIGHT,
+        render_to_normal_target,
+        render_to_position_target};
 
     const auto vertex_program = load_function(compiler.vertex_shader(), "vertex_main");
     const auto fragment_program = load_function(compiler.fragment_shader(), "fragment_main");
@@ -6,10 +6,12 @@
 
 #include "graphics/metal/metal_material_manager.h"
 
+#include "core/error_handling.h"
 #include "graphics/lights/light_type.h"
 #include "graphics/metal/metal_mesh.h"
 #include "graphics/render_entity.h"
 #include "graphics/render_graph/render_graph.h"
+#include "graphics/shading_mode.h"
 
 namespace iris
 {
@@ -18,11 +20,14 @@ Material *MetalMaterialManager::create(
     RenderGraph *render_graph,
     RenderEntity *render_entity,
     LightType light_type,
+    ShadingMode shading_mode,
     bool,
     bool render_to_normal_target,
     bool render_to_position_target,
     bool has_transparency)
 {
+    ensure(shading_mode == ShadingMode::PER_LIGHT, "metal only supports per light shading");
+
     return materials_.try_emplace(
         render_graph,
         light_type,
@@ -6,6 +6,8 @@
 
 #include "graphics/metal/metal_renderer.h"
 
+#include <algorithm>
+#include <cstddef>
 #include <cstdint>
 #include <memory>
 #include <mutex>
@@ -16,6 +18,7 @@
 #import <MetalPerformanceShaders/MetalPerformanceShaders.h>
 #import <QuartzCore/QuartzCore.h>
 
+#include "core/dirty_range_tracker.h"
 #include "core/error_handling.h"
 #include "core/macos/macos_ios_utility.h"
 #include "core/matrix4.h"
@@ -302,7 +305,7 @@ MetalRenderer::MetalRenderer(
     , frames_()
     , render_encoders_()
     , default_depth_buffer_()
-    , instance_data_()
+    , dirty_ranges_()
     , texture_table_()
     , cube_map_table_()
 {
@@ -385,32 +388,10 @@ void MetalRenderer::do_set_render_pipeline(std::function<void()> build_queue)
 {
     build_queue();
 
-    instance_data_.clear();
-
     for (auto &frame : frames_)
     {
         frame.model_data.clear();
-    }
-
-    // find all instanced render entities and write their instance data to buffers - this allows us to quickly set them
-    // during rendering
-    for (const auto &command : render_queue_)
-    {
-        if (command.type() == RenderCommandType::DRAW)
-        {
-            const auto *render_entity = command.render_entity();
-
-            if (render_entity->type() == RenderEntityType::INSTANCED)
-            {
-                const auto *instanced_entity = static_cast<const InstancedEntity *>(render_entity);
-                instance_data_[render_entity] =
-                    std::make_unique<MetalConstantBuffer>(instanced_entity->data().size() * sizeof(Matrix4) * 2u);
-
-                ConstantBufferWriter writer{*instance_data_[render_entity]};
-
-                writer.write(instanced_entity->data());
-            }
-        }
+        frame.instance_data.clear();
     }
 
     resident_resources_.clear();
@@ -436,6 +417,19 @@ void MetalRenderer::pre_render()
 
         // create render encoders fresh each frame
         render_encoders_.clear();
+
+        // instances can be changed at any time, so bring the instance data of every instanced entity up to date
+        // before drawing
+        for (auto *instanced_entity : instanced_entities_)
+        {
+            upload_instance_data(*instanced_entity);
+        }
+
+        // entities can be removed from a scene at any time, so free the buffers of any not seen this frame (we hold
+        // the lock for this frame so the GPU has finished with them)
+        std::erase_if(
+            frames_[current_frame_ % 3u].instance_data,
+            [this](const auto &entry) { return entry.second.frame != current_frame_; });
     }
 }
 
@@ -587,8 +581,8 @@ void MetalRenderer::execute_draw(RenderCommand &command)
         frame.property_data[material]->write(property_buffer.data(), property_buffer.size_bytes(), 0u);
     }
 
-    auto *model_buffer =
-        entity->type() == RenderEntityType::SINGLE ? frame.model_data[entity].get() : instance_data_[entity].get();
+    auto *model_buffer = entity->type() == RenderEntityType::SINGLE ? frame.model_data[entity].get()
+                                                                   : frame.instance_data.at(entity).buffer.get();
     const std::uint32_t shadow_map_index =
         (command.shadow_map() == nullptr) ? 0u : command.shadow_map()->depth_texture()->index();
     const std::uint32_t shadow_map_sampler_index =
@@ -662,4 +656,66 @@ void MetalRenderer::post_render()
     ++current_frame_;
 }
 
+void MetalRenderer::upload_instance_data(InstancedEntity &instanced_entity)
+{
+    const auto *key = std::addressof(instanced_entity);
+
+    // every frame has its own copy of the instance data, so changes need recording against all of them before they are
+    // cleared from the entity
+    if (!instanced_entity.dirty_instances().empty())
+    {
+        instanced_entity.dirty_instances().ranges(dirty_ranges_);
+
+        for (auto &frame : frames_)
+        {
+            auto &dirty_instances = frame.instance_data[key].dirty_instances;
+
+            for (const auto &range : dirty_ranges_)
+            {
+                dirty_instances.mark(range.begin, range.end);
+            }
+        }
+
+        instanced_entity.clear_dirty_instances();
+    }
+
+    const auto &data = instanced_entity.data();
+    const auto instance_count = instanced_entity.instance_count();
+    auto &instance_data = frames_[current_frame_ % 3u].instance_data[key];
+    auto &buffer = instance_data.buffer;
+    instance_data.frame = current_frame_;
+
+    if ((buffer == nullptr) || (instance_data.capacity < instance_count))
+    {
+        // grow geometrically so adding instances one at a time doesn't reallocate every frame
+        instance_data.capacity = std::max({instance_count, std::size_t{1u}, instance_data.capacity * 2u});
+        buffer = std::make_unique<MetalConstantBuffer>(instance_data.capacity * sizeof(Matrix4) * 2u);
+
+        if (!data.empty())
+        {
+            buffer->write(data.data(), data.size() * sizeof(Matrix4), 0u);
+        }
+    }
+    else if (!instance_data.dirty_instances.empty())
+    {
+        // only upload changed instances, each instance is a transform and a normal transform
+        instance_data.dirty_instances.ranges(dirty_ranges_);
+
+        for (const auto &range : dirty_ranges_)
+        {
+            // instances may have been removed after being changed
+            const auto end = std::min(range.end, instance_count);
+            if (range.begin < end)
+            {
+                buffer->write(
+                    data.data() + (range.begin * 2u),
+                    (end - range.begin) * sizeof(Matrix4) * 2u,
+                    range.begin * sizeof(Matrix4) * 2u);
+            }
+        }
+    }
+
+    instance_data.dirty_instances.clear();
+}
+
 }
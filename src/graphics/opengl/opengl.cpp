@@ -11,13 +11,104 @@
 #include <string>
 #include <string_view>
 
+#include "core/telemetry.h"
+#include "core/telemetry_counter.h"
+#include "graphics/opengl/opengl_error_mode.h"
+#include "log/log.h"
+
+#if !defined(IRIS_OPENGL_ERROR_MODE)
+#define IRIS_OPENGL_ERROR_MODE 0
+#endif
+
+namespace
+{
+
+iris::OpenGLErrorMode error_mode = static_cast<iris::OpenGLErrorMode>(IRIS_OPENGL_ERROR_MODE);
+
+/**
+ * Callback for KHR_debug messages.
+ *
+ * @param source
+ *   Source of message.
+ *
+ * @param type
+ *   Type of message.
+ *
+ * @param id
+ *   Driver specific id of message.
+ *
+ * @param severity
+ *   Severity of message.
+ *
+ * @param message
+ *   Null terminated message.
+ */
+void APIENTRY debug_callback(
+    GLenum source,
+    GLenum type,
+    GLuint id,
+    GLenum severity,
+    GLsizei,
+    const GLchar *message,
+    const void *)
+{
+    switch (severity)
+    {
+        case GL_DEBUG_SEVERITY_HIGH:
+            LOG_ENGINE_ERROR("opengl", "[{} {} {}] {}", source, type, id, message);
+            break;
+        case GL_DEBUG_SEVERITY_MEDIUM:
+            LOG_ENGINE_WARN("opengl", "[{} {} {}] {}", source, type, id, message);
+            break;
+        case GL_DEBUG_SEVERITY_LOW:
+            LOG_ENGINE_INFO("opengl", "[{} {} {}] {}", source, type, id, message);
+            break;
+        default:
+            // notifications are very chatty (e.g. buffer placement hints) so ignore them
+            break;
+    }
+}
+
+}
+
 namespace iris
 {
 
+OpenGLErrorMode opengl_error_mode()
+{
+    return error_mode;
+}
+
+void set_opengl_error_mode(OpenGLErrorMode mode)
+{
+    error_mode = mode;
+
+    // messages are delivered asynchronously, which keeps the callback off the critical path but means the callstack
+    // will not point at the failing call - use CHECK_EACH_CALL to track that down
+    if (error_mode == OpenGLErrorMode::DEBUG_CALLBACK)
+    {
+        ::glEnable(GL_DEBUG_OUTPUT);
+        ::glDebugMessageCallback(debug_callback, nullptr);
+    }
+    else
+    {
+        ::glDebugMessageCallback(nullptr, nullptr);
+        ::glDisable(GL_DEBUG_OUTPUT);
+    }
+}
+
 std::optional<std::string> do_check_opengl_error(std::string_view error_message)
 {
     std::optional<std::string> final_message{};
 
+    if (error_mode != OpenGLErrorMode::CHECK_EACH_CALL)
+    {
+        return final_message;
+    }
+
+    static auto &checks_counter = Telemetry::instance().counter("opengl.error_checks");
+    checks_counter.add();
+
     if (const auto error = ::glGetError(); error != GL_NO_ERROR)
     {
         std::stringstream strm{};
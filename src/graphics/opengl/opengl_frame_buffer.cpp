@@ -107,6 +107,11 @@ void OpenGLFrameBuffer::unbind() const
     expect(check_opengl_error, "could not bind framebuffer");
 }
 
+GLuint OpenGLFrameBuffer::handle() const
+{
+    return handle_.get();
+}
+
 const OpenGLRenderTarget *OpenGLFrameBuffer::colour_target() const
 {
     return colour_target_;
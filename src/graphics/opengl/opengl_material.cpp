@@ -14,9 +14,11 @@
 #include "graphics/default_shader_languages.h"
 #include "graphics/opengl/opengl.h"
 #include "graphics/opengl/opengl_shader.h"
+#include "graphics/opengl/opengl_uniform.h"
 #include "graphics/render_graph/render_graph.h"
 #include "graphics/render_graph/shader_compiler.h"
 #include "graphics/shader_type.h"
+#include "graphics/shading_mode.h"
 #include "log/log.h"
 
 namespace
@@ -82,6 +84,45 @@ GLuint create_program(const std::string &vertex_shader_source, const std::string
     return program;
 }
 
+/**
+ * Helper function to compile a render graph and link it into an opengl program.
+ *
+ * @param render_graph
+ *   RenderGraph that describes the material.
+ *
+ * @param light_type
+ *   Type of light for this material.
+ *
+ * @param shading_mode
+ *   How lights are applied.
+ *
+ * @param render_to_normal_target
+ *   Flag indicating whether the material should also write out screen space normals to a render texture.
+ *
+ * @param render_to_position_target
+ *   Flag indicating whether the material should also write out screen space positions to a render texture.
+ *
+ * @returns
+ *   Opengl program object.
+ */
+GLuint link_program(
+    const iris::RenderGraph *render_graph,
+    iris::LightType light_type,
+    iris::ShadingMode shading_mode,
+    bool render_to_normal_target,
+    bool render_to_position_target)
+{
+    iris::ShaderCompiler compiler{
+        iris::ShaderLanguage::GLSL,
+        render_graph,
+        light_type,
+        shading_mode,
+        render_to_normal_target,
+        render_to_position_target};
+
+    return create_program(compiler.vertex_shader(), compiler.fragment_shader());
+}
+
 }
 
 namespace iris
@@ -90,15 +131,15 @@ namespace iris
 OpenGLMaterial::OpenGLMaterial(
     const RenderGraph *render_graph,
     LightType light_type,
+    ShadingMode shading_mode,
     bool render_to_normal_target,
     bool render_to_position_target)
     : Material(render_graph)
-    , handle_(0u)
+    , handle_(
+          link_program(render_graph, light_type, shading_mode, render_to_normal_target, render_to_position_target))
+    , shadow_map_index_uniform_(handle_, "shadow_map_index", false)
+    , receive_shadow_uniform_(handle_, "receive_shadow", false)
 {
-    ShaderCompiler compiler{
-        ShaderLanguage::GLSL, render_graph, light_type, render_to_normal_target, render_to_position_target};
-
-    handle_ = create_program(compiler.vertex_shader(), compiler.fragment_shader());
 }
 
 OpenGLMaterial::~OpenGLMaterial()
@@ -117,4 +158,14 @@ GLuint OpenGLMaterial::handle() const
     return handle_;
 }
 
+const OpenGLUniform &OpenGLMaterial::shadow_map_index_uniform() const
+{
+    return shadow_map_index_uniform_;
+}
+
+const OpenGLUniform &OpenGLMaterial::receive_shadow_uniform() const
+{
+    return receive_shadow_uniform_;
+}
+
 }
@@ -10,6 +10,7 @@
 #include "graphics/opengl/opengl_render_target.h"
 #include "graphics/render_entity.h"
 #include "graphics/render_graph/render_graph.h"
+#include "graphics/shading_mode.h"
 
 namespace iris
 {
@@ -18,18 +19,27 @@ Material *OpenGLMaterialManager::create(
     RenderGraph *render_graph,
     RenderEntity *,
     LightType light_type,
+    ShadingMode shading_mode,
     bool,
     bool render_to_normal_target,
     bool render_to_position_target,
     bool)
 {
+    // a single pass material handles every light type, so they all share one entry
+    if (shading_mode == ShadingMode::SINGLE_PASS)
+    {
+        light_type = LightType::AMBIENT;
+    }
+
     return materials_.try_emplace(
         render_graph,
         light_type,
+        shading_mode,
         render_to_normal_target,
         render_to_position_target,
         render_graph,
         light_type,
+        shading_mode,
         render_to_normal_target,
         render_to_position_target);
 }
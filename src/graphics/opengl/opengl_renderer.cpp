@@ -6,8 +6,13 @@
 
 #include "graphics/opengl/opengl_renderer.h"
 
+#include <algorithm>
+#include <array>
 #include <cassert>
+#include <cstddef>
+#include <cstdint>
 #include <deque>
+#include <memory>
 #include <string>
 #include <utility>
 
@@ -24,13 +29,16 @@
 #include "graphics/opengl/opengl_material.h"
 #include "graphics/opengl/opengl_mesh.h"
 #include "graphics/opengl/opengl_render_target.h"
+#include "graphics/opengl/opengl_ring_buffer.h"
 #include "graphics/opengl/opengl_texture.h"
 #include "graphics/opengl/opengl_texture_manager.h"
 #include "graphics/render_entity.h"
 #include "graphics/render_entity_type.h"
 #include "graphics/render_graph/sky_box_node.h"
 #include "graphics/render_graph/texture_node.h"
+#include "graphics/render_pipeline.h"
 #include "graphics/sampler.h"
+#include "graphics/shading_mode.h"
 #include "graphics/single_entity.h"
 #include "graphics/texture_manager.h"
 #include "graphics/window.h"
@@ -49,21 +57,24 @@ namespace
 /**
  * Helper function to setup opengl for a render pass.
  *
- * @param target
- *   RenderTarget for render pass.
+ * @param frame_buffer
+ *   Frame buffer for render pass.
+ *
+ * @param state_cache
+ *   State cache to bind frame buffer through.
  */
-void render_setup(const iris::OpenGLFrameBuffer &frame_buffer)
+void render_setup(const iris::OpenGLFrameBuffer &frame_buffer, iris::OpenGLStateCache &state_cache)
 {
     if (frame_buffer.colour_target() == nullptr)
     {
-        ::glBindFramebuffer(GL_FRAMEBUFFER, 0u);
+        state_cache.bind_framebuffer(0u);
     }
     else
     {
         ::glViewport(0, 0, frame_buffer.colour_target()->width(), frame_buffer.colour_target()->height());
         iris::expect(iris::check_opengl_error, "could not set viewport");
 
-        frame_buffer.bind();
+        state_cache.bind_framebuffer(frame_buffer.handle());
     }
 }
 
@@ -88,11 +99,6 @@ void draw_meshes(const iris::RenderEntity *entity)
     iris::expect(iris::check_opengl_error, "could not draw triangles");
 
     mesh->unbind();
-
-    if (entity->should_render_wireframe())
-    {
-        ::glPolygonMode(GL_FRONT_AND_BACK, GL_FILL);
-    }
 }
 
 /**
@@ -165,6 +171,66 @@ std::unique_ptr<iris::SSBO> create_cube_map_table_ssbo(iris::TextureManager &tex
     return cube_map_table;
 }
 
+/**
+ * Helper function to write all the (non ambient) lights in a scene, for use with single pass shading.
+ *
+ * @param lighting_rig
+ *   Lights to write.
+ *
+ * @param render_pipeline
+ *   Pipeline being rendered, used to look up shadow maps.
+ *
+ * @param frame_data
+ *   Buffer to allocate light array from.
+ *
+ * @return
+ *   Allocation with a 16 byte header containing the light count followed by an entry for each light.
+ */
+iris::OpenGLBufferAllocation write_light_array(
+    const iris::LightingRig &lighting_rig,
+    const iris::RenderPipeline &render_pipeline,
+    iris::OpenGLRingBuffer &frame_data)
+{
+    // must match the Light struct in the fragment shader
+    static constexpr auto entry_size = (sizeof(iris::Matrix4) * 2u) + (sizeof(float) * 4u * 3u) + 16u;
+
+    const auto light_count = lighting_rig.directional_lights.size() + lighting_rig.point_lights.size();
+    auto light_array = frame_data.allocate(16u + (light_count * entry_size));
+
+    iris::ConstantBufferWriter writer{light_array};
+    writer.write(std::array<std::uint32_t, 4u>{static_cast<std::uint32_t>(light_count), 0u, 0u, 0u});
+
+    const auto write_light = [&writer](const iris::Light *light, std::int32_t shadow_map_index)
+    {
+        writer.write(light->colour_data());
+        writer.write(light->world_space_data());
+        const auto attenuation = light->attenuation_data();
+        writer.write(std::array<float, 4u>{attenuation[0], attenuation[1], attenuation[2], 0.0f});
+        writer.write(
+            std::array<std::int32_t, 4u>{static_cast<std::int32_t>(light->type()), shadow_map_index, 0, 0});
+    };
+
+    for (const auto &light : lighting_rig.directional_lights)
+    {
+        const auto *shadow_map = render_pipeline.shadow_map(light.get());
+        const auto shadow_map_index =
+            (shadow_map == nullptr) ? -1 : static_cast<std::int32_t>(shadow_map->depth_texture()->index());
+
+        writer.write(light->shadow_camera().projection());
+        writer.write(light->shadow_camera().view());
+        write_light(light.get(), shadow_map_index);
+    }
+
+    for (const auto &light : lighting_rig.point_lights)
+    {
+        // skip over directional light specific data
+        writer.advance(sizeof(iris::Matrix4) * 2u);
+        write_light(light.get(), -1);
+    }
+
+    return light_array;
+}
+
 }
 
 namespace iris
@@ -176,22 +242,32 @@ OpenGLRenderer::OpenGLRenderer(
     MaterialManager &material_manager,
     std::uint32_t width,
     std::uint32_t height)
-    : Renderer(material_manager)
+    : Renderer(material_manager, true)
     , window_manager_(window_manager)
     , texture_manager_(texture_manager)
     , width_(width)
     , height_(height)
+    , state_cache_()
+    , frame_data_(std::make_unique<OpenGLRingBuffer>(1024u * 1024u))
+    , default_bone_data_()
+    , camera_data_()
     , bone_data_()
+    , model_data_()
+    , frame_(0u)
+    , instance_data_()
+    , dirty_ranges_()
+    , render_values_()
     , light_data_()
+    , light_array_()
 {
+    // now we have a context the build time error mode can be applied, installing the debug callback if required
+    set_opengl_error_mode(opengl_error_mode());
+
     ::glClearColor(0.39f, 0.58f, 0.93f, 1.0f);
     expect(check_opengl_error, "could not set clear colour");
 
-    ::glEnable(GL_DEPTH_TEST);
-    expect(check_opengl_error, "could not enable depth testing");
-
-    ::glDepthFunc(GL_LEQUAL);
-    expect(check_opengl_error, "could not set depth test function");
+    state_cache_.set_depth_test(true);
+    state_cache_.set_depth_func(GL_LEQUAL);
 
     LOG_ENGINE_INFO("render_system", "constructed opengl renderer");
 }
@@ -203,27 +279,6 @@ void OpenGLRenderer::do_set_render_pipeline(std::function<void()> build_queue)
 
     build_queue();
 
-    // loop through all draw commands, for each drawn entity create a uniform object so they can be easily set during
-    // render
-    for (const auto &command : render_queue_)
-    {
-        if (command.type() == RenderCommandType::DRAW)
-        {
-            const auto *render_entity = command.render_entity();
-
-            if (render_entity->type() == RenderEntityType::INSTANCED)
-            {
-                const auto *instanced_entity = static_cast<const InstancedEntity *>(render_entity);
-                instance_data_[render_entity] =
-                    std::make_unique<SSBO>(instanced_entity->data().size() * sizeof(Matrix4), 5u);
-
-                ConstantBufferWriter writer{*instance_data_[render_entity]};
-
-                writer.write(instanced_entity->data());
-            }
-        }
-    }
-
     for (const auto *pass : render_pipeline_->render_passes())
     {
         pass_frame_buffers_[pass] = OpenGLFrameBuffer{
@@ -236,6 +291,39 @@ void OpenGLRenderer::do_set_render_pipeline(std::function<void()> build_queue)
     cube_map_table_ = create_cube_map_table_ssbo(texture_manager_);
 }
 
+void OpenGLRenderer::pre_render()
+{
+    // this may wait for the GPU to finish with the frame that last used this frames region of the buffer
+    frame_data_->begin_frame();
+    ++frame_;
+
+    // entities without a skeleton all share the same bone data
+    static const std::vector<Matrix4> default_bones(100u);
+    default_bone_data_ = frame_data_->allocate(sizeof(Matrix4) * 100u);
+    ConstantBufferWriter writer{default_bone_data_};
+    writer.write(default_bones);
+
+    // instances can be changed at any time, so bring the instance data of every instanced entity up to date before
+    // drawing
+    for (auto *instanced_entity : instanced_entities_)
+    {
+        upload_instance_data(*instanced_entity);
+    }
+
+    // entities can be removed from a scene at any time, so free the buffers of any not seen this frame (otherwise they
+    // would leak and something later allocated at the same address would be drawn with them)
+    std::erase_if(instance_data_, [this](const auto &entry) { return entry.second.frame != frame_; });
+
+    // state may have been changed outside of the cache since the last frame (e.g. creating buffers or frame buffers
+    // binds them) so start from a clean slate
+    state_cache_.invalidate();
+}
+
+void OpenGLRenderer::post_render()
+{
+    frame_data_->end_frame();
+}
+
 void OpenGLRenderer::execute_pass_start(RenderCommand &command)
 {
     const auto &frame_buffer = pass_frame_buffers_.at(command.render_pass());
@@ -250,15 +338,14 @@ void OpenGLRenderer::execute_pass_start(RenderCommand &command)
         ::glViewport(0, 0, width_ * scale, height_ * scale);
         expect(check_opengl_error, "could not set viewport");
 
-        ::glBindFramebuffer(GL_FRAMEBUFFER, 0);
-        expect(check_opengl_error, "could not bind default buffer");
+        state_cache_.bind_framebuffer(0u);
     }
     else
     {
         ::glViewport(0, 0, frame_buffer.colour_target()->width(), frame_buffer.colour_target()->height());
         expect(check_opengl_error, "could not set viewport");
 
-        frame_buffer.bind();
+        state_cache_.bind_framebuffer(frame_buffer.handle());
     }
 
     // clear current target
@@ -278,9 +365,21 @@ void OpenGLRenderer::execute_pass_start(RenderCommand &command)
     bone_data_.clear();
     model_data_.clear();
     light_data_.clear();
+    light_array_.reset();
+
+    // with single pass shading every light is needed for every draw, so upload them all up front
+    if (RenderPipeline::shading_mode(command.render_pass()) == ShadingMode::SINGLE_PASS)
+    {
+        light_array_ =
+            write_light_array(*command.render_pass()->scene->lighting_rig(), *render_pipeline_, *frame_data_);
+    }
+
+    camera_data_ = frame_data_->allocate((sizeof(Matrix4) * 3u) + sizeof(Vector3));
+    render_values_ = frame_data_->allocate(64u);
 
-    camera_data_ = std::make_unique<UBO>((sizeof(Matrix4) * 3u) + sizeof(Vector3), 0u);
-    render_values_ = std::make_unique<UBO>(64u, 6u);
+    const auto time_value = static_cast<float>(time().count()) / 1000.0f;
+    ConstantBufferWriter render_values_writer{render_values_};
+    render_values_writer.write(time_value);
 
     // calculate view matrix for normals
     auto normal_view = Matrix4::transpose(Matrix4::invert(camera->view()));
@@ -288,7 +387,7 @@ void OpenGLRenderer::execute_pass_start(RenderCommand &command)
     normal_view[7] = 0.0f;
     normal_view[11] = 0.0f;
 
-    ConstantBufferWriter writer{*camera_data_};
+    ConstantBufferWriter writer{camera_data_};
     writer.write(camera->projection());
     writer.write(camera->view());
     writer.write(normal_view);
@@ -300,6 +399,7 @@ void OpenGLRenderer::execute_draw(RenderCommand &command)
     const auto *render_entity = command.render_entity();
     const auto *light = command.light();
     const auto &frame_buffer = pass_frame_buffers_.at(command.render_pass());
+    const auto *instance_data = scene_instance_data(render_entity);
 
     static const OpenGLRenderTarget *previous_target = nullptr;
     const auto *target = static_cast<const OpenGLRenderTarget *>(frame_buffer.colour_target());
@@ -307,89 +407,75 @@ void OpenGLRenderer::execute_draw(RenderCommand &command)
     // optimisation, we only call render_setup when the target changes
     if (target != previous_target)
     {
-        render_setup(frame_buffer);
+        render_setup(frame_buffer, state_cache_);
         previous_target = target;
     }
 
-    static const OpenGLMaterial *previous_material = nullptr;
-    auto *material = static_cast<const OpenGLMaterial *>(command.material());
-
-    // optimisation, we only bind a material when it changes
-    if (material != previous_material)
-    {
-        material->bind();
-        previous_material = material;
-    }
+    // the state cache filters out any of these which haven't changed since the last draw
+    const auto *material = static_cast<const OpenGLMaterial *>(command.material());
+    state_cache_.use_program(material->handle());
 
     // set blend mode based on light
     // ambient is always rendered first (no blending)
     // directional and point are always rendered after (blending)
     switch (light->type())
     {
-        case LightType::AMBIENT: ::glDisable(GL_BLEND); break;
+        case LightType::AMBIENT: state_cache_.set_blend(false); break;
         case LightType::DIRECTIONAL:
         case LightType::POINT:
-            ::glEnable(GL_BLEND);
-            ::glBlendFunc(GL_ONE, GL_ONE);
+            state_cache_.set_blend(true);
+            state_cache_.set_blend_func(GL_ONE, GL_ONE);
             break;
     }
 
-    if (render_entity->should_render_wireframe())
-    {
-        ::glPolygonMode(GL_FRONT_AND_BACK, GL_LINE);
-    }
+    state_cache_.set_polygon_mode(render_entity->should_render_wireframe() ? GL_LINE : GL_FILL);
 
     // we use caching to minimise the CPU->GPU communication
-    // the first time we see a RenderEntity we cache its bone data (and if its single entity its transform data) we can
-    // then reuse these buffers for any subsequent renders of that entity (in this pass)
+    // the first time we see a RenderEntity we write its bone data (and if its single entity its transform data) into
+    // the frame buffer, we can then reuse these allocations for any subsequent renders of that entity (in this pass)
 
     if (!bone_data_.contains(render_entity))
     {
-        static std::vector<Matrix4> default_bones(100u);
-
-        // first time seeing this entity this pass, so create a new UBO
-        bone_data_[render_entity] = std::make_unique<UBO>(sizeof(Matrix4) * 100u, 1u);
-
-        ConstantBufferWriter writer{*bone_data_[render_entity]};
+        // entities without a skeleton (including all instanced entities, as we don't support animating them) use the
+        // default bones
+        bone_data_[render_entity] = default_bone_data_;
 
         if (render_entity->type() == RenderEntityType::SINGLE)
         {
-            // a single entity, so write in bone data
-
             const auto *single_entity = static_cast<const SingleEntity *>(render_entity);
 
             if (single_entity->skeleton() != nullptr)
             {
-                const auto &bones = single_entity->skeleton()->transforms();
-                writer.write(bones);
-                writer.advance((100u - bones.size()) * sizeof(iris::Matrix4));
-            }
-            else
-            {
-                writer.write(default_bones);
+                // first time seeing this entity this pass, so write in bone data
+                bone_data_[render_entity] = frame_data_->allocate(sizeof(Matrix4) * 100u);
+                ConstantBufferWriter writer{bone_data_[render_entity]};
+                writer.write(single_entity->skeleton()->transforms());
             }
 
             // also cache the entities transform data
-            model_data_[render_entity] = std::make_unique<SSBO>(128u, 5u);
-            ConstantBufferWriter writer2{*model_data_[render_entity]};
-            writer2.write(single_entity->transform());
-            writer2.write(single_entity->normal_transform());
+            model_data_[render_entity] = frame_data_->allocate(sizeof(Matrix4) * 2u);
+            ConstantBufferWriter writer{model_data_[render_entity]};
+            writer.write(single_entity->transform());
+            writer.write(single_entity->normal_transform());
         }
-        else
+        else if (instance_data == nullptr)
         {
-            // we don't support animation of instanced entities - so just send default bone transforms
-            writer.write(default_bones);
+            // instanced entities not in a scene are batches, whose instances change every frame
+            const auto *instanced_entity = static_cast<const InstancedEntity *>(render_entity);
+            model_data_[render_entity] = frame_data_->allocate(instanced_entity->data().size() * sizeof(Matrix4));
+            ConstantBufferWriter writer{model_data_[render_entity]};
+            writer.write(instanced_entity->data());
         }
     }
 
     // we also cache light data per pass
-    // the first time we see  alight we write its data to a UBO and reuse it for subsequent renders
+    // the first time we see a light we write its data and reuse it for subsequent renders
 
     if (!light_data_.contains(light))
     {
-        light_data_[light] = std::make_unique<UBO>(256u, 2u);
+        light_data_[light] = frame_data_->allocate(256u);
 
-        ConstantBufferWriter writer{*light_data_[light]};
+        ConstantBufferWriter writer{light_data_[light]};
 
         if (light->type() == iris::LightType::DIRECTIONAL)
         {
@@ -420,48 +506,97 @@ void OpenGLRenderer::execute_draw(RenderCommand &command)
         {
             // if we are rendering with a shadow casting directional light then pass the index of the shadow map (into
             // the texture table) as a uniform
-            OpenGLUniform shadow_map_index_uniform{material->handle(), "shadow_map_index", true};
-            shadow_map_index_uniform.set_value(command.shadow_map()->depth_texture()->index());
+            material->shadow_map_index_uniform().set_value(
+                static_cast<std::int32_t>(command.shadow_map()->depth_texture()->index()));
         }
     }
 
-    const auto time_value = static_cast<float>(time().count()) / 1000.0f;
-    ConstantBufferWriter writer(*render_values_);
-    writer.write(time_value);
-
-    ::glBindBufferBase(GL_UNIFORM_BUFFER, 0, camera_data_->handle());
-    expect(check_opengl_error, "could not bind camera data ubo");
-
-    ::glBindBufferBase(GL_UNIFORM_BUFFER, 1, bone_data_[render_entity]->handle());
-    expect(check_opengl_error, "could not bind vertex data ubo");
+    camera_data_.bind(state_cache_, GL_UNIFORM_BUFFER, 0u);
+    bone_data_[render_entity].bind(state_cache_, GL_UNIFORM_BUFFER, 1u);
+    light_data_[light].bind(state_cache_, GL_UNIFORM_BUFFER, 2u);
 
-    ::glBindBufferBase(GL_UNIFORM_BUFFER, 2, light_data_[light]->handle());
-    expect(check_opengl_error, "could not bind light data ubo");
+    state_cache_.bind_buffer_base(GL_SHADER_STORAGE_BUFFER, 3u, texture_table_->handle());
+    state_cache_.bind_buffer_base(GL_SHADER_STORAGE_BUFFER, 4u, cube_map_table_->handle());
 
-    ::glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 3, texture_table_->handle());
-    expect(check_opengl_error, "could not bind texture data ssbo");
+    render_values_.bind(state_cache_, GL_SHADER_STORAGE_BUFFER, 6u);
 
-    ::glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 4, cube_map_table_->handle());
-    expect(check_opengl_error, "could not bind cube map data ssbo");
+    if (light_array_)
+    {
+        light_array_->bind(state_cache_, GL_SHADER_STORAGE_BUFFER, 7u);
 
-    ::glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 6, render_values_->handle());
-    expect(check_opengl_error, "could not bind cube render value ssbo");
+        // not every material in the pass is single pass (e.g. a sky box) so the uniform may not exist
+        material->receive_shadow_uniform().set_value(render_entity->receive_shadow() ? 1 : 0);
+    }
 
-    // bind model data, depending on if we're rendering a single or instanced entity
-    if (render_entity->type() != RenderEntityType::INSTANCED)
+    // bind model data, depending on if we're rendering a single (or batched) or instanced entity
+    if (instance_data == nullptr)
     {
-        ::glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 5, model_data_[render_entity]->handle());
-        expect(check_opengl_error, "could not bind model data ssbo");
+        model_data_[render_entity].bind(state_cache_, GL_SHADER_STORAGE_BUFFER, 5u);
     }
     else
     {
-        ::glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 5, instance_data_[render_entity]->handle());
-        expect(check_opengl_error, "could not bind model data ssbo");
+        state_cache_.bind_buffer_base(GL_SHADER_STORAGE_BUFFER, 5u, instance_data->handle());
     }
 
     draw_meshes(render_entity);
 }
 
+void OpenGLRenderer::upload_instance_data(InstancedEntity &instanced_entity)
+{
+    const auto &data = instanced_entity.data();
+    const auto size = data.size() * sizeof(Matrix4);
+    auto &instance_data = instance_data_[std::addressof(instanced_entity)];
+    auto &buffer = instance_data.buffer;
+    instance_data.frame = frame_;
+
+    if ((buffer == nullptr) || (buffer->capacity() < size))
+    {
+        // grow geometrically so adding instances one at a time doesn't reallocate every frame
+        const auto capacity =
+            std::max({size, sizeof(Matrix4) * 2u, (buffer == nullptr) ? 0u : buffer->capacity() * 2u});
+        buffer = std::make_unique<SSBO>(capacity, 5u);
+
+        if (!data.empty())
+        {
+            buffer->write(data.data(), size, 0u);
+        }
+    }
+    else if (!instanced_entity.dirty_instances().empty())
+    {
+        // only upload changed instances, each instance is a transform and a normal transform
+        instanced_entity.dirty_instances().ranges(dirty_ranges_);
+
+        for (const auto &range : dirty_ranges_)
+        {
+            // instances may have been removed after being changed
+            const auto end = std::min(range.end, instanced_entity.instance_count());
+            if (range.begin < end)
+            {
+                buffer->write(
+                    data.data() + (range.begin * 2u),
+                    (end - range.begin) * sizeof(Matrix4) * 2u,
+                    range.begin * sizeof(Matrix4) * 2u);
+            }
+        }
+    }
+
+    instanced_entity.clear_dirty_instances();
+}
+
+const SSBO *OpenGLRenderer::scene_instance_data(const RenderEntity *render_entity) const
+{
+    // batches are also instanced entities, but are never in a scene so only have per frame model data
+    if (render_entity->type() != RenderEntityType::INSTANCED)
+    {
+        return nullptr;
+    }
+
+    const auto instance_data = instance_data_.find(render_entity);
+    return ((instance_data != std::cend(instance_data_)) && (instance_data->second.frame == frame_))
+               ? instance_data->second.buffer.get()
+               : nullptr;
+}
+
 void OpenGLRenderer::execute_present(RenderCommand &)
 {
 #if defined(IRIS_PLATFORM_MACOS)
@@ -0,0 +1,206 @@
+////////////////////////////////////////////////////////////////////////////////
+//         Distributed under the Boost Software License, Version 1.0.         //
+//            (See accompanying file LICENSE or copy at                       //
+//                 https://www.boost.org/LICENSE_1_0.txt)                     //
+////////////////////////////////////////////////////////////////////////////////
+
+#include "graphics/opengl/opengl_ring_buffer.h"
+
+#include <algorithm>
+#include <cstddef>
+
+#include "core/error_handling.h"
+#include "graphics/opengl/opengl.h"
+
+namespace
+{
+
+/**
+ * Helper function to round a value up to a multiple of an alignment.
+ *
+ * @param value
+ *   Value to round.
+ *
+ * @param alignment
+ *   Alignment to round to.
+ *
+ * @returns
+ *   Smallest multiple of alignment not less than value.
+ */
+std::size_t align_up(std::size_t value, std::size_t alignment)
+{
+    return ((value + alignment - 1u) / alignment) * alignment;
+}
+
+/**
+ * Helper function to get the offset alignment required for binding a buffer range.
+ *
+ * @returns
+ *   Alignment suitable for both uniform and shader storage buffers.
+ */
+std::size_t buffer_alignment()
+{
+    GLint uniform_alignment = 0;
+    ::glGetIntegerv(GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT, &uniform_alignment);
+    iris::expect(iris::check_opengl_error, "could not get uniform buffer alignment");
+
+    GLint storage_alignment = 0;
+    ::glGetIntegerv(GL_SHADER_STORAGE_BUFFER_OFFSET_ALIGNMENT, &storage_alignment);
+    iris::expect(iris::check_opengl_error, "could not get shader storage buffer alignment");
+
+    // both are powers of two, so the larger satisfies both
+    return static_cast<std::size_t>(std::max({uniform_alignment, storage_alignment, 16}));
+}
+
+}
+
+namespace iris
+{
+
+OpenGLRingBuffer::OpenGLRingBuffer(std::size_t frame_capacity)
+    : handle_(0u)
+    , data_(nullptr)
+    , frame_capacity_(0u)
+    , alignment_(buffer_alignment())
+    , frame_index_(0u)
+    , frame_offset_(0u)
+    , fences_()
+    , retired_handles_()
+{
+    frame_capacity_ = align_up(frame_capacity, alignment_);
+    fences_.fill(nullptr);
+
+    create_buffer();
+}
+
+OpenGLRingBuffer::~OpenGLRingBuffer()
+{
+    retire_buffer();
+    delete_retired_buffers();
+}
+
+void OpenGLRingBuffer::begin_frame()
+{
+    // all commands from the previous frame have been issued, so any buffers replaced during it can now be deleted
+    delete_retired_buffers();
+
+    frame_index_ = (frame_index_ + 1u) % frames_in_flight;
+    frame_offset_ = 0u;
+
+    auto &fence = fences_[frame_index_];
+
+    if (fence != nullptr)
+    {
+        // flush on the first wait, otherwise the fence may never be submitted and we would wait forever
+        GLbitfield flags = GL_SYNC_FLUSH_COMMANDS_BIT;
+        GLenum result = GL_TIMEOUT_EXPIRED;
+
+        do
+        {
+            result = ::glClientWaitSync(fence, flags, 1'000'000u);
+            flags = 0u;
+        } while (result == GL_TIMEOUT_EXPIRED);
+
+        ensure(result != GL_WAIT_FAILED, "could not wait for frame fence");
+
+        ::glDeleteSync(fence);
+        fence = nullptr;
+    }
+}
+
+void OpenGLRingBuffer::end_frame()
+{
+    auto &fence = fences_[frame_index_];
+    expect(fence == nullptr, "frame already has a fence");
+
+    fence = ::glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0u);
+    expect(check_opengl_error, "could not create frame fence");
+}
+
+OpenGLBufferAllocation OpenGLRingBuffer::allocate(std::size_t size)
+{
+    const auto aligned_size = align_up(std::max(size, std::size_t{1u}), alignment_);
+
+    if (frame_offset_ + aligned_size > frame_capacity_)
+    {
+        // the new buffer is unused so there is nothing to wait on, the old buffer has to outlive this frame as earlier
+        // allocations may still be bound
+        frame_capacity_ = std::max(frame_capacity_ * 2u, aligned_size);
+
+        retire_buffer();
+        create_buffer();
+
+        frame_index_ = 0u;
+        frame_offset_ = 0u;
+    }
+
+    const auto offset = (frame_index_ * frame_capacity_) + frame_offset_;
+    frame_offset_ += aligned_size;
+
+    return {handle_, offset, size, data_ + offset};
+}
+
+std::size_t OpenGLRingBuffer::frame_capacity() const
+{
+    return frame_capacity_;
+}
+
+void OpenGLRingBuffer::create_buffer()
+{
+    const auto size = static_cast<GLsizeiptr>(frame_capacity_ * frames_in_flight);
+    const GLbitfield flags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+
+    ::glGenBuffers(1, &handle_);
+    expect(check_opengl_error, "could not generate opengl buffer");
+
+    ::glBindBuffer(GL_COPY_WRITE_BUFFER, handle_);
+    expect(check_opengl_error, "could not bind buffer");
+
+    ::glBufferStorage(GL_COPY_WRITE_BUFFER, size, nullptr, flags);
+    expect(check_opengl_error, "could not create buffer storage");
+
+    data_ = static_cast<std::byte *>(::glMapBufferRange(GL_COPY_WRITE_BUFFER, 0, size, flags));
+    ensure(data_ != nullptr, "could not map buffer");
+
+    ::glBindBuffer(GL_COPY_WRITE_BUFFER, 0u);
+    expect(check_opengl_error, "could not unbind buffer");
+}
+
+void OpenGLRingBuffer::retire_buffer()
+{
+    // fences only guard regions of the current buffer
+    for (auto &fence : fences_)
+    {
+        if (fence != nullptr)
+        {
+            ::glDeleteSync(fence);
+            fence = nullptr;
+        }
+    }
+
+    ::glBindBuffer(GL_COPY_WRITE_BUFFER, handle_);
+    expect(check_opengl_error, "could not bind buffer");
+
+    ::glUnmapBuffer(GL_COPY_WRITE_BUFFER);
+    expect(check_opengl_error, "could not unmap buffer");
+
+    ::glBindBuffer(GL_COPY_WRITE_BUFFER, 0u);
+    expect(check_opengl_error, "could not unbind buffer");
+
+    retired_handles_.push_back(handle_);
+    handle_ = 0u;
+    data_ = nullptr;
+}
+
+void OpenGLRingBuffer::delete_retired_buffers()
+{
+    // the driver defers freeing the storage until the GPU has finished with it
+    for (auto handle : retired_handles_)
+    {
+        ::glDeleteBuffers(1, &handle);
+    }
+
+    retired_handles_.clear();
+}
+
+}
@@ -0,0 +1,173 @@
+////////////////////////////////////////////////////////////////////////////////
+//         Distributed under the Boost Software License, Version 1.0.         //
+//            (See accompanying file LICENSE or copy at                       //
+//                 https://www.boost.org/LICENSE_1_0.txt)                     //
+////////////////////////////////////////////////////////////////////////////////
+
+#include "graphics/opengl/opengl_state_cache.h"
+
+#include <array>
+#include <optional>
+
+#include "core/error_handling.h"
+#include "core/telemetry.h"
+#include "graphics/opengl/opengl.h"
+
+namespace iris
+{
+
+OpenGLStateCache::OpenGLStateCache()
+    : program_()
+    , framebuffer_()
+    , blend_()
+    , blend_func_()
+    , depth_test_()
+    , depth_func_()
+    , polygon_mode_()
+    , uniform_buffers_()
+    , storage_buffers_()
+    , issued_counter_(Telemetry::instance().counter("opengl.state.calls_issued"))
+    , skipped_counter_(Telemetry::instance().counter("opengl.state.calls_skipped"))
+{
+}
+
+void OpenGLStateCache::invalidate()
+{
+    program_.reset();
+    framebuffer_.reset();
+    blend_.reset();
+    blend_func_.reset();
+    depth_test_.reset();
+    depth_func_.reset();
+    polygon_mode_.reset();
+    uniform_buffers_.fill(std::nullopt);
+    storage_buffers_.fill(std::nullopt);
+}
+
+void OpenGLStateCache::use_program(GLuint program)
+{
+    if (update(program_, program))
+    {
+        ::glUseProgram(program);
+        expect(check_opengl_error, "could not bind program");
+    }
+}
+
+void OpenGLStateCache::bind_framebuffer(GLuint framebuffer)
+{
+    if (update(framebuffer_, framebuffer))
+    {
+        ::glBindFramebuffer(GL_FRAMEBUFFER, framebuffer);
+        expect(check_opengl_error, "could not bind framebuffer");
+    }
+}
+
+void OpenGLStateCache::set_blend(bool enabled)
+{
+    if (update(blend_, enabled))
+    {
+        if (enabled)
+        {
+            ::glEnable(GL_BLEND);
+        }
+        else
+        {
+            ::glDisable(GL_BLEND);
+        }
+
+        expect(check_opengl_error, "could not set blend");
+    }
+}
+
+void OpenGLStateCache::set_blend_func(GLenum source, GLenum destination)
+{
+    if (update(blend_func_, {source, destination}))
+    {
+        ::glBlendFunc(source, destination);
+        expect(check_opengl_error, "could not set blend function");
+    }
+}
+
+void OpenGLStateCache::set_depth_test(bool enabled)
+{
+    if (update(depth_test_, enabled))
+    {
+        if (enabled)
+        {
+            ::glEnable(GL_DEPTH_TEST);
+        }
+        else
+        {
+            ::glDisable(GL_DEPTH_TEST);
+        }
+
+        expect(check_opengl_error, "could not set depth test");
+    }
+}
+
+void OpenGLStateCache::set_depth_func(GLenum func)
+{
+    if (update(depth_func_, func))
+    {
+        ::glDepthFunc(func);
+        expect(check_opengl_error, "could not set depth test function");
+    }
+}
+
+void OpenGLStateCache::set_polygon_mode(GLenum mode)
+{
+    if (update(polygon_mode_, mode))
+    {
+        ::glPolygonMode(GL_FRONT_AND_BACK, mode);
+        expect(check_opengl_error, "could not set polygon mode");
+    }
+}
+
+void OpenGLStateCache::bind_buffer_base(GLenum target, GLuint index, GLuint buffer)
+{
+    if (update(buffer_binding(target, index), {.buffer = buffer, .offset = 0, .size = -1}))
+    {
+        ::glBindBufferBase(target, index, buffer);
+        expect(check_opengl_error, "could not bind buffer base");
+    }
+}
+
+void OpenGLStateCache::bind_buffer_range(
+    GLenum target,
+    GLuint index,
+    GLuint buffer,
+    GLintptr offset,
+    GLsizeiptr size)
+{
+    if (update(buffer_binding(target, index), {.buffer = buffer, .offset = offset, .size = size}))
+    {
+        ::glBindBufferRange(target, index, buffer, offset, size);
+        expect(check_opengl_error, "could not bind buffer range");
+    }
+}
+
+template <class T>
+bool OpenGLStateCache::update(std::optional<T> &cached, const T &value)
+{
+    if (cached == value)
+    {
+        skipped_counter_.add();
+        return false;
+    }
+
+    cached = value;
+    issued_counter_.add();
+
+    return true;
+}
+
+std::optional<OpenGLStateCache::BufferBinding> &OpenGLStateCache::buffer_binding(GLenum target, GLuint index)
+{
+    expect(index < max_buffer_bindings, "buffer binding index out of range");
+    expect(
+        (target == GL_UNIFORM_BUFFER) || (target == GL_SHADER_STORAGE_BUFFER), "unsupported indexed buffer target");
+
+    return (target == GL_UNIFORM_BUFFER) ? uniform_buffers_[index] : storage_buffers_[index];
+}
+
+}
@@ -0,0 +1,209 @@
+////////////////////////////////////////////////////////////////////////////////
+//         Distributed under the Boost Software License, Version 1.0.         //
+//            (See accompanying file LICENSE or copy at                       //
+//                 https://www.boost.org/LICENSE_1_0.txt)                     //
+////////////////////////////////////////////////////////////////////////////////
+
+#include "graphics/render_command_sorter.h"
+
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <utility>
+#include <vector>
+
+#include "core/camera.h"
+#include "graphics/lights/light.h"
+#include "graphics/lights/light_type.h"
+#include "graphics/render_command.h"
+#include "graphics/render_command_type.h"
+#include "graphics/render_entity.h"
+#include "graphics/render_entity_type.h"
+#include "graphics/render_pass.h"
+#include "graphics/single_entity.h"
+
+namespace
+{
+
+// bit widths of each field in the sort key
+constexpr auto pass_bits = 8u;
+constexpr auto light_bits = 2u;
+constexpr auto id_bits = 16u;
+constexpr auto depth_bits = 21u;
+
+// shifts of each field in the sort key
+constexpr auto pass_shift = 64u - pass_bits;
+constexpr auto light_shift = pass_shift - light_bits;
+constexpr auto blend_shift = light_shift - 1u;
+constexpr auto high_shift = blend_shift - id_bits;
+
+/**
+ * Helper function to reduce a pointer to a small id. Collisions are harmless, they just mean two objects may not be
+ * grouped together.
+ *
+ * @param ptr
+ *   Pointer to get id for.
+ *
+ * @returns
+ *   Id in the range [0, 2^id_bits).
+ */
+std::uint64_t pointer_id(const void *ptr)
+{
+    // fibonacci hashing, take the top bits so the (always zero) alignment bits don't matter
+    return (static_cast<std::uint64_t>(reinterpret_cast<std::uintptr_t>(ptr)) * 0x9e3779b97f4a7c15ull) >>
+           (64u - id_bits);
+}
+
+/**
+ * Helper function to get the order lights are drawn in, this matches the order the RenderPipeline encodes them in.
+ *
+ * @param light_type
+ *   Light type to get order of.
+ *
+ * @returns
+ *   Order of light type.
+ */
+std::uint64_t light_order(iris::LightType light_type)
+{
+    switch (light_type)
+    {
+        case iris::LightType::AMBIENT: return 0u;
+        case iris::LightType::POINT: return 1u;
+        case iris::LightType::DIRECTIONAL: return 2u;
+    }
+
+    return 3u;
+}
+
+/**
+ * Helper function to get the quantised depth of the entity of a draw command.
+ *
+ * @param command
+ *   Command to get depth for.
+ *
+ * @returns
+ *   Quantised depth in the range [0, 2^depth_bits), instanced entities and passes without a camera have depth 0.
+ */
+std::uint64_t quantised_depth(const iris::RenderCommand &command)
+{
+    const auto *camera = command.render_pass()->camera;
+    const auto *render_entity = command.render_entity();
+
+    if ((camera == nullptr) || (render_entity->type() != iris::RenderEntityType::SINGLE))
+    {
+        return 0u;
+    }
+
+    const auto *entity = static_cast<const iris::SingleEntity *>(render_entity);
+    const auto offset = entity->position() - camera->position();
+    const auto distance = offset.dot(offset);
+
+    // the bit pattern of a positive float increases with its value, so the top bits (ignoring the sign) are a
+    // cheap logarithmic quantisation
+    return static_cast<std::uint64_t>(std::bit_cast<std::uint32_t>(distance) >> (31u - depth_bits));
+}
+
+}
+
+namespace iris
+{
+
+std::uint64_t RenderCommandSorter::sort_key(std::uint32_t pass_index, const RenderCommand &command)
+{
+    const auto *render_entity = command.render_entity();
+    const auto transparent = render_entity->has_transparency();
+    const auto material = pointer_id(command.material());
+    const auto mesh = pointer_id(render_entity->mesh());
+    const auto depth = quantised_depth(command);
+
+    auto key = (static_cast<std::uint64_t>(pass_index & ((1u << pass_bits) - 1u)) << pass_shift) |
+               (light_order(command.light()->type()) << light_shift);
+
+    if (transparent)
+    {
+        // back-to-front, so invert the depth
+        const auto inverted_depth = ((1ull << depth_bits) - 1u) - depth;
+        key |= (1ull << blend_shift) | (inverted_depth << (high_shift + id_bits - depth_bits)) | (material << id_bits) |
+               mesh;
+    }
+    else
+    {
+        key |= (material << high_shift) | (mesh << depth_bits) | depth;
+    }
+
+    return key;
+}
+
+void RenderCommandSorter::sort(std::span<RenderCommand> render_queue)
+{
+    auto pass_index = 0u;
+    std::size_t start = 0u;
+
+    for (auto i = 0u; i < render_queue.size(); ++i)
+    {
+        switch (render_queue[i].type())
+        {
+            case RenderCommandType::PASS_START: start = i + 1u; break;
+            case RenderCommandType::PASS_END: sort_pass(pass_index++, render_queue.subspan(start, i - start)); break;
+            default: break;
+        }
+    }
+}
+
+void RenderCommandSorter::sort_pass(std::uint32_t pass_index, std::span<RenderCommand> commands)
+{
+    const auto count = commands.size();
+    if (count < 2u)
+    {
+        return;
+    }
+
+    entries_.resize(count);
+    scratch_entries_.resize(count);
+
+    for (auto i = 0u; i < count; ++i)
+    {
+        entries_[i] = {.key = sort_key(pass_index, commands[i]), .index = static_cast<std::uint32_t>(i)};
+    }
+
+    // lsd radix sort, a byte at a time
+    for (auto shift = 0u; shift < 64u; shift += 8u)
+    {
+        std::array<std::uint32_t, 256u> offsets{};
+
+        for (const auto &entry : entries_)
+        {
+            ++offsets[(entry.key >> shift) & 0xffu];
+        }
+
+        // skip any byte which is the same for every key (e.g. the pass index), it wouldn't change the order
+        if (offsets[(entries_.front().key >> shift) & 0xffu] == count)
+        {
+            continue;
+        }
+
+        auto total = 0u;
+        for (auto &offset : offsets)
+        {
+            total += std::exchange(offset, total);
+        }
+
+        for (const auto &entry : entries_)
+        {
+            scratch_entries_[offsets[(entry.key >> shift) & 0xffu]++] = entry;
+        }
+
+        std::swap(entries_, scratch_entries_);
+    }
+
+    scratch_commands_.assign(std::cbegin(commands), std::cend(commands));
+
+    for (auto i = 0u; i < count; ++i)
+    {
+        commands[i] = scratch_commands_[entries_[i].index];
+    }
+}
+
+}
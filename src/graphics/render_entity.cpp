@@ -9,6 +9,8 @@
 #include <string>
 #include <string_view>
 
+#include "core/aabb.h"
+#include "core/bounding_sphere.h"
 #include "graphics/mesh.h"
 #include "graphics/primitive_type.h"
 
@@ -21,6 +23,11 @@ RenderEntity::RenderEntity(const Mesh *mesh, PrimitiveType primitive_type)
     , primitive_type_(primitive_type)
     , name_()
     , receive_shadow_(true)
+    , aabb_()
+    , bounding_sphere_()
+    , bounds_dirty_(false)
+    , cullable_(true)
+    , batchable_(true)
 {
 }
 
@@ -64,4 +71,51 @@ void RenderEntity::set_receive_shadow(bool receive_shadow)
     receive_shadow_ = receive_shadow;
 }
 
+const AABB &RenderEntity::aabb() const
+{
+    if (bounds_dirty_)
+    {
+        update_bounds();
+        bounds_dirty_ = false;
+    }
+
+    return aabb_;
+}
+
+const BoundingSphere &RenderEntity::bounding_sphere() const
+{
+    if (bounds_dirty_)
+    {
+        update_bounds();
+        bounds_dirty_ = false;
+    }
+
+    return bounding_sphere_;
+}
+
+bool RenderEntity::cullable() const
+{
+    return cullable_;
+}
+
+void RenderEntity::set_cullable(bool cullable)
+{
+    cullable_ = cullable;
+}
+
+bool RenderEntity::batchable() const
+{
+    return batchable_;
+}
+
+void RenderEntity::set_batchable(bool batchable)
+{
+    batchable_ = batchable;
+}
+
+void RenderEntity::update_bounds() const
+{
+    // default is to do nothing
+}
+
 }
@@ -49,6 +49,7 @@
 #include "graphics/render_graph/variable_node.h"
 #include "graphics/render_graph/vertex_node.h"
 #include "graphics/sampler.h"
+#include "graphics/shading_mode.h"
 #include "graphics/texture.h"
 #include "graphics/texture_manager.h"
 
@@ -133,6 +134,7 @@ ShaderCompiler::ShaderCompiler(
     ShaderLanguage language,
     const RenderGraph *render_graph,
     LightType light_type,
+    ShadingMode shading_mode,
     bool render_to_normal_target,
     bool render_to_position_target)
     : language_(language)
@@ -140,6 +142,7 @@ ShaderCompiler::ShaderCompiler(
     , fragment_stream_()
     , fragment_functions_()
     , light_type_(light_type)
+    , shading_mode_(shading_mode)
     , render_to_normal_target_(render_to_normal_target)
     , render_to_position_target_(render_to_position_target)
     , is_vertex_shader_(true)
@@ -189,6 +192,7 @@ void ShaderCompiler::visit(const RenderNode &node)
     ::inja::json vertex_args{
         {"is_directional_light", light_type_ == LightType::DIRECTIONAL},
         {"is_vertex_shader", true},
+        {"single_pass", shading_mode_ == ShadingMode::SINGLE_PASS},
         {"variables", std::vector<std::string>{}}};
 
     if (node.position_input() != nullptr)
@@ -232,6 +236,7 @@ void ShaderCompiler::visit(const RenderNode &node)
         {"render_normal", render_to_normal_target_},
         {"render_position", render_to_position_target_},
         {"light_type", static_cast<std::uint32_t>(light_type_)},
+        {"single_pass", shading_mode_ == ShadingMode::SINGLE_PASS},
         {"variables", std::vector<std::string>{}}};
 
     if (node.colour_input() != nullptr)
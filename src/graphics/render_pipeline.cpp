@@ -6,11 +6,17 @@
 
 #include "graphics/render_pipeline.h"
 
+#include <algorithm>
 #include <cstddef>
 #include <memory>
+#include <span>
+#include <tuple>
+#include <unordered_map>
+#include <unordered_set>
 #include <vector>
 
 #include "core/error_handling.h"
+#include "core/profile_scope.h"
 #include "graphics/material_manager.h"
 #include "graphics/mesh_manager.h"
 #include "graphics/render_graph/binary_operator_node.h"
@@ -31,30 +37,109 @@
 #include "graphics/render_target_manager.h"
 #include "graphics/renderer.h"
 #include "graphics/scene.h"
+#include "graphics/shading_mode.h"
 #include "graphics/single_entity.h"
+#include "jobs/job.h"
+#include "jobs/job_system_manager.h"
 #include "log/log.h"
 
 namespace
 {
 
+// number of entities encoded by a single job, small enough to spread a large pass over several jobs but large enough
+// that the cost of a job is amortised
+constexpr auto encode_chunk_size = 256u;
+
 /**
- * Helper function to create and enqueue all commands for rendering a Scene with
- * a given light type.
+ * Helper function to create the material for drawing an entity.
  *
- * @param scene
- *   Scene to render.
+ * @param material_manager
+ *   Material manager to create material with.
+ *
+ * @param render_pass
+ *   Pass entity is being drawn in.
+ *
+ * @param render_graph
+ *   RenderGraph for entity.
+ *
+ * @param render_entity
+ *   Entity to create material for.
  *
  * @param light_type
- *   Type of light for the scene.
+ *   Type of light entity is being drawn with.
  *
- * @param has_normal_target
- *   Flag indicating if normals should be rendered.
+ * @returns
+ *   Material for entity.
+ */
+const iris::Material *create_material(
+    iris::MaterialManager &material_manager,
+    const iris::RenderPass *render_pass,
+    iris::RenderGraph *render_graph,
+    iris::RenderEntity *render_entity,
+    iris::LightType light_type)
+{
+    // in single pass shading the ambient draw is the only draw and applies every light
+    const auto mode = (light_type == iris::LightType::AMBIENT) ? iris::RenderPipeline::shading_mode(render_pass)
+                                                               : iris::ShadingMode::PER_LIGHT;
+
+    return material_manager.create(
+        render_graph,
+        render_entity,
+        light_type,
+        mode,
+        render_pass->colour_target != nullptr,
+        (render_pass->normal_target != nullptr) && (light_type == iris::LightType::AMBIENT),
+        (render_pass->position_target != nullptr) && (light_type == iris::LightType::AMBIENT),
+        render_entity->has_transparency());
+}
+
+/**
+ * Helper function to get the shadow map an entity should sample when drawn with a directional light.
  *
- * @param has_position_target
- *   Flag indicating if positions should be rendered.
+ * @param render_entity
+ *   Entity being drawn.
  *
- * @param sky_box_render_graph
- *   Render graph for the sky box for this scene (if one is present), otherwise nullptr.
+ * @param light
+ *   Light entity is being drawn with.
+ *
+ * @param shadow_maps
+ *   Map of directional lights to their associated shadow map render target.
+ *
+ * @returns
+ *   Shadow map if entity receives shadows and light has one, otherwise nullptr.
+ */
+const iris::RenderTarget *shadow_map(
+    const iris::RenderEntity *render_entity,
+    const iris::Light *light,
+    const std::unordered_map<iris::DirectionalLight *, iris::RenderTarget *> &shadow_maps)
+{
+    if (!render_entity->receive_shadow())
+    {
+        return nullptr;
+    }
+
+    const auto found = std::find_if(
+        std::cbegin(shadow_maps),
+        std::cend(shadow_maps),
+        [light](const auto &element) { return element.first == light; });
+
+    return found == std::cend(shadow_maps) ? nullptr : found->second;
+}
+
+/**
+ * Helper function to create and enqueue all commands for rendering an entity with a given light type.
+ *
+ * @param scene
+ *   Scene entity is in.
+ *
+ * @param material
+ *   Material to draw entity with.
+ *
+ * @param render_entity
+ *   Entity to render.
+ *
+ * @param light_type
+ *   Type of light for the scene.
  *
  * @param cmd
  *   Command object to mutate and enqueue, this is passed in so it can be "pre-loaded" with the correct state.
@@ -65,74 +150,92 @@ namespace
  * @param shadow_maps
  *   Map of directional lights to their associated shadow map render target.
  */
-void encode_light_pass_commands(
-    iris::MaterialManager &material_manager,
+void encode_entity_commands(
     const iris::Scene *scene,
+    const iris::Material *material,
+    iris::RenderEntity *render_entity,
     iris::LightType light_type,
-    bool has_normal_target,
-    bool has_position_target,
-    const iris::RenderGraph *sky_box_render_graph,
     iris::RenderCommand &cmd,
     std::vector<iris::RenderCommand> &render_queue,
     const std::unordered_map<iris::DirectionalLight *, iris::RenderTarget *> &shadow_maps)
 {
-    for (const auto &[render_graph, render_entity] : scene->entities())
+    cmd.set_type(iris::RenderCommandType::DRAW);
+    cmd.set_material(material);
+    cmd.set_render_entity(render_entity);
+
+    // light specific draw commands
+    switch (light_type)
     {
-        // if we have a sky box we only want to render it once on the ambient pass
-        if ((render_graph == sky_box_render_graph) && (light_type != iris::LightType::AMBIENT))
+        case iris::LightType::AMBIENT:
+            cmd.set_light(scene->lighting_rig()->ambient_light.get());
+            render_queue.push_back(cmd);
+            break;
+        case iris::LightType::POINT:
+            // a draw command for each light
+            for (auto &light : scene->lighting_rig()->point_lights)
+            {
+                cmd.set_light(light.get());
+                render_queue.push_back(cmd);
+            }
+            break;
+        case iris::LightType::DIRECTIONAL:
+            // a draw command for each light
+            for (auto &light : scene->lighting_rig()->directional_lights)
+            {
+                cmd.set_light(light.get());
+                cmd.set_shadow_map(shadow_map(render_entity, light.get(), shadow_maps));
+                render_queue.push_back(cmd);
+            }
+            break;
+    }
+}
+
+/**
+ * Helper function to re-create the materials (and shadow maps) of all commands for a set of entities whose render
+ * graphs have changed.
+ *
+ * @param material_manager
+ *   Material manager to create materials with.
+ *
+ * @param updated
+ *   Map of updated entities to their new RenderGraph (and a mutable pointer to the entity).
+ *
+ * @param light_type
+ *   Type of light the commands are drawn with.
+ *
+ * @param render_queue
+ *   Commands to patch.
+ *
+ * @param shadow_maps
+ *   Map of directional lights to their associated shadow map render target.
+ */
+void update_entity_commands(
+    iris::MaterialManager &material_manager,
+    const std::unordered_map<const iris::RenderEntity *, std::tuple<iris::RenderGraph *, iris::RenderEntity *>>
+        &updated,
+    iris::LightType light_type,
+    std::vector<iris::RenderCommand> &render_queue,
+    const std::unordered_map<iris::DirectionalLight *, iris::RenderTarget *> &shadow_maps)
+{
+    for (auto &cmd : render_queue)
+    {
+        const auto found = updated.find(cmd.render_entity());
+        if (found == std::cend(updated))
         {
             continue;
         }
 
-        auto *material = material_manager.create(
-            render_graph,
-            render_entity.get(),
-            light_type,
-            cmd.render_pass()->colour_target != nullptr,
-            has_normal_target && (light_type == iris::LightType::AMBIENT),
-            has_position_target && (light_type == iris::LightType::AMBIENT),
-            render_entity->has_transparency());
-        cmd.set_material(material);
+        const auto &[render_graph, render_entity] = found->second;
 
-        cmd.set_render_entity(render_entity.get());
+        cmd.set_material(create_material(material_manager, cmd.render_pass(), render_graph, render_entity, light_type));
 
-        // light specific draw commands
-        switch (light_type)
+        if (light_type == iris::LightType::DIRECTIONAL)
         {
-            case iris::LightType::AMBIENT:
-                cmd.set_type(iris::RenderCommandType::DRAW);
-                cmd.set_light(scene->lighting_rig()->ambient_light.get());
-                render_queue.push_back(cmd);
-                break;
-            case iris::LightType::POINT:
-                // a draw command for each light
-                for (auto &light : scene->lighting_rig()->point_lights)
-                {
-                    cmd.set_type(iris::RenderCommandType::DRAW);
-                    cmd.set_light(light.get());
-                    render_queue.push_back(cmd);
-                }
-                break;
-            case iris::LightType::DIRECTIONAL:
-                // a draw command for each light
-                for (auto &light : scene->lighting_rig()->directional_lights)
-                {
-                    cmd.set_type(iris::RenderCommandType::DRAW);
-                    cmd.set_light(light.get());
-
-                    // set shadow map in render command
-                    if (render_entity->receive_shadow())
-                    {
-                        auto *shadow_map = shadow_maps.count(light.get()) == 0u ? nullptr : shadow_maps.at(light.get());
-                        cmd.set_shadow_map(shadow_map);
-                    }
-
-                    render_queue.push_back(cmd);
-                }
-                break;
+            cmd.set_shadow_map(shadow_map(render_entity, cmd.light(), shadow_maps));
         }
     }
 }
+
 }
 
 namespace iris
@@ -143,15 +246,18 @@ RenderPipeline::RenderPipeline(
     MeshManager &mesh_manager,
     RenderTargetManager &render_target_manager,
     std::uint32_t width,
-    std::uint32_t height)
+    std::uint32_t height,
+    JobSystemManager *jobs_manager)
     : material_manager_(material_manager)
     , mesh_manager_(mesh_manager)
     , render_target_manager_(render_target_manager)
+    , jobs_manager_(jobs_manager)
     , scenes_()
     , render_graphs_()
     , user_created_passes_()
     , engine_created_passes_()
     , render_passes_()
+    , pass_commands_()
     , sky_box_entities_()
     , dirty_(false)
     , width_(width)
@@ -194,6 +300,8 @@ RenderPass *RenderPipeline::create_render_pass(Scene *scene)
 
 std::vector<RenderCommand> RenderPipeline::build()
 {
+    IRIS_PROFILE_SCOPE("RenderPipeline::build");
+
     engine_created_passes_.clear();
     sky_box_entities_.clear();
     shadow_maps_.clear();
@@ -283,6 +391,9 @@ std::vector<RenderCommand> RenderPipeline::build()
             expect(inserted, "sky box exists");
 
             sky_box_entities_[pass.get()]->set_receive_shadow(false);
+
+            // the sky box is drawn around the camera regardless of its position
+            sky_box_entities_[pass.get()]->set_cullable(false);
             sky_box_render_graphs_[pass.get()] = sky_box_rg;
         }
     }
@@ -301,80 +412,79 @@ std::vector<RenderCommand> RenderPipeline::build()
 
 std::vector<RenderCommand> RenderPipeline::rebuild()
 {
-    std::vector<RenderCommand> render_queue;
-    RenderCommand cmd{};
-
-    // convert each pass into a series of commands which will render it
-    for (auto *pass : render_passes_)
-    {
-        cmd.set_render_pass(pass);
-
-        cmd.set_type(RenderCommandType::PASS_START);
-        render_queue.push_back(cmd);
-
-        const auto has_normal_target = pass->normal_target != nullptr;
-        const auto has_position_target = pass->position_target != nullptr;
+    IRIS_PROFILE_SCOPE("RenderPipeline::rebuild");
 
-        const auto *sky_box_rg = (sky_box_render_graphs_.contains(pass)) ? sky_box_render_graphs_[pass] : nullptr;
+    pass_commands_.clear();
+    pass_commands_.resize(render_passes_.size());
 
-        // encode ambient light pass unless we have used ssao (in which case this gets done by the ssao pass itself)
-        if (!pass->post_processing_description.ambient_occlusion)
+    // materials are created up front on this thread, as material managers are not thread safe and may need the
+    // graphics context
+    std::vector<std::vector<EntityMaterials>> pass_entities(render_passes_.size());
+    for (auto i = 0u; i < render_passes_.size(); ++i)
+    {
+        for (const auto &[render_graph, render_entity] : render_passes_[i]->scene->entities())
         {
-            encode_light_pass_commands(
-                material_manager_,
-                pass->scene,
-                LightType::AMBIENT,
-                has_normal_target,
-                has_position_target,
-                sky_box_rg,
-                cmd,
-                render_queue,
-                shadow_maps_);
+            pass_entities[i].push_back(create_materials(render_passes_[i], render_graph, render_entity.get()));
         }
+    }
 
-        if (!pass->depth_only)
+    // convert each pass into a series of commands which will render it
+    if (jobs_manager_ == nullptr)
+    {
+        for (auto i = 0u; i < render_passes_.size(); ++i)
         {
-            // encode point lights if there are any
-            if (!pass->scene->lighting_rig()->point_lights.empty())
-            {
-                encode_light_pass_commands(
-                    material_manager_,
-                    pass->scene,
-                    LightType::POINT,
-                    has_normal_target,
-                    has_position_target,
-                    sky_box_rg,
-                    cmd,
-                    render_queue,
-                    shadow_maps_);
-            }
-
-            // encode directional lights if there are any
-            if (!pass->scene->lighting_rig()->directional_lights.empty())
+            for (const auto &entity_materials : pass_entities[i])
             {
-                encode_light_pass_commands(
-                    material_manager_,
-                    pass->scene,
-                    LightType::DIRECTIONAL,
-                    has_normal_target,
-                    has_position_target,
-                    sky_box_rg,
-                    cmd,
-                    render_queue,
-                    shadow_maps_);
+                encode_entity(render_passes_[i], entity_materials, pass_commands_[i]);
             }
         }
+    }
+    else
+    {
+        encode_parallel(pass_entities);
+    }
 
-        cmd.set_type(RenderCommandType::PASS_END);
-        render_queue.push_back(cmd);
+    // every entity has just been encoded, so any pending changes are already accounted for
+    for (auto &scene : scenes_)
+    {
+        scene->clear_changes();
     }
 
-    cmd.set_type(RenderCommandType::PRESENT);
-    render_queue.push_back(cmd);
+    std::vector<RenderCommand> render_queue{};
+    flatten(render_queue);
 
     return render_queue;
 }
 
+bool RenderPipeline::update(std::vector<RenderCommand> &render_queue)
+{
+    if (std::none_of(
+            std::cbegin(scenes_), std::cend(scenes_), [](const auto &scene) { return scene->has_changes(); }))
+    {
+        return false;
+    }
+
+    IRIS_PROFILE_SCOPE("RenderPipeline::update");
+
+    for (auto i = 0u; i < render_passes_.size(); ++i)
+    {
+        if (render_passes_[i]->scene->has_changes())
+        {
+            patch_pass(render_passes_[i], pass_commands_[i]);
+        }
+    }
+
+    // only clear once all passes have been patched, as a scene may be rendered by several passes
+    for (auto &scene : scenes_)
+    {
+        scene->clear_changes();
+    }
+
+    flatten(render_queue);
+
+    return true;
+}
+
 std::vector<RenderPass *> RenderPipeline::render_passes() const
 {
     return render_passes_;
@@ -401,6 +511,218 @@ RenderPass *RenderPipeline::create_engine_render_pass(Scene *scene)
     return engine_created_passes_.back().get();
 }
 
+RenderPipeline::EntityMaterials RenderPipeline::create_materials(
+    const RenderPass *pass,
+    RenderGraph *render_graph,
+    RenderEntity *render_entity)
+{
+    EntityMaterials entity_materials{
+        .render_entity = render_entity, .ambient = nullptr, .point = nullptr, .directional = nullptr};
+
+    const auto *sky_box_rg = sky_box_render_graphs_.contains(pass) ? sky_box_render_graphs_.at(pass) : nullptr;
+
+    // ambient light pass is skipped if we have used ssao (in which case this gets done by the ssao pass itself)
+    if (!pass->post_processing_description.ambient_occlusion)
+    {
+        entity_materials.ambient =
+            create_material(material_manager_, pass, render_graph, render_entity, LightType::AMBIENT);
+    }
+
+    // if we have a sky box we only want to render it once on the ambient pass, and in single pass shading the ambient
+    // draw applies all the other lights
+    if (pass->depth_only || (render_graph == sky_box_rg) || (shading_mode(pass) == ShadingMode::SINGLE_PASS))
+    {
+        return entity_materials;
+    }
+
+    if (!pass->scene->lighting_rig()->point_lights.empty())
+    {
+        entity_materials.point =
+            create_material(material_manager_, pass, render_graph, render_entity, LightType::POINT);
+    }
+
+    if (!pass->scene->lighting_rig()->directional_lights.empty())
+    {
+        entity_materials.directional =
+            create_material(material_manager_, pass, render_graph, render_entity, LightType::DIRECTIONAL);
+    }
+
+    return entity_materials;
+}
+
+void RenderPipeline::encode_entity(
+    const RenderPass *pass,
+    const EntityMaterials &entity_materials,
+    PassCommands &commands) const
+{
+    RenderCommand cmd{};
+    cmd.set_render_pass(pass);
+
+    if (entity_materials.ambient != nullptr)
+    {
+        encode_entity_commands(
+            pass->scene,
+            entity_materials.ambient,
+            entity_materials.render_entity,
+            LightType::AMBIENT,
+            cmd,
+            commands.ambient,
+            shadow_maps_);
+    }
+
+    if (entity_materials.point != nullptr)
+    {
+        encode_entity_commands(
+            pass->scene,
+            entity_materials.point,
+            entity_materials.render_entity,
+            LightType::POINT,
+            cmd,
+            commands.point,
+            shadow_maps_);
+    }
+
+    if (entity_materials.directional != nullptr)
+    {
+        encode_entity_commands(
+            pass->scene,
+            entity_materials.directional,
+            entity_materials.render_entity,
+            LightType::DIRECTIONAL,
+            cmd,
+            commands.directional,
+            shadow_maps_);
+    }
+}
+
+void RenderPipeline::encode_parallel(const std::vector<std::vector<EntityMaterials>> &pass_entities)
+{
+    IRIS_PROFILE_SCOPE("RenderPipeline::encode_parallel");
+
+    // a contiguous run of entities from a single pass, with the commands encoded for them
+    struct Chunk
+    {
+        std::size_t pass_index;
+        std::span<const EntityMaterials> entities;
+        PassCommands commands;
+    };
+
+    std::vector<Chunk> chunks{};
+
+    for (auto i = 0u; i < pass_entities.size(); ++i)
+    {
+        const std::span<const EntityMaterials> entities{pass_entities[i]};
+
+        for (auto start = 0u; start < entities.size(); start += encode_chunk_size)
+        {
+            const auto count = std::min<std::size_t>(encode_chunk_size, entities.size() - start);
+            chunks.push_back({.pass_index = i, .entities = entities.subspan(start, count), .commands = {}});
+        }
+    }
+
+    std::vector<Job> jobs{};
+    for (auto &chunk : chunks)
+    {
+        jobs.emplace_back(
+            [this, &chunk]
+            {
+                for (const auto &entity_materials : chunk.entities)
+                {
+                    encode_entity(render_passes_[chunk.pass_index], entity_materials, chunk.commands);
+                }
+            });
+    }
+
+    // a single chunk gains nothing from being run as a job
+    if (jobs.size() == 1u)
+    {
+        jobs.front()();
+    }
+    else if (!jobs.empty())
+    {
+        jobs_manager_->wait(jobs);
+    }
+
+    // chunks are in pass and entity order, so appending them reproduces the serial output
+    for (const auto &chunk : chunks)
+    {
+        auto &commands = pass_commands_[chunk.pass_index];
+
+        commands.ambient.insert(
+            std::cend(commands.ambient), std::cbegin(chunk.commands.ambient), std::cend(chunk.commands.ambient));
+        commands.point.insert(
+            std::cend(commands.point), std::cbegin(chunk.commands.point), std::cend(chunk.commands.point));
+        commands.directional.insert(
+            std::cend(commands.directional),
+            std::cbegin(chunk.commands.directional),
+            std::cend(chunk.commands.directional));
+    }
+}
+
+void RenderPipeline::patch_pass(const RenderPass *pass, PassCommands &commands)
+{
+    const auto *scene = pass->scene;
+
+    // removals are applied first, an added entity may have been allocated at the address of a removed one
+    if (!scene->removed_entities_.empty())
+    {
+        const std::unordered_set<const RenderEntity *> removed{
+            std::cbegin(scene->removed_entities_), std::cend(scene->removed_entities_)};
+        const auto is_removed = [&removed](const RenderCommand &cmd) { return removed.contains(cmd.render_entity()); };
+
+        std::erase_if(commands.ambient, is_removed);
+        std::erase_if(commands.point, is_removed);
+        std::erase_if(commands.directional, is_removed);
+    }
+
+    // entities with a new render graph keep their place in the queue, we just swap out their materials
+    if (!scene->updated_entities_.empty())
+    {
+        std::unordered_map<const RenderEntity *, std::tuple<RenderGraph *, RenderEntity *>> updated{};
+        for (const auto &[render_graph, render_entity] : scene->updated_entities_)
+        {
+            updated.emplace(render_entity, std::make_tuple(render_graph, render_entity));
+        }
+
+        update_entity_commands(material_manager_, updated, LightType::AMBIENT, commands.ambient, shadow_maps_);
+        update_entity_commands(material_manager_, updated, LightType::POINT, commands.point, shadow_maps_);
+        update_entity_commands(material_manager_, updated, LightType::DIRECTIONAL, commands.directional, shadow_maps_);
+    }
+
+    // entities are only ever appended to a scene, so their commands go at the end of each light section
+    for (const auto &[render_graph, render_entity] : scene->added_entities_)
+    {
+        encode_entity(pass, create_materials(pass, render_graph, render_entity), commands);
+    }
+}
+
+void RenderPipeline::flatten(std::vector<RenderCommand> &render_queue) const
+{
+    render_queue.clear();
+    RenderCommand cmd{};
+
+    for (auto i = 0u; i < render_passes_.size(); ++i)
+    {
+        const auto &commands = pass_commands_[i];
+
+        cmd.set_render_pass(render_passes_[i]);
+
+        cmd.set_type(RenderCommandType::PASS_START);
+        render_queue.push_back(cmd);
+
+        render_queue.insert(std::cend(render_queue), std::cbegin(commands.ambient), std::cend(commands.ambient));
+        render_queue.insert(std::cend(render_queue), std::cbegin(commands.point), std::cend(commands.point));
+        render_queue.insert(
+            std::cend(render_queue), std::cbegin(commands.directional), std::cend(commands.directional));
+
+        cmd.set_type(RenderCommandType::PASS_END);
+        render_queue.push_back(cmd);
+    }
+
+    cmd.set_type(RenderCommandType::PRESENT);
+    render_queue.push_back(cmd);
+}
+
 const RenderTarget *RenderPipeline::add_pass(
     std::vector<RenderPass *> &render_passes,
     std::function<void(RenderGraph *, const RenderTarget *)> create_render_graph_callback)
@@ -413,11 +735,14 @@ const RenderTarget *RenderPipeline::add_pass(
     auto *scene = create_scene();
     auto *rg = create_render_graph();
     create_render_graph_callback(rg, target);
-    scene->create_entity<SingleEntity>(
+    auto *entity = scene->create_entity<SingleEntity>(
         rg,
         mesh_manager_.sprite({}),
         Transform({}, {}, {static_cast<float>(width_), static_cast<float>(height_), 1. - 1}));
 
+    // full screen passes always cover the whole target, so there's no point culling them
+    entity->set_cullable(false);
+
     auto *pass = create_engine_render_pass(scene);
     pass->camera = camera;
 
@@ -504,4 +829,21 @@ Scene *RenderPipeline::scene(std::size_t index) const
     return scenes_[index].get();
 }
 
+const RenderTarget *RenderPipeline::shadow_map(const DirectionalLight *light) const
+{
+    const auto found = std::find_if(
+        std::cbegin(shadow_maps_),
+        std::cend(shadow_maps_),
+        [light](const auto &element) { return element.first == light; });
+
+    return found == std::cend(shadow_maps_) ? nullptr : found->second;
+}
+
+ShadingMode RenderPipeline::shading_mode(const RenderPass *render_pass)
+{
+    return (render_pass->depth_only || render_pass->post_processing_description.ambient_occlusion)
+               ? ShadingMode::PER_LIGHT
+               : render_pass->shading_mode;
+}
+
 }
@@ -6,29 +6,69 @@
 
 #include "graphics/renderer.h"
 
+#include <algorithm>
 #include <cassert>
+#include <vector>
 
 #include "core/exception.h"
+#include "core/latency_tracker.h"
+#include "core/profile_scope.h"
+#include "core/scoped_timer.h"
+#include "core/telemetry.h"
+#include "graphics/draw_batcher.h"
+#include "graphics/frustum_culler.h"
+#include "graphics/instanced_entity.h"
+#include "graphics/light_culler.h"
 #include "graphics/material_manager.h"
+#include "graphics/render_command_sorter.h"
+#include "graphics/render_entity_type.h"
 
 namespace iris
 {
 
-Renderer::Renderer(MaterialManager &material_manager)
+Renderer::Renderer(MaterialManager &material_manager, bool batch_draws)
     : render_queue_()
+    , instanced_entities_()
     , render_pipeline_()
     , start_(std::chrono::steady_clock::now())
     , time_(0u)
+    , visible_queue_()
+    , frustum_culler_()
+    , light_culler_()
+    , render_command_sorter_()
+    , draw_batcher_()
+    , batch_draws_(batch_draws)
     , material_manager_(material_manager)
 {
 }
 
 void Renderer::render()
 {
+    IRIS_PROFILE_SCOPE("Renderer::render");
+
+    static auto &render_histogram = Telemetry::instance().histogram("renderer.render");
+    ScopedTimer timer{render_histogram};
+
+    // structural changes need the whole queue re-encoding, otherwise just patch in any entity changes
     if (render_pipeline_->is_dirty())
     {
         render_queue_ = render_pipeline_->rebuild();
         render_pipeline_->clear_dirty_bit();
+        update_instanced_entities();
+    }
+    else if (render_pipeline_->update(render_queue_))
+    {
+        update_instanced_entities();
+    }
+
+    // cull and sort every frame, as entities, lights and cameras moving changes both visibility and depth
+    frustum_culler_.cull(render_queue_, visible_queue_);
+    light_culler_.cull(visible_queue_);
+    render_command_sorter_.sort(visible_queue_);
+
+    if (batch_draws_)
+    {
+        draw_batcher_.batch(visible_queue_);
     }
 
     pre_render();
@@ -38,14 +78,17 @@ void Renderer::render()
     time_ = std::chrono::steady_clock::now() - start_;
 
     // call each command with the appropriate handler
-    for (auto &command : render_queue_)
+    for (auto &command : visible_queue_)
     {
         switch (command.type())
         {
             case RenderCommandType::PASS_START: execute_pass_start(command); break;
             case RenderCommandType::DRAW: execute_draw(command); break;
             case RenderCommandType::PASS_END: execute_pass_end(command); break;
-            case RenderCommandType::PRESENT: execute_present(command); break;
+            case RenderCommandType::PRESENT:
+                execute_present(command);
+                LatencyTracker::instance().record_present();
+                break;
             default: throw Exception("unknown render queue command");
         }
     }
@@ -64,6 +107,7 @@ void Renderer::set_render_pipeline(std::unique_ptr<RenderPipeline> render_pipeli
         {
             render_queue_ = render_pipeline_->build();
             render_pipeline_->clear_dirty_bit();
+            update_instanced_entities();
         });
 }
 
@@ -72,6 +116,32 @@ std::chrono::milliseconds Renderer::time() const
     return std::chrono::duration_cast<std::chrono::milliseconds>(time_);
 }
 
+void Renderer::update_instanced_entities()
+{
+    instanced_entities_.clear();
+
+    std::vector<const Scene *> scenes{};
+
+    for (const auto *pass : render_pipeline_->render_passes())
+    {
+        // several passes may render the same scene
+        if (std::find(std::cbegin(scenes), std::cend(scenes), pass->scene) != std::cend(scenes))
+        {
+            continue;
+        }
+
+        scenes.push_back(pass->scene);
+
+        for (auto &[render_graph, render_entity] : pass->scene->entities())
+        {
+            if (render_entity->type() == RenderEntityType::INSTANCED)
+            {
+                instanced_entities_.push_back(static_cast<InstancedEntity *>(render_entity.get()));
+            }
+        }
+    }
+}
+
 void Renderer::pre_render()
 {
     // default is to do nothing
@@ -6,6 +6,8 @@
 
 #include "graphics/scene.h"
 
+#include <algorithm>
+#include <tuple>
 #include <vector>
 
 #include "core/colour.h"
@@ -22,23 +24,28 @@ Scene::Scene(RenderGraph *default_render_graph, bool *dirty_pipeline)
     , lighting_rig_()
     , default_render_graph_(default_render_graph)
     , dirty_pipeline_(dirty_pipeline)
+    , added_entities_()
+    , removed_entities_()
+    , updated_entities_()
 {
     lighting_rig_.ambient_light = std::make_unique<AmbientLight>(Colour{1.0f, 1.0f, 1.0f});
 }
 
 RenderEntity *Scene::add(RenderGraph *render_graph, std::unique_ptr<RenderEntity> entity)
 {
-    *dirty_pipeline_ = true;
-
     if (render_graph == nullptr)
     {
         render_graph = default_render_graph_;
         entity->set_receive_shadow(false);
     }
 
-    entities_.emplace_back(render_graph, std::move(entity));
+    auto *added = std::get<1>(entities_.emplace_back(render_graph, std::move(entity))).get();
+
+    // appending an entity doesn't change the structure of the pipeline, so just record it and let the pipeline patch
+    // in its commands
+    added_entities_.emplace_back(render_graph, added);
 
-    return std::get<1>(entities_.back()).get();
+    return added;
 }
 
 RenderEntity *Scene::add_at_front(RenderGraph *render_graph, std::unique_ptr<RenderEntity> entity)
@@ -58,7 +65,16 @@ RenderEntity *Scene::add_at_front(RenderGraph *render_graph, std::unique_ptr<Ren
 
 void Scene::remove(RenderEntity *entity)
 {
-    *dirty_pipeline_ = true;
+    const auto is_entity = [entity](const auto &element) { return std::get<1>(element) == entity; };
+
+    // if the pipeline never saw this entity then we can just forget about it, otherwise record it so its commands can
+    // be removed
+    if (std::erase_if(added_entities_, is_entity) == 0u)
+    {
+        removed_entities_.emplace_back(entity);
+    }
+
+    std::erase_if(updated_entities_, is_entity);
 
     entities_.erase(
         std::remove_if(
@@ -68,6 +84,40 @@ void Scene::remove(RenderEntity *entity)
         std::end(entities_));
 }
 
+void Scene::set_render_graph(RenderEntity *entity, RenderGraph *render_graph)
+{
+    if (render_graph == nullptr)
+    {
+        render_graph = default_render_graph_;
+    }
+
+    auto found = std::find_if(std::begin(entities_), std::end(entities_), [entity](const auto &element) {
+        return std::get<1>(element).get() == entity;
+    });
+
+    expect(found != std::end(entities_), "entity not in scene");
+
+    std::get<0>(*found) = render_graph;
+
+    const auto is_entity = [entity](const auto &element) { return std::get<1>(element) == entity; };
+
+    // a pending add will pick up the new render graph, otherwise record the update (replacing any earlier one)
+    if (auto pending = std::find_if(std::begin(added_entities_), std::end(added_entities_), is_entity);
+        pending != std::end(added_entities_))
+    {
+        std::get<0>(*pending) = render_graph;
+    }
+    else if (auto updated = std::find_if(std::begin(updated_entities_), std::end(updated_entities_), is_entity);
+             updated != std::end(updated_entities_))
+    {
+        std::get<0>(*updated) = render_graph;
+    }
+    else
+    {
+        updated_entities_.emplace_back(render_graph, entity);
+    }
+}
+
 PointLight *Scene::add(std::unique_ptr<PointLight> light)
 {
     *dirty_pipeline_ = true;
@@ -91,8 +141,7 @@ Colour Scene::ambient_light() const
 
 void Scene::set_ambient_light(const Colour &colour)
 {
-    *dirty_pipeline_ = true;
-
+    // commands reference the light, which is read when drawing, so no need to touch the pipeline
     lighting_rig_.ambient_light->set_colour(colour);
 }
 
@@ -102,7 +151,7 @@ RenderGraph *Scene::render_graph(RenderEntity *entity) const
         return std::get<1>(element).get() == entity;
     });
 
-    expect(found == std::cend(entities_), "entity not in scene");
+    expect(found != std::cend(entities_), "entity not in scene");
 
     return std::get<0>(*found);
 }
@@ -122,4 +171,16 @@ const LightingRig *Scene::lighting_rig() const
     return &lighting_rig_;
 }
 
+bool Scene::has_changes() const
+{
+    return !added_entities_.empty() || !removed_entities_.empty() || !updated_entities_.empty();
+}
+
+void Scene::clear_changes()
+{
+    added_entities_.clear();
+    removed_entities_.clear();
+    updated_entities_.clear();
+}
+
 }
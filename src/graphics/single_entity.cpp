@@ -82,6 +82,10 @@ SingleEntity::SingleEntity(
     ensure(mesh != nullptr, "must supply mesh");
 
     normal_ = create_normal_transform(transform_.matrix());
+    update_bounds();
+
+    // skinning moves vertices away from the bind pose, so the mesh bounds can't be trusted
+    cullable_ = (skeleton_ == nullptr);
 }
 
 RenderEntityType SingleEntity::type() const
@@ -98,6 +102,7 @@ void SingleEntity::set_position(const Vector3 &position)
 {
     transform_.set_translation(position);
     normal_ = create_normal_transform(transform_.matrix());
+    update_bounds();
 }
 
 Quaternion SingleEntity::orientation() const
@@ -109,6 +114,7 @@ void SingleEntity::set_orientation(const Quaternion &orientation)
 {
     transform_.set_rotation(orientation);
     normal_ = create_normal_transform(transform_.matrix());
+    update_bounds();
 }
 
 Vector3 SingleEntity::scale() const
@@ -120,6 +126,7 @@ void SingleEntity::set_scale(const Vector3 &scale)
 {
     transform_.set_scale(scale);
     normal_ = create_normal_transform(transform_.matrix());
+    update_bounds();
 }
 
 Matrix4 SingleEntity::transform() const
@@ -131,6 +138,7 @@ void SingleEntity::set_transform(const Matrix4 &transform)
 {
     transform_.set_matrix(transform);
     normal_ = create_normal_transform(transform_.matrix());
+    update_bounds();
 }
 
 void SingleEntity::set_transform(const Transform &transform)
@@ -146,6 +154,7 @@ Matrix4 SingleEntity::normal_transform() const
 void SingleEntity::set_mesh(const Mesh *mesh)
 {
     mesh_ = mesh;
+    update_bounds();
 }
 
 Skeleton *SingleEntity::skeleton()
@@ -163,4 +172,12 @@ bool SingleEntity::has_transparency() const
     return has_transparency_;
 }
 
+void SingleEntity::update_bounds()
+{
+    const auto transform = transform_.matrix();
+
+    aabb_ = mesh_->aabb().transformed(transform);
+    bounding_sphere_ = mesh_->bounding_sphere().transformed(transform);
+}
+
 }
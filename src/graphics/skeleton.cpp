@@ -15,6 +15,7 @@
 
 #include "core/error_handling.h"
 #include "core/matrix4.h"
+#include "core/string_id.h"
 #include "graphics/animation/animation.h"
 #include "graphics/animation/bone_query.h"
 #include "graphics/bone.h"
@@ -72,7 +73,7 @@ void update_transforms(
         else if (query != nullptr)
         {
             // check if our bone exists in the supplied animation
-            if (const auto transform = query->transform(bone.name()); transform)
+            if (const auto transform = query->transform(bone.id()); transform)
             {
                 // apply parent transform with animation transform
                 cache[i] = cache[parents[i]] * transform->matrix();
@@ -101,6 +102,7 @@ Skeleton::Skeleton()
 Skeleton::Skeleton(std::vector<Bone> bones)
     : bones_()
     , parents_()
+    , bone_lookup_()
     , transforms_(100)
 {
     // a root bone is one without a parent, only support one
@@ -147,6 +149,12 @@ Skeleton::Skeleton(std::vector<Bone> bones)
         }
 
     } while (!queue.empty());
+
+    // keep the first bone for duplicate names, to match the linear search this replaced
+    for (auto i = 0u; i < bones_.size(); ++i)
+    {
+        bone_lookup_.try_emplace(bones_[i].id(), i);
+    }
 }
 
 const std::vector<Bone> &Skeleton::bones() const
@@ -166,20 +174,25 @@ void Skeleton::update(BoneQuery *query)
 
 bool Skeleton::has_bone(std::string_view name) const
 {
-    const auto bone =
-        std::find_if(std::cbegin(bones_), std::cend(bones_), [&name](const Bone &bone) { return bone.name() == name; });
+    return has_bone(StringId{name});
+}
 
-    return bone != std::cend(bones_);
+bool Skeleton::has_bone(StringId id) const
+{
+    return bone_lookup_.contains(id);
 }
 
 std::size_t Skeleton::bone_index(std::string_view name) const
 {
-    const auto bone =
-        std::find_if(std::cbegin(bones_), std::cend(bones_), [&name](const Bone &bone) { return bone.name() == name; });
+    return bone_index(StringId{name});
+}
 
-    expect(bone != std::cend(bones_), "unknown bone");
+std::size_t Skeleton::bone_index(StringId id) const
+{
+    const auto bone = bone_lookup_.find(id);
+    expect(bone != std::cend(bone_lookup_), "unknown bone");
 
-    return std::distance(std::cbegin(bones_), bone);
+    return bone->second;
 }
 
 Bone &Skeleton::bone(std::size_t index)
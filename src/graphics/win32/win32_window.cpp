@@ -7,9 +7,11 @@
 #include "graphics/win32/win32_window.h"
 
 #include <cmath>
+#include <cstddef>
 #include <optional>
 #include <queue>
 #include <set>
+#include <vector>
 
 #define WIN32_LEAN_AND_MEAN
 #include <ShellScalingApi.h>
@@ -37,6 +39,20 @@ namespace
 // way of passing in custom data we use a global queue to store events
 std::queue<iris::Event> event_queue;
 
+/**
+ * Helper function to run a non-blocking loop to drain all available windows messages, our window procedure converts
+ * them to engine events in event_queue.
+ */
+void dispatch_messages()
+{
+    MSG message = {0};
+    while (::PeekMessageA(&message, NULL, 0, 0, PM_REMOVE) != 0)
+    {
+        ::TranslateMessage(&message);
+        ::DispatchMessageA(&message);
+    }
+}
+
 /**
  * Helper function to convert a windows key code to an engine key type.
  *
@@ -330,13 +346,7 @@ std::uint32_t Win32Window::screen_scale() const
 
 std::optional<Event> Win32Window::pump_event()
 {
-    // non-blocking loop to drain all available windows messages
-    MSG message = {0};
-    while (::PeekMessageA(&message, NULL, 0, 0, PM_REMOVE) != 0)
-    {
-        ::TranslateMessage(&message);
-        ::DispatchMessageA(&message);
-    }
+    dispatch_messages();
 
     std::optional<Event> event;
 
@@ -345,11 +355,27 @@ std::optional<Event> Win32Window::pump_event()
     {
         event = event_queue.front();
         event_queue.pop();
+        record_input(*event);
     }
 
     return event;
 }
 
+std::size_t Win32Window::pump_events(std::vector<Event> &events)
+{
+    dispatch_messages();
+
+    const auto count = event_queue.size();
+
+    while (!event_queue.empty())
+    {
+        record_input(events.emplace_back(event_queue.front()));
+        event_queue.pop();
+    }
+
+    return count;
+}
+
 HDC Win32Window::device_context() const
 {
     return dc_;
@@ -7,10 +7,15 @@
 #include "graphics/window.h"
 
 #include <chrono>
+#include <cstddef>
 #include <cstdint>
 #include <deque>
 #include <memory>
+#include <optional>
+#include <vector>
 
+#include "core/latency_tracker.h"
+#include "events/event.h"
 #include "graphics/render_pass.h"
 #include "graphics/render_pipeline.h"
 #include "graphics/render_target.h"
@@ -25,6 +30,26 @@ Window::Window(std::uint32_t width, std::uint32_t height)
 {
 }
 
+std::size_t Window::pump_events(std::vector<Event> &events)
+{
+    const auto size = events.size();
+
+    for (auto event = pump_event(); event; event = pump_event())
+    {
+        events.emplace_back(*event);
+    }
+
+    return events.size() - size;
+}
+
+void Window::record_input(Event &event)
+{
+    auto &latency_tracker = LatencyTracker::instance();
+
+    event.set_frame(latency_tracker.frame());
+    latency_tracker.record_input(event.frame(), event.timestamp());
+}
+
 void Window::render() const
 {
     renderer_->render();
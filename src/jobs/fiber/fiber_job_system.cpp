@@ -18,6 +18,7 @@
 #include <vector>
 
 #include "core/auto_release.h"
+#include "core/profile_scope.h"
 #include "core/semaphore.h"
 #include "core/thread.h"
 #include "jobs/concurrent_queue.h"
@@ -82,6 +83,7 @@ void job_thread(
         {
             // if we have no wait counter then this is the first time we are
             // seeing this fibre - so start it
+            IRIS_PROFILE_SCOPE("job");
             fiber->start();
         }
         else
@@ -93,7 +95,10 @@ void job_thread(
             {
                 // wait counter of zero means all its children jobs have
                 // finished so we can resume
-                fiber->resume();
+                {
+                    IRIS_PROFILE_SCOPE("job");
+                    fiber->resume();
+                }
 
                 // if nothing is waiting on us then we were a fire-and-forget
                 // job so need to cleanup
@@ -10,6 +10,7 @@
 #include <future>
 #include <vector>
 
+#include "core/profile_scope.h"
 #include "jobs/job.h"
 #include "log/log.h"
 
@@ -33,7 +34,13 @@ void ThreadJobSystem::add_jobs(const std::vector<Job> &jobs)
         // scope until the job is complete
         auto future = std::make_shared<std::future<void>>();
 
-        *future = std::async(std::launch::async, [future, job] { job(); });
+        *future = std::async(
+            std::launch::async,
+            [future, job]
+            {
+                IRIS_PROFILE_SCOPE("job");
+                job();
+            });
     }
 }
 
@@ -43,7 +50,13 @@ void ThreadJobSystem::wait_for_jobs(const std::vector<Job> &jobs)
 
     for (const auto &job : jobs)
     {
-        waiting_jobs.emplace_back(std::async(std::launch::async, job));
+        waiting_jobs.emplace_back(std::async(
+            std::launch::async,
+            [&job]
+            {
+                IRIS_PROFILE_SCOPE("job");
+                job();
+            }));
     }
 
     for (auto &waiting_job : waiting_jobs)
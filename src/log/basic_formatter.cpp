@@ -8,11 +8,10 @@
 
 #include <chrono>
 #include <filesystem>
-#include <iomanip>
-#include <iostream>
-#include <sstream>
 #include <string>
+#include <string_view>
 
+#include "log/format.h"
 #include "log/log_level.h"
 
 namespace
@@ -27,16 +26,16 @@ namespace
  * @returns
  *   Filename from supplied string.
  */
-std::string format_filename(const std::string &filename)
+std::string_view format_filename(std::string_view filename)
 {
     // find last occurrence of file separator
     const auto index = filename.rfind(std::filesystem::path::preferred_separator);
 
-    return std::string{filename.substr(index + 1)};
+    return index == std::string_view::npos ? filename : filename.substr(index + 1u);
 }
 
 /**
- * Convert log level to string and get first character.
+ * Get first character of log level string.
  *
  * @param level
  *   Log level to get first character of.
@@ -46,12 +45,14 @@ std::string format_filename(const std::string &filename)
  */
 char first_char_of_level(const iris::LogLevel level)
 {
-    std::stringstream strm{};
-    strm << level;
-
-    const auto str = strm.str();
-
-    return !str.empty() ? str.front() : 'U';
+    switch (level)
+    {
+        case iris::LogLevel::DEBUG: return 'D';
+        case iris::LogLevel::INFO: return 'I';
+        case iris::LogLevel::WARN: return 'W';
+        case iris::LogLevel::ERR: return 'E';
+        default: return 'U';
+    }
 }
 
 }
@@ -59,21 +60,26 @@ char first_char_of_level(const iris::LogLevel level)
 namespace iris
 {
 
-std::string BasicFormatter::format(
+void BasicFormatter::format(
+    std::string &out,
     const LogLevel level,
-    const std::string &tag,
-    const std::string &message,
-    const std::string &filename,
+    std::string_view tag,
+    std::string_view message,
+    std::string_view filename,
     const int line)
 {
     const auto now = std::chrono::system_clock::now();
     const auto seconds = std::chrono::duration_cast<std::chrono::seconds>(now.time_since_epoch());
 
-    std::stringstream strm{};
-
-    strm << first_char_of_level(level) << " " << seconds.count() << " [" << tag << "] " << format_filename(filename)
-         << ":" << line << " | " << message;
-    return strm.str();
+    format_to(
+        out,
+        "{} {} [{}] {}:{} | {}",
+        first_char_of_level(level),
+        seconds.count(),
+        tag,
+        format_filename(filename),
+        line,
+        message);
 }
 
 }
@@ -0,0 +1,294 @@
+////////////////////////////////////////////////////////////////////////////////
+//         Distributed under the Boost Software License, Version 1.0.         //
+//            (See accompanying file LICENSE or copy at                       //
+//                 https://www.boost.org/LICENSE_1_0.txt)                     //
+////////////////////////////////////////////////////////////////////////////////
+
+#include "log/binary_log_decoder.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <iomanip>
+#include <istream>
+#include <ostream>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include "core/error_handling.h"
+#include "log/binary_log_format.h"
+#include "log/binary_log_type.h"
+#include "log/format.h"
+#include "log/log_level.h"
+
+namespace
+{
+
+/**
+ * Decoded LogSite.
+ */
+struct Site
+{
+    iris::LogLevel level;
+    std::int32_t line;
+    std::string filename;
+    std::string tag;
+    std::string format;
+    bool dynamic_tag;
+    bool dynamic_format;
+};
+
+/**
+ * A single undecoded message.
+ */
+struct Record
+{
+    std::uint64_t timestamp;
+    std::uint32_t site_id;
+    std::string payload;
+};
+
+/**
+ * Helper function to read a value from a stream as raw bytes.
+ *
+ * @param in
+ *   Stream to read from.
+ *
+ * @returns
+ *   Read value.
+ */
+template <class T>
+T read_value(std::istream &in)
+{
+    T value{};
+    in.read(reinterpret_cast<char *>(&value), sizeof(value));
+    iris::ensure(static_cast<bool>(in), "truncated binary log");
+
+    return value;
+}
+
+/**
+ * Helper function to read a length prefixed string from a stream.
+ *
+ * @param in
+ *   Stream to read from.
+ *
+ * @returns
+ *   Read string.
+ */
+std::string read_string(std::istream &in)
+{
+    std::string str(read_value<std::uint32_t>(in), '\0');
+    in.read(str.data(), str.size());
+    iris::ensure(static_cast<bool>(in), "truncated binary log");
+
+    return str;
+}
+
+/**
+ * Helper class for reading values out of a record payload.
+ */
+class PayloadReader
+{
+  public:
+    explicit PayloadReader(std::string_view payload)
+        : payload_(payload)
+        , offset_(0u)
+    {
+    }
+
+    bool empty() const
+    {
+        return offset_ == payload_.size();
+    }
+
+    template <class T>
+    T read()
+    {
+        iris::ensure(payload_.size() - offset_ >= sizeof(T), "corrupt binary log record");
+
+        T value{};
+        std::memcpy(&value, payload_.data() + offset_, sizeof(T));
+        offset_ += sizeof(T);
+
+        return value;
+    }
+
+    std::string_view read_string()
+    {
+        const auto size = read<std::uint32_t>();
+        iris::ensure(payload_.size() - offset_ >= size, "corrupt binary log record");
+
+        const auto str = payload_.substr(offset_, size);
+        offset_ += size;
+
+        return str;
+    }
+
+    std::string_view read_string_arg()
+    {
+        iris::ensure(read<iris::BinaryLogType>() == iris::BinaryLogType::STRING, "expected string argument");
+        return read_string();
+    }
+
+    /**
+     * Read the next argument and pass it (as its original type) to the supplied function.
+     *
+     * @param func
+     *   Function to call with argument.
+     */
+    template <class F>
+    void visit_arg(F &&func)
+    {
+        switch (read<iris::BinaryLogType>())
+        {
+            case iris::BinaryLogType::BOOL: func(read<bool>()); break;
+            case iris::BinaryLogType::CHAR: func(read<char>()); break;
+            case iris::BinaryLogType::INT8: func(read<std::int8_t>()); break;
+            case iris::BinaryLogType::UINT8: func(read<std::uint8_t>()); break;
+            case iris::BinaryLogType::INT16: func(read<std::int16_t>()); break;
+            case iris::BinaryLogType::UINT16: func(read<std::uint16_t>()); break;
+            case iris::BinaryLogType::INT32: func(read<std::int32_t>()); break;
+            case iris::BinaryLogType::UINT32: func(read<std::uint32_t>()); break;
+            case iris::BinaryLogType::INT64: func(read<std::int64_t>()); break;
+            case iris::BinaryLogType::UINT64: func(read<std::uint64_t>()); break;
+            case iris::BinaryLogType::FLOAT: func(read<float>()); break;
+            case iris::BinaryLogType::DOUBLE: func(read<double>()); break;
+            case iris::BinaryLogType::STRING: func(read_string()); break;
+            default: throw iris::Exception("unknown binary log type");
+        }
+    }
+
+  private:
+    std::string_view payload_;
+    std::size_t offset_;
+};
+
+/**
+ * Format a message in the same way as the text logger, each '{}' is replaced with the next argument.
+ *
+ * @param format
+ *   Format string.
+ *
+ * @param reader
+ *   Reader positioned at the first argument.
+ *
+ * @returns
+ *   Formatted message.
+ */
+std::string format_message(std::string_view format, PayloadReader &reader)
+{
+    std::string message{};
+    std::size_t pos = 0u;
+
+    while (!reader.empty())
+    {
+        reader.visit_arg([&](const auto &value) { iris::detail::format_next(message, format, pos, value); });
+    }
+
+    message.append(format.substr(pos));
+
+    return message;
+}
+
+}
+
+namespace iris
+{
+
+void decode_binary_log(std::istream &in, std::ostream &out)
+{
+    char magic[sizeof(binary_log_magic)] = {};
+    in.read(magic, sizeof(magic));
+    ensure(in && std::equal(std::cbegin(magic), std::cend(magic), binary_log_magic), "not a binary log");
+    ensure(read_value<std::uint32_t>(in) == binary_log_version, "unsupported binary log version");
+
+    const auto steady_start = read_value<std::uint64_t>(in);
+    const auto system_start = read_value<std::uint64_t>(in);
+
+    std::unordered_map<std::uint32_t, Site> sites{};
+    std::vector<Record> records{};
+
+    while (in.peek() != std::istream::traits_type::eof())
+    {
+        switch (read_value<BinaryLogBlockType>(in))
+        {
+            case BinaryLogBlockType::SITE:
+            {
+                const auto id = read_value<std::uint32_t>(in);
+
+                Site site{};
+                site.level = read_value<LogLevel>(in);
+                read_value<std::uint8_t>(in);
+                site.line = read_value<std::int32_t>(in);
+                site.filename = read_string(in);
+                site.tag = read_string(in);
+                site.format = read_string(in);
+
+                const auto flags = read_value<std::uint8_t>(in);
+                site.dynamic_tag = (flags & 0x1) != 0u;
+                site.dynamic_format = (flags & 0x2) != 0u;
+
+                sites[id] = std::move(site);
+                break;
+            }
+            case BinaryLogBlockType::CHUNK:
+            {
+                read_value<std::uint32_t>(in);
+                const auto chunk = read_string(in);
+
+                // split the chunk into records
+                PayloadReader reader{chunk};
+                while (!reader.empty())
+                {
+                    Record record{};
+                    record.site_id = reader.read<std::uint32_t>();
+                    record.timestamp = reader.read<std::uint64_t>();
+                    record.payload = std::string{reader.read_string()};
+
+                    records.emplace_back(std::move(record));
+                }
+                break;
+            }
+            default: throw Exception("unknown binary log block");
+        }
+    }
+
+    // chunks from different threads are interleaved, so restore global time order
+    std::stable_sort(
+        std::begin(records),
+        std::end(records),
+        [](const Record &a, const Record &b) { return a.timestamp < b.timestamp; });
+
+    for (const auto &record : records)
+    {
+        const auto site = sites.find(record.site_id);
+        ensure(site != std::cend(sites), "binary log record has unknown site");
+
+        PayloadReader reader{record.payload};
+
+        const auto tag = site->second.dynamic_tag ? std::string{reader.read_string_arg()} : site->second.tag;
+        const auto message = site->second.dynamic_format ? std::string{reader.read_string_arg()}
+                                                         : format_message(site->second.format, reader);
+
+        // convert to wall clock time
+        const auto time = system_start + (record.timestamp - steady_start);
+
+        std::stringstream level{};
+        level << site->second.level;
+
+        const auto &filename = site->second.filename;
+        const auto separator = filename.rfind(std::filesystem::path::preferred_separator);
+
+        out << level.str().front() << " " << time / 1'000'000'000u << "." << std::setw(6) << std::setfill('0')
+            << (time % 1'000'000'000u) / 1'000u << " [" << tag << "] " << filename.substr(separator + 1u) << ":"
+            << site->second.line << " | " << message << '\n';
+    }
+}
+
+}
@@ -0,0 +1,289 @@
+////////////////////////////////////////////////////////////////////////////////
+//         Distributed under the Boost Software License, Version 1.0.         //
+//            (See accompanying file LICENSE or copy at                       //
+//                 https://www.boost.org/LICENSE_1_0.txt)                     //
+////////////////////////////////////////////////////////////////////////////////
+
+#include "log/binary_log_writer.h"
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <string_view>
+
+#include "core/error_handling.h"
+#include "log/binary_log_format.h"
+#include "log/log_site.h"
+
+namespace
+{
+
+/** How often the background thread writes buffers to file. */
+static constexpr auto drain_interval = std::chrono::milliseconds(5);
+
+/** Source of unique writer ids. */
+std::atomic<std::uint64_t> next_writer_id = 1u;
+
+/**
+ * Helper function to write a value to a stream as raw bytes.
+ *
+ * @param out
+ *   Stream to write to.
+ *
+ * @param value
+ *   Value to write.
+ */
+template <class T>
+void write_value(std::ostream &out, const T &value)
+{
+    out.write(reinterpret_cast<const char *>(&value), sizeof(value));
+}
+
+/**
+ * Helper function to write a length prefixed string to a stream.
+ *
+ * @param out
+ *   Stream to write to.
+ *
+ * @param str
+ *   String to write, null is written as an empty string.
+ */
+void write_string(std::ostream &out, const char *str)
+{
+    const std::string_view view = str == nullptr ? std::string_view{} : std::string_view{str};
+
+    write_value(out, static_cast<std::uint32_t>(view.size()));
+    out.write(view.data(), view.size());
+}
+
+/**
+ * Get current time as nanoseconds since epoch of the supplied clock.
+ *
+ * @returns
+ *   Current time in nanoseconds.
+ */
+template <class Clock>
+std::uint64_t now_ns()
+{
+    return static_cast<std::uint64_t>(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now().time_since_epoch()).count());
+}
+
+}
+
+namespace iris
+{
+
+BinaryLogWriter::BinaryLogWriter(const std::filesystem::path &path, std::size_t thread_capacity)
+    : id_(next_writer_id++)
+    , thread_capacity_(std::bit_ceil(thread_capacity))
+    , file_(path, std::ios::out | std::ios::binary | std::ios::trunc)
+    , buffers_()
+    , free_buffers_(std::make_shared<FreeBuffers>())
+    , buffers_mutex_()
+    , drain_mutex_()
+    , sites_written_(0u)
+    , running_(true)
+    , running_mutex_()
+    , running_cv_()
+    , thread_()
+{
+    ensure(thread_capacity > 0u, "thread capacity must be non-zero");
+    ensure(file_.is_open(), "could not open binary log file");
+
+    // header contains the time on both the clock used for timestamps and the wall clock, so the decoder can convert
+    file_.write(binary_log_magic, sizeof(binary_log_magic));
+    write_value(file_, binary_log_version);
+    write_value(file_, now_ns<std::chrono::steady_clock>());
+    write_value(file_, now_ns<std::chrono::system_clock>());
+
+    thread_ = std::thread{&BinaryLogWriter::run, this};
+}
+
+BinaryLogWriter::~BinaryLogWriter()
+{
+    {
+        std::unique_lock lock(running_mutex_);
+        running_ = false;
+    }
+
+    running_cv_.notify_one();
+    thread_.join();
+
+    flush();
+}
+
+void BinaryLogWriter::flush()
+{
+    std::unique_lock lock(drain_mutex_);
+    drain();
+}
+
+bool BinaryLogWriter::try_flush()
+{
+    std::unique_lock lock(drain_mutex_, std::try_to_lock);
+    if (lock.owns_lock())
+    {
+        drain();
+    }
+
+    return lock.owns_lock();
+}
+
+std::uint64_t BinaryLogWriter::dropped_count() const
+{
+    std::unique_lock lock(buffers_mutex_);
+
+    std::uint64_t dropped = 0u;
+    for (const auto &buffer : buffers_)
+    {
+        dropped += buffer->dropped.load(std::memory_order_relaxed);
+    }
+
+    return dropped;
+}
+
+BinaryLogWriter::ThreadBufferOwner::~ThreadBufferOwner()
+{
+    release();
+}
+
+void BinaryLogWriter::ThreadBufferOwner::release()
+{
+    if (buffer == nullptr)
+    {
+        return;
+    }
+
+    // if the writer has been destroyed then so has the buffer, so there is nothing to return
+    if (const auto free = free_buffers.lock(); free)
+    {
+        std::unique_lock lock(free->mutex);
+        free->buffers.push_back(buffer);
+    }
+
+    buffer = nullptr;
+    free_buffers.reset();
+}
+
+BinaryLogWriter::ThreadBuffer *BinaryLogWriter::thread_buffer()
+{
+    // the owner records the id of the writer the buffer belongs to, so a new writer doesn't get a stale buffer
+    thread_local ThreadBufferOwner owner{};
+
+    if (owner.writer_id != id_)
+    {
+        owner.release();
+
+        {
+            // reuse the buffer of an exited thread, any messages still in it are drained as normal as only the
+            // producer has changed
+            std::unique_lock lock(free_buffers_->mutex);
+            if (!free_buffers_->buffers.empty())
+            {
+                owner.buffer = free_buffers_->buffers.back();
+                free_buffers_->buffers.pop_back();
+            }
+        }
+
+        if (owner.buffer == nullptr)
+        {
+            auto new_buffer = std::make_unique<ThreadBuffer>();
+            new_buffer->data = std::make_unique<std::byte[]>(thread_capacity_);
+            new_buffer->mask = thread_capacity_ - 1u;
+            new_buffer->head = 0u;
+            new_buffer->tail = 0u;
+            new_buffer->position = 0u;
+            new_buffer->dropped = 0u;
+
+            std::unique_lock lock(buffers_mutex_);
+
+            new_buffer->thread_id = static_cast<std::uint32_t>(buffers_.size() + 1u);
+            owner.buffer = new_buffer.get();
+
+            buffers_.emplace_back(std::move(new_buffer));
+        }
+
+        owner.writer_id = id_;
+        owner.free_buffers = free_buffers_;
+    }
+
+    return owner.buffer;
+}
+
+void BinaryLogWriter::drain()
+{
+    std::vector<std::pair<ThreadBuffer *, std::uint64_t>> buffers{};
+
+    {
+        std::unique_lock lock(buffers_mutex_);
+        for (const auto &buffer : buffers_)
+        {
+            buffers.emplace_back(buffer.get(), buffer->tail.load(std::memory_order_acquire));
+        }
+    }
+
+    // sites are registered before any message using them is committed, so by loading the tails first we are
+    // guaranteed to write every site a message refers to before the message itself
+    for (const auto *site : LogSiteRegistry::instance().sites(sites_written_))
+    {
+        write_value(file_, BinaryLogBlockType::SITE);
+        write_value(file_, site->id);
+        write_value(file_, site->level);
+        write_value(file_, static_cast<std::uint8_t>(site->engine));
+        write_value(file_, static_cast<std::int32_t>(site->line));
+        write_string(file_, site->filename);
+        write_string(file_, site->tag);
+        write_string(file_, site->format);
+        write_value(file_, static_cast<std::uint8_t>((site->tag == nullptr) | ((site->format == nullptr) << 1u)));
+
+        ++sites_written_;
+    }
+
+    for (auto &[buffer, tail] : buffers)
+    {
+        const auto head = buffer->head.load(std::memory_order_relaxed);
+        if (head == tail)
+        {
+            continue;
+        }
+
+        // a chunk is a contiguous run of whole records from a single thread, which may wrap around the buffer
+        const auto size = tail - head;
+        const auto index = head & buffer->mask;
+        const auto first = std::min<std::uint64_t>(size, (buffer->mask + 1u) - index);
+
+        write_value(file_, BinaryLogBlockType::CHUNK);
+        write_value(file_, buffer->thread_id);
+        write_value(file_, static_cast<std::uint32_t>(size));
+        file_.write(reinterpret_cast<const char *>(buffer->data.get() + index), first);
+        file_.write(reinterpret_cast<const char *>(buffer->data.get()), size - first);
+
+        buffer->head.store(tail, std::memory_order_release);
+    }
+
+    file_.flush();
+}
+
+void BinaryLogWriter::run()
+{
+    std::unique_lock lock(running_mutex_);
+
+    while (running_)
+    {
+        running_cv_.wait_for(lock, drain_interval);
+
+        std::unique_lock drain_lock(drain_mutex_);
+        drain();
+    }
+}
+
+}
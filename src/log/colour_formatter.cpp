@@ -6,41 +6,35 @@
 
 #include "log/colour_formatter.h"
 
-#include <chrono>
-#include <filesystem>
-#include <iomanip>
-#include <iostream>
-#include <sstream>
 #include <string>
+#include <string_view>
 
 #include "log/log_level.h"
 
 namespace iris
 {
 
-std::string ColourFormatter::format(
+void ColourFormatter::format(
+    std::string &out,
     const LogLevel level,
-    const std::string &tag,
-    const std::string &message,
-    const std::string &filename,
+    std::string_view tag,
+    std::string_view message,
+    std::string_view filename,
     const int line)
 {
-    std::stringstream strm{};
-
     // apply an ANSI escape sequence to start colour output
     switch (level)
     {
-        case LogLevel::DEBUG: strm << "\x1b[35m"; break;
-        case LogLevel::INFO: strm << "\x1b[34m"; break;
-        case LogLevel::WARN: strm << "\x1b[33m"; break;
-        case LogLevel::ERR: strm << "\x1b[31m"; break;
+        case LogLevel::DEBUG: out += "\x1b[35m"; break;
+        case LogLevel::INFO: out += "\x1b[34m"; break;
+        case LogLevel::WARN: out += "\x1b[33m"; break;
+        case LogLevel::ERR: out += "\x1b[31m"; break;
         default: break;
     }
 
     // write message and reset ANSI escape code
-    strm << formatter_.format(level, tag, message, filename, line) << "\x1b[0m";
-
-    return strm.str();
+    formatter_.format(out, level, tag, message, filename, line);
+    out += "\x1b[0m";
 }
 
 }
@@ -6,43 +6,36 @@
 
 #include "log/emoji_formatter.h"
 
-#include <chrono>
-#include <filesystem>
-#include <iomanip>
-#include <iostream>
-#include <sstream>
 #include <string>
+#include <string_view>
 
 #include "log/log_level.h"
 
 namespace iris
 {
 
-std::string EmojiFormatter::format(
+void EmojiFormatter::format(
+    std::string &out,
     const LogLevel level,
-    const std::string &tag,
-    const std::string &message,
-    const std::string &filename,
+    std::string_view tag,
+    std::string_view message,
+    std::string_view filename,
     const int line)
 {
-    std::stringstream strm{};
-
     // apply an emoji to start of output
     // depending on your text editor the emojis below may not display, but they
     // are there!
     switch (level)
     {
-        case LogLevel::DEBUG: strm << "🔵 "; break;
-        case LogLevel::INFO: strm << "ℹ️ "; break;
-        case LogLevel::WARN: strm << "⚠️ "; break;
-        case LogLevel::ERR: strm << "❌ "; break;
+        case LogLevel::DEBUG: out += "🔵 "; break;
+        case LogLevel::INFO: out += "ℹ️ "; break;
+        case LogLevel::WARN: out += "⚠️ "; break;
+        case LogLevel::ERR: out += "❌ "; break;
         default: break;
     }
 
     // write message
-    strm << formatter_.format(level, tag, message, filename, line);
-
-    return strm.str();
+    formatter_.format(out, level, tag, message, filename, line);
 }
 
 }
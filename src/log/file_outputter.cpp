@@ -22,7 +22,12 @@ FileOutputter::FileOutputter(const std::string &filename)
 
 void FileOutputter::output(const std::string &log)
 {
-    file_ << log << std::endl;
+    file_ << log << '\n';
+}
+
+void FileOutputter::flush()
+{
+    file_.flush();
 }
 
 }
@@ -0,0 +1,55 @@
+////////////////////////////////////////////////////////////////////////////////
+//         Distributed under the Boost Software License, Version 1.0.         //
+//            (See accompanying file LICENSE or copy at                       //
+//                 https://www.boost.org/LICENSE_1_0.txt)                     //
+////////////////////////////////////////////////////////////////////////////////
+
+#include "log/log_site.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <mutex>
+#include <vector>
+
+#include "core/string_id.h"
+#include "log/log_level.h"
+
+namespace iris
+{
+
+LogSite::LogSite(LogLevel level, bool engine, const char *filename, int line, const char *tag, const char *format)
+    : level(level)
+    , engine(engine)
+    , filename(filename)
+    , line(line)
+    , tag(tag)
+    , tag_id(tag != nullptr ? StringId::intern(tag) : StringId{})
+    , format(format)
+    , id(LogSiteRegistry::instance().add(this))
+{
+}
+
+LogSiteRegistry &LogSiteRegistry::instance()
+{
+    static LogSiteRegistry registry{};
+    return registry;
+}
+
+std::uint32_t LogSiteRegistry::add(const LogSite *site)
+{
+    std::unique_lock lock(mutex_);
+
+    sites_.emplace_back(site);
+    return static_cast<std::uint32_t>(sites_.size() - 1u);
+}
+
+std::vector<const LogSite *> LogSiteRegistry::sites(std::size_t first) const
+{
+    std::unique_lock lock(mutex_);
+
+    return first < sites_.size() ? std::vector<const LogSite *>(std::cbegin(sites_) + first, std::cend(sites_))
+                                 : std::vector<const LogSite *>{};
+}
+
+}
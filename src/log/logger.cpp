@@ -0,0 +1,497 @@
+////////////////////////////////////////////////////////////////////////////////
+//         Distributed under the Boost Software License, Version 1.0.         //
+//            (See accompanying file LICENSE or copy at                       //
+//                 https://www.boost.org/LICENSE_1_0.txt)                     //
+////////////////////////////////////////////////////////////////////////////////
+
+#include "log/logger.h"
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <csignal>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <exception>
+#include <filesystem>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <thread>
+
+#include "core/mpsc_queue.h"
+#include "log/binary_log_writer.h"
+#include "log/colour_formatter.h"
+#include "log/format.h"
+#include "log/log_level.h"
+#include "log/log_overflow_policy.h"
+#include "log/log_site.h"
+#include "log/stdout_outputter.h"
+
+namespace
+{
+
+/** Maximum number of messages the writer outputs before flushing. */
+static constexpr std::size_t batch_size = 256u;
+
+/** How long to sleep between checks of the writer's progress when crashing. */
+static constexpr auto crash_drain_poll = std::chrono::milliseconds(1);
+
+/** How long to wait for the writer to drain the queue when crashing. */
+static constexpr auto crash_drain_timeout = std::chrono::milliseconds(500);
+
+/** Fatal signals to flush on. */
+static constexpr int crash_signals[] = {
+    SIGABRT,
+    SIGFPE,
+    SIGILL,
+    SIGSEGV,
+#if defined(SIGBUS)
+    SIGBUS,
+#endif
+};
+
+/**
+ * Get a thread local buffer to format log lines into. This is separate to format_buffer() as the message is
+ * typically in that buffer.
+ *
+ * @returns
+ *   Cleared thread local buffer.
+ */
+std::string &line_buffer()
+{
+    thread_local std::string buffer{};
+
+    buffer.clear();
+    return buffer;
+}
+
+/** Whether the calling thread holds the logger lock, so a crash handler on this thread knows not to take it. */
+thread_local bool holds_output_lock = false;
+
+/** Whether the calling thread is the asynchronous writer, so a crash handler on this thread knows not to wait on it. */
+thread_local bool is_async_writer = false;
+
+/**
+ * RAII guard for the logger lock which records that the calling thread holds it.
+ */
+class OutputLock
+{
+  public:
+    /**
+     * Construct a new OutputLock, blocking until the lock is acquired.
+     *
+     * @param mutex
+     *   Logger lock.
+     */
+    explicit OutputLock(std::mutex &mutex)
+        : lock_(mutex)
+    {
+        holds_output_lock = true;
+    }
+
+    ~OutputLock()
+    {
+        holds_output_lock = false;
+    }
+
+    OutputLock(const OutputLock &) = delete;
+    OutputLock &operator=(const OutputLock &) = delete;
+
+  private:
+    /** Underlying lock. */
+    std::unique_lock<std::mutex> lock_;
+};
+
+/** Terminate handler which was installed before ours. */
+std::terminate_handler previous_terminate_handler = nullptr;
+
+/**
+ * Handler for fatal signals, flushes the log then re-raises the signal with the default handler.
+ *
+ * This is best effort, flushing is not async-signal-safe. Logger::flush_on_crash() avoids the lock and the writer
+ * when the crashing thread is using them, but output may still be lost or the handler may itself crash.
+ *
+ * @param signal
+ *   Signal that was raised.
+ */
+extern "C" void crash_signal_handler(int signal)
+{
+    iris::Logger::instance().flush_on_crash();
+
+    std::signal(signal, SIG_DFL);
+    std::raise(signal);
+}
+
+/**
+ * Handler for std::terminate, flushes the log then calls the previous handler.
+ */
+void crash_terminate_handler()
+{
+    iris::Logger::instance().flush_on_crash();
+
+    if (previous_terminate_handler != nullptr)
+    {
+        previous_terminate_handler();
+    }
+
+    std::abort();
+}
+
+}
+
+namespace iris
+{
+
+/**
+ * A log message waiting to be formatted and output.
+ */
+struct LogRecord
+{
+    LogLevel level;
+    std::string tag;
+    std::string filename;
+    int line;
+    std::string message;
+};
+
+struct Logger::AsyncState
+{
+    AsyncState(std::size_t capacity, LogOverflowPolicy policy)
+        : queue(capacity)
+        , policy(policy)
+        , running(true)
+        , enqueued(0u)
+        , written(0u)
+        , dropped(0u)
+        , sleeping(false)
+        , wake_mutex()
+        , wake()
+        , writer()
+    {
+    }
+
+    /**
+     * Wake the writer if it is waiting. This only takes the lock if the writer is (or is about to start) waiting, so
+     * producers don't touch it whilst the writer is busy.
+     */
+    void wake_writer()
+    {
+        // seq_cst pairs with the writer setting sleeping before checking for work, so either we see it sleeping or it
+        // sees our message
+        if (sleeping.load(std::memory_order_seq_cst))
+        {
+            {
+                std::unique_lock lock(wake_mutex);
+            }
+
+            wake.notify_one();
+        }
+    }
+
+    /** Queue of messages to write. */
+    MpscQueue<LogRecord> queue;
+
+    /** What to do when queue is full. */
+    LogOverflowPolicy policy;
+
+    /** Flag indicating whether the writer should keep running. */
+    std::atomic<bool> running;
+
+    /** Number of messages pushed on to the queue. */
+    std::atomic<std::uint64_t> enqueued;
+
+    /** Number of messages written and flushed by the writer. */
+    std::atomic<std::uint64_t> written;
+
+    /** Number of messages dropped because the queue was full. */
+    std::atomic<std::uint64_t> dropped;
+
+    /** Flag indicating the writer is waiting for messages. */
+    std::atomic<bool> sleeping;
+
+    /** Lock for waiting on wake. */
+    std::mutex wake_mutex;
+
+    /** Used to wake the writer when there are messages or it should stop. */
+    std::condition_variable wake;
+
+    /** Writer thread. */
+    std::thread writer;
+};
+
+Logger::Logger()
+    : formatter_(std::make_unique<ColourFormatter>())
+    , outputter_(std::make_unique<StdoutFormatter>())
+    , ignore_()
+    , min_level_(LogLevel::DEBUG)
+    , log_engine_(false)
+    , mutex_()
+    , async_()
+    , binary_()
+{
+    // make sure the site registry outlives us, as the binary writer reads it on destruction
+    LogSiteRegistry::instance();
+}
+
+Logger::~Logger()
+{
+    set_async(false);
+    binary_.reset();
+}
+
+void Logger::set_async(bool async, std::size_t queue_capacity, LogOverflowPolicy policy)
+{
+    if (async_)
+    {
+        // stop the current writer, it will drain the queue before exiting
+        async_->running = false;
+
+        {
+            std::unique_lock lock(async_->wake_mutex);
+        }
+
+        async_->wake.notify_one();
+        async_->writer.join();
+        async_.reset();
+    }
+
+    if (async)
+    {
+        async_ = std::make_unique<AsyncState>(queue_capacity, policy);
+        async_->writer = std::thread{&Logger::write_async, this};
+    }
+}
+
+void Logger::set_binary_output(const std::filesystem::path &path, std::size_t thread_capacity)
+{
+    binary_.reset();
+
+    if (!path.empty())
+    {
+        binary_ = std::make_unique<BinaryLogWriter>(path, thread_capacity);
+    }
+}
+
+void Logger::flush()
+{
+    if (binary_)
+    {
+        binary_->flush();
+    }
+
+    if (async_)
+    {
+        // wait for the writer to catch up with everything pushed so far
+        const auto target = async_->enqueued.load(std::memory_order_acquire);
+        while (async_->written.load(std::memory_order_acquire) < target)
+        {
+            std::this_thread::yield();
+        }
+    }
+
+    OutputLock lock(mutex_);
+    outputter_->sync();
+}
+
+std::uint64_t Logger::dropped_count() const
+{
+    return (async_ ? async_->dropped.load(std::memory_order_relaxed) : 0u) +
+           (binary_ ? binary_->dropped_count() : 0u);
+}
+
+void Logger::install_crash_handler()
+{
+    for (const auto signal : crash_signals)
+    {
+        std::signal(signal, crash_signal_handler);
+    }
+
+    previous_terminate_handler = std::set_terminate(crash_terminate_handler);
+}
+
+void Logger::flush_on_crash()
+{
+    if (binary_)
+    {
+        binary_->try_flush();
+    }
+
+    // if this thread crashed while holding the lock then the outputter is in an unknown state and the writer can never
+    // make progress, so there is nothing we can safely do (and trying to lock a mutex we own is undefined)
+    if (holds_output_lock)
+    {
+        return;
+    }
+
+    if (async_ && !is_async_writer)
+    {
+        // give the writer a chance to drain the queue, but don't wait forever as it may be stuck behind another thread
+        const auto target = async_->enqueued.load(std::memory_order_acquire);
+        const auto deadline = std::chrono::steady_clock::now() + crash_drain_timeout;
+
+        while ((async_->written.load(std::memory_order_acquire) < target) &&
+               (std::chrono::steady_clock::now() < deadline))
+        {
+            // nanosleep and clock_gettime are async-signal-safe, unlike yielding
+            std::this_thread::sleep_for(crash_drain_poll);
+        }
+    }
+
+    // only write out what is already buffered, another thread may hold the lock so never block on it
+    std::unique_lock lock(mutex_, std::try_to_lock);
+    if (lock.owns_lock())
+    {
+        outputter_->sync();
+    }
+}
+
+void Logger::write(
+    LogLevel level,
+    std::string_view tag,
+    std::string_view filename,
+    int line,
+    std::string_view message)
+{
+    if (async_)
+    {
+        enqueue(level, tag, filename, line, message);
+    }
+    else
+    {
+        auto &buffer = line_buffer();
+
+        OutputLock lock(mutex_);
+        formatter_->format(buffer, level, tag, message, filename, line);
+        outputter_->output(buffer);
+        outputter_->flush();
+    }
+}
+
+void Logger::enqueue(
+    LogLevel level,
+    std::string_view tag,
+    std::string_view filename,
+    int line,
+    std::string_view message)
+{
+    // write straight in to the queue slot, reusing the capacity of the strings it held last time round so a warmed up
+    // queue doesn't allocate
+    const auto write = [&](LogRecord &record)
+    {
+        record.level = level;
+        record.tag.assign(tag);
+        record.filename.assign(filename);
+        record.line = line;
+        record.message.assign(message);
+    };
+
+    while (!async_->queue.try_push_with(write))
+    {
+        if (async_->policy == LogOverflowPolicy::DROP)
+        {
+            async_->dropped.fetch_add(1u, std::memory_order_relaxed);
+            async_->wake_writer();
+            return;
+        }
+
+        std::this_thread::yield();
+    }
+
+    async_->enqueued.fetch_add(1u, std::memory_order_seq_cst);
+    async_->wake_writer();
+}
+
+void Logger::write_async()
+{
+    std::uint64_t reported_dropped = 0u;
+    std::string buffer{};
+    auto flush_deadline = std::chrono::steady_clock::time_point::max();
+
+    is_async_writer = true;
+
+    // there is work if messages have been pushed but not written, drops need reporting or we need to stop
+    const auto has_work = [this, &reported_dropped]
+    {
+        return !async_->running.load(std::memory_order_acquire) ||
+               (async_->enqueued.load(std::memory_order_seq_cst) != async_->written.load(std::memory_order_relaxed)) ||
+               (async_->dropped.load(std::memory_order_relaxed) != reported_dropped);
+    };
+
+    for (;;)
+    {
+        // check this before draining so any message pushed before we were stopped is written
+        const auto running = async_->running.load(std::memory_order_acquire);
+
+        std::size_t count = 0u;
+
+        {
+            OutputLock lock(mutex_);
+
+            // format straight from the queue slot, so it keeps its storage for the next push
+            const auto output = [this, &buffer](const LogRecord &record)
+            {
+                buffer.clear();
+                formatter_->format(buffer, record.level, record.tag, record.message, record.filename, record.line);
+                outputter_->output(buffer);
+            };
+
+            while ((count < batch_size) && async_->queue.try_pop_with(output))
+            {
+                ++count;
+            }
+
+            auto flush = count != 0u;
+
+            // report any dropped messages in the log itself, so gaps are obvious
+            if (const auto dropped = async_->dropped.load(std::memory_order_relaxed); dropped != reported_dropped)
+            {
+                auto &message = format_buffer();
+                format_to(message, "{} messages dropped", dropped - reported_dropped);
+
+                buffer.clear();
+                formatter_->format(buffer, LogLevel::WARN, "log", message, __FILE__, __LINE__);
+                outputter_->output(buffer);
+                reported_dropped = dropped;
+                flush = true;
+            }
+
+            // only flush after writing, or when output the outputter deferred is due
+            if (flush || (std::chrono::steady_clock::now() >= flush_deadline))
+            {
+                outputter_->flush();
+            }
+
+            flush_deadline = outputter_->flush_deadline();
+        }
+
+        async_->written.fetch_add(count, std::memory_order_release);
+
+        if (count == 0u)
+        {
+            if (!running)
+            {
+                break;
+            }
+
+            // block until there is work or deferred output is due
+            std::unique_lock lock(async_->wake_mutex);
+            async_->sleeping.store(true, std::memory_order_seq_cst);
+
+            if (flush_deadline == std::chrono::steady_clock::time_point::max())
+            {
+                async_->wake.wait(lock, has_work);
+            }
+            else
+            {
+                async_->wake.wait_until(lock, flush_deadline, has_work);
+            }
+
+            async_->sleeping.store(false, std::memory_order_relaxed);
+        }
+    }
+}
+
+}
@@ -0,0 +1,561 @@
+////////////////////////////////////////////////////////////////////////////////
+//         Distributed under the Boost Software License, Version 1.0.         //
+//            (See accompanying file LICENSE or copy at                       //
+//                 https://www.boost.org/LICENSE_1_0.txt)                     //
+////////////////////////////////////////////////////////////////////////////////
+
+#include "log/rotating_file_outputter.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <memory>
+#include <string>
+#include <system_error>
+#include <vector>
+
+#if !defined(IRIS_PLATFORM_WIN32)
+#include <cerrno>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include "core/error_handling.h"
+#include "core/exception.h"
+
+namespace
+{
+
+/**
+ * Interface for the different ways of getting bytes into a file.
+ */
+class FileSink
+{
+  public:
+    virtual ~FileSink() = default;
+
+    /**
+     * Append bytes to the file.
+     *
+     * @param data
+     *   Pointer to bytes.
+     *
+     * @param size
+     *   Number of bytes.
+     */
+    virtual void write(const char *data, std::size_t size) = 0;
+
+    /**
+     * Push all buffered bytes to the OS.
+     */
+    virtual void flush() = 0;
+
+    /**
+     * Get the size of the file when it was opened.
+     *
+     * @returns
+     *   Size in bytes.
+     */
+    virtual std::uint64_t initial_size() const = 0;
+};
+
+/**
+ * Sink which collects bytes in a user space buffer and writes it in one call when full. The FILE is unbuffered so
+ * each of our writes maps to a single system call.
+ */
+class BufferedSink : public FileSink
+{
+  public:
+    BufferedSink(const std::filesystem::path &path, std::size_t buffer_size)
+        : file_(nullptr, &std::fclose)
+        , buffer_(buffer_size)
+        , used_(0u)
+        , initial_size_(0u)
+    {
+        std::error_code error{};
+        const auto size = std::filesystem::file_size(path, error);
+        initial_size_ = error ? 0u : size;
+
+        file_.reset(std::fopen(path.string().c_str(), "ab"));
+        iris::ensure(file_ != nullptr, "failed to open log file");
+        std::setvbuf(file_.get(), nullptr, _IONBF, 0);
+    }
+
+    ~BufferedSink() override
+    {
+        flush();
+    }
+
+    void write(const char *data, std::size_t size) override
+    {
+        if (used_ + size > buffer_.size())
+        {
+            flush();
+
+            // too big to buffer, so don't bother copying it
+            if (size >= buffer_.size())
+            {
+                std::fwrite(data, 1u, size, file_.get());
+                return;
+            }
+        }
+
+        std::memcpy(buffer_.data() + used_, data, size);
+        used_ += size;
+    }
+
+    void flush() override
+    {
+        if (used_ != 0u)
+        {
+            std::fwrite(buffer_.data(), 1u, used_, file_.get());
+            used_ = 0u;
+        }
+    }
+
+    std::uint64_t initial_size() const override
+    {
+        return initial_size_;
+    }
+
+  private:
+    /** File to write to. */
+    std::unique_ptr<std::FILE, decltype(&std::fclose)> file_;
+
+    /** Write buffer. */
+    std::vector<char> buffer_;
+
+    /** Number of bytes used in buffer. */
+    std::size_t used_;
+
+    /** Size of file when opened. */
+    std::uint64_t initial_size_;
+};
+
+#if !defined(IRIS_PLATFORM_WIN32)
+
+/**
+ * Helper function to write all bytes at an offset, retrying on partial writes and signals.
+ *
+ * @param fd
+ *   File to write to.
+ *
+ * @param data
+ *   Bytes to write.
+ *
+ * @param size
+ *   Number of bytes.
+ *
+ * @param offset
+ *   Offset in file to write at.
+ */
+void pwrite_all(int fd, const char *data, std::size_t size, ::off_t offset)
+{
+    while (size != 0u)
+    {
+        const auto written = ::pwrite(fd, data, size, offset);
+        if (written < 0)
+        {
+            // nowhere sensible to report a failure to write the log, so drop it
+            if (errno == EINTR)
+            {
+                continue;
+            }
+
+            return;
+        }
+
+        data += written;
+        size -= static_cast<std::size_t>(written);
+        offset += written;
+    }
+}
+
+/**
+ * Sink which bypasses the page cache. Unbuffered IO requires the buffer, size and file offset of every write to be
+ * block aligned, so we only ever write whole blocks. On flush the partial tail block is written padded and the file
+ * is then truncated back to its real size, the tail is kept in the buffer and rewritten once it has been filled.
+ */
+class DirectSink : public FileSink
+{
+  public:
+    DirectSink(const std::filesystem::path &path, std::size_t buffer_size)
+        : buffer_(nullptr, &std::free)
+        , capacity_(((std::max(buffer_size, block_size) + block_size - 1u) / block_size) * block_size)
+        , used_(0u)
+        , base_offset_(0u)
+        , initial_size_(0u)
+        , fd_(-1)
+    {
+        buffer_.reset(static_cast<char *>(std::aligned_alloc(block_size, capacity_)));
+        iris::ensure(buffer_ != nullptr, "failed to allocate log buffer");
+
+        const auto filename = path.string();
+#if defined(IRIS_PLATFORM_LINUX)
+        fd_ = ::open(filename.c_str(), O_RDWR | O_CREAT | O_CLOEXEC | O_DIRECT, 0644);
+
+        // some filesystems (e.g. tmpfs) don't support O_DIRECT, in which case we still get aligned block writes
+        if ((fd_ == -1) && (errno == EINVAL))
+        {
+            fd_ = ::open(filename.c_str(), O_RDWR | O_CREAT | O_CLOEXEC, 0644);
+        }
+#else
+        fd_ = ::open(filename.c_str(), O_RDWR | O_CREAT | O_CLOEXEC, 0644);
+        if (fd_ != -1)
+        {
+            ::fcntl(fd_, F_NOCACHE, 1);
+        }
+#endif
+        iris::ensure(fd_ != -1, "failed to open log file");
+
+        struct stat info = {};
+        ::fstat(fd_, &info);
+        initial_size_ = static_cast<std::uint64_t>(info.st_size);
+
+        // read back any partial block at the end of the file so we can keep appending to it
+        base_offset_ = initial_size_ & ~static_cast<std::uint64_t>(block_size - 1u);
+        used_ = static_cast<std::size_t>(initial_size_ - base_offset_);
+        if (used_ != 0u)
+        {
+            iris::ensure(
+                ::pread(fd_, buffer_.get(), block_size, static_cast<::off_t>(base_offset_)) ==
+                    static_cast<::ssize_t>(used_),
+                "failed to read log file");
+        }
+    }
+
+    ~DirectSink() override
+    {
+        flush();
+        ::close(fd_);
+    }
+
+    void write(const char *data, std::size_t size) override
+    {
+        while (size != 0u)
+        {
+            const auto count = std::min(size, capacity_ - used_);
+            std::memcpy(buffer_.get() + used_, data, count);
+            used_ += count;
+            data += count;
+            size -= count;
+
+            if (used_ == capacity_)
+            {
+                write_blocks();
+            }
+        }
+    }
+
+    void flush() override
+    {
+        write_blocks();
+
+        if (used_ != 0u)
+        {
+            std::memset(buffer_.get() + used_, 0, block_size - used_);
+            pwrite_all(fd_, buffer_.get(), block_size, static_cast<::off_t>(base_offset_));
+            ::ftruncate(fd_, static_cast<::off_t>(base_offset_ + used_));
+        }
+    }
+
+    std::uint64_t initial_size() const override
+    {
+        return initial_size_;
+    }
+
+  private:
+    /**
+     * Write all complete blocks and move any remainder to the front of the buffer.
+     */
+    void write_blocks()
+    {
+        const auto full = used_ & ~(block_size - 1u);
+        if (full == 0u)
+        {
+            return;
+        }
+
+        pwrite_all(fd_, buffer_.get(), full, static_cast<::off_t>(base_offset_));
+        base_offset_ += full;
+        used_ -= full;
+        std::memmove(buffer_.get(), buffer_.get() + full, used_);
+    }
+
+    /** Alignment required for unbuffered IO. */
+    static constexpr std::size_t block_size = 4096u;
+
+    /** Block aligned write buffer. */
+    std::unique_ptr<char, decltype(&std::free)> buffer_;
+
+    /** Size of buffer, multiple of block_size. */
+    std::size_t capacity_;
+
+    /** Number of bytes used in buffer. */
+    std::size_t used_;
+
+    /** File offset of the start of the buffer. */
+    std::uint64_t base_offset_;
+
+    /** Size of file when opened. */
+    std::uint64_t initial_size_;
+
+    /** File descriptor. */
+    int fd_;
+};
+
+/**
+ * Sink which copies bytes straight into a shared mapping of the file. The file is extended a window at a time, so
+ * until it is closed it will have zero padding at the end.
+ */
+class MappedSink : public FileSink
+{
+  public:
+    MappedSink(const std::filesystem::path &path, std::size_t window_size)
+        : page_size_(static_cast<std::size_t>(::sysconf(_SC_PAGESIZE)))
+        , window_size_(0u)
+        , map_(nullptr)
+        , offset_(0u)
+        , position_(0u)
+        , initial_size_(0u)
+        , fd_(-1)
+    {
+        window_size_ = ((std::max(window_size, page_size_) + page_size_ - 1u) / page_size_) * page_size_;
+
+        fd_ = ::open(path.string().c_str(), O_RDWR | O_CREAT | O_CLOEXEC, 0644);
+        iris::ensure(fd_ != -1, "failed to open log file");
+
+        struct stat info = {};
+        ::fstat(fd_, &info);
+        initial_size_ = static_cast<std::uint64_t>(info.st_size);
+
+        map_window(initial_size_);
+    }
+
+    ~MappedSink() override
+    {
+        ::munmap(map_, window_size_);
+        ::ftruncate(fd_, static_cast<::off_t>(offset_ + position_));
+        ::close(fd_);
+    }
+
+    void write(const char *data, std::size_t size) override
+    {
+        while (size != 0u)
+        {
+            const auto count = std::min(size, window_size_ - position_);
+            std::memcpy(map_ + position_, data, count);
+            position_ += count;
+            data += count;
+            size -= count;
+
+            if (position_ == window_size_)
+            {
+                ::munmap(map_, window_size_);
+                map_window(offset_ + window_size_);
+            }
+        }
+    }
+
+    void flush() override
+    {
+        ::msync(map_, position_, MS_ASYNC);
+    }
+
+    std::uint64_t initial_size() const override
+    {
+        return initial_size_;
+    }
+
+  private:
+    /**
+     * Extend the file and map the window containing the supplied offset.
+     *
+     * @param offset
+     *   File offset to continue writing from.
+     */
+    void map_window(std::uint64_t offset)
+    {
+        offset_ = offset & ~static_cast<std::uint64_t>(page_size_ - 1u);
+        position_ = static_cast<std::size_t>(offset - offset_);
+
+        iris::ensure(::ftruncate(fd_, static_cast<::off_t>(offset_ + window_size_)) == 0, "failed to extend log file");
+
+        auto *map =
+            ::mmap(nullptr, window_size_, PROT_READ | PROT_WRITE, MAP_SHARED, fd_, static_cast<::off_t>(offset_));
+        iris::ensure(map != MAP_FAILED, "failed to map log file");
+
+        map_ = static_cast<char *>(map);
+    }
+
+    /** Size of a page. */
+    std::size_t page_size_;
+
+    /** Size of mapped window, multiple of page_size_. */
+    std::size_t window_size_;
+
+    /** Mapped window. */
+    char *map_;
+
+    /** File offset of mapped window. */
+    std::uint64_t offset_;
+
+    /** Write position in mapped window. */
+    std::size_t position_;
+
+    /** Size of file when opened. */
+    std::uint64_t initial_size_;
+
+    /** File descriptor. */
+    int fd_;
+};
+
+#endif
+
+/**
+ * Helper function to get the path of a rotated file i.e. "dir/name.ext" -> "dir/name.index.ext".
+ *
+ * @param path
+ *   Path of log file.
+ *
+ * @param index
+ *   Rotation index.
+ *
+ * @returns
+ *   Rotated path.
+ */
+std::filesystem::path rotated_path(const std::filesystem::path &path, std::uint32_t index)
+{
+    auto filename = path.stem();
+    filename += "." + std::to_string(index);
+    filename += path.extension();
+
+    return path.parent_path() / filename;
+}
+
+}
+
+namespace iris
+{
+
+struct RotatingFileOutputter::implementation
+{
+    std::unique_ptr<FileSink> sink;
+};
+
+RotatingFileOutputter::RotatingFileOutputter(const std::filesystem::path &path, const RotatingFileOptions &options)
+    : path_(path)
+    , options_(options)
+    , file_size_(0u)
+    , opened_()
+    , last_flush_()
+    , pending_(false)
+    , impl_(std::make_unique<implementation>())
+{
+    ensure(options_.buffer_size != 0u, "buffer size must be non-zero");
+
+#if defined(IRIS_PLATFORM_WIN32)
+    ensure(options_.mode == FileWriteMode::BUFFERED, "only buffered log files are supported on this platform");
+#endif
+
+    open();
+}
+
+RotatingFileOutputter::~RotatingFileOutputter() = default;
+
+void RotatingFileOutputter::output(const std::string &log)
+{
+    const auto size = static_cast<std::uint64_t>(log.size()) + 1u;
+
+    // never rotate an empty file, otherwise a single oversized line would rotate forever
+    if (file_size_ != 0u)
+    {
+        const auto too_big = (options_.max_file_size != 0u) && (file_size_ + size > options_.max_file_size);
+        const auto too_old = (options_.rotation_interval.count() != 0) &&
+                             (std::chrono::steady_clock::now() - opened_ >= options_.rotation_interval);
+
+        if (too_big || too_old)
+        {
+            rotate();
+        }
+    }
+
+    impl_->sink->write(log.data(), log.size());
+    impl_->sink->write("\n", 1u);
+    file_size_ += size;
+    pending_ = true;
+}
+
+void RotatingFileOutputter::flush()
+{
+    if (std::chrono::steady_clock::now() - last_flush_ >= options_.flush_interval)
+    {
+        sync();
+    }
+}
+
+std::chrono::steady_clock::time_point RotatingFileOutputter::flush_deadline() const
+{
+    return pending_ ? last_flush_ + options_.flush_interval : std::chrono::steady_clock::time_point::max();
+}
+
+void RotatingFileOutputter::sync()
+{
+    impl_->sink->flush();
+    last_flush_ = std::chrono::steady_clock::now();
+    pending_ = false;
+}
+
+void RotatingFileOutputter::rotate()
+{
+    // close the current file before shuffling names
+    impl_->sink.reset();
+
+    std::error_code error{};
+
+    if (options_.retention == 0u)
+    {
+        std::filesystem::remove(path_, error);
+    }
+    else
+    {
+        std::filesystem::remove(rotated_path(path_, options_.retention), error);
+
+        for (auto index = options_.retention - 1u; index != 0u; --index)
+        {
+            std::filesystem::rename(rotated_path(path_, index), rotated_path(path_, index + 1u), error);
+        }
+
+        std::filesystem::rename(path_, rotated_path(path_, 1u), error);
+    }
+
+    open();
+}
+
+void RotatingFileOutputter::open()
+{
+    switch (options_.mode)
+    {
+#if !defined(IRIS_PLATFORM_WIN32)
+        case FileWriteMode::DIRECT:
+            impl_->sink = std::make_unique<DirectSink>(path_, options_.buffer_size);
+            break;
+        case FileWriteMode::MAPPED:
+            impl_->sink = std::make_unique<MappedSink>(path_, options_.buffer_size);
+            break;
+#endif
+        default: impl_->sink = std::make_unique<BufferedSink>(path_, options_.buffer_size); break;
+    }
+
+    file_size_ = impl_->sink->initial_size();
+    opened_ = std::chrono::steady_clock::now();
+    last_flush_ = opened_;
+}
+
+}
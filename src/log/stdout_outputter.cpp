@@ -14,7 +14,12 @@ namespace iris
 
 void StdoutFormatter::output(const std::string &log)
 {
-    std::cout << log << std::endl;
+    std::cout << log << '\n';
+}
+
+void StdoutFormatter::flush()
+{
+    std::cout.flush();
 }
 
 }
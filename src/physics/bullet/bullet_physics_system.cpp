@@ -22,7 +22,10 @@
 #include <btBulletDynamicsCommon.h>
 
 #include "core/error_handling.h"
+#include "core/profile_scope.h"
 #include "core/quaternion.h"
+#include "core/scoped_timer.h"
+#include "core/telemetry.h"
 #include "core/vector3.h"
 #include "graphics/mesh_manager.h"
 #include "log/log.h"
@@ -150,6 +153,11 @@ BulletPhysicsSystem::~BulletPhysicsSystem()
 
 void BulletPhysicsSystem::step(std::chrono::milliseconds time_step)
 {
+    IRIS_PROFILE_SCOPE("BulletPhysicsSystem::step");
+
+    static auto &step_histogram = Telemetry::instance().histogram("physics.step");
+    ScopedTimer timer{step_histogram};
+
     for (auto &controller : character_controllers_)
     {
         controller->update(this, time_step);
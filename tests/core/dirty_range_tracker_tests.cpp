@@ -0,0 +1,77 @@
+////////////////////////////////////////////////////////////////////////////////
+//         Distributed under the Boost Software License, Version 1.0.         //
+//            (See accompanying file LICENSE or copy at                       //
+//                 https://www.boost.org/LICENSE_1_0.txt)                     //
+////////////////////////////////////////////////////////////////////////////////
+
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "core/dirty_range_tracker.h"
+
+TEST(dirty_range_tracker, empty)
+{
+    iris::DirtyRangeTracker tracker{};
+    std::vector<iris::DirtyRange> ranges{{.begin = 1u, .end = 2u}};
+
+    tracker.ranges(ranges);
+
+    ASSERT_TRUE(tracker.empty());
+    ASSERT_TRUE(ranges.empty());
+}
+
+TEST(dirty_range_tracker, single_elements)
+{
+    iris::DirtyRangeTracker tracker{};
+    tracker.mark(3u);
+    tracker.mark(4u);
+    tracker.mark(10u);
+
+    std::vector<iris::DirtyRange> ranges{};
+    tracker.ranges(ranges);
+
+    ASSERT_FALSE(tracker.empty());
+    ASSERT_EQ(ranges, (std::vector<iris::DirtyRange>{{.begin = 3u, .end = 5u}, {.begin = 10u, .end = 11u}}));
+}
+
+TEST(dirty_range_tracker, ranges_span_words)
+{
+    iris::DirtyRangeTracker tracker{};
+    tracker.mark(60u, 200u);
+    tracker.mark(256u);
+
+    std::vector<iris::DirtyRange> ranges{};
+    tracker.ranges(ranges);
+
+    ASSERT_EQ(ranges, (std::vector<iris::DirtyRange>{{.begin = 60u, .end = 200u}, {.begin = 256u, .end = 257u}}));
+}
+
+TEST(dirty_range_tracker, merge_gap)
+{
+    iris::DirtyRangeTracker tracker{2u};
+    tracker.mark(0u);
+    tracker.mark(3u);
+    tracker.mark(7u);
+
+    std::vector<iris::DirtyRange> ranges{};
+    tracker.ranges(ranges);
+
+    ASSERT_EQ(ranges, (std::vector<iris::DirtyRange>{{.begin = 0u, .end = 4u}, {.begin = 7u, .end = 8u}}));
+}
+
+TEST(dirty_range_tracker, clear)
+{
+    iris::DirtyRangeTracker tracker{};
+    tracker.mark(100u, 300u);
+    tracker.clear();
+
+    ASSERT_TRUE(tracker.empty());
+
+    tracker.mark(5u);
+
+    std::vector<iris::DirtyRange> ranges{};
+    tracker.ranges(ranges);
+
+    ASSERT_EQ(ranges, (std::vector<iris::DirtyRange>{{.begin = 5u, .end = 6u}}));
+}
@@ -0,0 +1,78 @@
+////////////////////////////////////////////////////////////////////////////////
+//         Distributed under the Boost Software License, Version 1.0.         //
+//            (See accompanying file LICENSE or copy at                       //
+//                 https://www.boost.org/LICENSE_1_0.txt)                     //
+////////////////////////////////////////////////////////////////////////////////
+
+#include <gtest/gtest.h>
+
+#include "core/aabb.h"
+#include "core/bounding_sphere.h"
+#include "core/camera.h"
+#include "core/camera_type.h"
+#include "core/frustum.h"
+#include "core/matrix4.h"
+#include "core/vector3.h"
+
+TEST(frustum, planes_are_normalised)
+{
+    const iris::Camera camera{iris::CameraType::PERSPECTIVE, 800u, 600u};
+
+    for (const auto &plane : camera.frustum().planes())
+    {
+        ASSERT_NEAR(plane.normal.magnitude(), 1.0f, 0.0001f);
+    }
+}
+
+TEST(frustum, perspective_sphere)
+{
+    // default camera is at (0, 0, 100) looking down -z
+    const auto frustum = iris::Camera{iris::CameraType::PERSPECTIVE, 800u, 800u}.frustum();
+
+    ASSERT_TRUE(frustum.intersects(iris::BoundingSphere{{}, 1.0f}));
+    ASSERT_FALSE(frustum.intersects(iris::BoundingSphere{{0.0f, 0.0f, 200.0f}, 1.0f}));
+    ASSERT_FALSE(frustum.intersects(iris::BoundingSphere{{500.0f, 0.0f, 0.0f}, 1.0f}));
+    ASSERT_FALSE(frustum.intersects(iris::BoundingSphere{{0.0f, 0.0f, -2000.0f}, 1.0f}));
+
+    // straddling the right plane
+    ASSERT_TRUE(frustum.intersects(iris::BoundingSphere{{45.0f, 0.0f, 0.0f}, 10.0f}));
+}
+
+TEST(frustum, perspective_aabb)
+{
+    const auto frustum = iris::Camera{iris::CameraType::PERSPECTIVE, 800u, 800u}.frustum();
+
+    ASSERT_TRUE(frustum.intersects(iris::AABB{{-1.0f}, {1.0f}}));
+    ASSERT_FALSE(frustum.intersects(iris::AABB{{-1.0f, -1.0f, 199.0f}, {1.0f, 1.0f, 201.0f}}));
+    ASSERT_TRUE(frustum.intersects(iris::AABB{{-1000.0f, -1.0f, -1.0f}, {1000.0f, 1.0f, 1.0f}}));
+}
+
+TEST(frustum, orthographic_sphere)
+{
+    auto camera = iris::Camera{iris::CameraType::ORTHOGRAPHIC, 800u, 800u};
+    camera.set_position({});
+    const auto frustum = camera.frustum();
+
+    ASSERT_TRUE(frustum.intersects(iris::BoundingSphere{{790.0f, 790.0f, -10.0f}, 1.0f}));
+    ASSERT_FALSE(frustum.intersects(iris::BoundingSphere{{810.0f, 0.0f, -10.0f}, 1.0f}));
+}
+
+TEST(aabb, transformed)
+{
+    const iris::AABB aabb{{-1.0f}, {1.0f}};
+
+    const auto moved = aabb.transformed(
+        iris::Matrix4::make_translate({10.0f, 0.0f, 0.0f}) * iris::Matrix4::make_scale({2.0f, 1.0f, 1.0f}));
+
+    ASSERT_EQ(moved.min, iris::Vector3(8.0f, -1.0f, -1.0f));
+    ASSERT_EQ(moved.max, iris::Vector3(12.0f, 1.0f, 1.0f));
+}
+
+TEST(bounding_sphere, merge)
+{
+    iris::BoundingSphere sphere{{-1.0f, 0.0f, 0.0f}, 1.0f};
+    sphere.merge({{1.0f, 0.0f, 0.0f}, 1.0f});
+
+    ASSERT_EQ(sphere.centre, iris::Vector3{});
+    ASSERT_FLOAT_EQ(sphere.radius, 2.0f);
+}
@@ -0,0 +1,85 @@
+////////////////////////////////////////////////////////////////////////////////
+//         Distributed under the Boost Software License, Version 1.0.         //
+//            (See accompanying file LICENSE or copy at                       //
+//                 https://www.boost.org/LICENSE_1_0.txt)                     //
+////////////////////////////////////////////////////////////////////////////////
+
+#include <chrono>
+
+#include <gtest/gtest.h>
+
+#include "core/latency_tracker.h"
+#include "core/telemetry.h"
+
+using namespace std::chrono_literals;
+
+namespace
+{
+
+/**
+ * Fixture which resets the tracker and its telemetry.
+ */
+class LatencyTrackerFixture : public ::testing::Test
+{
+  protected:
+    void SetUp() override
+    {
+        auto &telemetry = iris::Telemetry::instance();
+        telemetry.histogram("latency.input_to_present").reset();
+        telemetry.counter("latency.presented_inputs").reset();
+        telemetry.counter("latency.input_frame_lag").reset();
+
+        iris::LatencyTracker::instance().set_enabled(true);
+    }
+
+    void TearDown() override
+    {
+        iris::LatencyTracker::instance().set_enabled(false);
+    }
+};
+
+}
+
+TEST_F(LatencyTrackerFixture, disabled_records_nothing)
+{
+    auto &tracker = iris::LatencyTracker::instance();
+    tracker.set_enabled(false);
+
+    tracker.record_input(tracker.begin_frame(), std::chrono::steady_clock::now());
+    tracker.record_present();
+
+    ASSERT_EQ(iris::Telemetry::instance().histogram("latency.input_to_present").count(), 0u);
+}
+
+TEST_F(LatencyTrackerFixture, oldest_input_per_frame)
+{
+    auto &tracker = iris::LatencyTracker::instance();
+    const auto now = std::chrono::steady_clock::now();
+    const auto frame = tracker.begin_frame();
+
+    tracker.record_input(frame, now - 5ms);
+    tracker.record_input(frame, now - 1ms);
+    tracker.record_present();
+
+    auto &histogram = iris::Telemetry::instance().histogram("latency.input_to_present");
+    ASSERT_EQ(histogram.count(), 1u);
+    ASSERT_GE(histogram.summary().min, 5000u * 31u / 32u);
+
+    // nothing new to present
+    tracker.record_present();
+    ASSERT_EQ(histogram.count(), 1u);
+}
+
+TEST_F(LatencyTrackerFixture, frame_lag)
+{
+    auto &tracker = iris::LatencyTracker::instance();
+
+    tracker.record_input(tracker.begin_frame(), std::chrono::steady_clock::now());
+    tracker.begin_frame();
+    tracker.begin_frame();
+    tracker.record_present();
+
+    auto &telemetry = iris::Telemetry::instance();
+    ASSERT_EQ(telemetry.counter("latency.presented_inputs").value(), 1u);
+    ASSERT_EQ(telemetry.counter("latency.input_frame_lag").value(), 2u);
+}
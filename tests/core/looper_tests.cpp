@@ -0,0 +1,133 @@
+////////////////////////////////////////////////////////////////////////////////
+//         Distributed under the Boost Software License, Version 1.0.         //
+//            (See accompanying file LICENSE or copy at                       //
+//                 https://www.boost.org/LICENSE_1_0.txt)                     //
+////////////////////////////////////////////////////////////////////////////////
+
+#include <chrono>
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "core/looper.h"
+
+using namespace std::chrono_literals;
+
+TEST(looper, alpha_in_range)
+{
+    std::vector<float> alphas{};
+
+    iris::Looper looper{
+        0us,
+        1ms,
+        [](auto, auto) { return true; },
+        [&alphas](auto, auto, float alpha)
+        {
+            alphas.emplace_back(alpha);
+            std::this_thread::sleep_for(300us);
+            return alphas.size() < 20u;
+        }};
+
+    looper.run();
+
+    ASSERT_EQ(alphas.size(), 20u);
+    for (const auto alpha : alphas)
+    {
+        ASSERT_GE(alpha, 0.0f);
+        ASSERT_LT(alpha, 1.0f);
+    }
+}
+
+TEST(looper, catch_up_limited)
+{
+    std::vector<std::uint32_t> steps_per_frame{0u};
+
+    iris::Looper looper{
+        0us,
+        1ms,
+        [&steps_per_frame](auto, auto)
+        {
+            ++steps_per_frame.back();
+            return true;
+        },
+        [&steps_per_frame](auto, auto, float)
+        {
+            // one slow frame, which would require ~50 fixed steps to catch up
+            if (steps_per_frame.size() == 1u)
+            {
+                std::this_thread::sleep_for(50ms);
+            }
+
+            steps_per_frame.emplace_back(0u);
+            return steps_per_frame.size() < 5u;
+        }};
+    looper.set_max_fixed_steps(3u);
+
+    looper.run();
+
+    for (const auto steps : steps_per_frame)
+    {
+        ASSERT_LE(steps, 3u);
+    }
+}
+
+TEST(looper, frame_limit)
+{
+    auto frames = 0u;
+
+    iris::Looper looper{0us, 1ms, [](auto, auto) { return true; }, [&frames](auto, auto) { return ++frames < 10u; }};
+    looper.set_frame_limit(5ms);
+
+    const auto start = std::chrono::steady_clock::now();
+    looper.run();
+    const auto duration = std::chrono::steady_clock::now() - start;
+
+    // the final frame exits before limiting
+    ASSERT_GE(duration, 45ms);
+}
+
+TEST(looper, frame_limit_spin)
+{
+    auto frames = 0u;
+
+    iris::Looper looper{0us, 1ms, [](auto, auto) { return true; }, [&frames](auto, auto) { return ++frames < 10u; }};
+    looper.set_frame_limit(5ms);
+    looper.set_frame_limit_spin(2ms);
+
+    const auto start = std::chrono::steady_clock::now();
+    looper.run();
+    const auto duration = std::chrono::steady_clock::now() - start;
+
+    ASSERT_GE(duration, 45ms);
+}
+
+TEST(looper, catch_up_unlimited_by_default)
+{
+    std::vector<std::uint32_t> steps_per_frame{0u};
+
+    iris::Looper looper{
+        0us,
+        1ms,
+        [&steps_per_frame](auto, auto)
+        {
+            ++steps_per_frame.back();
+            return true;
+        },
+        [&steps_per_frame](auto, auto, float)
+        {
+            if (steps_per_frame.size() == 1u)
+            {
+                std::this_thread::sleep_for(50ms);
+            }
+
+            steps_per_frame.emplace_back(0u);
+            return steps_per_frame.size() < 3u;
+        }};
+
+    looper.run();
+
+    // all of the slow frame is simulated in the following frame
+    ASSERT_GE(steps_per_frame[1], 50u);
+}
@@ -0,0 +1,145 @@
+////////////////////////////////////////////////////////////////////////////////
+//         Distributed under the Boost Software License, Version 1.0.         //
+//            (See accompanying file LICENSE or copy at                       //
+//                 https://www.boost.org/LICENSE_1_0.txt)                     //
+////////////////////////////////////////////////////////////////////////////////
+
+#include <cstdint>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "core/mpsc_queue.h"
+
+TEST(mpsc_queue, capacity_rounded_to_power_of_two)
+{
+    iris::MpscQueue<int> queue1{1u};
+    iris::MpscQueue<int> queue5{5u};
+
+    ASSERT_EQ(queue1.capacity(), 2u);
+    ASSERT_EQ(queue5.capacity(), 8u);
+}
+
+TEST(mpsc_queue, empty_pop)
+{
+    iris::MpscQueue<int> queue{4u};
+    int value = 0;
+
+    ASSERT_FALSE(queue.try_pop(value));
+}
+
+TEST(mpsc_queue, fifo)
+{
+    iris::MpscQueue<std::string> queue{4u};
+
+    ASSERT_TRUE(queue.try_push("a"));
+    ASSERT_TRUE(queue.try_push("b"));
+    ASSERT_TRUE(queue.try_push("c"));
+
+    std::string value{};
+    ASSERT_TRUE(queue.try_pop(value));
+    ASSERT_EQ(value, "a");
+    ASSERT_TRUE(queue.try_pop(value));
+    ASSERT_EQ(value, "b");
+    ASSERT_TRUE(queue.try_pop(value));
+    ASSERT_EQ(value, "c");
+    ASSERT_FALSE(queue.try_pop(value));
+}
+
+TEST(mpsc_queue, full)
+{
+    iris::MpscQueue<int> queue{2u};
+
+    ASSERT_TRUE(queue.try_push(1));
+    ASSERT_TRUE(queue.try_push(2));
+    ASSERT_FALSE(queue.try_push(3));
+
+    int value = 0;
+    ASSERT_TRUE(queue.try_pop(value));
+    ASSERT_TRUE(queue.try_push(3));
+}
+
+TEST(mpsc_queue, multiple_producers)
+{
+    static constexpr auto producers = 4u;
+    static constexpr auto per_producer = 10000u;
+
+    iris::MpscQueue<std::uint32_t> queue{1024u};
+    std::vector<std::thread> threads{};
+
+    for (auto i = 0u; i < producers; ++i)
+    {
+        threads.emplace_back(
+            [&queue, i]
+            {
+                for (auto j = 0u; j < per_producer; ++j)
+                {
+                    while (!queue.try_push(i * per_producer + j))
+                    {
+                        std::this_thread::yield();
+                    }
+                }
+            });
+    }
+
+    // values from each producer should arrive in the order they were pushed
+    std::vector<std::uint32_t> next(producers, 0u);
+    auto count = 0u;
+
+    while (count < producers * per_producer)
+    {
+        std::uint32_t value = 0u;
+        if (queue.try_pop(value))
+        {
+            const auto producer = value / per_producer;
+            ASSERT_EQ(value % per_producer, next[producer]);
+            ++next[producer];
+            ++count;
+        }
+    }
+
+    for (auto &thread : threads)
+    {
+        thread.join();
+    }
+}
+
+TEST(mpsc_queue, in_place_reuses_storage)
+{
+    iris::MpscQueue<std::string> queue{2u};
+    std::string value{};
+
+    // fill every slot once so each has some capacity
+    for (auto i = 0u; i < queue.capacity(); ++i)
+    {
+        ASSERT_TRUE(queue.try_push_with([](std::string &slot) { slot.assign(64u, 'x'); }));
+        ASSERT_TRUE(queue.try_pop_with([&value](const std::string &slot) { value = slot; }));
+    }
+
+    const char *data = nullptr;
+    ASSERT_TRUE(queue.try_push_with(
+        [&data](std::string &slot)
+        {
+            slot.assign("short");
+            data = slot.data();
+        }));
+    ASSERT_TRUE(queue.try_pop_with([&value](const std::string &slot) { value = slot; }));
+
+    // the next lap writes in to the same storage
+    for (auto i = 1u; i < queue.capacity(); ++i)
+    {
+        ASSERT_TRUE(queue.try_push_with([](std::string &slot) { slot.assign("pad"); }));
+        ASSERT_TRUE(queue.try_pop_with([](const std::string &) {}));
+    }
+
+    ASSERT_TRUE(queue.try_push_with(
+        [data](std::string &slot)
+        {
+            slot.assign("again");
+            ASSERT_EQ(slot.data(), data);
+        }));
+
+    ASSERT_EQ(value, "short");
+}
@@ -0,0 +1,104 @@
+////////////////////////////////////////////////////////////////////////////////
+//         Distributed under the Boost Software License, Version 1.0.         //
+//            (See accompanying file LICENSE or copy at                       //
+//                 https://www.boost.org/LICENSE_1_0.txt)                     //
+////////////////////////////////////////////////////////////////////////////////
+
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <string>
+
+#include <gtest/gtest.h>
+
+#include "core/profiler_analyser.h"
+#include "core/profiler_output_format.h"
+
+namespace
+{
+
+iris::ProfilerAnalyser create_analyser()
+{
+    iris::ProfilerAnalyser pa{};
+
+    // stack traces are innermost frame first, as returned by backtrace
+    pa.add_stack_trace(1u, {"leaf", "middle", "main"});
+    pa.add_stack_trace(1u, {"leaf", "middle", "main"});
+    pa.add_stack_trace(1u, {"other", "main"});
+    pa.add_stack_trace(2u, {"work;er", "thread_start"});
+    pa.add_stack_trace(2u, {});
+
+    return pa;
+}
+
+}
+
+TEST(profiler_analyser, sample_count)
+{
+    const auto pa = create_analyser();
+
+    ASSERT_EQ(pa.sample_count(), 4u);
+}
+
+TEST(profiler_analyser, collapsed)
+{
+    const auto pa = create_analyser();
+    std::stringstream strm{};
+
+    pa.write_collapsed(strm);
+
+    ASSERT_EQ(
+        strm.str(),
+        "thread-1;main;middle;leaf 2\n"
+        "thread-1;main;other 1\n"
+        "thread-2;thread_start;work:er 1\n");
+}
+
+TEST(profiler_analyser, speedscope)
+{
+    const auto pa = create_analyser();
+    std::stringstream strm{};
+
+    pa.write_speedscope(strm);
+    const auto json = strm.str();
+
+    ASSERT_NE(json.find(R"("frames":[{"name":"main"},{"name":"middle"},{"name":"leaf"},{"name":"other"},)"), std::string::npos);
+    ASSERT_NE(
+        json.find(R"({"type":"sampled","name":"thread-1","unit":"none","startValue":0,"endValue":3,"samples":[[0,1,2],[0,3]],"weights":[2,1]})"),
+        std::string::npos);
+    ASSERT_NE(json.find(R"("name":"thread-2")"), std::string::npos);
+}
+
+TEST(profiler_analyser, pprof)
+{
+    const auto pa = create_analyser();
+    std::stringstream strm{};
+
+    pa.write_pprof(strm);
+    const auto proto = strm.str();
+
+    // first field should be the sample_type message
+    ASSERT_GT(proto.size(), 2u);
+    ASSERT_EQ(proto[0], static_cast<char>((1u << 3u) | 2u));
+
+    // all function names should be in the string table
+    ASSERT_NE(proto.find("thread_start"), std::string::npos);
+    ASSERT_NE(proto.find("work;er"), std::string::npos);
+    ASSERT_NE(proto.find("samples"), std::string::npos);
+}
+
+TEST(profiler_analyser, text_to_file)
+{
+    auto pa = create_analyser();
+    const auto path = std::filesystem::temp_directory_path() / "iris_profiler_analyser_text.txt";
+
+    pa.write(iris::ProfilerOutputFormat::TEXT, path);
+
+    std::ifstream file{path};
+    std::stringstream strm{};
+    strm << file.rdbuf();
+    file.close();
+    std::filesystem::remove(path);
+
+    ASSERT_NE(strm.str().find("|---middle (2 | "), std::string::npos);
+}
@@ -0,0 +1,162 @@
+////////////////////////////////////////////////////////////////////////////////
+//         Distributed under the Boost Software License, Version 1.0.         //
+//            (See accompanying file LICENSE or copy at                       //
+//                 https://www.boost.org/LICENSE_1_0.txt)                     //
+////////////////////////////////////////////////////////////////////////////////
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "core/random.h"
+#include "core/random_generator.h"
+#include "core/vector3.h"
+
+namespace
+{
+
+/**
+ * Generate a sequence on several threads, each with its own stream, and return the results by stream.
+ */
+std::vector<std::vector<std::uint32_t>> generate_on_threads(std::uint64_t seed)
+{
+    static constexpr auto thread_count = 4u;
+    static constexpr auto count = 1000u;
+
+    iris::set_random_seed(seed);
+
+    std::vector<std::vector<std::uint32_t>> results(thread_count, std::vector<std::uint32_t>(count));
+    std::vector<std::thread> threads{};
+
+    for (auto i = 0u; i < thread_count; ++i)
+    {
+        threads.emplace_back([i, &results] {
+            iris::set_thread_random_stream(i);
+            iris::random_uint32s(results[i], 0u, 1000u);
+        });
+    }
+
+    for (auto &thread : threads)
+    {
+        thread.join();
+    }
+
+    return results;
+}
+
+}
+
+TEST(random, same_seed_same_sequence)
+{
+    iris::RandomGenerator a{42u, 1u};
+    iris::RandomGenerator b{42u, 1u};
+
+    for (auto i = 0u; i < 100u; ++i)
+    {
+        ASSERT_EQ(a(), b());
+    }
+}
+
+TEST(random, streams_differ)
+{
+    iris::RandomGenerator a{42u, 0u};
+    iris::RandomGenerator b{42u, 1u};
+
+    ASSERT_NE(a(), b());
+}
+
+TEST(random, deterministic_across_threads)
+{
+    const auto first = generate_on_threads(1234u);
+    const auto second = generate_on_threads(1234u);
+
+    ASSERT_EQ(first, second);
+    ASSERT_NE(first[0], first[1]);
+
+    const auto other_seed = generate_on_threads(4321u);
+    ASSERT_NE(first, other_seed);
+}
+
+TEST(random, uint32_range)
+{
+    iris::RandomGenerator generator{1u};
+    std::array<bool, 6u> seen{};
+
+    for (auto i = 0u; i < 1000u; ++i)
+    {
+        const auto value = generator.uniform_uint32(5u, 10u);
+        ASSERT_GE(value, 5u);
+        ASSERT_LE(value, 10u);
+        seen[value - 5u] = true;
+    }
+
+    ASSERT_TRUE(std::all_of(std::cbegin(seen), std::cend(seen), [](bool s) { return s; }));
+    ASSERT_EQ(generator.uniform_uint32(7u, 7u), 7u);
+}
+
+TEST(random, uint32_full_range)
+{
+    iris::RandomGenerator generator{1u};
+
+    // just check this doesn't get stuck or divide by zero
+    generator.uniform_uint32(0u, std::numeric_limits<std::uint32_t>::max());
+}
+
+TEST(random, int32_range)
+{
+    iris::RandomGenerator generator{1u};
+
+    for (auto i = 0u; i < 1000u; ++i)
+    {
+        const auto value = generator.uniform_int32(-3, 3);
+        ASSERT_GE(value, -3);
+        ASSERT_LE(value, 3);
+    }
+
+    static constexpr auto lowest = std::numeric_limits<std::int32_t>::min();
+    for (auto i = 0u; i < 1000u; ++i)
+    {
+        ASSERT_LE(generator.uniform_int32(lowest, lowest + 1), lowest + 1);
+    }
+}
+
+TEST(random, fill_float)
+{
+    iris::RandomGenerator generator{1u};
+    std::vector<float> values(1000u);
+
+    generator.fill_float(values, -2.0f, 2.0f);
+
+    ASSERT_TRUE(
+        std::all_of(std::cbegin(values), std::cend(values), [](float v) { return (v >= -2.0f) && (v < 2.0f); }));
+}
+
+TEST(random, fill_unit_vector)
+{
+    iris::RandomGenerator generator{1u};
+    std::vector<iris::Vector3> values(1000u);
+
+    generator.fill_unit_vector(values);
+
+    for (const auto &value : values)
+    {
+        ASSERT_NEAR(value.magnitude(), 1.0f, 0.0001f);
+    }
+}
+
+TEST(random, flip_coin_bias)
+{
+    iris::RandomGenerator generator{1u};
+
+    for (auto i = 0u; i < 100u; ++i)
+    {
+        ASSERT_TRUE(generator.flip_coin(1.0f));
+        ASSERT_FALSE(generator.flip_coin(0.0f));
+    }
+}
@@ -0,0 +1,53 @@
+////////////////////////////////////////////////////////////////////////////////
+//         Distributed under the Boost Software License, Version 1.0.         //
+//            (See accompanying file LICENSE or copy at                       //
+//                 https://www.boost.org/LICENSE_1_0.txt)                     //
+////////////////////////////////////////////////////////////////////////////////
+
+#include <string>
+#include <unordered_set>
+
+#include <gtest/gtest.h>
+
+#include "core/string_id.h"
+
+using namespace iris;
+
+TEST(string_id, compile_time)
+{
+    static_assert(StringId{"hello"} == "hello"_sid);
+    static_assert(StringId{"hello"} != StringId{"world"});
+
+    // known FNV-1a values
+    static_assert(StringId{}.value() == 14695981039346656037ull);
+    static_assert(StringId{"a"}.value() == 0xaf63dc4c8601ec8cull);
+}
+
+TEST(string_id, runtime_matches_compile_time)
+{
+    const std::string str = "left_arm";
+
+    ASSERT_EQ(StringId{str}, "left_arm"_sid);
+    ASSERT_EQ(StringId::intern(str), "left_arm"_sid);
+}
+
+TEST(string_id, name)
+{
+    const auto id = StringId::intern("right_leg");
+
+#if !defined(NDEBUG) || defined(IRIS_FORCE_EXPECT)
+    ASSERT_EQ(id.name(), "right_leg");
+#else
+    ASSERT_EQ(id.name(), "");
+#endif
+
+    ASSERT_EQ(StringId{"never_interned"}.name(), "");
+}
+
+TEST(string_id, hash_key)
+{
+    std::unordered_set<StringId> ids{"a"_sid, "b"_sid};
+
+    ASSERT_TRUE(ids.contains(StringId{"a"}));
+    ASSERT_FALSE(ids.contains(StringId{"c"}));
+}
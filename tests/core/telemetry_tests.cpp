@@ -0,0 +1,217 @@
+////////////////////////////////////////////////////////////////////////////////
+//         Distributed under the Boost Software License, Version 1.0.         //
+//            (See accompanying file LICENSE or copy at                       //
+//                 https://www.boost.org/LICENSE_1_0.txt)                     //
+////////////////////////////////////////////////////////////////////////////////
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <sstream>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "core/histogram.h"
+#include "core/looper.h"
+#include "core/telemetry.h"
+
+using namespace std::chrono_literals;
+
+TEST(histogram, empty)
+{
+    iris::Histogram histogram{};
+
+    ASSERT_EQ(histogram.count(), 0u);
+    ASSERT_EQ(histogram.percentile(0.5), 0us);
+    ASSERT_EQ(histogram.summary().count, 0u);
+}
+
+TEST(histogram, single_value)
+{
+    iris::Histogram histogram{};
+    histogram.record(16'667us);
+
+    const auto summary = histogram.summary();
+    ASSERT_EQ(summary.count, 1u);
+    ASSERT_EQ(summary.min, 16'667u);
+    ASSERT_EQ(summary.max, 16'667u);
+    ASSERT_EQ(summary.p50, 16'667u);
+    ASSERT_EQ(summary.p99, 16'667u);
+}
+
+TEST(histogram, percentiles)
+{
+    iris::Histogram histogram{};
+
+    for (auto i = 1; i <= 1000; ++i)
+    {
+        histogram.record(std::chrono::microseconds{i});
+    }
+
+    // buckets have a relative error of ~3%
+    ASSERT_NEAR(static_cast<double>(histogram.percentile(0.50).count()), 500.0, 500.0 * 0.04);
+    ASSERT_NEAR(static_cast<double>(histogram.percentile(0.95).count()), 950.0, 950.0 * 0.04);
+    ASSERT_NEAR(static_cast<double>(histogram.percentile(0.99).count()), 990.0, 990.0 * 0.04);
+    ASSERT_EQ(histogram.percentile(0.0), 1us);
+    ASSERT_EQ(histogram.percentile(1.0).count(), 992);
+    ASSERT_EQ(histogram.summary().max, 1000u);
+}
+
+TEST(histogram, small_values_exact)
+{
+    iris::Histogram histogram{};
+
+    for (auto i = 0; i < 64; ++i)
+    {
+        histogram.record(std::chrono::microseconds{i});
+    }
+
+    ASSERT_EQ(histogram.percentile(0.5), 31us);
+}
+
+TEST(histogram, reset)
+{
+    iris::Histogram histogram{};
+    histogram.record(10us);
+    histogram.reset();
+
+    ASSERT_EQ(histogram.count(), 0u);
+    ASSERT_EQ(histogram.percentile(0.5), 0us);
+}
+
+TEST(histogram, concurrent_record)
+{
+    iris::Histogram histogram{};
+    std::vector<std::thread> threads{};
+
+    for (auto i = 0; i < 4; ++i)
+    {
+        threads.emplace_back(
+            [&histogram]
+            {
+                for (auto j = 0; j < 10000; ++j)
+                {
+                    histogram.record(100us);
+                }
+            });
+    }
+
+    for (auto &thread : threads)
+    {
+        thread.join();
+    }
+
+    ASSERT_EQ(histogram.count(), 40000u);
+    ASSERT_EQ(histogram.percentile(0.5), 100us);
+}
+
+TEST(histogram, take_summary_loses_nothing)
+{
+    iris::Histogram histogram{};
+    std::atomic<bool> done = false;
+
+    std::thread recorder{
+        [&histogram, &done]
+        {
+            for (auto j = 0; j < 100000; ++j)
+            {
+                histogram.record(100us);
+            }
+
+            done = true;
+        }};
+
+    // every value recorded must appear in exactly one summary
+    std::uint64_t total = 0u;
+    while (!done)
+    {
+        total += histogram.take_summary().count;
+    }
+
+    recorder.join();
+    total += histogram.take_summary().count;
+
+    ASSERT_EQ(total, 100000u);
+    ASSERT_EQ(histogram.count(), 0u);
+}
+
+TEST(telemetry, stable_references)
+{
+    iris::Telemetry telemetry{};
+
+    auto &counter = telemetry.counter("counter");
+    auto &histogram = telemetry.histogram("histogram");
+
+    ASSERT_EQ(&counter, &telemetry.counter("counter"));
+    ASSERT_EQ(&histogram, &telemetry.histogram("histogram"));
+}
+
+TEST(telemetry, snapshot)
+{
+    iris::Telemetry telemetry{};
+    telemetry.counter("counter").add(3u);
+    telemetry.histogram("histogram").record(5us);
+
+    const auto snapshot = telemetry.snapshot();
+
+    ASSERT_EQ(snapshot.counters.at("counter"), 3u);
+    ASSERT_EQ(snapshot.histograms.at("histogram").count, 1u);
+    ASSERT_EQ(snapshot.histograms.at("histogram").p50, 5u);
+}
+
+TEST(telemetry, export_callback)
+{
+    iris::Telemetry telemetry{};
+    telemetry.histogram("histogram").record(5us);
+
+    std::vector<iris::TelemetrySnapshot> snapshots{};
+    telemetry.set_exporter([&snapshots](const auto &snapshot) { snapshots.push_back(snapshot); }, 1ms);
+
+    telemetry.tick();
+    std::this_thread::sleep_for(2ms);
+    telemetry.tick();
+
+    ASSERT_EQ(snapshots.size(), 1u);
+    ASSERT_EQ(snapshots.front().histograms.at("histogram").count, 1u);
+
+    // histograms are reset after export
+    ASSERT_EQ(telemetry.histogram("histogram").count(), 0u);
+
+    telemetry.clear_exporter();
+    std::this_thread::sleep_for(2ms);
+    telemetry.tick();
+
+    ASSERT_EQ(snapshots.size(), 1u);
+}
+
+TEST(telemetry, write_json)
+{
+    iris::TelemetrySnapshot snapshot{};
+    snapshot.counters["frames"] = 2u;
+    snapshot.histograms["frame_time"] = {.count = 1u, .min = 3u, .max = 3u, .mean = 3.0, .p50 = 3u, .p95 = 3u, .p99 = 3u};
+
+    std::stringstream strm{};
+    iris::Telemetry::write_json(snapshot, strm);
+
+    ASSERT_NE(strm.str().find(R"("counters":{"frames":2})"), std::string::npos);
+    ASSERT_NE(
+        strm.str().find(
+            R"("frame_time":{"count":1,"min_us":3,"max_us":3,"mean_us":3,"p50_us":3,"p95_us":3,"p99_us":3})"),
+        std::string::npos);
+}
+
+TEST(telemetry, looper_records_frames)
+{
+    auto &frames = iris::Telemetry::instance().counter("looper.frames");
+    const auto start_frames = frames.value();
+
+    auto count = 0;
+    iris::Looper looper{
+        0us, 1ms, [](auto, auto) { return true; }, [&count](auto, auto) { return ++count < 10; }};
+    looper.run();
+
+    ASSERT_EQ(frames.value() - start_frames, 10u);
+    ASSERT_GE(iris::Telemetry::instance().histogram("looper.frame_time").count(), 10u);
+}
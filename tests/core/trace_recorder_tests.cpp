@@ -0,0 +1,118 @@
+////////////////////////////////////////////////////////////////////////////////
+//         Distributed under the Boost Software License, Version 1.0.         //
+//            (See accompanying file LICENSE or copy at                       //
+//                 https://www.boost.org/LICENSE_1_0.txt)                     //
+////////////////////////////////////////////////////////////////////////////////
+
+#include <sstream>
+#include <string>
+#include <thread>
+
+#include <gtest/gtest.h>
+
+#include "core/profile_scope.h"
+#include "core/trace_recorder.h"
+
+TEST(trace_recorder, not_recording)
+{
+    auto &recorder = iris::TraceRecorder::instance();
+    recorder.start();
+    recorder.stop();
+
+    {
+        iris::ProfileScope scope{"zone"};
+    }
+
+    ASSERT_TRUE(recorder.zones().empty());
+}
+
+TEST(trace_recorder, nested_zones)
+{
+    auto &recorder = iris::TraceRecorder::instance();
+    recorder.start();
+
+    {
+        iris::ProfileScope outer{"outer"};
+        {
+            iris::ProfileScope inner{"inner"};
+        }
+    }
+
+    recorder.stop();
+
+    const auto zones = recorder.zones();
+    ASSERT_EQ(zones.size(), 1u);
+
+    const auto &thread_zones = zones.front().second;
+    ASSERT_EQ(thread_zones.size(), 2u);
+
+    // zones are recorded as they end, so inner comes first
+    ASSERT_EQ(std::string{thread_zones[0].name}, "inner");
+    ASSERT_EQ(std::string{thread_zones[1].name}, "outer");
+    ASSERT_LE(thread_zones[1].begin, thread_zones[0].begin);
+    ASSERT_GE(thread_zones[1].end, thread_zones[0].end);
+}
+
+TEST(trace_recorder, start_discards_previous)
+{
+    auto &recorder = iris::TraceRecorder::instance();
+    recorder.start();
+    recorder.record("first", 1u, 2u);
+    recorder.start();
+    recorder.record("second", 3u, 4u);
+    recorder.stop();
+
+    const auto zones = recorder.zones();
+    ASSERT_EQ(zones.size(), 1u);
+    ASSERT_EQ(zones.front().second.size(), 1u);
+    ASSERT_EQ(std::string{zones.front().second.front().name}, "second");
+}
+
+TEST(trace_recorder, per_thread)
+{
+    auto &recorder = iris::TraceRecorder::instance();
+    recorder.start();
+
+    recorder.record("main", 1u, 2u);
+    std::thread{[&recorder] { recorder.record("worker", 1u, 2u); }}.join();
+
+    recorder.stop();
+
+    const auto zones = recorder.zones();
+    ASSERT_EQ(zones.size(), 2u);
+    ASSERT_NE(zones[0].first, zones[1].first);
+}
+
+TEST(trace_recorder, exited_thread_buffers_reused)
+{
+    auto &recorder = iris::TraceRecorder::instance();
+    recorder.start();
+
+    for (auto i = 0u; i < 10u; ++i)
+    {
+        std::thread{[&recorder] { recorder.record("job", 1u, 2u); }}.join();
+    }
+
+    recorder.stop();
+
+    // each thread exits before the next starts, so they should all share a single buffer
+    const auto zones = recorder.zones();
+    ASSERT_EQ(zones.size(), 1u);
+    ASSERT_EQ(zones[0].second.size(), 10u);
+}
+
+TEST(trace_recorder, chrome_trace)
+{
+    auto &recorder = iris::TraceRecorder::instance();
+    recorder.start();
+    recorder.record("zone", 1'500u, 4'000u);
+    recorder.stop();
+
+    std::stringstream strm{};
+    recorder.write_chrome_trace(strm);
+    const auto json = strm.str();
+
+    ASSERT_EQ(json.find(R"({"displayTimeUnit":"ns","traceEvents":[)"), 0u);
+    ASSERT_NE(json.find(R"({"name":"zone","ph":"X","pid":1,"tid":)"), std::string::npos);
+    ASSERT_NE(json.find(R"("ts":1.500,"dur":2.500})"), std::string::npos);
+}
@@ -11,6 +11,8 @@
 #include <functional>
 #include <vector>
 
+#include "graphics/material.h"
+#include "graphics/material_manager.h"
 #include "graphics/render_command.h"
 #include "graphics/render_command_type.h"
 #include "graphics/render_pass.h"
@@ -20,10 +22,9 @@
 class FakeRenderer : public iris::Renderer
 {
   public:
-    FakeRenderer(const std::vector<iris::RenderCommand> &render_queue)
-        : iris::Renderer()
+    FakeRenderer(iris::MaterialManager &material_manager)
+        : iris::Renderer(material_manager)
     {
-        render_queue_ = render_queue;
     }
 
     std::vector<iris::RenderCommandType> call_log() const
@@ -31,6 +32,16 @@ class FakeRenderer : public iris::Renderer
         return call_log_;
     }
 
+    std::uint32_t material_changes() const
+    {
+        return material_changes_;
+    }
+
+    std::vector<iris::RenderCommand> render_queue() const
+    {
+        return render_queue_;
+    }
+
     ~FakeRenderer() override = default;
 
     // overridden methods which just log when they are called
@@ -44,9 +55,16 @@ class FakeRenderer : public iris::Renderer
         call_log_.emplace_back(iris::RenderCommandType::PASS_START);
     }
 
-    void execute_draw(iris::RenderCommand &) override
+    void execute_draw(iris::RenderCommand &command) override
     {
         call_log_.emplace_back(iris::RenderCommandType::DRAW);
+
+        // count the binds a renderer which skips redundant material binds would perform
+        if (command.material() != previous_material_)
+        {
+            ++material_changes_;
+            previous_material_ = command.material();
+        }
     }
 
     void execute_pass_end(iris::RenderCommand &) override
@@ -64,11 +82,13 @@ class FakeRenderer : public iris::Renderer
     }
 
   protected:
-    void do_set_render_pipeline(std::function<void()> build_queue)
+    void do_set_render_pipeline(std::function<void()> build_queue) override
     {
         build_queue();
     }
 
   private:
     std::vector<iris::RenderCommandType> call_log_;
+    std::uint32_t material_changes_ = 0u;
+    const iris::Material *previous_material_ = nullptr;
 };
\ No newline at end of file
@@ -0,0 +1,140 @@
+////////////////////////////////////////////////////////////////////////////////
+//         Distributed under the Boost Software License, Version 1.0.         //
+//            (See accompanying file LICENSE or copy at                       //
+//                 https://www.boost.org/LICENSE_1_0.txt)                     //
+////////////////////////////////////////////////////////////////////////////////
+
+#include <cmath>
+#include <memory>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "core/bounding_sphere.h"
+#include "core/camera.h"
+#include "core/camera_type.h"
+#include "core/vector3.h"
+#include "graphics/clustered_light_grid.h"
+#include "graphics/lights/light.h"
+#include "graphics/lights/point_light.h"
+
+namespace
+{
+
+/**
+ * Helper function to create a white point light with a range of 16.
+ */
+std::unique_ptr<iris::PointLight> create_light(const iris::Vector3 &position)
+{
+    auto light = std::make_unique<iris::PointLight>(position);
+    light->set_attenuation_linear_term(0.0f);
+    light->set_attenuation_quadratic_term(1.0f);
+
+    return light;
+}
+
+}
+
+TEST(clustered_light_grid, point_light_range)
+{
+    iris::PointLight light{{}};
+    ASSERT_FLOAT_EQ(light.range(), 256.0f);
+
+    light.set_attenuation_constant_term(1.0f);
+    light.set_attenuation_linear_term(0.0f);
+    light.set_attenuation_quadratic_term(1.0f);
+    ASSERT_FLOAT_EQ(light.range(), std::sqrt(255.0f));
+
+    light.set_attenuation_quadratic_term(0.0f);
+    ASSERT_TRUE(std::isinf(light.range()));
+}
+
+TEST(clustered_light_grid, finds_lights_in_range)
+{
+    // default camera is at (0, 0, 100) looking down -z
+    const iris::Camera camera{iris::CameraType::PERSPECTIVE, 800u, 800u};
+
+    std::vector<std::unique_ptr<iris::PointLight>> lights{};
+    lights.push_back(create_light({}));
+    lights.push_back(create_light({0.0f, 0.0f, -500.0f}));
+
+    iris::ClusteredLightGrid grid{};
+    grid.build(camera, lights);
+
+    std::vector<const iris::Light *> found{};
+
+    grid.lights({{1.0f, 0.0f, 0.0f}, 1.0f}, found);
+    ASSERT_EQ(found, std::vector<const iris::Light *>{lights[0].get()});
+
+    grid.lights({{0.0f, 10.0f, -500.0f}, 1.0f}, found);
+    ASSERT_EQ(found, std::vector<const iris::Light *>{lights[1].get()});
+
+    grid.lights({{40.0f, 0.0f, 0.0f}, 1.0f}, found);
+    ASSERT_TRUE(found.empty());
+}
+
+TEST(clustered_light_grid, ignores_lights_outside_frustum)
+{
+    const iris::Camera camera{iris::CameraType::PERSPECTIVE, 800u, 800u};
+
+    std::vector<std::unique_ptr<iris::PointLight>> lights{};
+    lights.push_back(create_light({0.0f, 0.0f, 200.0f}));
+
+    iris::ClusteredLightGrid grid{};
+    grid.build(camera, lights);
+
+    for (auto z = 0u; z < iris::ClusteredLightGrid::slices; ++z)
+    {
+        for (auto y = 0u; y < iris::ClusteredLightGrid::tiles_y; ++y)
+        {
+            for (auto x = 0u; x < iris::ClusteredLightGrid::tiles_x; ++x)
+            {
+                ASSERT_EQ(grid.light_count(x, y, z), 0u);
+            }
+        }
+    }
+}
+
+TEST(clustered_light_grid, unattenuated_light_fills_grid)
+{
+    const iris::Camera camera{iris::CameraType::ORTHOGRAPHIC, 800u, 800u};
+
+    std::vector<std::unique_ptr<iris::PointLight>> lights{};
+    lights.push_back(std::make_unique<iris::PointLight>(iris::Vector3{}));
+    lights.back()->set_attenuation_linear_term(0.0f);
+
+    iris::ClusteredLightGrid grid{};
+    grid.build(camera, lights);
+
+    for (auto z = 0u; z < iris::ClusteredLightGrid::slices; ++z)
+    {
+        for (auto y = 0u; y < iris::ClusteredLightGrid::tiles_y; ++y)
+        {
+            for (auto x = 0u; x < iris::ClusteredLightGrid::tiles_x; ++x)
+            {
+                ASSERT_EQ(grid.light_count(x, y, z), 1u);
+            }
+        }
+    }
+}
+
+TEST(clustered_light_grid, orthographic_camera)
+{
+    auto camera = iris::Camera{iris::CameraType::ORTHOGRAPHIC, 800u, 800u};
+    camera.set_position({});
+
+    std::vector<std::unique_ptr<iris::PointLight>> lights{};
+    lights.push_back(create_light({-500.0f, 0.0f, 0.0f}));
+    lights.push_back(create_light({500.0f, 0.0f, 0.0f}));
+
+    iris::ClusteredLightGrid grid{};
+    grid.build(camera, lights);
+
+    std::vector<const iris::Light *> found{};
+
+    grid.lights({{-500.0f, 0.0f, 0.0f}, 1.0f}, found);
+    ASSERT_EQ(found, std::vector<const iris::Light *>{lights[0].get()});
+
+    grid.lights({{0.0f, 0.0f, 0.0f}, 1.0f}, found);
+    ASSERT_TRUE(found.empty());
+}
@@ -0,0 +1,187 @@
+////////////////////////////////////////////////////////////////////////////////
+//         Distributed under the Boost Software License, Version 1.0.         //
+//            (See accompanying file LICENSE or copy at                       //
+//                 https://www.boost.org/LICENSE_1_0.txt)                     //
+////////////////////////////////////////////////////////////////////////////////
+
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include "core/matrix4.h"
+#include "core/telemetry.h"
+#include "core/vector3.h"
+#include "graphics/draw_batcher.h"
+#include "graphics/instanced_entity.h"
+#include "graphics/lights/point_light.h"
+#include "graphics/render_command.h"
+#include "graphics/render_command_type.h"
+#include "graphics/render_entity_type.h"
+#include "graphics/render_pipeline.h"
+#include "graphics/scene.h"
+#include "graphics/single_entity.h"
+
+#include "fakes/fake_material.h"
+#include "fakes/fake_mesh.h"
+#include "mocks/mock_material_manager.h"
+#include "mocks/mock_mesh_manager.h"
+#include "mocks/mock_render_target_manager.h"
+#include "mocks/mock_resource_manager.h"
+
+using ::testing::NiceMock;
+
+class DrawBatcherTests : public ::testing::Test
+{
+  public:
+    DrawBatcherTests()
+        : resource_manager_()
+        , material_manager_()
+        , mesh_manager_(resource_manager_)
+        , render_target_manager_()
+        , pipeline_(material_manager_, mesh_manager_, render_target_manager_, 800u, 800u)
+        , scene_(pipeline_.create_scene())
+        , pass_(pipeline_.create_render_pass(scene_))
+        , mesh_()
+        , material_()
+        , light1_(scene_->create_light<iris::PointLight>(iris::Vector3{}))
+        , light2_(scene_->create_light<iris::PointLight>(iris::Vector3{}))
+        , entities_()
+    {
+        for (auto i = 0u; i < 3u; ++i)
+        {
+            entities_.push_back(
+                std::make_unique<iris::SingleEntity>(&mesh_, iris::Vector3{static_cast<float>(i), 0.0f, 0.0f}));
+        }
+    }
+
+  protected:
+    /**
+     * Create a queue for a single pass with a draw for each entity and light pair, in the supplied order.
+     */
+    std::vector<iris::RenderCommand> create_queue(
+        const std::vector<std::pair<const iris::RenderEntity *, const iris::Light *>> &draws) const
+    {
+        iris::RenderCommand cmd{};
+        cmd.set_render_pass(pass_);
+
+        std::vector<iris::RenderCommand> render_queue{cmd};
+
+        for (const auto &[entity, light] : draws)
+        {
+            render_queue.emplace_back(iris::RenderCommandType::DRAW, pass_, &material_, entity, nullptr, light);
+        }
+
+        cmd.set_type(iris::RenderCommandType::PASS_END);
+        render_queue.push_back(cmd);
+
+        cmd.set_type(iris::RenderCommandType::PRESENT);
+        render_queue.push_back(cmd);
+
+        return render_queue;
+    }
+
+    /**
+     * Get the instanced entity drawn by a command.
+     */
+    static const iris::InstancedEntity *instanced_entity(const iris::RenderCommand &command)
+    {
+        EXPECT_EQ(command.render_entity()->type(), iris::RenderEntityType::INSTANCED);
+        return static_cast<const iris::InstancedEntity *>(command.render_entity());
+    }
+
+    NiceMock<MockResourceManager> resource_manager_;
+    NiceMock<MockMaterialManager> material_manager_;
+    NiceMock<MockMeshManager> mesh_manager_;
+    NiceMock<MockRenderTargetManager> render_target_manager_;
+    iris::RenderPipeline pipeline_;
+    iris::Scene *scene_;
+    iris::RenderPass *pass_;
+    FakeMesh mesh_;
+    FakeMaterial material_;
+    iris::PointLight *light1_;
+    iris::PointLight *light2_;
+    std::vector<std::unique_ptr<iris::SingleEntity>> entities_;
+};
+
+TEST_F(DrawBatcherTests, batches_identical_draws)
+{
+    auto render_queue =
+        create_queue({{entities_[0].get(), light1_}, {entities_[1].get(), light1_}, {entities_[2].get(), light1_}});
+
+    auto &telemetry = iris::Telemetry::instance();
+    const auto saved = telemetry.counter("renderer.batch.draws_saved").value();
+
+    iris::DrawBatcher batcher{};
+    batcher.batch(render_queue);
+
+    ASSERT_EQ(render_queue.size(), 4u);
+    ASSERT_EQ(render_queue[1].type(), iris::RenderCommandType::DRAW);
+    ASSERT_EQ(render_queue[1].light(), light1_);
+    ASSERT_EQ(render_queue[1].material(), &material_);
+
+    const auto *batch = instanced_entity(render_queue[1]);
+    ASSERT_EQ(batch->mesh(), &mesh_);
+    ASSERT_EQ(batch->instance_count(), 3u);
+
+    std::vector<iris::Matrix4> expected{};
+    for (const auto &entity : entities_)
+    {
+        expected.push_back(entity->transform());
+        expected.push_back(entity->normal_transform());
+    }
+    ASSERT_EQ(batch->data(), expected);
+
+    ASSERT_EQ(telemetry.counter("renderer.batch.draws_saved").value() - saved, 2u);
+}
+
+TEST_F(DrawBatcherTests, batches_by_light)
+{
+    auto render_queue = create_queue(
+        {{entities_[0].get(), light1_},
+         {entities_[0].get(), light2_},
+         {entities_[1].get(), light1_},
+         {entities_[1].get(), light2_}});
+
+    iris::DrawBatcher batcher{};
+    batcher.batch(render_queue);
+
+    ASSERT_EQ(render_queue.size(), 5u);
+    ASSERT_NE(render_queue[1].light(), render_queue[2].light());
+    ASSERT_EQ(instanced_entity(render_queue[1])->instance_count(), 2u);
+    ASSERT_EQ(instanced_entity(render_queue[2])->instance_count(), 2u);
+    ASSERT_NE(render_queue[1].render_entity(), render_queue[2].render_entity());
+}
+
+TEST_F(DrawBatcherTests, respects_opt_out)
+{
+    entities_[2]->set_batchable(false);
+
+    auto render_queue =
+        create_queue({{entities_[0].get(), light1_}, {entities_[1].get(), light1_}, {entities_[2].get(), light1_}});
+
+    iris::DrawBatcher batcher{};
+    batcher.batch(render_queue);
+
+    ASSERT_EQ(render_queue.size(), 5u);
+    ASSERT_EQ(instanced_entity(render_queue[1])->instance_count(), 2u);
+    ASSERT_EQ(render_queue[2].render_entity(), entities_[2].get());
+}
+
+TEST_F(DrawBatcherTests, different_state_not_batched)
+{
+    FakeMesh other_mesh{};
+    entities_[1]->set_mesh(&other_mesh);
+    entities_[2]->set_receive_shadow(false);
+
+    auto render_queue =
+        create_queue({{entities_[0].get(), light1_}, {entities_[1].get(), light1_}, {entities_[2].get(), light1_}});
+    const auto expected = render_queue;
+
+    iris::DrawBatcher batcher{};
+    batcher.batch(render_queue);
+
+    ASSERT_EQ(render_queue, expected);
+}
@@ -0,0 +1,151 @@
+////////////////////////////////////////////////////////////////////////////////
+//         Distributed under the Boost Software License, Version 1.0.         //
+//            (See accompanying file LICENSE or copy at                       //
+//                 https://www.boost.org/LICENSE_1_0.txt)                     //
+////////////////////////////////////////////////////////////////////////////////
+
+#include <vector>
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include "core/camera.h"
+#include "core/camera_type.h"
+#include "core/telemetry.h"
+#include "core/vector3.h"
+#include "graphics/frustum_culler.h"
+#include "graphics/lights/directional_light.h"
+#include "graphics/render_command.h"
+#include "graphics/render_command_type.h"
+#include "graphics/render_pipeline.h"
+#include "graphics/single_entity.h"
+
+#include "fakes/fake_material.h"
+#include "fakes/fake_mesh.h"
+#include "mocks/mock_material_manager.h"
+#include "mocks/mock_mesh_manager.h"
+#include "mocks/mock_render_target_manager.h"
+#include "mocks/mock_resource_manager.h"
+
+using ::testing::NiceMock;
+
+class FrustumCullerTests : public ::testing::Test
+{
+  public:
+    FrustumCullerTests()
+        : resource_manager_()
+        , material_manager_()
+        , mesh_manager_(resource_manager_)
+        , render_target_manager_()
+        , pipeline_(material_manager_, mesh_manager_, render_target_manager_, 800u, 800u)
+        , pass_(pipeline_.create_render_pass(pipeline_.create_scene()))
+        , mesh_()
+        , material_()
+    {
+    }
+
+  protected:
+    /**
+     * Create a queue for a single pass drawing the supplied entities.
+     */
+    std::vector<iris::RenderCommand> create_queue(const std::vector<const iris::RenderEntity *> &entities) const
+    {
+        iris::RenderCommand cmd{};
+        cmd.set_render_pass(pass_);
+
+        std::vector<iris::RenderCommand> render_queue{cmd};
+
+        for (const auto *entity : entities)
+        {
+            render_queue.emplace_back(iris::RenderCommandType::DRAW, pass_, &material_, entity, nullptr, nullptr);
+        }
+
+        cmd.set_type(iris::RenderCommandType::PASS_END);
+        render_queue.push_back(cmd);
+
+        cmd.set_type(iris::RenderCommandType::PRESENT);
+        render_queue.push_back(cmd);
+
+        return render_queue;
+    }
+
+    NiceMock<MockResourceManager> resource_manager_;
+    NiceMock<MockMaterialManager> material_manager_;
+    NiceMock<MockMeshManager> mesh_manager_;
+    NiceMock<MockRenderTargetManager> render_target_manager_;
+    iris::RenderPipeline pipeline_;
+    iris::RenderPass *pass_;
+    FakeMesh mesh_;
+    FakeMaterial material_;
+};
+
+TEST_F(FrustumCullerTests, culls_entities_outside_frustum)
+{
+    // default camera is at (0, 0, 100) looking down -z
+    iris::Camera camera{iris::CameraType::PERSPECTIVE, 800u, 800u};
+    pass_->camera = &camera;
+
+    const iris::SingleEntity visible{&mesh_, iris::Vector3{}};
+    const iris::SingleEntity behind{&mesh_, iris::Vector3{0.0f, 0.0f, 200.0f}};
+
+    const auto render_queue = create_queue({&visible, &behind});
+    std::vector<iris::RenderCommand> visible_queue{};
+
+    auto &telemetry = iris::Telemetry::instance();
+    const auto tested = telemetry.counter("renderer.cull.tested").value();
+    const auto kept = telemetry.counter("renderer.cull.visible").value();
+
+    iris::FrustumCuller culler{};
+    culler.cull(render_queue, visible_queue);
+
+    ASSERT_EQ(visible_queue, create_queue({&visible}));
+    ASSERT_EQ(telemetry.counter("renderer.cull.tested").value() - tested, 2u);
+    ASSERT_EQ(telemetry.counter("renderer.cull.visible").value() - kept, 1u);
+}
+
+TEST_F(FrustumCullerTests, keeps_non_cullable_entities)
+{
+    iris::Camera camera{iris::CameraType::PERSPECTIVE, 800u, 800u};
+    pass_->camera = &camera;
+
+    iris::SingleEntity behind{&mesh_, iris::Vector3{0.0f, 0.0f, 200.0f}};
+    behind.set_cullable(false);
+
+    const auto render_queue = create_queue({&behind});
+    std::vector<iris::RenderCommand> visible_queue{};
+
+    iris::FrustumCuller culler{};
+    culler.cull(render_queue, visible_queue);
+
+    ASSERT_EQ(visible_queue, render_queue);
+}
+
+TEST_F(FrustumCullerTests, no_camera_keeps_everything)
+{
+    const iris::SingleEntity behind{&mesh_, iris::Vector3{0.0f, 0.0f, 200.0f}};
+
+    const auto render_queue = create_queue({&behind});
+    std::vector<iris::RenderCommand> visible_queue{};
+
+    iris::FrustumCuller culler{};
+    culler.cull(render_queue, visible_queue);
+
+    ASSERT_EQ(visible_queue, render_queue);
+}
+
+TEST_F(FrustumCullerTests, culls_with_shadow_camera)
+{
+    const iris::DirectionalLight light{{-1.0f, -1.0f, 0.0f}, true};
+    pass_->camera = &light.shadow_camera();
+
+    const iris::SingleEntity visible{&mesh_, iris::Vector3{}};
+    const iris::SingleEntity outside{&mesh_, iris::Vector3{500.0f, 0.0f, 0.0f}};
+
+    const auto render_queue = create_queue({&visible, &outside});
+    std::vector<iris::RenderCommand> visible_queue{};
+
+    iris::FrustumCuller culler{};
+    culler.cull(render_queue, visible_queue);
+
+    ASSERT_EQ(visible_queue, create_queue({&visible}));
+}
@@ -0,0 +1,120 @@
+////////////////////////////////////////////////////////////////////////////////
+//         Distributed under the Boost Software License, Version 1.0.         //
+//            (See accompanying file LICENSE or copy at                       //
+//                 https://www.boost.org/LICENSE_1_0.txt)                     //
+////////////////////////////////////////////////////////////////////////////////
+
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "core/dirty_range_tracker.h"
+#include "core/matrix4.h"
+#include "core/transform.h"
+#include "core/vector3.h"
+#include "graphics/instanced_entity.h"
+
+#include "fakes/fake_mesh.h"
+
+namespace
+{
+
+/**
+ * Helper function to get the changed instances of an entity.
+ */
+std::vector<iris::DirtyRange> dirty_ranges(const iris::InstancedEntity &entity)
+{
+    std::vector<iris::DirtyRange> ranges{};
+    entity.dirty_instances().ranges(ranges);
+
+    return ranges;
+}
+
+/**
+ * Helper function to create a transform at a position.
+ */
+iris::Transform create_transform(float x)
+{
+    return {{x, 0.0f, 0.0f}, {}, {1.0f}};
+}
+
+}
+
+TEST(instanced_entity, construct_marks_all_dirty)
+{
+    FakeMesh mesh{};
+    const iris::InstancedEntity entity{&mesh, {create_transform(0.0f), create_transform(1.0f)}};
+
+    ASSERT_EQ(entity.instance_count(), 2u);
+    ASSERT_EQ(entity.data().size(), 4u);
+    ASSERT_EQ(dirty_ranges(entity), (std::vector<iris::DirtyRange>{{.begin = 0u, .end = 2u}}));
+}
+
+TEST(instanced_entity, set_transform)
+{
+    FakeMesh mesh{};
+    iris::InstancedEntity entity{&mesh, {create_transform(0.0f), create_transform(1.0f), create_transform(2.0f)}};
+    entity.clear_dirty_instances();
+
+    const auto transform = create_transform(10.0f);
+    entity.set_transform(1u, transform);
+
+    const iris::InstancedEntity expected{&mesh, {transform}};
+    ASSERT_EQ(entity.data()[2], expected.data()[0]);
+    ASSERT_EQ(entity.data()[3], expected.data()[1]);
+    ASSERT_EQ(dirty_ranges(entity), (std::vector<iris::DirtyRange>{{.begin = 1u, .end = 2u}}));
+
+    // bounds contain the moved instance
+    const auto &bounding_sphere = entity.bounding_sphere();
+    const auto distance = (bounding_sphere.centre - iris::Vector3{10.0f, 0.0f, 0.0f}).magnitude();
+    ASSERT_LE(distance, bounding_sphere.radius + 0.0001f);
+}
+
+TEST(instanced_entity, add_instance)
+{
+    FakeMesh mesh{};
+    iris::InstancedEntity entity{&mesh, {create_transform(0.0f), create_transform(1.0f)}};
+    entity.clear_dirty_instances();
+
+    ASSERT_EQ(entity.add_instance(create_transform(2.0f)), 2u);
+    ASSERT_EQ(entity.instance_count(), 3u);
+    ASSERT_EQ(entity.data().size(), 6u);
+    ASSERT_EQ(dirty_ranges(entity), (std::vector<iris::DirtyRange>{{.begin = 2u, .end = 3u}}));
+}
+
+TEST(instanced_entity, remove_instance)
+{
+    FakeMesh mesh{};
+    iris::InstancedEntity entity{&mesh, {create_transform(0.0f), create_transform(1.0f), create_transform(2.0f)}};
+    entity.clear_dirty_instances();
+
+    const auto last = entity.data()[4];
+    entity.remove_instance(0u);
+
+    // last instance is moved into the removed slot
+    ASSERT_EQ(entity.instance_count(), 2u);
+    ASSERT_EQ(entity.data().size(), 4u);
+    ASSERT_EQ(entity.data()[0], last);
+    ASSERT_EQ(dirty_ranges(entity), (std::vector<iris::DirtyRange>{{.begin = 0u, .end = 1u}}));
+
+    // removing the last instance needs no upload
+    entity.clear_dirty_instances();
+    entity.remove_instance(1u);
+
+    ASSERT_EQ(entity.instance_count(), 1u);
+    ASSERT_TRUE(entity.dirty_instances().empty());
+}
+
+TEST(instanced_entity, remove_instance_shrinks_bounds)
+{
+    FakeMesh mesh{};
+    iris::InstancedEntity entity{&mesh, {create_transform(0.0f), create_transform(100.0f)}};
+
+    ASSERT_GE(entity.bounding_sphere().radius, 50.0f);
+
+    entity.remove_instance(1u);
+
+    const auto &bounding_sphere = entity.bounding_sphere();
+    ASSERT_LE(bounding_sphere.centre.magnitude(), 0.0001f);
+    ASSERT_LE(bounding_sphere.radius, 0.0001f);
+}
@@ -0,0 +1,144 @@
+////////////////////////////////////////////////////////////////////////////////
+//         Distributed under the Boost Software License, Version 1.0.         //
+//            (See accompanying file LICENSE or copy at                       //
+//                 https://www.boost.org/LICENSE_1_0.txt)                     //
+////////////////////////////////////////////////////////////////////////////////
+
+#include <vector>
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include "core/camera.h"
+#include "core/camera_type.h"
+#include "core/telemetry.h"
+#include "core/vector3.h"
+#include "graphics/light_culler.h"
+#include "graphics/lights/point_light.h"
+#include "graphics/render_command.h"
+#include "graphics/render_command_type.h"
+#include "graphics/render_pipeline.h"
+#include "graphics/scene.h"
+#include "graphics/single_entity.h"
+
+#include "fakes/fake_material.h"
+#include "fakes/fake_mesh.h"
+#include "mocks/mock_material_manager.h"
+#include "mocks/mock_mesh_manager.h"
+#include "mocks/mock_render_target_manager.h"
+#include "mocks/mock_resource_manager.h"
+
+using ::testing::NiceMock;
+
+class LightCullerTests : public ::testing::Test
+{
+  public:
+    LightCullerTests()
+        : resource_manager_()
+        , material_manager_()
+        , mesh_manager_(resource_manager_)
+        , render_target_manager_()
+        , pipeline_(material_manager_, mesh_manager_, render_target_manager_, 800u, 800u)
+        , scene_(pipeline_.create_scene())
+        , pass_(pipeline_.create_render_pass(scene_))
+        , camera_(iris::CameraType::PERSPECTIVE, 800u, 800u)
+        , mesh_()
+        , material_()
+        , near_light_(scene_->create_light<iris::PointLight>(iris::Vector3{}))
+        , far_light_(scene_->create_light<iris::PointLight>(iris::Vector3{0.0f, 0.0f, -500.0f}))
+    {
+        pass_->camera = &camera_;
+
+        // give both lights a range of 16
+        for (auto *light : {near_light_, far_light_})
+        {
+            light->set_attenuation_linear_term(0.0f);
+            light->set_attenuation_quadratic_term(1.0f);
+        }
+    }
+
+  protected:
+    /**
+     * Create a queue for a single pass drawing an entity with the supplied lights.
+     */
+    std::vector<iris::RenderCommand> create_queue(
+        const iris::RenderEntity *entity,
+        const std::vector<const iris::Light *> &lights) const
+    {
+        iris::RenderCommand cmd{};
+        cmd.set_render_pass(pass_);
+
+        std::vector<iris::RenderCommand> render_queue{cmd};
+
+        for (const auto *light : lights)
+        {
+            render_queue.emplace_back(iris::RenderCommandType::DRAW, pass_, &material_, entity, nullptr, light);
+        }
+
+        cmd.set_type(iris::RenderCommandType::PASS_END);
+        render_queue.push_back(cmd);
+
+        cmd.set_type(iris::RenderCommandType::PRESENT);
+        render_queue.push_back(cmd);
+
+        return render_queue;
+    }
+
+    NiceMock<MockResourceManager> resource_manager_;
+    NiceMock<MockMaterialManager> material_manager_;
+    NiceMock<MockMeshManager> mesh_manager_;
+    NiceMock<MockRenderTargetManager> render_target_manager_;
+    iris::RenderPipeline pipeline_;
+    iris::Scene *scene_;
+    iris::RenderPass *pass_;
+    iris::Camera camera_;
+    FakeMesh mesh_;
+    FakeMaterial material_;
+    iris::PointLight *near_light_;
+    iris::PointLight *far_light_;
+};
+
+TEST_F(LightCullerTests, culls_lights_out_of_range)
+{
+    const iris::SingleEntity entity{&mesh_, iris::Vector3{}};
+    auto render_queue = create_queue(&entity, {near_light_, far_light_});
+
+    auto &telemetry = iris::Telemetry::instance();
+    const auto tested = telemetry.counter("renderer.light_cull.tested").value();
+    const auto kept = telemetry.counter("renderer.light_cull.visible").value();
+
+    iris::LightCuller culler{};
+    culler.cull(render_queue);
+
+    ASSERT_EQ(render_queue, create_queue(&entity, {near_light_}));
+    ASSERT_EQ(telemetry.counter("renderer.light_cull.tested").value() - tested, 2u);
+    ASSERT_EQ(telemetry.counter("renderer.light_cull.visible").value() - kept, 1u);
+}
+
+TEST_F(LightCullerTests, keeps_non_cullable_entities)
+{
+    iris::SingleEntity entity{&mesh_, iris::Vector3{}};
+    entity.set_cullable(false);
+
+    auto render_queue = create_queue(&entity, {near_light_, far_light_});
+    const auto expected = render_queue;
+
+    iris::LightCuller culler{};
+    culler.cull(render_queue);
+
+    ASSERT_EQ(render_queue, expected);
+}
+
+TEST_F(LightCullerTests, no_camera_keeps_everything)
+{
+    pass_->camera = nullptr;
+
+    const iris::SingleEntity entity{&mesh_, iris::Vector3{100.0f, 0.0f, 0.0f}};
+    auto render_queue = create_queue(&entity, {near_light_, far_light_});
+    const auto expected = render_queue;
+
+    iris::LightCuller culler{};
+    culler.cull(render_queue);
+
+    ASSERT_EQ(render_queue, expected);
+}
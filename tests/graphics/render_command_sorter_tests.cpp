@@ -0,0 +1,194 @@
+////////////////////////////////////////////////////////////////////////////////
+//         Distributed under the Boost Software License, Version 1.0.         //
+//            (See accompanying file LICENSE or copy at                       //
+//                 https://www.boost.org/LICENSE_1_0.txt)                     //
+////////////////////////////////////////////////////////////////////////////////
+
+#include <array>
+#include <memory>
+#include <vector>
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include "core/camera.h"
+#include "core/camera_type.h"
+#include "core/colour.h"
+#include "core/vector3.h"
+#include "graphics/lights/ambient_light.h"
+#include "graphics/lights/point_light.h"
+#include "graphics/render_command.h"
+#include "graphics/render_command_sorter.h"
+#include "graphics/render_command_type.h"
+#include "graphics/render_pipeline.h"
+#include "graphics/scene.h"
+#include "graphics/single_entity.h"
+
+#include "fakes/fake_material.h"
+#include "fakes/fake_mesh.h"
+#include "fakes/fake_renderer.h"
+#include "mocks/mock_material_manager.h"
+#include "mocks/mock_mesh_manager.h"
+#include "mocks/mock_render_target_manager.h"
+#include "mocks/mock_resource_manager.h"
+
+using ::testing::_;
+using ::testing::NiceMock;
+using ::testing::Return;
+
+namespace
+{
+
+std::uint32_t count_material_changes(const std::vector<iris::RenderCommand> &render_queue)
+{
+    std::uint32_t changes = 0u;
+    const iris::Material *previous = nullptr;
+
+    for (const auto &command : render_queue)
+    {
+        if ((command.type() == iris::RenderCommandType::DRAW) && (command.material() != previous))
+        {
+            ++changes;
+            previous = command.material();
+        }
+    }
+
+    return changes;
+}
+
+}
+
+class RenderCommandSorterTests : public ::testing::Test
+{
+  public:
+    RenderCommandSorterTests()
+        : resource_manager_()
+        , material_manager_()
+        , mesh_manager_(resource_manager_)
+        , render_target_manager_()
+        , camera_(iris::CameraType::PERSPECTIVE, 800u, 800u)
+        , pipeline_(material_manager_, mesh_manager_, render_target_manager_, 800u, 800u)
+        , pass_(pipeline_.create_render_pass(pipeline_.create_scene()))
+        , mesh_()
+        , material_()
+        , light_(iris::Colour{1.0f, 1.0f, 1.0f})
+    {
+        camera_.set_position({});
+        pass_->camera = &camera_;
+    }
+
+  protected:
+    iris::RenderCommand draw(const iris::RenderEntity *entity, const iris::Light *light = nullptr)
+    {
+        return {
+            iris::RenderCommandType::DRAW,
+            pass_,
+            &material_,
+            entity,
+            nullptr,
+            light == nullptr ? static_cast<const iris::Light *>(&light_) : light};
+    }
+
+    NiceMock<MockResourceManager> resource_manager_;
+    NiceMock<MockMaterialManager> material_manager_;
+    NiceMock<MockMeshManager> mesh_manager_;
+    NiceMock<MockRenderTargetManager> render_target_manager_;
+    iris::Camera camera_;
+    iris::RenderPipeline pipeline_;
+    iris::RenderPass *pass_;
+    FakeMesh mesh_;
+    FakeMaterial material_;
+    iris::AmbientLight light_;
+};
+
+TEST_F(RenderCommandSorterTests, opaque_front_to_back)
+{
+    const iris::SingleEntity near{&mesh_, iris::Vector3{0.0f, 0.0f, 1.0f}};
+    const iris::SingleEntity far{&mesh_, iris::Vector3{0.0f, 0.0f, 10.0f}};
+
+    ASSERT_LT(
+        iris::RenderCommandSorter::sort_key(0u, draw(&near)), iris::RenderCommandSorter::sort_key(0u, draw(&far)));
+}
+
+TEST_F(RenderCommandSorterTests, transparent_back_to_front_after_opaque)
+{
+    const iris::SingleEntity opaque{&mesh_, iris::Vector3{0.0f, 0.0f, 100.0f}};
+    const iris::SingleEntity near{&mesh_, iris::Vector3{0.0f, 0.0f, 1.0f}, true};
+    const iris::SingleEntity far{&mesh_, iris::Vector3{0.0f, 0.0f, 10.0f}, true};
+
+    ASSERT_LT(
+        iris::RenderCommandSorter::sort_key(0u, draw(&opaque)), iris::RenderCommandSorter::sort_key(0u, draw(&far)));
+    ASSERT_LT(
+        iris::RenderCommandSorter::sort_key(0u, draw(&far)), iris::RenderCommandSorter::sort_key(0u, draw(&near)));
+}
+
+TEST_F(RenderCommandSorterTests, light_type_order_preserved)
+{
+    const iris::SingleEntity near{&mesh_, iris::Vector3{0.0f, 0.0f, 1.0f}};
+    const iris::SingleEntity far{&mesh_, iris::Vector3{0.0f, 0.0f, 10.0f}, true};
+    const iris::PointLight point_light{iris::Vector3{}};
+
+    ASSERT_LT(
+        iris::RenderCommandSorter::sort_key(0u, draw(&far)),
+        iris::RenderCommandSorter::sort_key(0u, draw(&near, &point_light)));
+}
+
+TEST_F(RenderCommandSorterTests, sort_only_reorders_draws)
+{
+    const iris::SingleEntity near{&mesh_, iris::Vector3{0.0f, 0.0f, 1.0f}};
+    const iris::SingleEntity far{&mesh_, iris::Vector3{0.0f, 0.0f, 10.0f}};
+
+    iris::RenderCommand pass_start{};
+    pass_start.set_render_pass(pass_);
+    auto pass_end = pass_start;
+    pass_end.set_type(iris::RenderCommandType::PASS_END);
+    auto present = pass_start;
+    present.set_type(iris::RenderCommandType::PRESENT);
+
+    std::vector<iris::RenderCommand> render_queue{pass_start, draw(&far), draw(&near), pass_end, present};
+    const std::vector<iris::RenderCommand> expected{pass_start, draw(&near), draw(&far), pass_end, present};
+
+    iris::RenderCommandSorter sorter{};
+    sorter.sort(render_queue);
+
+    ASSERT_EQ(render_queue, expected);
+}
+
+TEST_F(RenderCommandSorterTests, reduces_material_changes)
+{
+    FakeRenderer renderer{material_manager_};
+
+    auto pipeline =
+        std::make_unique<iris::RenderPipeline>(material_manager_, mesh_manager_, render_target_manager_, 800u, 800u);
+    auto *scene = pipeline->create_scene();
+    scene->create_light<iris::PointLight>(iris::Vector3{}, iris::Colour{1.0f, 1.0f, 1.0f});
+    pipeline->create_render_pass(scene)->camera = &camera_;
+
+    // a synthetic scene where every consecutive entity uses a different material
+    std::array<iris::RenderGraph *, 4u> render_graphs{};
+    std::array<FakeMaterial, 4u> materials{};
+    for (auto i = 0u; i < render_graphs.size(); ++i)
+    {
+        render_graphs[i] = pipeline->create_render_graph();
+        ON_CALL(material_manager_, create(render_graphs[i], _, _, _, _, _, _, _)).WillByDefault(Return(&materials[i]));
+    }
+
+    for (auto i = 0u; i < 100u; ++i)
+    {
+        scene->create_entity<iris::SingleEntity>(
+            render_graphs[i % render_graphs.size()], &mesh_, iris::Vector3{0.0f, 0.0f, -1.0f - static_cast<float>(i)});
+    }
+
+    renderer.set_render_pipeline(std::move(pipeline));
+    const auto unsorted_changes = count_material_changes(renderer.render_queue());
+
+    renderer.render();
+
+    // 100 entities each drawn for the ambient and point light
+    ASSERT_EQ(unsorted_changes, 200u);
+
+    // one bind per material for each light type
+    ASSERT_EQ(renderer.material_changes(), 8u);
+
+    ::testing::Test::RecordProperty("saved_material_changes", unsorted_changes - renderer.material_changes());
+}
@@ -0,0 +1,254 @@
+////////////////////////////////////////////////////////////////////////////////
+//         Distributed under the Boost Software License, Version 1.0.         //
+//            (See accompanying file LICENSE or copy at                       //
+//                 https://www.boost.org/LICENSE_1_0.txt)                     //
+////////////////////////////////////////////////////////////////////////////////
+
+#include <algorithm>
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include "core/colour.h"
+#include "core/vector3.h"
+#include "graphics/lights/directional_light.h"
+#include "graphics/lights/point_light.h"
+#include "graphics/render_command.h"
+#include "graphics/render_command_type.h"
+#include "graphics/render_pipeline.h"
+#include "graphics/scene.h"
+#include "graphics/shading_mode.h"
+#include "graphics/single_entity.h"
+#include "jobs/thread/thread_job_system_manager.h"
+
+#include "fakes/fake_material.h"
+#include "fakes/fake_mesh.h"
+#include "fakes/fake_renderer.h"
+#include "mocks/mock_material_manager.h"
+#include "mocks/mock_mesh_manager.h"
+#include "mocks/mock_render_target_manager.h"
+#include "mocks/mock_resource_manager.h"
+
+using ::testing::_;
+using ::testing::Eq;
+using ::testing::NiceMock;
+using ::testing::Return;
+
+class RenderPipelineTests : public ::testing::Test
+{
+  public:
+    RenderPipelineTests()
+        : resource_manager_()
+        , material_manager_()
+        , mesh_manager_(resource_manager_)
+        , render_target_manager_()
+        , pipeline_(material_manager_, mesh_manager_, render_target_manager_, 600u, 600u)
+        , mesh_()
+        , material_()
+        , scene_(pipeline_.create_scene())
+    {
+        ON_CALL(material_manager_, create).WillByDefault(Return(&material_));
+
+        pipeline_.create_render_pass(scene_);
+        scene_->create_light<iris::PointLight>(iris::Vector3{}, iris::Colour{1.0f, 1.0f, 1.0f});
+
+        for (auto i = 0u; i < 3u; ++i)
+        {
+            entities_.push_back(scene_->create_entity<iris::SingleEntity>(nullptr, &mesh_, iris::Vector3{}));
+        }
+
+        render_queue_ = pipeline_.build();
+        pipeline_.clear_dirty_bit();
+    }
+
+  protected:
+    NiceMock<MockResourceManager> resource_manager_;
+    NiceMock<MockMaterialManager> material_manager_;
+    NiceMock<MockMeshManager> mesh_manager_;
+    NiceMock<MockRenderTargetManager> render_target_manager_;
+    iris::RenderPipeline pipeline_;
+    FakeMesh mesh_;
+    FakeMaterial material_;
+    iris::Scene *scene_;
+    std::vector<iris::RenderEntity *> entities_;
+    std::vector<iris::RenderCommand> render_queue_;
+};
+
+TEST_F(RenderPipelineTests, no_changes_does_not_update)
+{
+    const auto expected = render_queue_;
+
+    ASSERT_FALSE(pipeline_.update(render_queue_));
+    ASSERT_EQ(render_queue_, expected);
+}
+
+TEST_F(RenderPipelineTests, add_entity_is_incremental)
+{
+    // one material for the ambient light and one for the point light, none for the existing entities
+    EXPECT_CALL(material_manager_, create).Times(2);
+
+    scene_->create_entity<iris::SingleEntity>(nullptr, &mesh_, iris::Vector3{});
+
+    ASSERT_FALSE(pipeline_.is_dirty());
+    ASSERT_TRUE(pipeline_.update(render_queue_));
+    ::testing::Mock::VerifyAndClearExpectations(&material_manager_);
+
+    ASSERT_EQ(render_queue_, pipeline_.rebuild());
+}
+
+TEST_F(RenderPipelineTests, remove_entity_is_incremental)
+{
+    EXPECT_CALL(material_manager_, create).Times(0);
+
+    scene_->remove(entities_[1]);
+
+    ASSERT_FALSE(pipeline_.is_dirty());
+    ASSERT_TRUE(pipeline_.update(render_queue_));
+    ::testing::Mock::VerifyAndClearExpectations(&material_manager_);
+
+    ASSERT_EQ(render_queue_, pipeline_.rebuild());
+}
+
+TEST_F(RenderPipelineTests, add_then_remove_entity_is_a_no_op)
+{
+    const auto expected = render_queue_;
+
+    auto *entity = scene_->create_entity<iris::SingleEntity>(nullptr, &mesh_, iris::Vector3{});
+    scene_->remove(entity);
+
+    ASSERT_FALSE(pipeline_.update(render_queue_));
+    ASSERT_EQ(render_queue_, expected);
+}
+
+TEST_F(RenderPipelineTests, set_render_graph_updates_material)
+{
+    FakeMaterial new_material{};
+    auto *render_graph = pipeline_.create_render_graph();
+
+    EXPECT_CALL(material_manager_, create(Eq(render_graph), Eq(entities_[1]), _, _, _, _, _, _))
+        .Times(2)
+        .WillRepeatedly(Return(&new_material));
+
+    scene_->set_render_graph(entities_[1], render_graph);
+
+    ASSERT_FALSE(pipeline_.is_dirty());
+    ASSERT_TRUE(pipeline_.update(render_queue_));
+
+    for (const auto &command : render_queue_)
+    {
+        if (command.type() == iris::RenderCommandType::DRAW)
+        {
+            ASSERT_EQ(command.material() == &new_material, command.render_entity() == entities_[1]);
+        }
+    }
+}
+
+TEST_F(RenderPipelineTests, add_light_is_structural)
+{
+    scene_->create_light<iris::PointLight>(iris::Vector3{}, iris::Colour{1.0f, 1.0f, 1.0f});
+
+    ASSERT_TRUE(pipeline_.is_dirty());
+}
+
+TEST_F(RenderPipelineTests, parallel_encoding_matches_serial)
+{
+    iris::ThreadJobSystemManager jobs_manager{};
+    jobs_manager.create_job_system();
+
+    iris::RenderPipeline pipeline{material_manager_, mesh_manager_, render_target_manager_, 600u, 600u, &jobs_manager};
+    auto *scene = pipeline.create_scene();
+    auto *pass = pipeline.create_render_pass(scene);
+
+    const auto *light1 = scene->create_light<iris::PointLight>(iris::Vector3{}, iris::Colour{1.0f, 1.0f, 1.0f});
+    const auto *light2 = scene->create_light<iris::PointLight>(iris::Vector3{}, iris::Colour{1.0f, 1.0f, 1.0f});
+
+    // enough entities to be split over several jobs
+    std::vector<const iris::RenderEntity *> entities{};
+    for (auto i = 0u; i < 1000u; ++i)
+    {
+        entities.push_back(scene->create_entity<iris::SingleEntity>(nullptr, &mesh_, iris::Vector3{}));
+    }
+
+    std::vector<iris::RenderCommand> expected{};
+    expected.emplace_back(iris::RenderCommandType::PASS_START, pass, nullptr, nullptr, nullptr, nullptr);
+
+    for (const auto *entity : entities)
+    {
+        expected.emplace_back(
+            iris::RenderCommandType::DRAW,
+            pass,
+            &material_,
+            entity,
+            nullptr,
+            scene->lighting_rig()->ambient_light.get());
+    }
+
+    for (const auto *entity : entities)
+    {
+        expected.emplace_back(iris::RenderCommandType::DRAW, pass, &material_, entity, nullptr, light1);
+        expected.emplace_back(iris::RenderCommandType::DRAW, pass, &material_, entity, nullptr, light2);
+    }
+
+    expected.emplace_back(iris::RenderCommandType::PASS_END, pass, nullptr, nullptr, nullptr, nullptr);
+    expected.emplace_back(iris::RenderCommandType::PRESENT, pass, nullptr, nullptr, nullptr, nullptr);
+
+    ASSERT_EQ(pipeline.build(), expected);
+}
+
+TEST_F(RenderPipelineTests, single_pass_shading_draws_each_entity_once)
+{
+    const auto draw_count = [this](iris::ShadingMode shading_mode)
+    {
+        FakeRenderer renderer{material_manager_};
+
+        auto pipeline = std::make_unique<iris::RenderPipeline>(
+            material_manager_, mesh_manager_, render_target_manager_, 600u, 600u);
+        auto *scene = pipeline->create_scene();
+        pipeline->create_render_pass(scene)->shading_mode = shading_mode;
+
+        for (auto i = 0u; i < 8u; ++i)
+        {
+            scene->create_light<iris::PointLight>(iris::Vector3{}, iris::Colour{1.0f, 1.0f, 1.0f});
+        }
+
+        for (auto i = 0u; i < 2u; ++i)
+        {
+            scene->create_light<iris::DirectionalLight>(iris::Vector3{0.0f, -1.0f, -1.0f}, false);
+        }
+
+        for (auto i = 0u; i < 10u; ++i)
+        {
+            scene->create_entity<iris::SingleEntity>(nullptr, &mesh_, iris::Vector3{});
+        }
+
+        renderer.set_render_pipeline(std::move(pipeline));
+        renderer.render();
+
+        const auto call_log = renderer.call_log();
+        return static_cast<std::size_t>(
+            std::count(std::cbegin(call_log), std::cend(call_log), iris::RenderCommandType::DRAW));
+    };
+
+    // an ambient draw plus one for each of the ten lights
+    ASSERT_EQ(draw_count(iris::ShadingMode::PER_LIGHT), 10u * 11u);
+    ASSERT_EQ(draw_count(iris::ShadingMode::SINGLE_PASS), 10u);
+}
+
+TEST_F(RenderPipelineTests, single_pass_materials_keyed_by_shading_mode)
+{
+    iris::RenderPipeline pipeline{material_manager_, mesh_manager_, render_target_manager_, 600u, 600u};
+    auto *scene = pipeline.create_scene();
+    pipeline.create_render_pass(scene)->shading_mode = iris::ShadingMode::SINGLE_PASS;
+    scene->create_light<iris::PointLight>(iris::Vector3{}, iris::Colour{1.0f, 1.0f, 1.0f});
+    scene->create_entity<iris::SingleEntity>(nullptr, &mesh_, iris::Vector3{});
+
+    EXPECT_CALL(material_manager_, create(_, _, _, Eq(iris::ShadingMode::PER_LIGHT), _, _, _, _)).Times(0);
+    EXPECT_CALL(
+        material_manager_, create(_, _, Eq(iris::LightType::AMBIENT), Eq(iris::ShadingMode::SINGLE_PASS), _, _, _, _))
+        .Times(1);
+
+    pipeline.build();
+}
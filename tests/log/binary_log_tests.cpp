@@ -0,0 +1,188 @@
+////////////////////////////////////////////////////////////////////////////////
+//         Distributed under the Boost Software License, Version 1.0.         //
+//            (See accompanying file LICENSE or copy at                       //
+//                 https://www.boost.org/LICENSE_1_0.txt)                     //
+////////////////////////////////////////////////////////////////////////////////
+
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "core/exception.h"
+#include "core/vector3.h"
+#include "log/binary_log_decoder.h"
+#include "log/log.h"
+#include "log/log_level.h"
+#include "log/logger.h"
+
+namespace
+{
+
+/**
+ * Decode a binary log file and return each line.
+ */
+std::vector<std::string> decode(const std::filesystem::path &path)
+{
+    std::ifstream in{path, std::ios::in | std::ios::binary};
+    std::stringstream out{};
+
+    iris::decode_binary_log(in, out);
+
+    std::vector<std::string> lines{};
+    std::string line{};
+    while (std::getline(out, line))
+    {
+        lines.emplace_back(line);
+    }
+
+    return lines;
+}
+
+/**
+ * Fixture which writes a binary log to a temporary file.
+ */
+class binary_log_fixture : public ::testing::Test
+{
+  protected:
+    void SetUp() override
+    {
+        path_ = std::filesystem::temp_directory_path() / "iris_binary_log_test.bin";
+
+        auto &logger = iris::Logger::instance();
+        logger.set_min_level(iris::LogLevel::DEBUG);
+        logger.set_binary_output(path_);
+    }
+
+    void TearDown() override
+    {
+        iris::Logger::instance().set_binary_output({});
+        std::filesystem::remove(path_);
+    }
+
+    std::filesystem::path path_;
+};
+
+}
+
+TEST_F(binary_log_fixture, round_trip)
+{
+    const std::string dynamic_tag{"dynamic"};
+    const std::string dynamic_format{"dynamic {}"};
+    const char *c_str = "c_str";
+
+    IRIS_LOG(iris::LogLevel::INFO, false, "tag", "no args");
+    IRIS_LOG(iris::LogLevel::WARN, false, "tag", "{} {} {} {}", 1, -2ll, 3u, std::uint8_t{65u});
+    IRIS_LOG(iris::LogLevel::ERR, false, "tag", "{} {} {} {}", 1.5f, 2.25, true, 'c');
+    IRIS_LOG(iris::LogLevel::INFO, false, "tag", "{} {}", std::string{"str"}, c_str);
+    IRIS_LOG(iris::LogLevel::INFO, false, "tag", "{}", iris::Vector3{1.0f, 2.0f, 3.0f});
+    IRIS_LOG(iris::LogLevel::INFO, false, dynamic_tag, "hello");
+    IRIS_LOG(iris::LogLevel::INFO, false, "tag", iris::runtime_format(dynamic_format), 4);
+    IRIS_LOG(iris::LogLevel::INFO, false, "tag", iris::runtime_format("too few {} {}"), 5);
+
+    iris::Logger::instance().set_binary_output({});
+
+    std::stringstream vector_strm{};
+    vector_strm << iris::Vector3{1.0f, 2.0f, 3.0f};
+
+    const auto lines = decode(path_);
+    ASSERT_EQ(lines.size(), 8u);
+
+    const auto message = [](const std::string &line) { return line.substr(line.find(" | ") + 3u); };
+
+    ASSERT_EQ(message(lines[0]), "no args");
+    ASSERT_EQ(message(lines[1]), "1 -2 3 A");
+    ASSERT_EQ(message(lines[2]), "1.5 2.25 1 c");
+    ASSERT_EQ(message(lines[3]), "str c_str");
+    ASSERT_EQ(message(lines[4]), vector_strm.str());
+    ASSERT_NE(lines[5].find("[dynamic]"), std::string::npos);
+    ASSERT_EQ(message(lines[5]), "hello");
+    ASSERT_EQ(message(lines[6]), "dynamic 4");
+    ASSERT_EQ(message(lines[7]), "too few 5 {}");
+}
+
+TEST_F(binary_log_fixture, multiple_threads)
+{
+    std::vector<std::thread> threads{};
+    for (auto i = 0; i < 4; ++i)
+    {
+        threads.emplace_back(
+            []
+            {
+                for (auto j = 0; j < 1000; ++j)
+                {
+                    IRIS_LOG(iris::LogLevel::INFO, false, "tag", "{}", j);
+                }
+            });
+    }
+
+    for (auto &thread : threads)
+    {
+        thread.join();
+    }
+
+    iris::Logger::instance().set_binary_output({});
+
+    ASSERT_EQ(decode(path_).size(), 4000u);
+}
+
+TEST_F(binary_log_fixture, null_c_string)
+{
+    const char *null_str = nullptr;
+
+    IRIS_LOG(iris::LogLevel::INFO, false, "tag", "value {}", null_str);
+
+    iris::Logger::instance().set_binary_output({});
+
+    const auto lines = decode(path_);
+    ASSERT_EQ(lines.size(), 1u);
+    ASSERT_EQ(lines[0].substr(lines[0].find(" | ") + 3u), "value (null)");
+}
+
+TEST_F(binary_log_fixture, mutable_tag_buffer)
+{
+    char tag[8] = "first";
+
+    for (auto i = 0; i < 2; ++i)
+    {
+        IRIS_LOG(iris::LogLevel::INFO, false, tag, "hello");
+        std::strcpy(tag, "second");
+    }
+
+    iris::Logger::instance().set_binary_output({});
+
+    const auto lines = decode(path_);
+    ASSERT_EQ(lines.size(), 2u);
+    ASSERT_NE(lines[0].find("[first]"), std::string::npos);
+    ASSERT_NE(lines[1].find("[second]"), std::string::npos);
+}
+
+TEST_F(binary_log_fixture, exited_thread_buffers_reused)
+{
+    // a reused buffer may still hold undrained messages from the previous thread, which must all be written
+    iris::Logger::instance().set_binary_output(path_, 256u);
+
+    for (auto i = 0; i < 10; ++i)
+    {
+        std::thread{[i] { IRIS_LOG(iris::LogLevel::INFO, false, "tag", "{}", i); }}.join();
+    }
+
+    iris::Logger::instance().set_binary_output({});
+
+    const auto lines = decode(path_);
+    ASSERT_EQ(lines.size(), 10u);
+}
+
+TEST(binary_log, bad_file)
+{
+    std::stringstream in{"not a binary log"};
+    std::stringstream out{};
+
+    ASSERT_THROW(iris::decode_binary_log(in, out), iris::Exception);
+}
@@ -0,0 +1,105 @@
+////////////////////////////////////////////////////////////////////////////////
+//         Distributed under the Boost Software License, Version 1.0.         //
+//            (See accompanying file LICENSE or copy at                       //
+//                 https://www.boost.org/LICENSE_1_0.txt)                     //
+////////////////////////////////////////////////////////////////////////////////
+
+#include <cstdint>
+#include <sstream>
+#include <string>
+#include <string_view>
+
+#include <gtest/gtest.h>
+
+#include "core/vector3.h"
+#include "log/format.h"
+
+TEST(format, count_placeholders)
+{
+    static_assert(iris::detail::count_placeholders("") == 0u);
+    static_assert(iris::detail::count_placeholders("hello") == 0u);
+    static_assert(iris::detail::count_placeholders("{}") == 1u);
+    static_assert(iris::detail::count_placeholders("a {} b {}{}") == 3u);
+    static_assert(iris::detail::count_placeholders("{ } {") == 0u);
+}
+
+TEST(format, no_args)
+{
+    std::string out{};
+    iris::format_to(out, "hello");
+
+    ASSERT_EQ(out, "hello");
+}
+
+TEST(format, appends)
+{
+    std::string out{"a"};
+    iris::format_to(out, "{}", 1);
+
+    ASSERT_EQ(out, "a1");
+}
+
+TEST(format, arithmetic)
+{
+    std::string out{};
+    iris::format_to(out, "{} {} {} {} {} {}", -1, 2u, std::int64_t{-3}, std::uint8_t{65u}, true, 'c');
+
+    ASSERT_EQ(out, "-1 2 -3 A 1 c");
+}
+
+TEST(format, floating_point_matches_stream)
+{
+    std::stringstream strm{};
+    strm << 1.5f << " " << 0.1 << " " << 1.0f / 3.0f << " " << 1e20;
+
+    std::string out{};
+    iris::format_to(out, "{} {} {} {}", 1.5f, 0.1, 1.0f / 3.0f, 1e20);
+
+    ASSERT_EQ(out, strm.str());
+}
+
+TEST(format, strings)
+{
+    const char *c_str = "c";
+    const char *null_str = nullptr;
+
+    std::string out{};
+    iris::format_to(out, "{} {} {} {}", "a", std::string{"b"}, c_str, std::string_view{"d"});
+    iris::format_to(out, " {}", null_str);
+
+    ASSERT_EQ(out, "a b c d (null)");
+}
+
+TEST(format, stream_fallback)
+{
+    const iris::Vector3 vec{1.0f, 2.0f, 3.0f};
+
+    std::stringstream strm{};
+    strm << "vec: " << vec << "!";
+
+    std::string out{};
+    iris::format_to(out, "vec: {}!", vec);
+
+    ASSERT_EQ(out, strm.str());
+}
+
+TEST(format, runtime_format)
+{
+    std::string out{};
+
+    iris::format_to(out, iris::runtime_format("{} and {}"), 1);
+    ASSERT_EQ(out, "1 and {}");
+
+    out.clear();
+    iris::format_to(out, iris::runtime_format("no placeholders"), 1);
+    ASSERT_EQ(out, "no placeholders");
+}
+
+TEST(format, buffer_reused)
+{
+    auto &buffer = iris::format_buffer();
+    iris::format_to(buffer, "{}", 123);
+
+    ASSERT_EQ(iris::format_buffer(), "");
+    ASSERT_EQ(&iris::format_buffer(), &buffer);
+}
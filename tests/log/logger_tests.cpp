@@ -0,0 +1,221 @@
+////////////////////////////////////////////////////////////////////////////////
+//         Distributed under the Boost Software License, Version 1.0.         //
+//            (See accompanying file LICENSE or copy at                       //
+//                 https://www.boost.org/LICENSE_1_0.txt)                     //
+////////////////////////////////////////////////////////////////////////////////
+
+#include <chrono>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "log/formatter.h"
+#include "log/log_level.h"
+#include "log/logger.h"
+#include "log/outputter.h"
+#include "log/rotating_file_outputter.h"
+
+using namespace std::chrono_literals;
+
+namespace
+{
+
+/**
+ * Formatter which just returns the message.
+ */
+class MessageFormatter : public iris::Formatter
+{
+  public:
+    void format(
+        std::string &out,
+        const iris::LogLevel,
+        std::string_view,
+        std::string_view message,
+        std::string_view,
+        const int) override
+    {
+        out += message;
+    }
+};
+
+/**
+ * Outputter which stores messages in a shared vector.
+ */
+class VectorOutputter : public iris::Outputter
+{
+  public:
+    VectorOutputter(std::shared_ptr<std::vector<std::string>> logs)
+        : logs_(logs)
+    {
+    }
+
+    void output(const std::string &log) override
+    {
+        logs_->emplace_back(log);
+    }
+
+  private:
+    std::shared_ptr<std::vector<std::string>> logs_;
+};
+
+/**
+ * Fixture which captures log output and restores the logger afterwards.
+ */
+class logger_fixture : public ::testing::Test
+{
+  protected:
+    void SetUp() override
+    {
+        logs_ = std::make_shared<std::vector<std::string>>();
+
+        auto &logger = iris::Logger::instance();
+        logger.set_Formatter<MessageFormatter>();
+        logger.set_Outputter<VectorOutputter>(logs_);
+        logger.set_min_level(iris::LogLevel::DEBUG);
+    }
+
+    void TearDown() override
+    {
+        auto &logger = iris::Logger::instance();
+        logger.set_async(false);
+        logger.set_Formatter<iris::ColourFormatter>();
+        logger.set_Outputter<iris::StdoutFormatter>();
+    }
+
+    std::shared_ptr<std::vector<std::string>> logs_;
+};
+
+}
+
+TEST_F(logger_fixture, sync)
+{
+    iris::Logger::instance().log(iris::LogLevel::INFO, "tag", "file", 1, false, "hello {}", 1);
+
+    ASSERT_EQ(*logs_, std::vector<std::string>{"hello 1"});
+}
+
+TEST_F(logger_fixture, filtered)
+{
+    auto &logger = iris::Logger::instance();
+    logger.ignore_tag("ignored");
+
+    logger.log(iris::LogLevel::INFO, "ignored", "file", 1, false, "hello {}", 1);
+    logger.log(iris::LogLevel::INFO, "tag", "file", 1, true, "hello {}", 2);
+    logger.set_min_level(iris::LogLevel::WARN);
+    logger.log(iris::LogLevel::INFO, "tag", "file", 1, false, "hello {}", 3);
+    logger.log(iris::LogLevel::WARN, "tag", "file", 1, false, "hello {}", 4);
+    logger.show_tag("ignored");
+    logger.log(iris::LogLevel::WARN, "ignored", "file", 1, false, "hello {}", 5);
+
+    ASSERT_TRUE(logger.is_enabled(iris::LogLevel::ERR, "ignored", false));
+    ASSERT_FALSE(logger.is_enabled(iris::LogLevel::ERR, "ignored", true));
+    ASSERT_EQ(*logs_, (std::vector<std::string>{"hello 4", "hello 5"}));
+}
+
+TEST_F(logger_fixture, async)
+{
+    auto &logger = iris::Logger::instance();
+    logger.set_async(true);
+
+    logger.log(iris::LogLevel::INFO, "tag", "file", 1, false, "hello {}", 1);
+    logger.log(iris::LogLevel::INFO, "tag", "file", 1, false, "hello {}", 2);
+    logger.flush();
+
+    ASSERT_EQ(*logs_, (std::vector<std::string>{"hello 1", "hello 2"}));
+}
+
+TEST_F(logger_fixture, async_multiple_threads)
+{
+    auto &logger = iris::Logger::instance();
+    logger.set_async(true, 16u, iris::LogOverflowPolicy::BLOCK);
+
+    std::vector<std::thread> threads{};
+    for (auto i = 0; i < 4; ++i)
+    {
+        threads.emplace_back(
+            [&logger]
+            {
+                for (auto j = 0; j < 1000; ++j)
+                {
+                    logger.log(iris::LogLevel::INFO, "tag", "file", 1, false, "{}", j);
+                }
+            });
+    }
+
+    for (auto &thread : threads)
+    {
+        thread.join();
+    }
+
+    // stopping the writer drains the queue
+    logger.set_async(false);
+
+    ASSERT_EQ(logs_->size(), 4000u);
+    ASSERT_EQ(logger.dropped_count(), 0u);
+}
+
+TEST_F(logger_fixture, async_drop)
+{
+    auto &logger = iris::Logger::instance();
+    logger.set_async(true, 1u, iris::LogOverflowPolicy::DROP);
+
+    for (auto i = 0; i < 1000; ++i)
+    {
+        logger.log(iris::LogLevel::INFO, "tag", "file", 1, false, "{}", i);
+    }
+
+    const auto dropped = logger.dropped_count();
+    logger.set_async(false);
+
+    // every message is either written or dropped, and drops are reported in the log
+    std::uint64_t written = 0u;
+    std::uint64_t reported = 0u;
+    for (const auto &log : *logs_)
+    {
+        if (const auto pos = log.find(" messages dropped"); pos != std::string::npos)
+        {
+            reported += std::stoull(log.substr(0u, pos));
+        }
+        else
+        {
+            ++written;
+        }
+    }
+
+    ASSERT_GT(dropped, 0u);
+    ASSERT_EQ(reported, dropped);
+    ASSERT_EQ(written + dropped, 1000u);
+}
+
+TEST_F(logger_fixture, async_flushes_when_idle)
+{
+    const auto path = std::filesystem::temp_directory_path() / "iris_logger_idle_flush_test.log";
+    std::filesystem::remove(path);
+
+    auto &logger = iris::Logger::instance();
+    logger.set_Outputter<iris::RotatingFileOutputter>(path, iris::RotatingFileOptions{.flush_interval = 50ms});
+    logger.set_async(true);
+
+    logger.log(iris::LogLevel::INFO, "tag", "file", 1, false, "hello {}", 1);
+
+    // no further messages, so only the idle writer can write the buffered line
+    std::this_thread::sleep_for(250ms);
+
+    std::ifstream file{path};
+    const std::string contents{std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>()};
+
+    logger.set_async(false);
+    logger.set_Outputter<iris::StdoutFormatter>();
+    std::filesystem::remove(path);
+
+    ASSERT_EQ(contents, "hello 1\n");
+}
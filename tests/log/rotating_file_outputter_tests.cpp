@@ -0,0 +1,226 @@
+////////////////////////////////////////////////////////////////////////////////
+//         Distributed under the Boost Software License, Version 1.0.         //
+//            (See accompanying file LICENSE or copy at                       //
+//                 https://www.boost.org/LICENSE_1_0.txt)                     //
+////////////////////////////////////////////////////////////////////////////////
+
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <string>
+
+#include <gtest/gtest.h>
+
+#include "log/file_write_mode.h"
+#include "log/rotating_file_outputter.h"
+
+namespace
+{
+
+/**
+ * Read a whole file.
+ */
+std::string read(const std::filesystem::path &path)
+{
+    std::ifstream file{path, std::ios::binary};
+    return {std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>()};
+}
+
+/**
+ * Fixture which provides an empty directory to write logs into.
+ */
+class RotatingFileOutputterFixture : public ::testing::Test
+{
+  protected:
+    void SetUp() override
+    {
+        directory_ = std::filesystem::temp_directory_path() / "iris_rotating_file_outputter_tests";
+        std::filesystem::remove_all(directory_);
+        std::filesystem::create_directories(directory_);
+        path_ = directory_ / "test.log";
+    }
+
+    void TearDown() override
+    {
+        std::filesystem::remove_all(directory_);
+    }
+
+    std::filesystem::path directory_;
+    std::filesystem::path path_;
+};
+
+/**
+ * Write enough lines to cross several buffers and blocks, then check they all arrived intact.
+ */
+void write_and_check(
+    const std::filesystem::path &path,
+    iris::FileWriteMode mode,
+    const std::string &existing)
+{
+    std::string expected = existing;
+
+    {
+        iris::RotatingFileOutputter outputter{path, {.buffer_size = 4096u, .mode = mode}};
+        for (auto i = 0u; i < 2000u; ++i)
+        {
+            const auto line = "line " + std::to_string(i);
+            outputter.output(line);
+            expected += line + '\n';
+        }
+    }
+
+    ASSERT_EQ(read(path), expected);
+}
+
+}
+
+TEST_F(RotatingFileOutputterFixture, buffers_until_sync)
+{
+    iris::RotatingFileOutputter outputter{path_, {.flush_interval = std::chrono::hours(1)}};
+
+    outputter.output("hello");
+    outputter.flush();
+    ASSERT_EQ(read(path_), "");
+
+    outputter.sync();
+    ASSERT_EQ(read(path_), "hello\n");
+}
+
+TEST_F(RotatingFileOutputterFixture, flush_interval_zero)
+{
+    iris::RotatingFileOutputter outputter{path_, {.flush_interval = std::chrono::milliseconds(0)}};
+
+    outputter.output("hello");
+    outputter.flush();
+    ASSERT_EQ(read(path_), "hello\n");
+}
+
+TEST_F(RotatingFileOutputterFixture, appends_to_existing)
+{
+    {
+        std::ofstream file{path_};
+        file << "existing\n";
+    }
+
+    {
+        iris::RotatingFileOutputter outputter{path_};
+        outputter.output("hello");
+    }
+
+    ASSERT_EQ(read(path_), "existing\nhello\n");
+}
+
+TEST_F(RotatingFileOutputterFixture, size_rotation)
+{
+    {
+        iris::RotatingFileOutputter outputter{path_, {.max_file_size = 12u, .retention = 2u}};
+
+        outputter.output("one");
+        outputter.output("two");
+        outputter.output("three");
+        outputter.output("four");
+        outputter.output("five");
+    }
+
+    ASSERT_EQ(read(path_), "five\n");
+    ASSERT_EQ(read(directory_ / "test.1.log"), "three\nfour\n");
+    ASSERT_EQ(read(directory_ / "test.2.log"), "one\ntwo\n");
+    ASSERT_FALSE(std::filesystem::exists(directory_ / "test.3.log"));
+}
+
+TEST_F(RotatingFileOutputterFixture, retention)
+{
+    {
+        iris::RotatingFileOutputter outputter{path_, {.retention = 1u}};
+
+        outputter.output("one");
+        outputter.rotate();
+        outputter.output("two");
+        outputter.rotate();
+        outputter.output("three");
+    }
+
+    ASSERT_EQ(read(path_), "three\n");
+    ASSERT_EQ(read(directory_ / "test.1.log"), "two\n");
+    ASSERT_FALSE(std::filesystem::exists(directory_ / "test.2.log"));
+}
+
+TEST_F(RotatingFileOutputterFixture, zero_retention)
+{
+    {
+        iris::RotatingFileOutputter outputter{path_, {.retention = 0u}};
+
+        outputter.output("one");
+        outputter.rotate();
+        outputter.output("two");
+    }
+
+    ASSERT_EQ(read(path_), "two\n");
+    ASSERT_FALSE(std::filesystem::exists(directory_ / "test.1.log"));
+}
+
+TEST_F(RotatingFileOutputterFixture, oversized_line_does_not_rotate_empty_file)
+{
+    {
+        iris::RotatingFileOutputter outputter{path_, {.max_file_size = 4u}};
+        outputter.output("too long for the file");
+    }
+
+    ASSERT_EQ(read(path_), "too long for the file\n");
+    ASSERT_FALSE(std::filesystem::exists(directory_ / "test.1.log"));
+}
+
+TEST_F(RotatingFileOutputterFixture, buffered_mode)
+{
+    write_and_check(path_, iris::FileWriteMode::BUFFERED, "");
+}
+
+#if !defined(IRIS_PLATFORM_WIN32)
+
+TEST_F(RotatingFileOutputterFixture, direct_mode)
+{
+    write_and_check(path_, iris::FileWriteMode::DIRECT, "");
+}
+
+TEST_F(RotatingFileOutputterFixture, direct_mode_append)
+{
+    const std::string existing = "existing partial block\n";
+    {
+        std::ofstream file{path_};
+        file << existing;
+    }
+
+    write_and_check(path_, iris::FileWriteMode::DIRECT, existing);
+}
+
+TEST_F(RotatingFileOutputterFixture, direct_mode_sync)
+{
+    iris::RotatingFileOutputter outputter{path_, {.mode = iris::FileWriteMode::DIRECT}};
+
+    outputter.output("one");
+    outputter.sync();
+    ASSERT_EQ(read(path_), "one\n");
+
+    outputter.output("two");
+    outputter.sync();
+    ASSERT_EQ(read(path_), "one\ntwo\n");
+}
+
+TEST_F(RotatingFileOutputterFixture, mapped_mode)
+{
+    write_and_check(path_, iris::FileWriteMode::MAPPED, "");
+}
+
+TEST_F(RotatingFileOutputterFixture, mapped_mode_append)
+{
+    const std::string existing = "existing partial page\n";
+    {
+        std::ofstream file{path_};
+        file << existing;
+    }
+
+    write_and_check(path_, iris::FileWriteMode::MAPPED, existing);
+}
+
+#endif
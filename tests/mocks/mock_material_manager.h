@@ -14,6 +14,7 @@
 #include "graphics/material.h"
 #include "graphics/material_manager.h"
 #include "graphics/render_entity.h"
+#include "graphics/shading_mode.h"
 
 class MockMaterialManager : public iris::MaterialManager
 {
@@ -21,7 +22,7 @@ class MockMaterialManager : public iris::MaterialManager
     MOCK_METHOD(
         iris::Material *,
         create,
-        (iris::RenderGraph *, iris::RenderEntity *, iris::LightType, bool, bool, bool, bool),
+        (iris::RenderGraph *, iris::RenderEntity *, iris::LightType, iris::ShadingMode, bool, bool, bool, bool),
         (override));
     MOCK_METHOD(void, clear, (), (override));
 };
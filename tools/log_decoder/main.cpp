@@ -0,0 +1,54 @@
+////////////////////////////////////////////////////////////////////////////////
+//         Distributed under the Boost Software License, Version 1.0.         //
+//            (See accompanying file LICENSE or copy at                       //
+//                 https://www.boost.org/LICENSE_1_0.txt)                     //
+////////////////////////////////////////////////////////////////////////////////
+
+#include <fstream>
+#include <iostream>
+
+#include "core/exception.h"
+#include "log/binary_log_decoder.h"
+
+/**
+ * Tool to decode a binary log (see Logger::set_binary_output) to text.
+ *
+ * usage: log_decoder <binary log> [output file]
+ *
+ * If no output file is supplied the log is written to stdout.
+ */
+int main(int argc, char **argv)
+{
+    if ((argc != 2) && (argc != 3))
+    {
+        std::cerr << "usage: " << argv[0] << " <binary log> [output file]" << std::endl;
+        return 1;
+    }
+
+    try
+    {
+        std::ifstream in{argv[1], std::ios::in | std::ios::binary};
+        if (!in.is_open())
+        {
+            std::cerr << "could not open " << argv[1] << std::endl;
+            return 1;
+        }
+
+        if (argc == 3)
+        {
+            std::ofstream out{argv[2], std::ios::out | std::ios::trunc};
+            iris::decode_binary_log(in, out);
+        }
+        else
+        {
+            iris::decode_binary_log(in, std::cout);
+        }
+    }
+    catch (const iris::Exception &e)
+    {
+        std::cerr << e.what() << std::endl;
+        return 1;
+    }
+
+    return 0;
+}